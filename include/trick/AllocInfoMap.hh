@@ -0,0 +1,66 @@
+#ifndef ALLOCINFOMAP_HH
+#define ALLOCINFOMAP_HH
+/*
+    PURPOSE: ( AllocInfoMap - index of the allocations known to the MemoryManager.)
+    ICG: (No)
+*/
+
+#include <stddef.h>
+#include <map>
+#include <functional>
+
+#include "trick/io_alloc.h"
+
+namespace Trick {
+
+/**
+ AllocInfoMap indexes the allocations of the MemoryManager by start address. Iteration visits the
+ allocations from the highest to the lowest address, and lower_bound(addr) returns the allocation
+ with the highest start address that is less than or equal to addr.
+
+ The entries are kept in a balanced tree, so inserting, erasing and finding an allocation are
+ O(log n) wherever its address falls. Erasing or inserting entries does not invalidate iterators
+ to other entries.
+ */
+    class AllocInfoMap {
+
+        private:
+
+            typedef std::map< void * , ALLOC_INFO * , std::greater< void * > > entry_map ;
+
+        public:
+
+            typedef void * key_type ;
+            typedef ALLOC_INFO * mapped_type ;
+            typedef entry_map::value_type value_type ;
+            typedef entry_map::const_iterator const_iterator ;
+            typedef const_iterator iterator ;
+
+            const_iterator begin() const { return entries.begin() ; }
+            const_iterator end() const { return entries.end() ; }
+
+            /** @return Iterator to the allocation starting at addr, or end(). */
+            const_iterator find( void * addr ) const { return entries.find(addr) ; }
+
+            /** @return Iterator to the allocation with the highest start address <= addr, or end(). */
+            const_iterator lower_bound( void * addr ) const { return entries.lower_bound(addr) ; }
+
+            /** @return Reference to the ALLOC_INFO pointer for addr, inserting NULL if addr is not present. */
+            ALLOC_INFO *& operator[]( void * addr ) { return entries[addr] ; }
+
+            /** Removes the allocation starting at addr. @return The number of entries removed. */
+            size_t erase( void * addr ) { return entries.erase(addr) ; }
+
+            void clear() { entries.clear() ; }
+
+            size_t size() const { return entries.size() ; }
+            bool empty() const { return entries.empty() ; }
+
+        private:
+
+            entry_map entries ;  /* keyed by start address, highest first */
+    } ;
+
+}
+
+#endif
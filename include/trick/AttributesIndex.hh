@@ -0,0 +1,88 @@
+#ifndef ATTRIBUTESINDEX_HH
+#define ATTRIBUTESINDEX_HH
+/*
+    PURPOSE: ( AttributesIndex - lookup indexes over the members of an ATTRIBUTES array.)
+*/
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "trick/attributes.h"
+
+namespace Trick {
+
+/**
+ An AttributesIndex provides constant time member lookup by name and logarithmic
+ member lookup by offset for a single, name[0] == '\\0' terminated ATTRIBUTES array.
+ Indexes are built lazily the first time an ATTRIBUTES array is searched and are
+ shared by the REF parser (MemoryManager::ref_name) and the checkpoint agent.
+ Once built, an index is read only, and lookups of existing indexes take a shared
+ read lock. An index remembers the first member of its array, and an array found at
+ the address of an array that was freed or unloaded gets a new index.
+
+ Lookups return the same member a linear scan of the array would return, including
+ for duplicated names (first declaration wins) and overlapping members.
+ */
+    class AttributesIndex {
+
+        public:
+
+        /**
+         Returns the index for the given ATTRIBUTES array, building it on first use.
+         @param attr_list - name[0] == '\\0' terminated ATTRIBUTES array.
+         @return The index, or NULL if attr_list is NULL.
+         */
+        static AttributesIndex * get_index( ATTRIBUTES * attr_list ) ;
+
+        /**
+         Discards the index of the given ATTRIBUTES array. Must be called before
+         a dynamically allocated ATTRIBUTES array is freed or modified. The index
+         itself is kept, since a reader may still be using it.
+         */
+        static void remove_index( ATTRIBUTES * attr_list ) ;
+
+        /**
+         Returns the member with the given name.
+         @return Pointer to the member's ATTRIBUTES, or NULL if not found.
+         */
+        ATTRIBUTES * find_name( const char * name ) const ;
+
+        /**
+         Returns the member whose storage contains the given byte offset.
+         @return Pointer to the member's ATTRIBUTES, or the terminating (name[0] == '\\0')
+         entry of the array if no member contains the offset.
+         */
+        ATTRIBUTES * find_offset( long offset ) const ;
+
+        /**
+         Returns the number of bytes occupied by the given member of a composite type.
+         References use the width stored in mods bits 3-8. Pointers are sizeof(void*).
+         */
+        static int member_size( ATTRIBUTES * attr ) ;
+
+        private:
+
+        /** Byte range [start, end) of one member, in declaration order (index) */
+        struct OffsetEntry {
+            long start ;
+            long end ;
+            int index ;
+        } ;
+
+        AttributesIndex( ATTRIBUTES * attr_list ) ;
+
+        /** Returns true if attr_list still holds the array this index was built from. */
+        bool matches( ATTRIBUTES * attr_list ) const ;
+
+        ATTRIBUTES * attr_list ;      /**< ** indexed ATTRIBUTES array */
+        ATTRIBUTES * terminator ;     /**< ** terminating entry of attr_list */
+        const char * first_name ;     /**< ** name of the first member when the index was built */
+        const char * first_type_name ; /**< ** type name of the first member when the index was built */
+        bool overlapping ;            /**< ** true if member ranges overlap (unions), offset lookups scan linearly */
+        std::unordered_map< std::string , ATTRIBUTES * > name_map ; /**< ** name -> member */
+        std::vector< OffsetEntry > offset_table ;                  /**< ** members sorted by start offset */
+    } ;
+
+}
+
+#endif
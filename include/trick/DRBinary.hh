@@ -83,7 +83,7 @@ namespace Trick {
             /**
              @brief DRBinary default constructor.
              */
-            DRBinary() {}
+            DRBinary() : write_columns(false) , header_bytes(0) {}
             #endif
             ~DRBinary() {}
 
@@ -95,6 +95,17 @@ namespace Trick {
              */
             DRBinary( std::string in_name, bool register_group = true ) ;
 
+            /**
+             @brief @userdesc Command to also write the log in columns at shutdown (default is false).
+             The columnar copy is written to log_<group_name>.trk.col.  Data products read only the
+             variables they plot from it, and use its time index to seek to a start time.
+             @par Python Usage:
+             @code <dr_group>.set_write_columns(<True|False>) @endcode
+             @param in_write_columns - write the columnar copy at shutdown
+             @return always 0
+             */
+            int set_write_columns(bool in_write_columns) ;
+
             /**
              @copybrief Trick::DataRecordGroup::format_specific_header
              */
@@ -116,9 +127,21 @@ namespace Trick {
             virtual int format_specific_shutdown() ;
 
         private:
+            /**
+             @brief Writes the columnar copy of the closed log file, see trick/trk_columns.h.
+             @return 0 on success
+             */
+            int write_columns_file() ;
+
             /** The log file.\n */
             int fd ;             /**< trick_io(**) trick_units(--) */
 
+            /** Write the columnar copy of the log at shutdown.\n */
+            bool write_columns ;             /**< trick_units(--) */
+
+            /** Size of the log file header, the first record starts here.\n */
+            unsigned int header_bytes ;      /**< trick_io(**) trick_units(--) */
+
     } ;
 
 } ;
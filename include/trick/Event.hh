@@ -159,6 +159,19 @@ class Event {
         /** process the event */
         virtual int process( long long curr_time ) = 0 ;
 
+        /**
+         @brief Tells whether processing may be split for an event processor with asynchronous evaluation.  Such
+         a processor calls evaluate(curr_time, false) when the event is due, evaluate(curr_time, true) on its helper
+         thread, and commit(curr_time) at its commit point, in place of process(curr_time).
+        */
+        virtual bool deferrable() { return false ; } ;
+
+        /** evaluates the conditions that are evaluated on the calling thread, or with on_helper on the helper thread */
+        virtual void evaluate( long long curr_time __attribute__((unused)) , bool on_helper __attribute__((unused)) ) {} ;
+
+        /** acts on the evaluated conditions */
+        virtual int commit( long long curr_time ) { return process(curr_time) ; } ;
+
         /** called when the event is added to the event manager */
         virtual void add() = 0 ;
 
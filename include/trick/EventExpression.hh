@@ -0,0 +1,156 @@
+/*
+    PURPOSE: ( Simple event condition expressions evaluated without Python. )
+*/
+
+#ifndef EVENTEXPRESSION_HH
+#define EVENTEXPRESSION_HH
+
+#include <string>
+#include <vector>
+#include "trick/reference.h"
+
+namespace Trick {
+
+/**
+  An event condition made only of comparisons and boolean operators over model variables and numbers, such as
+  "veh.alt < 1000.0 and veh.armed".  The variables are resolved once with ref_attributes, and the expression is
+  evaluated each cycle by reading them directly, without the Python interpreter or its lock.
+
+  The supported syntax is the Python subset: numbers, True, False, scalar variable references with constant indexes,
+  parentheses, the comparisons < <= > >= == != (which may be chained), not, and, or.  Anything else is left to Python.
+
+  Evaluation follows Python.  Integers, including integer and bool variables, are held as 64 bit ints and floats as
+  doubles, and an int is compared exactly with a float.  "and" and "or" short-circuit and yield one of their operands,
+  and any nonzero number, NaN included, is true.  Literals are read as Python reads them, so "010" and "1_" are left to
+  Python to report, and int literals or unsigned 64 bit variables that may not fit in an int64 are left to Python too.
+ */
+
+    class EventExpression {
+
+        public:
+
+            /**
+             @brief Builds the expression for a condition string.
+             @return the new expression, or NULL if the string is not a simple expression of resolvable variables
+            */
+            static EventExpression * parse(const std::string & str) ;
+
+            ~EventExpression() ;
+
+            /**
+             @brief Evaluates the expression with the current values of its variables.
+             @return the truth of the expression
+            */
+            bool evaluate() ;
+
+            /** A Python number, an int or a float.\n */
+            struct Value {
+                bool is_int ;
+                long long i ;
+                double d ;
+            } ;
+
+            /**
+             @brief Resolves a dotted variable name with constant indexes.
+             @return the reference, or NULL if the name is not a scalar of a type read as a Python number
+            */
+            static REF2 * resolve(const std::string & name) ;
+
+            /**
+             @brief Reads a variable returned by resolve() as Python would see it.
+            */
+            static Value read(REF2 * ref) ;
+
+        private:
+
+            enum NodeType { CONSTANT , VARIABLE , NOT , AND , OR , LT , LE , GT , GE , EQ , NE } ;
+
+            /** One operand or operator.  Operator operands are indexes into nodes.\n */
+            struct Node {
+                NodeType type ;
+                Value value ;
+                REF2 * ref ;
+                int left ;
+                int right ;
+            } ;
+
+            EventExpression() ;
+
+            /** @brief Adds an operator or variable node and returns its index. */
+            int add_node(NodeType type, REF2 * ref, int left, int right) ;
+
+            /** @brief Adds a constant node and returns its index. */
+            int add_constant(Value value) ;
+
+            /** @brief Evaluates the node at index ii. */
+            Value value_of(int ii) ;
+
+            /** @brief The Python truth of a value. */
+            static bool truth(const Value & value) ;
+
+            /** @brief Compares two values as Python does.
+                @return -1, 0 or 1 as left is less than, equal to or greater than right, 2 if either is NaN */
+            static int compare(const Value & left, const Value & right) ;
+
+            /** Nodes of the expression; the last one is the root.\n */
+            std::vector<Node> nodes ;
+
+            friend class EventExpressionParser ;
+    } ;
+
+/**
+  The values of the variables a Python event condition reads, taken when the event is due, so that the condition can
+  be evaluated on a helper thread while the jobs of the time step write those variables.
+
+  The condition is rewritten with each variable reference replaced by a name bound to its value.  Besides variables
+  that resolve() accepts, the condition may only use numbers, operators, the keywords and the calls abs, min, max,
+  round, int, float, bool and math functions.  Any other name, string or subscript may read state that is not taken,
+  and the condition has no snapshot.
+ */
+
+    class EventSnapshot {
+
+        public:
+
+            /**
+             @brief Builds the snapshot of a condition string.
+             @return the new snapshot, or NULL if the condition reads anything but resolvable variables
+            */
+            static EventSnapshot * parse(const std::string & str) ;
+
+            ~EventSnapshot() ;
+
+            /** @brief The condition with its variables replaced by the names of their values. */
+            const std::string & get_str() const { return str ; }
+
+            /** @brief Reads the current values of the variables. */
+            void take() ;
+
+            /** @brief The number of variables. */
+            unsigned int size() const { return refs.size() ; }
+
+            /** @brief The name the rewritten condition reads variable ii by. */
+            const std::string & name(unsigned int ii) const { return names[ii] ; }
+
+            /** @brief The value of variable ii read by the latest take(). */
+            const EventExpression::Value & value(unsigned int ii) const { return values[ii] ; }
+
+        private:
+
+            EventSnapshot() {}
+
+            /** The rewritten condition.\n */
+            std::string str ;
+            /** The variable names as written in the condition.\n */
+            std::vector<std::string> variables ;
+            /** The names of the values in str.\n */
+            std::vector<std::string> names ;
+            /** The variables.\n */
+            std::vector<REF2 *> refs ;
+            /** The values from the latest take().\n */
+            std::vector<EventExpression::Value> values ;
+    } ;
+
+}
+
+#endif
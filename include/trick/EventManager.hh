@@ -138,6 +138,17 @@ namespace Trick {
             */
             void add_event_processor( Trick::EventProcessor * in_ipep ) ;
 
+            /**
+             @brief @userdesc Command to evaluate the python conditions of cyclic events on a helper thread per
+             event processor, in parallel with the jobs of the same time step.  Variable, job and native
+             conditions are still evaluated when the event is due, and actions run at the end of the time step.
+             @par Python Usage:
+             @code trick.set_event_async_evaluation(True|False) @endcode
+             @param on_off - true to evaluate python conditions on helper threads
+             @return always 0
+            */
+            int set_async_evaluation( bool on_off ) ;
+
         protected:
 
             /** All active events in the simulation\n */
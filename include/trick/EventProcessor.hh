@@ -18,12 +18,65 @@
 
 #include <queue>
 #include <set>
+#include <vector>
+#include <pthread.h>
 
 #include "trick/Event.hh"
 #include "trick/JobData.hh"
+#include "trick/SysThread.hh"
 
 namespace Trick {
 
+/**
+  This thread evaluates the deferred conditions of an event processor's events while the processor's
+  thread goes on with its jobs.
+ */
+
+    class EventEvaluationThread : public Trick::SysThread {
+
+        public:
+
+            EventEvaluationThread() ;
+
+            /**
+             @brief Cancels and joins the thread if it was created.
+            */
+            virtual ~EventEvaluationThread() ;
+
+            /**
+             @brief Starts evaluating the events' deferred conditions for time curr_tics.  The thread must have
+             been created.  The events are not changed until wait() returns.
+            */
+            void start( std::vector< Trick::Event * > & in_events , long long curr_tics ) ;
+
+            /**
+             @brief Waits until the evaluation started by start() is complete.
+            */
+            void wait() ;
+
+            /**
+             @brief Returns true once the thread is created.
+            */
+            bool is_created() { return created ; } ;
+
+            virtual void * thread_body() ;
+
+        private:
+
+            /** Protects the fields below.\n */
+            pthread_mutex_t work_mutex ;            /**< trick_io(**) */
+            /** Signaled when there is work, or work is done.\n */
+            pthread_cond_t work_cv ;                /**< trick_io(**) */
+            /** Events to evaluate.\n */
+            std::vector< Trick::Event * > * events ; /**< trick_io(**) */
+            /** Time to evaluate the events at.\n */
+            long long eval_tics ;                   /**< trick_io(**) */
+            /** True from start() until the evaluation is done.\n */
+            bool busy ;                             /**< trick_io(**) */
+
+            void operator =(const Trick::EventEvaluationThread &) ;
+    } ;
+
 /**
   This class processes events on the thread the class was assigned.  The process_event
   job is an S_define level job that will be scheduled to run on an assigned thread.
@@ -37,11 +90,28 @@ namespace Trick {
 
         public:
 
+            EventProcessor() ;
+
             /**
              @brief Sets the process_event_job pointer.
             */
             void set_process_event_job( Trick::JobData * in_job) { process_event_job = in_job ; } ;
 
+            /**
+             @brief Sets the commit_events_job pointer.
+            */
+            void set_commit_events_job( Trick::JobData * in_job) { commit_events_job = in_job ; } ;
+
+            /**
+             @brief @userdesc Command to evaluate the python conditions of this processor's events on a helper
+             thread while the jobs of the same time step run.  The actions of those events run when
+             commit_events() is called at the end of the time step.  Set it before initialization, when the
+             helper thread is created.
+             @par Python Usage:
+             @code trick_em.ep.set_async_evaluation(True|False) @endcode
+            */
+            void set_async_evaluation( bool on_off ) { async_evaluation = on_off ; } ;
+
             /**
              @brief Add a new event to the pending events list.  Pending events are added to the
               processing queue at the next top of frame when add_pending_events is run.
@@ -59,12 +129,25 @@ namespace Trick {
             */
             void add_pending_events(long long curr_time, bool is_restart = false ) ;
 
+            /**
+             @brief Initialization job that creates the evaluation thread if asynchronous evaluation is on and an
+             event may be deferred.  Without the thread, all events are processed when they are due.
+             @return always 0
+            */
+            int create_evaluation_thread() ;
+
             /**
              @brief Automatic job to process input file events.
              @return always 0
             */
             int process_event( long long curr_time ) ;
 
+            /**
+             @brief automatic_last job that waits for the helper thread and commits the deferred events in order.
+             @return always 0
+            */
+            int commit_events( long long curr_time ) ;
+
             /**
              @brief Clears the event set before a checkpoint is loaded
             */
@@ -74,6 +157,17 @@ namespace Trick {
 
             Trick::JobData * process_event_job ; // trick_io(**)
 
+            Trick::JobData * commit_events_job ; // trick_io(**)
+
+            /** True when python conditions are evaluated on the evaluation_thread.\n */
+            bool async_evaluation ; // trick_io(**)
+
+            /** Events due this time step whose python conditions are evaluated on the evaluation_thread.\n */
+            std::vector< Trick::Event * > deferred_events ; // trick_io(**)
+
+            /** Thread evaluating deferred_events.\n */
+            Trick::EventEvaluationThread evaluation_thread ; // trick_io(**)
+
             /** Use an ordered set to store the events.  The events are sorted by their next execution
                 time.  The set allows us to add/remove items at any time.\n */
             std::multiset< Trick::Event *, CompareEventPtrs > event_set ;  // trick_io(**)
@@ -79,7 +79,8 @@ namespace Trick {
             /** Save the name of the trick master/slave sim object.\n */
             std::string ms_sim_object_name;      /**<  trick_io(**) */
 
-            Trick::Clock & clock ;               /**<  trick_io(**) */
+            /** The clock the job start and stop times are read from.\n */
+            Trick::Clock * clock ;               /**<  trick_io(**) */
 
             /**
              @brief Constructor.
@@ -156,6 +157,12 @@ namespace Trick {
             */
             int shutdown() ;
 
+            /**
+             @brief @userdesc Command to read the job start and stop times from another clock, for instance
+             trick_real_time.tsc_clock for nanosecond resolution.
+             @par Python Usage:
+             @code trick_frame_log.frame_log.set_clock(<clock>) @endcode
+            */
             void set_clock(Trick::Clock & in_clock) ;
 
         private:
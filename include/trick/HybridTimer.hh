@@ -0,0 +1,71 @@
+/*
+PURPOSE:
+    ( Sleep timer that sleeps until shortly before an absolute frame deadline )
+*/
+
+#ifndef HYBRIDTIMER_HH
+#define HYBRIDTIMER_HH
+
+#include <time.h>
+
+#include "trick/Timer.hh"
+
+namespace Trick {
+
+    /**
+     * This timer sleeps with clock_nanosleep(TIMER_ABSTIME) on CLOCK_MONOTONIC until guard_time before the end of
+     * the frame, and leaves the rest to the real-time clock's clock_spin().  The wake up time is an absolute
+     * deadline measured from the end of the previous frame, which RealtimeSync passes to reset_late() as how long
+     * ago the frame ended.  Time lost to a late wake up, or to scheduling before the reset or the sleep, does not
+     * push the next wake up later.  On macOS, which has no clock_nanosleep, the remaining time is slept with
+     * nanosleep.  Unlike the ITimer it uses no signals and has nanosecond resolution, so it is active for any
+     * frame longer than guard_time, and only the last guard_time of each underrun frame is spent spinning.
+     *
+     * RealtimeSync measures how far before the frame deadline the timer woke, see
+     * RealtimeSync::timer_wake_lead.  Set guard_time just above the worst wake up latency of the system.
+     *
+     * @date Oct. 2026
+     */
+    class HybridTimer : public Timer {
+
+        public:
+
+            /** @userdesc Time before the end of the frame to wake up and start spinning (default 100 us).\n */
+            double guard_time ;          /**< trick_units(s) */
+
+            HybridTimer() ;
+
+            /** @copybrief Trick::Timer::init() */
+            virtual int init() ;
+
+            /** @copybrief Trick::Timer::start() */
+            virtual int start(double frame_time) ;
+
+            /** @copybrief Trick::Timer::reset() */
+            virtual int reset(double frame_time) ;
+
+            /** @copybrief Trick::Timer::reset_late() */
+            virtual int reset_late(double frame_time, double late_time) ;
+
+            /** @copybrief Trick::Timer::stop() */
+            virtual int stop() ;
+
+            /** @copybrief Trick::Timer::pause() */
+            virtual int pause() ;
+
+            /** @copybrief Trick::Timer::shutdown() */
+            virtual int shutdown() ;
+
+        protected:
+
+            /** CLOCK_MONOTONIC time to wake up.\n */
+            struct timespec wake_time ;  /**< trick_io(**) */
+
+            /** @brief Sets wake_time to guard_time before the end of a frame that started late_time ago. */
+            int set_wake_time(double frame_time, double late_time) ;
+
+    } ;
+
+}
+
+#endif
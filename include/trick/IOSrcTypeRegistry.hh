@@ -0,0 +1,85 @@
+#ifndef IOSRCTYPEREGISTRY_HH
+#define IOSRCTYPEREGISTRY_HH
+/*
+    PURPOSE: ( Provides a map of mangled type names to the functions and attributes generated by ICG)
+*/
+#include <string>
+#include <unordered_map>
+#include <stddef.h>
+#include "trick/attributes.h"
+
+namespace Trick {
+
+/**
+ * The io_src functions and attributes ICG generates for one class/struct or enumeration.
+ * Entries that ICG did not generate for the type are NULL.
+ */
+    typedef struct {
+        size_t (*sizeof_func)(void) ;            /**< ** io_src_sizeof_<type> */
+        ATTRIBUTES * attr ;                      /**< ** attr<type> */
+        void (*init_attr_func)(void) ;           /**< ** init_attr<type>_c_intf */
+        void * (*allocate_func)(int) ;           /**< ** io_src_allocate_<type> */
+        void (*destruct_func)(void *, int) ;     /**< ** io_src_destruct_<type> */
+        void (*delete_func)(void *) ;            /**< ** io_src_delete_<type> */
+        ENUM_ATTR * enum_attr ;                  /**< ** enum<type> */
+    } IO_SRC_TYPE_INFO ;
+
+/**
+ * This registry is populated by the class_map code generated by ICG before any types
+ * are used, so the MemoryManager can find the io_src code for a type with a single hash
+ * lookup instead of several dlsym calls per loaded library. Types not in the registry
+ * (e.g. from libraries loaded at runtime) are still found with dlsym.
+ */
+    class IOSrcTypeRegistry {
+
+        public:
+            /**
+             * Returns a pointer to the singleton Trick::IOSrcTypeRegistry instance.
+             * @return    A pointer to Trick::IOSrcTypeRegistry.
+             */
+            static IOSrcTypeRegistry * registry() {
+                if ( pInstance == NULL ) {
+                    pInstance = new Trick::IOSrcTypeRegistry() ;
+                }
+                return pInstance ;
+            }
+
+            IOSrcTypeRegistry() {} ;
+            ~IOSrcTypeRegistry() {} ;
+
+            /**
+             * Adds the io_src code of a class or struct.
+             * @param type    The mangled name of the type, as used in the io_src function names.
+             */
+            void add_class( std::string type , size_t (*sizeof_func)(void) , ATTRIBUTES * attr ,
+             void (*init_attr_func)(void) , void * (*allocate_func)(int) ,
+             void (*destruct_func)(void *, int) , void (*delete_func)(void *) ) ;
+
+            /**
+             * Adds the io_src code of an enumeration.
+             * @param type    The mangled name of the type, as used in the io_src function names.
+             */
+            void add_enum( std::string type , size_t (*sizeof_func)(void) , ENUM_ATTR * enum_attr ) ;
+
+            /**
+             * Gets the io_src code of a type.
+             * @param type    The mangled name of the type.
+             * @return    The io_src code of the type, or NULL if the type was not registered.
+             */
+            const IO_SRC_TYPE_INFO * get_type( const std::string & type ) const {
+                std::unordered_map<std::string, IO_SRC_TYPE_INFO>::const_iterator it = type_map.find(type) ;
+                if ( it != type_map.end() ) {
+                    return &(it->second) ;
+                }
+                return NULL ;
+            }
+
+        private:
+            std::unordered_map<std::string, IO_SRC_TYPE_INFO> type_map ;
+            static IOSrcTypeRegistry * pInstance ;
+
+    } ;
+
+}
+
+#endif
@@ -21,6 +21,8 @@
 
 namespace Trick {
 
+    class EventSnapshot ;
+
 /**
   This class provides Python input processing.
   @author Alex Lin, Danny Strauss
@@ -77,6 +79,39 @@ namespace Trick {
             */
             virtual int parse_condition(std::string in_string, int & cond_return_val) ;
 
+            /**
+             @brief Compiles the given string once, for strings that are run repeatedly.
+             @param in_string - the statements, or the condition expression, to compile
+             @param is_condition - true to compile the string as a condition expression
+             @return the compiled code, or NULL if the string does not compile
+            */
+            void * compile(std::string in_string, bool is_condition) ;
+
+            /**
+             @brief Runs code returned by compile().
+             @return 0 on success, -1 if python raised an exception
+            */
+            virtual int parse_code(void * code) ;
+
+            /**
+             @brief Evaluates a condition returned by compile() and returns its truth in cond_return_val.
+             @return 0 on success, -1 if python raised an exception
+            */
+            virtual int parse_condition_code(void * code, int & cond_return_val) ;
+
+            /**
+             @brief Evaluates a condition compiled from EventSnapshot::get_str(), reading the values of the snapshot
+             instead of the sim variables, and returns its truth in cond_return_val.
+             @return 0 on success, -1 if python raised an exception
+            */
+            virtual int parse_condition_snapshot(void * code, const Trick::EventSnapshot & snapshot,
+             int & cond_return_val) ;
+
+            /**
+             @brief Releases code returned by compile().
+            */
+            void free_code(void * code) ;
+
             /**
              @brief Restore variables with memory manager names to python space.
              @return always 0
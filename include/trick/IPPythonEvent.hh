@@ -17,6 +17,8 @@ namespace Trick {
 
     class IPPython ;
     class MTV ;
+    class EventExpression ;
+    class EventSnapshot ;
 
     /** Data associated with each event condition.\n */
     struct condition_t {
@@ -42,6 +44,18 @@ namespace Trick {
         Trick::JobData * job ;                  /**< trick_io(**) trick_units(--) */
         /** Type of condition string: 0=python, 1=variable, 2=job.\n */
         int  cond_type ;                        /**< trick_io(*io) trick_units(--) */
+        /** The str that code or expr was built from; they are rebuilt when str changes.\n */
+        std::string code_str ;                  /**< trick_io(**) trick_units(--) */
+        /** Compiled python code for str.\n */
+        void * code ;                           /**< trick_io(**) trick_units(--) */
+        /** Native expression for str when it only compares model variables.\n */
+        Trick::EventExpression * expr ;         /**< trick_io(**) trick_units(--) */
+        /** Snapshot of the variables of a python condition, for its evaluation on a helper thread.\n */
+        Trick::EventSnapshot * snapshot ;       /**< trick_io(**) trick_units(--) */
+        /** Compiled python code for the condition of the snapshot.\n */
+        void * snapshot_code ;                  /**< trick_io(**) trick_units(--) */
+        /** Result of the latest evaluation, applied to fired when the event commits.\n */
+        int eval_val ;                          /**< trick_io(**) trick_units(--) */
     } ;
 
     /** Data associated with each event action.\n */
@@ -64,6 +78,10 @@ namespace Trick {
         JobData * job ;                         /**< trick_io(**) trick_units(--) */
         /** Type of action string: 0=python, 1=job ON, 2=job OFF 3=job call.\n */
         int  act_type ;                         /**< trick_io(*io) trick_units(--) */
+        /** The str that code was compiled from; it is recompiled when str changes.\n */
+        std::string code_str ;                  /**< trick_io(**) trick_units(--) */
+        /** Compiled python code for str.\n */
+        void * code ;                           /**< trick_io(**) trick_units(--) */
     } ;
 
 /**
@@ -203,7 +221,9 @@ namespace Trick {
              @par Python Usage:
              @code <event_object>.condition(<num>, """<str>""") @endcode
              @param num - number identifying the condition, starting at 0 for the 1st condition, 1 for the 2nd, etc.
-             @param str - the condition input boolean expression, using Python syntax, to be evaluated each cycle
+             @param str - the condition input boolean expression, using Python syntax, to be evaluated each cycle.
+             The string is compiled once.  If it only compares model variables and numbers with and/or/not, it is
+             evaluated without Python.
              @param comment - optional description to be displayed in mtv (defaults to 1st 50 characters of str)
              @param ref     - optional reference to a model variable to be used for the condition (this parameter for internal use only!)
              @param job     - optional pointer to job to be called as the condition (this parameter for internal use only!)
@@ -404,6 +424,25 @@ namespace Trick {
 
             bool process_user_event( long long curr_time ) ;
 
+            /**
+             @brief A user event in normal processing may have its python conditions evaluated on a helper thread
+             when each of them has a snapshot, so that the helper reads no sim variable.
+             @return true if the event has an enabled python condition to evaluate and all of them have snapshots
+            */
+            virtual bool deferrable() ;
+
+            /**
+             @brief Evaluates the python conditions from their snapshots if on_helper.  Otherwise evaluates the
+             variable, job and native conditions and takes the snapshots.
+            */
+            virtual void evaluate( long long curr_time , bool on_helper ) ;
+
+            /**
+             @brief Sets the fired states from the evaluated conditions and runs the actions.
+             @return always 0
+            */
+            virtual int commit( long long curr_time ) ;
+
             virtual void add() ;
             virtual void remove() ;
 
@@ -414,6 +453,25 @@ namespace Trick {
   
         private:
 
+            /* Rebuilds the compiled code or native expression of a python condition whose string changed */
+            void compile_condition(condition_t * cond) ;
+
+            /* Recompiles the code of a python action whose string changed */
+            void compile_action(action_t * act) ;
+
+            /* Releases the compiled code and native expressions of all conditions and actions */
+            void free_compiled() ;
+
+            /* Evaluates the conditions not in hold, python conditions if python and the others if native.  With
+               from_snapshot, the snapshots of python conditions are taken if native and evaluated if python. */
+            void evaluate_conditions( bool native , bool python , bool from_snapshot = false ) ;
+
+            /* Sets the fired states from the evaluated conditions and runs the actions if fired */
+            bool commit_user_event( long long curr_time ) ;
+
+            /* The first python error from evaluate_conditions, checked when the event commits */
+            int python_error ;
+
             /* A static pointer to the python input processor set at the S_define level */
             static Trick::IPPython * ip ;
 
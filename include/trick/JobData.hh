@@ -19,6 +19,7 @@ namespace Trick {
 
     class SimObject ;
     class InstrumentBase ;
+    class JobProfile ;
 
     /**
      * This class is the base JobData class.  Instances of this class are typically created
@@ -97,6 +98,12 @@ namespace Trick {
             /** Sim_object_id.id (for job identification in timeline logging) */
             double frame_id;                /**< trick_io(**) */
 
+            /** Execution time histogram recorded by call() while job profiling is on, else NULL */
+            JobProfile * profile ;          /**< trick_io(**) */
+
+            /** Copy of name kept by the TraceWriter, made the first time the job is traced, else NULL */
+            const char * trace_name ;       /**< trick_io(**) */
+
             /** Thread specified in the S_define file */
             unsigned int thread ;           /**< trick_units(--) */
 
@@ -250,7 +257,8 @@ namespace Trick {
             virtual int remove_inst( std::string job_name ) ;
 
             /**
-             * Calls the instumentation jobs and the job itself.
+             * Calls the instumentation jobs and the job itself.  If the job has a profile, the time of the
+             * job itself is recorded in it, and if a trace is on, the call is traced.
              * @return always 0
              */
             virtual int call() ;
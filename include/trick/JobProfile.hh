@@ -0,0 +1,165 @@
+/*
+    PURPOSE: ( Execution time histogram kept for each job while job profiling is on. )
+    ICG: (No)
+*/
+
+#ifndef JOBPROFILE_HH
+#define JOBPROFILE_HH
+
+#include <string.h>
+#include <time.h>
+
+/** Each power of two of the execution time is divided into 2^JOB_PROFILE_SUB_BUCKET_BITS buckets.\n */
+#define JOB_PROFILE_SUB_BUCKET_BITS 4
+#define JOB_PROFILE_SUB_BUCKETS (1 << JOB_PROFILE_SUB_BUCKET_BITS)
+/** Highest power of two with its own buckets; longer times (about 18 minutes) share the last bucket.\n */
+#define JOB_PROFILE_MAX_MAGNITUDE 39
+#define JOB_PROFILE_BUCKETS ((JOB_PROFILE_MAX_MAGNITUDE - JOB_PROFILE_SUB_BUCKET_BITS + 2) * JOB_PROFILE_SUB_BUCKETS)
+
+namespace Trick {
+
+    /**
+     * The execution times of one job, recorded by JobData::call() while the job has a profile.  Times are
+     * nanoseconds of CLOCK_MONOTONIC_RAW, counted in a log-linear histogram in the style of HdrHistogram: below
+     * JOB_PROFILE_SUB_BUCKETS ns each nanosecond has a bucket, and above that each power of two is split into
+     * JOB_PROFILE_SUB_BUCKETS buckets, so any percentile is known within about 6%.  Recording is a few adds and
+     * compares with no allocation, no locks and no string work.
+     *
+     * Only the thread running the job writes its profile.  Other threads read it without locking, so a reader may
+     * see one sample partly recorded.
+     *
+     * @date Oct. 2026
+     */
+    class JobProfile {
+
+        public:
+
+            /** Number of calls recorded.\n */
+            unsigned long long count ;
+
+            /** Sum of the recorded times in ns.\n */
+            long long total_ns ;
+
+            /** Shortest recorded time in ns.\n */
+            long long min_ns ;
+
+            /** Longest recorded time in ns.\n */
+            long long max_ns ;
+
+            /** The frame_number of the frame frame_ns was accumulated in.\n */
+            unsigned long long frame ;
+
+            /** Time in ns the job took in that frame.\n */
+            long long frame_ns ;
+
+            /** Number of overrun frames this job took the most time in.\n */
+            unsigned int overruns ;
+
+            /** Number of calls per histogram bucket.\n */
+            unsigned long long buckets[JOB_PROFILE_BUCKETS] ;
+
+            /** The current frame, advanced by the JobProfiler at the end of each frame.\n */
+            static unsigned long long frame_number ;
+
+            JobProfile() {
+                reset() ;
+            }
+
+            /** @brief Clears all recorded times. */
+            void reset() {
+                count = 0 ;
+                total_ns = 0 ;
+                min_ns = 0 ;
+                max_ns = 0 ;
+                frame = 0 ;
+                frame_ns = 0 ;
+                overruns = 0 ;
+                memset(buckets, 0, sizeof(buckets)) ;
+            }
+
+            /** @brief The current CLOCK_MONOTONIC_RAW time in ns. */
+            static long long now() {
+                struct timespec ts ;
+                clock_gettime(CLOCK_MONOTONIC_RAW, &ts) ;
+                return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec ;
+            }
+
+            /** @brief The histogram bucket of a time in ns. */
+            static int bucket_of(long long ns) {
+                if ( ns < JOB_PROFILE_SUB_BUCKETS ) {
+                    return ns < 0 ? 0 : (int)ns ;
+                }
+                int magnitude = 63 - __builtin_clzll((unsigned long long)ns) ;
+                if ( magnitude > JOB_PROFILE_MAX_MAGNITUDE ) {
+                    return JOB_PROFILE_BUCKETS - 1 ;
+                }
+                int shift = magnitude - JOB_PROFILE_SUB_BUCKET_BITS ;
+                return (shift + 1) * JOB_PROFILE_SUB_BUCKETS + (int)((ns >> shift) & (JOB_PROFILE_SUB_BUCKETS - 1)) ;
+            }
+
+            /** @brief The middle of the range of times in ns that fall in a bucket. */
+            static long long bucket_value(int bucket) {
+                if ( bucket < JOB_PROFILE_SUB_BUCKETS ) {
+                    return bucket ;
+                }
+                int shift = bucket / JOB_PROFILE_SUB_BUCKETS - 1 ;
+                long long low = (long long)(JOB_PROFILE_SUB_BUCKETS + bucket % JOB_PROFILE_SUB_BUCKETS) << shift ;
+                return low + ((1LL << shift) >> 1) ;
+            }
+
+            /** @brief Records one call that took elapsed_ns. */
+            void record(long long elapsed_ns) {
+                if ( count == 0 or elapsed_ns < min_ns ) {
+                    min_ns = elapsed_ns ;
+                }
+                if ( elapsed_ns > max_ns ) {
+                    max_ns = elapsed_ns ;
+                }
+                count++ ;
+                total_ns += elapsed_ns ;
+                buckets[bucket_of(elapsed_ns)]++ ;
+                if ( frame != frame_number ) {
+                    frame = frame_number ;
+                    frame_ns = 0 ;
+                }
+                frame_ns += elapsed_ns ;
+            }
+
+            /**
+             @brief The times in ns that pct[ii] percent of the recorded calls took at most, within the bucket
+             precision, for num percentages in increasing order.  The histogram is scanned once for all of them.
+            */
+            void percentiles(const double * pct, long long * values, int num) const {
+                unsigned long long seen = 0 ;
+                int bucket = 0 ;
+                for ( int jj = 0 ; jj < num ; jj++ ) {
+                    unsigned long long target = (unsigned long long)(pct[jj] / 100.0 * count + 0.5) ;
+                    if ( target == 0 ) {
+                        target = 1 ;
+                    }
+                    while ( bucket < JOB_PROFILE_BUCKETS and seen + buckets[bucket] < target ) {
+                        seen += buckets[bucket++] ;
+                    }
+                    if ( bucket == JOB_PROFILE_BUCKETS ) {
+                        values[jj] = max_ns ;
+                    } else {
+                        long long value = bucket_value(bucket) ;
+                        values[jj] = value > max_ns ? max_ns : (value < min_ns ? min_ns : value) ;
+                    }
+                }
+            }
+
+            /**
+             @brief The time in ns that pct percent of the recorded calls took at most, within the bucket
+             precision.
+            */
+            long long percentile(double pct) const {
+                long long value ;
+                percentiles(&pct, &value, 1) ;
+                return value ;
+            }
+    } ;
+
+}
+
+#endif
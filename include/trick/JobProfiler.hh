@@ -0,0 +1,198 @@
+/*
+PURPOSE:
+    ( Always-on job execution time profiling )
+*/
+
+#ifndef JOBPROFILER_HH
+#define JOBPROFILER_HH
+
+#include <vector>
+#include "trick/JobData.hh"
+#include "trick/RealtimeSync.hh"
+
+namespace Trick {
+
+    class JobProfile ;
+
+    /** Execution time statistics of one profiled job, readable through the variable server.\n */
+    struct JobProfileStats {
+        /** Job name.\n */
+        char * name ;                    /**< trick_units(--) */
+        /** Thread the job runs on.\n */
+        unsigned int thread ;            /**< trick_units(--) */
+        /** Number of calls.\n */
+        unsigned long long count ;       /**< trick_units(--) */
+        /** Mean execution time.\n */
+        double mean ;                    /**< trick_units(s) */
+        /** Shortest execution time.\n */
+        double min ;                     /**< trick_units(s) */
+        /** Median execution time.\n */
+        double p50 ;                     /**< trick_units(s) */
+        /** 90th percentile execution time.\n */
+        double p90 ;                     /**< trick_units(s) */
+        /** 99th percentile execution time.\n */
+        double p99 ;                     /**< trick_units(s) */
+        /** 99.9th percentile execution time.\n */
+        double p999 ;                    /**< trick_units(s) */
+        /** Longest execution time.\n */
+        double max ;                     /**< trick_units(s) */
+        /** Number of overrun frames the job took the most time in.\n */
+        unsigned int overruns ;          /**< trick_units(--) */
+    } ;
+
+    /** The jobs that took the most time in one overrun frame.\n */
+    struct JobProfileOverrun {
+        /** Simulation time at the end of the frame.\n */
+        double sim_time ;                /**< trick_units(s) */
+        /** How far the frame overran.\n */
+        double overrun ;                 /**< trick_units(s) */
+        /** Indexes into JobProfiler::stats of the jobs, longest first, or -1.\n */
+        int job[3] ;                     /**< trick_units(--) */
+        /** Time each job took in the frame.\n */
+        double job_time[3] ;             /**< trick_units(s) */
+    } ;
+
+    /**
+     * This class keeps an execution time histogram for every job, recorded inside JobData::call() itself.  Unlike
+     * FrameLog it adds no instrumentation jobs, reads the clock through no virtual call, and never stops
+     * recording, so it may be left on in production.
+     *
+     * At the end of each frame the profiler advances the profile frame number.  If real-time synchronization
+     * counted an overrun in the frame, the jobs that took the most time in it are charged with the overrun.
+     * Every stats_period of simulation time, the counts, means and extremes are copied into stats, which the
+     * variable server can read.  The percentiles scan each histogram, so they are left off the real-time thread
+     * and computed by update_stats(), which a variable server client calls before reading them.  At shutdown
+     * the summaries and the most recent overruns are written to job_profile.csv and job_profile_overruns.csv in
+     * the output directory.
+     *
+     * @date Oct. 2026
+     */
+    class JobProfiler {
+
+        public:
+
+            /** On unless turned off by job_profiler_off(), and back on by job_profiler_on().\n */
+            bool enabled ;                       /**< trick_units(--) */
+
+            /** @userdesc Simulation time between updates of stats (default 1.0).\n */
+            double stats_period ;                /**< trick_units(s) */
+
+            /** @userdesc Number of overrun frames remembered for job_profile_overruns.csv (default 1000).\n */
+            unsigned int max_overrun_records ;   /**< trick_units(--) */
+
+            /** Number of profiled jobs, the size of stats.\n */
+            unsigned int num_jobs ;              /**< trick_units(--) */
+
+            /** Summary of each profiled job.\n */
+            Trick::JobProfileStats * stats ;     /**< trick_units(--) */
+
+            /** Number of overrun frames seen.\n */
+            unsigned int num_overruns ;          /**< trick_units(--) */
+
+            /**
+             @brief Constructor.
+             @param in_rt_sync - the real-time synchronization that counts overruns
+            */
+            JobProfiler(Trick::RealtimeSync & in_rt_sync) ;
+
+            /**
+             @brief @userdesc Command to start recording the execution time of every job.
+             @par Python Usage:
+             @code trick.job_profiler_on() @endcode
+             @return always 0
+            */
+            int profiler_on() ;
+
+            /**
+             @brief @userdesc Command to stop recording.  The recorded times are kept.
+             @par Python Usage:
+             @code trick.job_profiler_off() @endcode
+             @return always 0
+            */
+            int profiler_off() ;
+
+            /**
+             @brief @userdesc Command to clear all recorded times and overruns.
+             @par Python Usage:
+             @code trick.job_profiler_reset() @endcode
+             @return always 0
+            */
+            int reset() ;
+
+            /**
+             @brief @userdesc Command to get the index into stats of a job.
+             @par Python Usage:
+             @code trick.job_profiler_get_index("<job_name>") @endcode
+             @return the index, or -1 if the job is not profiled
+            */
+            int get_index(std::string job_name) ;
+
+            /**
+             @brief Gives any jobs added since profiling was turned on a profile.
+             @return always 0
+            */
+            int initialize() ;
+
+            /**
+             @brief Attributes an overrun to the jobs that took the most time in the frame, advances the profile frame
+             number, and updates stats when due.
+             @return always 0
+            */
+            int end_of_frame() ;
+
+            /**
+             @brief Reallocates stats if the checkpoint did not have the current jobs.
+             @return always 0
+            */
+            int restart() ;
+
+            /**
+             @brief Writes job_profile.csv and job_profile_overruns.csv.
+             @return always 0
+            */
+            int shutdown() ;
+
+            /**
+             @brief @userdesc Command to summarize the histograms into stats, percentiles included.  Call it before
+             reading the percentiles of stats; it runs on the calling thread.
+             @par Python Usage:
+             @code trick.job_profiler_update_stats() @endcode
+             @return always 0
+            */
+            int update_stats() ;
+
+        private:
+
+            Trick::RealtimeSync & rt_sync ;                              /**< trick_io(**) */
+
+            /** The profiled jobs, in stats order.\n */
+            std::vector< Trick::JobData * > jobs ;                      /**< trick_io(**) */
+
+            /** Each profile, also when profiling is off.\n */
+            std::vector< Trick::JobProfile * > profiles ;               /**< trick_io(**) */
+
+            /** The most recent overruns, in a ring of max_overrun_records.\n */
+            std::vector< Trick::JobProfileOverrun > overrun_records ;   /**< trick_io(**) */
+
+            /** rt_sync.total_overrun at the end of the previous frame.\n */
+            unsigned int last_total_overrun ;                           /**< trick_io(**) */
+
+            /** Simulation time in tics of the next stats update.\n */
+            long long next_stats_tics ;                                 /**< trick_io(**) */
+
+            /** Gives each job without one a profile and sizes stats. */
+            void attach_profiles() ;
+
+            /** Records which jobs took the most time in an overrun frame. */
+            void attribute_overrun() ;
+
+            /** Copies the counts, means, extremes and overruns into stats, without the percentiles. */
+            void update_counts() ;
+
+            // This object is not copyable
+            void operator =(const JobProfiler &) {};
+    } ;
+
+} ;
+
+#endif
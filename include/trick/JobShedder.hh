@@ -0,0 +1,111 @@
+/*
+PURPOSE:
+    ( Sheds low priority jobs on sustained real-time overruns )
+*/
+
+#ifndef JOBSHEDDER_HH
+#define JOBSHEDDER_HH
+
+#include <string>
+#include <vector>
+
+namespace Trick {
+
+    struct JobShedGroup ;
+
+    /**
+     * This class keeps a real-time simulation in real-time under transient load by shedding designated low
+     * priority jobs, for instance display or logging jobs, and restoring them when the load goes away.
+     *
+     * Jobs are added in groups with add_group(), by job name or by a tag given in the S_define file.  A group is
+     * shed either by turning its jobs off or by multiplying their cycles by a factor.  Groups are shed in the order
+     * they were added, one group each time shed_overrun_cnt consecutive frames overrun.  A shed group is restored,
+     * the last one shed first, after restore_frames consecutive frames that used less than restore_usage of the
+     * software frame.  Restoring gives each job back the cycle and on/off state it had when it was shed.  A cycle
+     * or on/off state changed while the group was shed, for instance with trick.exec_set_job_onoff(), is kept
+     * instead.  Every decision is published as a message.
+     *
+     * RealtimeSync::rt_monitor() calls frame() at the end of every real-time frame.
+     *
+     * @date Oct. 2026
+     */
+    class JobShedder {
+
+        public:
+
+            /** @userdesc Set to false to stop shedding groups.  Shed groups are still restored (default true).\n */
+            bool enabled ;                      /**< trick_units(--) */
+
+            /** @userdesc Consecutive overrun frames that shed the next group (default 3).\n */
+            unsigned int shed_overrun_cnt ;     /**< trick_units(--) */
+
+            /** @userdesc Fraction of the software frame a frame must stay under to count towards restoring a
+                group (default 0.75).\n */
+            double restore_usage ;              /**< trick_units(--) */
+
+            /** @userdesc Consecutive frames under restore_usage that restore the last group shed (default 100).\n */
+            unsigned int restore_frames ;       /**< trick_units(--) */
+
+            /** Number of groups currently shed.\n */
+            unsigned int shed_level ;           /**< trick_units(--) */
+
+            /** Number of times a group has been shed.\n */
+            unsigned int total_shed ;           /**< trick_units(--) */
+
+            JobShedder() ;
+            virtual ~JobShedder() ;
+
+            /**
+             @brief @userdesc Command to add a group of jobs to shed on overruns.  Groups are shed in the order they
+             are added.
+             @par Python Usage:
+             @code trick.real_time_add_shed_group("<job_name or tag>", <cycle_factor>) @endcode
+             @param job_name - name of a job, or a job tag from the S_define file
+             @param cycle_factor - 0 turns the jobs off, a factor greater than 1 multiplies their cycles
+             @return 0, or -1 if the cycle factor is not valid
+             */
+            int add_group(std::string job_name, double cycle_factor) ;
+
+            /**
+             @brief Called at the end of each real-time frame.  Sheds or restores a group when due.
+             @param overrun - true if the frame overran
+             @param usage - fraction of the software frame used by the frame
+             @return always 0
+             */
+            virtual int frame(bool overrun, double usage) ;
+
+            /**
+             @brief @userdesc Command to restore all shed groups now.
+             @par Python Usage:
+             @code trick.real_time_restore_shed_groups() @endcode
+             @return always 0
+             */
+            int restore_all() ;
+
+        protected:
+
+            /** The groups in shedding order.\n */
+            std::vector< Trick::JobShedGroup * > groups ;      /**< trick_io(**) */
+
+            /** Consecutive overrun frames since the last group was shed.\n */
+            unsigned int overrun_frames ;       /**< trick_io(**) */
+
+            /** Consecutive frames under restore_usage.\n */
+            unsigned int headroom_frames ;      /**< trick_io(**) */
+
+            /**
+             @brief Sheds a group, saving the cycle and on/off state of its jobs.
+             */
+            void shed(Trick::JobShedGroup & group, double usage) ;
+
+            /**
+             @brief Restores the saved cycle and on/off state of the jobs of a group, except those changed while
+             the group was shed.
+             */
+            void restore(Trick::JobShedGroup & group, const char * reason) ;
+
+    } ;
+
+}
+
+#endif
@@ -121,6 +121,19 @@ namespace Trick {
              */
             virtual int write_command(MS_SIM_COMMAND command) = 0 ;
 
+            /**
+             @brief Tells whether a command from the other simulation is waiting to be read.
+             The default is true, so a connection that cannot tell is simply read.
+             @return true if read_command() will not wait
+             */
+            virtual bool command_ready() { return true ; }
+
+            /**
+             @brief The file descriptor that becomes readable when data arrives from the other simulation.
+             @return the descriptor, or -1 if the connection has none to poll
+             */
+            virtual int get_poll_fd() { return -1 ; }
+
             /** Limit of how long to wait for a message.\n */
             double sync_wait_limit ;  /**< trick_units(s) */
     } ;
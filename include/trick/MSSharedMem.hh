@@ -175,6 +175,12 @@ namespace Trick {
              */
             virtual int write_name(char * in_data, size_t size) ;
 
+            /**
+             @brief Tells whether a command from the other simulation is waiting in its queue.
+             @return true if the queue read by read_command() is not empty
+             */
+            virtual bool command_ready() ;
+
             /** Wait a short time before next read attempt, return total time waited.\n */
             double read_wait(struct timespec *start) ;
 
@@ -0,0 +1,194 @@
+/*
+PURPOSE:
+    (For master/slave sim, this implements the connection as lock-free rings in shared memory)
+*/
+
+#ifndef MSSHAREDMEMRING_HH
+#define MSSHAREDMEMRING_HH
+
+#include "trick/tsm.h"
+#include "trick/MSConnect.hh"
+
+/** Number of values each ring holds.  The master and slave never have more than a few outstanding.\n */
+#define MS_RING_SIZE 8
+
+namespace Trick {
+
+    /**
+     * A single writer, single reader ring of values in shared memory.  head counts the values written and tail the
+     * values read; each is changed only by its own side.  head is also the futex word a waiting reader sleeps on.\n
+     */
+    typedef struct {
+        unsigned int head ;               /**< trick_io(**) trick_units(--) */
+        unsigned int tail ;               /**< trick_io(**) trick_units(--) */
+        unsigned int reader_waiting ;     /**< trick_io(**) trick_units(--) */
+        long long data[MS_RING_SIZE] ;    /**< trick_io(**) trick_units(--) */
+    } MSRing ;
+
+    /** The data to read/write between the master and slave in shared memory.\n */
+    typedef struct {
+        pid_t master_pid ;                /**< trick_io(**) trick_units(--) */
+        MSRing master_time ;              /**< trick_io(**) trick_units(--) */
+        MSRing master_command ;           /**< trick_io(**) trick_units(--) */
+        MSRing slave_command ;            /**< trick_io(**) trick_units(--) */
+        MSRing slave_port ;               /**< trick_io(**) trick_units(--) */
+        MSRing chkpnt_name_ready ;        /**< trick_io(**) trick_units(--) */
+        char chkpnt_name[256] ;           /**< trick_io(**) trick_units(--) checkpoint dir/filename */
+    } MSSharedMemRingData ;
+
+    /**
+     * This class is a shared memory based MSConnect class for a master and slave on the same host.  Unlike
+     * MSSharedMem, each value is passed through a lock-free ring, and a reader that finds its ring empty spins
+     * for at most spin_wait_limit and then sleeps on a futex until the writer wakes it or sync_wait_limit passes.
+     * A value is handed off in well under a microsecond when the partner is on time, without burning a core
+     * when it is late.  On systems without futexes the reader yields the processor instead of sleeping.
+     *
+     * @date Oct. 2026
+     *
+     */
+
+    class MSSharedMemRing : public MSConnect {
+
+        public:
+
+            /**
+             @brief @userdesc Construct a new master/slave connection that will communicate via lock-free rings in
+             shared memory.
+             @par Python Usage:
+             @code <sharedmem_object> = trick.MSSharedMemRing() @endcode
+             @return the new MSSharedMemRing object
+            */
+            MSSharedMemRing() ;
+            ~MSSharedMemRing() ;
+
+            /**
+             @brief Sets the wait time limit for communications between the master and slaves.
+             Any @c in_limit <= 0.0 means an infinite wait limit.
+             @param in_limit - the desired wait limit.
+             @return always 0
+             */
+            virtual int set_sync_wait_limit(double in_limit) ;
+
+            /**
+             @brief Creates command line parameters specific to starting this particular connection type.
+             @return an empty string, shared memory needs no parameters
+             */
+            virtual std::string add_sim_args(std::string slave_type) ;
+
+            /**
+             @brief Searches the command line parameters for connection specific parameters.
+             @return always 1, there are no parameters to search for
+             */
+            virtual int process_sim_args() ;
+
+            /**
+             @brief Establishes the connection on the master side of the connection.
+             Creates and attaches the shared memory and empties the rings.
+             @return 0 if connection successful, or error status otherwise
+             */
+            virtual int accept() ;
+
+            /**
+             @brief Establishes the connection on the slave side of the connection.
+             Attaches the shared memory.  On a reconnect, also empties the rings the slave reads.
+             @return 0 if connection successful, or error status otherwise
+             */
+            virtual int connect() ;
+
+            /**
+             @brief Closes the connection on the slave side of the connection.
+             @return always 0
+             */
+            virtual int disconnect() ;
+
+            /**
+             @brief Read the simulation time from the other simulation.
+             @return the time read or MS_ERROR_TIME if the read failed
+             */
+            virtual long long read_time() ;
+
+            /**
+             @brief Read the mode command from the other simulation.
+             @return the simulation command or ErrorCmd if the read failed
+             */
+            virtual MS_SIM_COMMAND read_command() ;
+
+            /**
+             @brief Read a port number from the other simulation.
+             @return the port read or MS_ERROR_PORT if the read failed
+             */
+            virtual int read_port() ;
+
+            /**
+             @brief Read a character array (i.e. chkpnt name) into read_data from the other simulation.
+             @return the 1st character read or MS_ERROR_NAME if the read failed
+             */
+            virtual char read_name(char * read_data, size_t size) ;
+
+            /**
+             @brief Writes the simulation time to the other simulation.
+             @return the number of bytes written, 0 if the ring is full
+             */
+            virtual int write_time(long long sim_time) ;
+
+            /**
+             @brief Writes the mode command to the other simulation.
+             @return the number of bytes written, 0 if the ring is full
+             */
+            virtual int write_command(MS_SIM_COMMAND command) ;
+
+            /**
+             @brief Writes a port number to the other simulation.
+             @return the number of bytes written, 0 if the ring is full
+             */
+            virtual int write_port(int port) ;
+
+            /**
+             @brief Writes a character array (i.e. chkpnt name) from in_data to the other simulation.
+             @return the number of bytes written, 0 if the ring is full
+             */
+            virtual int write_name(char * in_data, size_t size) ;
+
+            /**
+             @brief Tells whether a command from the other simulation is waiting in its ring.
+             @return true if read_command() will not wait
+             */
+            virtual bool command_ready() ;
+
+            /** @userdesc How long a reader spins on an empty ring before sleeping (default 50 us, or 0 on a single
+                processor host).\n */
+            double spin_wait_limit ;        /**< trick_units(s) */
+
+            /** The Trick shared memory device between the master and slave.\n */
+            TSMDevice tsm_dev ;             /**< trick_units(--) */
+
+            /** Address of data to read/write between the master and slave in shared memory.\n */
+            MSSharedMemRingData * shm_addr ;    /**< trick_units(--) */
+
+        protected:
+
+            /**
+             @brief Takes the next value from the ring, spinning and then sleeping until one is written or
+             sync_wait_limit passes.
+             @return true if a value was read
+             */
+            bool pop(MSRing * ring, long long * value) ;
+
+            /**
+             @brief Adds a value to the ring and wakes its reader if it is sleeping.
+             @return true if the ring had room
+             */
+            bool push(MSRing * ring, long long value) ;
+
+            /**
+             @brief Drops every value in the ring and clears its waiting reader.  Only the reader may drain a ring.
+             */
+            void drain(MSRing * ring) ;
+
+            /** @brief True in the master's process. */
+            bool is_master() ;
+    } ;
+
+}
+
+#endif
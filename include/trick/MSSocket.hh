@@ -133,6 +133,18 @@ namespace Trick {
              */
             virtual int write_name(char * in_data, size_t size) ;
 
+            /**
+             @brief Tells whether a command from the other simulation is waiting to be read. Polls the socket.
+             @return true if data, or the other end closing, is waiting on the socket
+             */
+            virtual bool command_ready() ;
+
+            /**
+             @brief The socket of the connection.
+             @return the socket
+             */
+            virtual int get_poll_fd() ;
+
             /** The Trickcomm socket connection between the master and slave.\n */
             TCDevice tc_dev ;        /**< trick_units(--) */
 
@@ -21,6 +21,10 @@
 #include "trick/RemoteShell.hh"
 #include "trick/ms_sim_mode.h"
 
+/** Number of bins in each slave's sync latency histogram.  Bin 0 counts waits under 1 us, bin i waits of
+    [2^(i-1), 2^i) us, and the last bin everything longer. */
+#define MS_SYNC_LATENCY_BINS 24
+
 #ifdef SWIG
 // This allows SWIG access to the inside of the slave vector
 %template(slaveVector) std::vector<Trick::SlaveInfo *> ;
@@ -122,6 +126,15 @@ namespace Trick {
             /** Connection to the slave.\n */
             Trick::MSConnect * connection ;  /**< trick_units(--) */
 
+            /** How long the master waited for this slave's status at the end of the last frame.\n */
+            double sync_latency ;            /**< trick_units(s) */
+
+            /** The longest the master has waited for this slave's status.\n */
+            double sync_latency_max ;        /**< trick_units(s) */
+
+            /** Count of frames by how long the master waited for this slave's status, see MS_SYNC_LATENCY_BINS.\n */
+            unsigned int sync_latency_hist[MS_SYNC_LATENCY_BINS] ;  /**< trick_units(--) */
+
             /**
              @brief @userdesc Command to set the master's connection type to this slave.  Each slave may have a different connection type.
              @par Python Usage:
@@ -144,6 +157,19 @@ namespace Trick {
              */
             int read_slave_status() ;
 
+            /**
+             @brief Takes action on the mode command read from the slave if it is freeze or exit, or if the read failed.
+             @param slave_command - the command read from the slave, MS_ErrorCmd if it could not be read in time
+             @return always 0
+             */
+            int process_slave_status(MS_SIM_COMMAND slave_command) ;
+
+            /**
+             @brief Adds how long the master waited for this slave's status to the latency statistics.
+             @param latency - the wait in seconds
+             */
+            void record_sync_latency(double latency) ;
+
             /**
              @brief End of frame job that writes the master commands to the slave
              Writes the master simulation time and mode command to slave.
@@ -190,6 +216,11 @@ namespace Trick {
             /** Vector of slaves tracked by the master.\n */
             std::vector< Trick::SlaveInfo * > slaves ;  /**< trick_io(**) trick_units(--) */
 
+            /** @userdesc True to read the slaves' status as each arrives rather than in slave order (default is false).\n
+              Slaves that are late or lost then cost the master at most the longest sync_wait_limit per frame
+              instead of one sync_wait_limit each.\n */
+            bool parallel_sync ;                   /**< trick_units(--) */
+
             /**
              @brief @userdesc Command to enable the master/slave synchronization.
              @par Python Usage:
@@ -237,6 +268,21 @@ namespace Trick {
              */
             int end_of_frame_status_from_slave() ;
 
+            /**
+             @brief Reads the status of every activated slave as it arrives, waiting on all of the slaves at once.
+             Used by end_of_frame_status_from_slave() when parallel_sync is set.
+             @return always 0
+             */
+            int collect_slave_status() ;
+
+            /**
+             @brief @userdesc Command to print each slave's sync latency statistics.
+             @par Python Usage:
+             @code <master_slave_sim_obj>.<master_obj>.print_sync_latency() @endcode
+             @return always 0
+             */
+            int print_sync_latency() ;
+
             /**
              @brief End of frame class job that executes a synchronization job for each enabled slave.
              Writes the master simulation time and mode command to the slave.
@@ -24,6 +24,7 @@
 #include "trick/var.h"
 
 #include "trick/CheckPointAgent.hh"
+#include "trick/AllocInfoMap.hh"
 
 // forward declare the units converter types used by ref_assignment
 union cv_converter ;
@@ -31,8 +32,11 @@ struct ut_system ;
 
 namespace Trick {
 
-    typedef std::map<void*, ALLOC_INFO*, std::greater<void*> > ALLOC_INFO_MAP;
-    typedef std::map<void*, ALLOC_INFO*, std::greater<void*> >::const_iterator ALLOC_INFO_MAP_ITER ;
+    class RefCache ;
+    class MemoryPool ;
+
+    typedef AllocInfoMap ALLOC_INFO_MAP;
+    typedef AllocInfoMap::const_iterator ALLOC_INFO_MAP_ITER ;
     typedef std::map<std::string, ALLOC_INFO*> VARIABLE_MAP;
     typedef std::map<std::string, ALLOC_INFO*>::const_iterator VARIABLE_MAP_ITER ;
     typedef std::map<std::string, ENUM_ATTR*> ENUMERATION_MAP;
@@ -471,6 +475,27 @@ namespace Trick {
              */
             REF2 *ref_attributes( const char* name);
 
+            /**
+             Set the maximum number of resolved references (including their "." and "[]" prefixes)
+             that ref_attributes() keeps in its least recently used cache. 0 disables the cache.
+             @param num_entries - maximum number of cached references.
+             */
+            void set_ref_cache_size( unsigned int num_entries );
+
+            /**
+             Turn on/off the pooled allocation of small allocations. When on, declare_var() takes
+             ALLOC_INFO records and the memory of C types, pointers and arrays of them that fit in
+             a pool block from size class arenas instead of calloc. Memory already allocated is freed
+             correctly whichever way it was allocated.
+             @param on_off - true to use the pool, false to use calloc (default).
+             */
+            void set_pool_allocation( bool on_off );
+
+            /**
+             @return true if pooled allocation is on.
+             */
+            bool get_pool_allocation();
+
             /**
              @param address - Address for which a name reference is needed.
              @return a name reference for the given address.
@@ -651,6 +676,13 @@ namespace Trick {
             ALLOC_INFO_MAP_ITER alloc_info_map_begin() { return alloc_info_map.begin() ; } ;
             ALLOC_INFO_MAP_ITER alloc_info_map_end() { return alloc_info_map.end() ; } ;
 
+            /**
+             Lock and unlock the mutex that protects the allocation and variable maps, to iterate over the
+             allocations while other threads may allocate.  No MemoryManager call may be made while it is locked.
+             */
+            void lock_maps() { pthread_mutex_lock(&mm_mutex) ; } ;
+            void unlock_maps() { pthread_mutex_unlock(&mm_mutex) ; } ;
+
             VARIABLE_MAP_ITER variable_map_begin() { return variable_map.begin() ; } ;
             VARIABLE_MAP_ITER variable_map_end() { return variable_map.end() ; } ;
 
@@ -682,6 +714,10 @@ namespace Trick {
             VARIABLE_MAP    variable_map;    /**< ** Map of <name, ALLOC_INFO*> key-value pairs for each named-allocations. */
             ENUMERATION_MAP enumeration_map; /**< ** Enumeration map. */
             pthread_mutex_t mm_mutex;        /**< ** Mutex to control access to memory manager maps */
+            RefCache *      ref_cache;       /**< ** Cache of resolved references, invalidated when variable_map changes. */
+            MemoryPool *    alloc_pool;      /**< ** Size class arenas for small allocations. */
+            bool            use_alloc_pool;  /**< ** true = allocate small allocations from alloc_pool. */
+            bool            alloc_pool_used; /**< ** true = alloc_pool may own allocations, it has been turned on. */
 
             int alloc_info_map_counter ;     /**< ** counter to assign unique ids to allocations as they are added to map */
             int extern_alloc_info_map_counter ; /**< ** counter to assign unique ids to allocations as they are added to map */
@@ -693,6 +729,36 @@ namespace Trick {
 
             void execute_checkpoint( std::ostream& out_s );
 
+            /**
+             Resolve references of the form name ( "." name | "[" integer "]" )* without the
+             flex/bison reference parser, reusing the longest cached prefix of the reference.
+             @param name - fully qualified variable name.
+             @param result - set to the resolved REF2 object, or NULL on failure.
+             @return true if name was handled, false if name must be given to the reference parser.
+             */
+            bool simple_ref_attributes( const char* name, REF2** result);
+
+            /**
+             Allocate zeroed memory for n_elems elements of size bytes, from the pool if it is on
+             and the allocation fits in a pool block, otherwise with calloc.
+             */
+            void* allocate_memory( size_t n_elems, size_t size);
+
+            /**
+             Free memory from allocate_memory(), returning it to the pool if it came from there.
+             */
+            void free_memory( void* address);
+
+            /**
+             Allocate a zeroed ALLOC_INFO record.
+             */
+            ALLOC_INFO* allocate_alloc_info();
+
+            /**
+             Free an ALLOC_INFO record from allocate_alloc_info().
+             */
+            void free_alloc_info( ALLOC_INFO* alloc_info);
+
             /**
              Walks through allocation and allocates space for STLs
              FIXME: I NEED DOCUMENTATION!
@@ -0,0 +1,80 @@
+#ifndef MEMORYPOOL_HH
+#define MEMORYPOOL_HH
+/*
+    PURPOSE: ( MemoryPool - size class arenas for small MemoryManager allocations.)
+    ICG: (No)
+*/
+
+#include <stddef.h>
+#include <vector>
+#include <pthread.h>
+
+namespace Trick {
+
+/**
+ The MemoryPool hands out zeroed blocks of up to get_max_block_size() bytes from large chunks,
+ one free list per power of two size class. Freed blocks go back on their free list and are
+ reused by the next allocation of the same size class. Chunks are only returned to the system
+ when the pool is destroyed.
+ */
+    class MemoryPool {
+
+        public:
+
+            MemoryPool() ;
+            ~MemoryPool() ;
+
+            /**
+             Allocates a zeroed block.
+             @param bytes - requested size.
+             @return The block, or NULL if bytes is 0 or larger than get_max_block_size().
+             */
+            void * allocate( size_t bytes ) ;
+
+            /**
+             Returns a block to its free list.
+             @return false if address was not allocated by this pool.
+             */
+            bool deallocate( void * address ) ;
+
+            /** @return true if address is within a chunk of this pool. */
+            bool owns( void * address ) ;
+
+            /** @return The largest block the pool allocates. */
+            size_t get_max_block_size() const ;
+
+            /** @return The number of bytes the pool obtained from the system. */
+            size_t get_reserved_bytes() ;
+
+        private:
+
+            static const unsigned int num_size_classes = 8 ;   /* 16, 32, ... 2048 bytes */
+            static const size_t min_block_size = 16 ;
+            static const size_t chunk_size = 64 * 1024 ;
+
+            struct FreeBlock {
+                FreeBlock * next ;
+            } ;
+
+            struct Chunk {
+                char * start ;
+                char * end ;
+                unsigned int size_class ;
+            } ;
+
+            /** @return Index of the chunk containing address, or -1. Caller holds mutex. */
+            long find_chunk( void * address ) ;
+
+            /** Adds a chunk to size_class. Caller holds mutex. @return false if out of memory. */
+            bool add_chunk( unsigned int size_class ) ;
+
+            FreeBlock * free_lists[num_size_classes] ;   /* freed blocks of each size class */
+            char * next_block[num_size_classes] ;        /* next never used block in the newest chunk */
+            char * chunk_end[num_size_classes] ;         /* end of the newest chunk */
+            std::vector< Chunk > chunks ;                /* all chunks, sorted by address */
+            pthread_mutex_t mutex ;                      /* protects all of the above */
+    } ;
+
+}
+
+#endif
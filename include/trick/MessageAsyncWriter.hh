@@ -0,0 +1,40 @@
+/*
+    PURPOSE: ( Background thread that delivers messages published asynchronously. )
+    ICG: (No)
+*/
+
+#ifndef MESSAGEASYNCWRITER_HH
+#define MESSAGEASYNCWRITER_HH
+
+#include "trick/SysThread.hh"
+
+namespace Trick {
+
+    class MessagePublisher ;
+
+    /**
+     * The thread of a MessagePublisher in asynchronous mode.  Every MessagePublisher::async_period it calls
+     * MessagePublisher::flush(), which formats the headers of the queued messages, sends them to the subscribers
+     * and flushes the subscribers once for the whole batch.
+     *
+     * @date Oct. 2026
+     */
+    class MessageAsyncWriter : public Trick::SysThread {
+
+        public:
+
+            MessageAsyncWriter( Trick::MessagePublisher & in_publisher ) ;
+
+            /** @brief Delivers the queued messages every async_period.  The thread is cancelled in its sleep. */
+            virtual void * thread_body() ;
+
+        private:
+
+            Trick::MessagePublisher & publisher ;
+
+            void operator =(const Trick::MessageAsyncWriter &) ;
+    } ;
+
+}
+
+#endif
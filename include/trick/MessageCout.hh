@@ -39,6 +39,11 @@ namespace Trick {
              */
             virtual void update( unsigned int level , std::string header , std::string message ) ;
 
+            /**
+             @brief Flush std::cout after a batch of messages.
+             */
+            virtual void flush() ;
+
     } ;
 
 }
@@ -41,6 +41,11 @@ namespace Trick {
              */
             virtual void update( unsigned int level , std::string header , std::string message );
 
+            /**
+             @brief Flush the files after a batch of messages.
+             */
+            virtual void flush();
+
             int restart();
 
         protected:
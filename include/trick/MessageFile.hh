@@ -49,6 +49,11 @@ namespace Trick {
              */
             virtual void update( unsigned int level , std::string header , std::string message );
 
+            /**
+             @brief Flush the file after a batch of messages.
+             */
+            virtual void flush() ;
+
             /**
              @brief Set a file name for a file which the messages received by this subscriber goes to.
              @return always 0
@@ -3,14 +3,37 @@
 /*
     PURPOSE: ( MessagePublisher Class )
 */
+#include <pthread.h>
+#include <time.h>
 #include <string>
 #include <list>
+#include <map>
+#include <vector>
 #include "trick/MessageSubscriber.hh"
 
 namespace Trick {
 
+    class MessageAsyncWriter ;
+    struct MessageRing ;
+    struct MessageLimitEntry ;
+
 	/**
 	 * This class provides the capability of publishing executive and/or model messages.
+	 *
+	 * By default a message is sent to the subscribers by the thread that publishes it.  In asynchronous mode
+	 * (set_async()) the publishing thread only copies the formatted message text, its level, the simulation time
+	 * and the date into a ring of its own, which takes no lock.  A background thread formats the headers, sends
+	 * the messages to the subscribers in the order they were published, and flushes the subscribers once per
+	 * batch.  If a ring is full the message is dropped and counted in async_dropped.  When a thread exits, its ring
+	 * is freed once its messages are delivered.
+	 *
+	 * Messages published through message_publish() can be rate limited and deduplicated, so a model publishing
+	 * the same message every frame cannot flood the subscribers.  Messages are grouped by level and format string.
+	 * A format with no text of its own, such as "%s", is shared by unrelated messages, so its messages are also
+	 * grouped by the code that published them.
+	 * Within each rate_window, a group publishes at most rate_limit messages, and with suppress_duplicates a message
+	 * identical to the one before it in its group is not published.  When the window ends, one message at the
+	 * same level reports how many messages of the group were suppressed.  Both can be set per level.
 	 */
     class MessagePublisher {
 
@@ -32,11 +55,103 @@ namespace Trick {
              */
             void set_print_format() ;
 
+            /** Protects subscribers while messages are delivered.  Recursive, so a subscriber may publish.\n */
+            pthread_mutex_t subscribers_mutex ;              /**< trick_io(**) */
+
+            /** Host name for the header, read once.\n */
+            char hostname[64] ;                              /**< trick_io(**) */
+
+            /** The background thread, created the first time asynchronous mode is turned on.\n */
+            Trick::MessageAsyncWriter * async_writer ;      /**< trick_io(**) */
+
+            /** Protects rings.\n */
+            pthread_mutex_t rings_mutex ;                    /**< trick_io(**) */
+
+            /** The ring of every thread that has published asynchronously.\n */
+            std::vector< Trick::MessageRing * > rings ;     /**< trick_io(**) */
+
+            /** async_dropped when the last dropped messages warning was delivered.\n */
+            unsigned long long last_async_dropped ;          /**< trick_io(**) */
+
+            /**
+             @brief Formats the header and sends one message to the enabled subscribers.
+             */
+            void deliver(int level, long long tics, time_t date, const std::string & message) ;
+
+            /** Protects the limit tables and the per level settings.\n */
+            pthread_mutex_t limit_mutex ;                    /**< trick_io(**) */
+
+            /** Counts of the message groups in the current rate_window.\n */
+            Trick::MessageLimitEntry * limit_entries ;      /**< trick_io(**) */
+
+            /** Per level rate_limit set by set_rate_limit().\n */
+            std::map< int , unsigned int > level_rate_limit ;      /**< trick_io(**) */
+
+            /** Per level suppress_duplicates set by set_suppress_duplicates().\n */
+            std::map< int , bool > level_suppress_duplicates ;     /**< trick_io(**) */
+
+            /** True once a per level setting has been made.\n */
+            bool level_limits_set ;                          /**< trick_io(**) */
+
+            /** Time the message groups were last checked for ended windows, in ns.\n */
+            long long last_limit_sweep ;                     /**< trick_io(**) */
+
+            /**
+             @brief Once per rate_window, ends the windows of all groups whose window has passed, adding their reports
+             to reports.  Called with limit_mutex held.
+             */
+            void sweep_limit_windows(long long now, long long window_ns,
+             std::vector< std::pair< int , std::string > > & reports) ;
+
+            /**
+             @brief Publishes the reports of the groups whose window has passed, so a group that stopped publishing
+             is reported without waiting for another message.  Called by flush().
+             */
+            void report_ended_windows() ;
+
+            /**
+             @brief Ends the window of a message group, adding the report of its suppressed messages to reports.
+             */
+            void end_limit_window(Trick::MessageLimitEntry & entry, long long now,
+             std::vector< std::pair< int , std::string > > & reports) ;
+
+            /**
+             @brief Publishes a message bypassing the limits, from the background thread in asynchronous mode.
+             */
+            void publish_report(int level, const std::string & message) ;
+
         public:
 
             /** Name of the simulation, usually inputted through the input processor (default is " ").\n */
             std::string sim_name;                            /**< trick_units(--) */
 
+            /** True while messages are published by the background thread, see set_async().\n */
+            bool async ;                                     /**< trick_units(--) */
+
+            /** @userdesc Bytes of messages each publishing thread can hold for the background thread, rounded up
+                to a power of 2 (default 65536).\n */
+            unsigned int async_buffer_size ;                 /**< trick_units(--) */
+
+            /** @userdesc Time between deliveries by the background thread (default 0.01).\n */
+            double async_period ;                            /**< trick_units(s) */
+
+            /** Messages dropped because a ring was full.\n */
+            unsigned long long async_dropped ;               /**< trick_units(--) */
+
+            /** @userdesc Most messages a group publishes in a rate_window, 0 for no limit (default 0).  Set per
+                level with set_rate_limit().\n */
+            unsigned int rate_limit ;                        /**< trick_units(--) */
+
+            /** @userdesc Do not publish a message identical to the one before it in its group within a rate_window
+                (default false).  Set per level with set_suppress_duplicates().\n */
+            bool suppress_duplicates ;                       /**< trick_units(--) */
+
+            /** @userdesc Time over which rate_limit applies and suppressed messages are reported (default 1.0).\n */
+            double rate_window ;                             /**< trick_units(s) */
+
+            /** Messages not published because of rate_limit or suppress_duplicates.\n */
+            unsigned long long rate_suppressed ;             /**< trick_units(--) */
+
             /**
              @brief The constructor.
              */
@@ -53,13 +168,13 @@ namespace Trick {
              @brief Add a message subscriber to this publisher's subscriber list, which will output published messages in some manner.
              @param in_ms - an instance of Trick::MessageSubscriber that wants to subscribe to this publisher.
              */
-            void subscribe(MessageSubscriber *in_ms) { subscribers.push_back(in_ms) ; } ;
+            void subscribe(MessageSubscriber *in_ms) ;
 
             /**
              @brief Remove a message subscriber from this publisher's subscriber list.
              @param in_ms - an instance of Trick::MessageSubscriber that needs unsubscribe from this publisher.
              */
-            void unsubscribe(MessageSubscriber *in_ms) { subscribers.remove(in_ms) ; } ;
+            void unsubscribe(MessageSubscriber *in_ms) ;
 
             /**
              @brief Publish a message with specified level and header.
@@ -69,6 +184,77 @@ namespace Trick {
              */
             virtual int publish(int level, std::string message) ;
 
+            /**
+             @brief Copies a message into the calling thread's ring for the background thread.  Used by publish() and
+             by message_publish() in asynchronous mode, which saves copying the text into a std::string.
+             @param level - message level
+             @param message - the text of the message
+             @param length - length of the text
+             @return 0, or -1 if the ring was full and the message was dropped
+             */
+            int enqueue(int level, const char * message, size_t length) ;
+
+            /**
+             @brief @userdesc Command to publish messages from a background thread (true) or from the publishing
+             thread (false, the default).  Turning it off delivers the queued messages first.
+             @par Python Usage:
+             @code trick.message_set_async(<True|False>) @endcode
+             @return always 0
+             */
+            int set_async(bool yes_no) ;
+
+            /**
+             @brief Delivers all queued messages now and flushes the subscribers.
+             @return always 0
+             */
+            int flush() ;
+
+            /**
+             @brief Checks a message against the rate limit and duplicate suppression of its level.  Called by
+             message_publish() before the message is published.  Reports of suppressed messages whose window ended
+             are published from here.
+             @param level - message level
+             @param format - the format string, which with the level selects the group of the message
+             @param message - the formatted text of the message
+             @param length - length of the text
+             @param caller - the code that published the message, which also selects the group if the format has
+             no text of its own.  If NULL, the text of such a message selects the group.
+             @return true if the message must not be published
+             */
+            bool limit(int level, const char * format, const char * message, size_t length,
+             const void * caller = NULL) ;
+
+            /**
+             @brief @userdesc Command to set the most messages with the same format a level publishes in a
+             rate_window.  0 removes the limit.  A negative level sets rate_limit, the limit of the levels not set.
+             @par Python Usage:
+             @code trick.message_set_rate_limit(<level>, <max_count>) @endcode
+             @return always 0
+             */
+            int set_rate_limit(int level, unsigned int max_count) ;
+
+            /**
+             @brief @userdesc Command to suppress repeated identical messages of a level.  A negative level sets
+             suppress_duplicates, the setting of the levels not set.
+             @par Python Usage:
+             @code trick.message_set_suppress_duplicates(<level>, <True|False>) @endcode
+             @return always 0
+             */
+            int set_suppress_duplicates(int level, bool yes_no) ;
+
+            /**
+             @brief Publishes the reports of all suppressed messages now, without waiting for their windows to end.
+             @return always 0
+             */
+            int report_suppressed() ;
+
+            /**
+             @brief Shutdown job.  Reports suppressed messages, delivers the queued messages and turns asynchronous
+             mode off, so messages published during and after shutdown are delivered immediately.
+             @return always 0
+             */
+            int shutdown() ;
+
             /**
              @brief gets the subscriber from the list
              @param sub_name - name of the subscriber to get.
@@ -26,6 +26,10 @@ namespace Trick {
             /** Name of the subscriber\n */
             std::string name ;         /**< trick_units(--) */
 
+            /** True while the publisher delivers a batch of messages from its background thread.  Subscribers that
+                flush their output after each message leave it to flush() instead.\n */
+            bool batch_flush ;         /**< trick_io(**) */
+
             /**
              @brief Enable (default) or disable this message subscriber, so that it outputs the messages it receives.
              @param yes_no - true to enable, false to disable
@@ -59,6 +63,11 @@ namespace Trick {
              */
             virtual void update( unsigned int level , std::string header, std::string message ) = 0 ;
 
+            /**
+             @brief Flushes the output after a batch of messages.
+             */
+            virtual void flush() {} ;
+
             /**
              @brief Shutdown the subscriber
              */
@@ -6,8 +6,10 @@
 #define MONTECARLO_HH
 
 #include <deque>
+#include <map>
 #include <vector>
 #include <climits>
+#include <sys/types.h>
 
 #include "trick/MonteVar.hh"
 #include "trick/Executive.hh"
@@ -129,7 +131,8 @@ namespace Trick {
         enum Command {
             MC_PROCESS_RUN, /**< process a new run */
             MC_SHUTDOWN,    /**< kill any executing run, call shutdown jobs, and shutdown cleanly */
-            MC_DIE          /**< kill any executing run, do not call shutdown jobs, and exit */
+            MC_DIE,         /**< kill any executing run, do not call shutdown jobs, and exit */
+            MC_CANCEL_RUN   /**< do not process a run dispatched ahead, the master requeued it */
         };
 
         /** Unique identifier assigned by the master. */
@@ -144,9 +147,38 @@ namespace Trick {
         /** Port over which this slave is listening for dispatches. */
         unsigned int port;               /**< \n trick_units(--) */
 
-        /** Run most recently dispatched to this slave. */
+        /** Run this slave is processing. */
         MonteRun *current_run;           /**< \n trick_units(--) */
 
+        /**
+         * Run dispatched to this slave while it was processing #current_run. The slave starts it as soon as
+         * #current_run finishes.
+         *
+         * @see MonteCarlo::dispatch_ahead
+         */
+        MonteRun *next_run;              /**< \n trick_units(--) */
+
+        /**
+         * Connection the slave opened to the master at initialization. Runs and commands are dispatched, and results
+         * are returned, over this connection for the life of the slave.
+         */
+        TCDevice connection;             /**< \n trick_io(**) */
+
+        /**
+         * Indicates whether or not this slave is a local worker, which the master forks and executes directly rather
+         * than through a remote shell. A local worker talks to the master over pipes: its results come back over the
+         * pipe in #connection's socket and runs are dispatched over #pipe_fd.
+         *
+         * @see MonteCarlo::local_workers
+         */
+        bool local_worker;               /**< \n trick_units(--) */
+
+        /** Pipe over which runs are dispatched to a local worker, or -1. */
+        int pipe_fd;                     /**< \n trick_io(**) */
+
+        /** Process id of a local worker. */
+        pid_t pid;                       /**< \n trick_io(**) */
+
         /** Number of runs dispatched to this slave. */
         unsigned int num_dispatches;     /**< \n trick_units(--) */
 
@@ -189,11 +221,17 @@ namespace Trick {
             state(MC_UNINITIALIZED),
             port(0),
             current_run(NULL),
+            next_run(NULL),
+            connection(),
+            local_worker(false),
+            pipe_fd(-1),
+            pid(0),
             num_dispatches(0),
             num_results(0),
             cpu_time(0),
             remote_shell(Trick::TRICK_SSH),
             multiplier(1) {
+            connection.socket = TRICKCOMM_INVALID_SOCKET;
             if (name.empty()) {
                 machine_name = "localhost";
             }
@@ -335,6 +373,28 @@ namespace Trick {
         /** Maximum number of times that a run may be dispatched. Defaults to two. Specify zero for no limit. */
         unsigned int max_tries;                         /**< \n trick_units(--) */
 
+        /**
+         * Indicates whether or not the next run is dispatched to a slave before its current run finishes, so the slave
+         * can start it without waiting on the master. Runs are dispatched ahead only when no slave is ready. Defaults
+         * to <code>true</code>.
+         */
+        bool dispatch_ahead;                            /**< \n trick_units(--) */
+
+        /**
+         * Indicates whether or not each slave runs the initialization jobs once and forks every run from its
+         * initialized state, rather than forking before initialization. A run's variables are then set after
+         * initialization, so jobs that derive state from them belong in <code>monte_slave_pre</code> jobs. Defaults to
+         * <code>false</code>.
+         */
+        bool slave_init_once;                           /**< \n trick_units(--) */
+
+        /**
+         * Number of local workers to add to the slaves. Local workers are forked and executed directly by the master
+         * and talk to it over pipes, avoiding the remote shell and sockets. A negative number adds one per online
+         * processor. Defaults to zero.
+         */
+        int local_workers;                              /**< \n trick_units(--) */
+
         /** Options to be passed to the remote shell when spawning new slaves. */
         std::string user_cmd_string;                         /**< \n trick_units(--) */
 
@@ -353,6 +413,12 @@ namespace Trick {
         /** Device over which data is sent and received. */
         TCDevice connection_device;                     /**< \n trick_units(--) */
 
+        /** Data returned by the slave with the run being resolved, read by #read in the master post run jobs. */
+        std::string run_data;                           /**< \n trick_io(**) */
+
+        /** Offset in #run_data of the next byte to be read. */
+        size_t run_data_offset;                         /**< \n trick_io(**) */
+
         /** Runs to be dispatched. */
         std::deque <Trick::MonteRun *> runs;                 /**< \n trick_io(**) trick_units(--) */
 
@@ -401,6 +467,15 @@ namespace Trick {
         /** Unique identifier. This value is zero for the master. */
         unsigned int slave_id;                          /**< \n trick_units(--) */
 
+        /**
+         * Pipe to the master if this slave is a local worker, or -1. The pipe from the master is #connection_device's
+         * socket.
+         */
+        int pipe_fd;                                    /**< \n trick_io(**) */
+
+        /** Command read from the master ahead of time by #slave_run_cancelled, or -1. */
+        int pending_command;                            /**< \n trick_io(**) */
+
         /** Name of the machine on which this simulation is running. */
         std::string machine_name;                            /**< \n trick_units(--) */
 
@@ -461,6 +536,14 @@ namespace Trick {
          */
         int execute_monte();
 
+        /**
+         * S_define level job run at the end of initialization. If #slave_init_once is set, the slave begins processing
+         * runs here.
+         *
+         * @return 0 on success
+         */
+        int execute_monte_post_init();
+
         /**
          * Sets #enabled.
          *
@@ -541,6 +624,36 @@ namespace Trick {
          */
         unsigned int get_max_tries();
 
+        /**
+         * Sets #dispatch_ahead.
+         */
+        void set_dispatch_ahead(bool dispatch_ahead);
+
+        /**
+         * Gets #dispatch_ahead.
+         */
+        bool get_dispatch_ahead();
+
+        /**
+         * Sets #slave_init_once.
+         */
+        void set_slave_init_once(bool slave_init_once);
+
+        /**
+         * Gets #slave_init_once.
+         */
+        bool get_slave_init_once();
+
+        /**
+         * Sets #local_workers.
+         */
+        void set_local_workers(int local_workers);
+
+        /**
+         * Gets #local_workers.
+         */
+        int get_local_workers();
+
         /**
          * Sets #user_cmd_string.
          */
@@ -774,7 +887,16 @@ namespace Trick {
          */
         int  get_connection_device_port() ;
 
+        /**
+         * Writes data for the master. On a slave, the data is sent to the master with the run's exit status after the
+         * slave post run jobs finish.
+         */
         int write(char* data, int size);
+
+        /**
+         * Reads data from the slave. On the master, the data is what the slave wrote in its post run jobs for the
+         * run being resolved.
+         */
         int read(char* data, int size);
 
 #if 0
@@ -806,11 +928,64 @@ namespace Trick {
          */
         void spawn_slaves();
 
-        /** Receives from any slaves that are ready to return results. */
+        /**
+         * Waits for a slave to connect or return results, or for the next run to time out, and receives from any
+         * slaves that are ready.
+         */
         void receive_results();
 
-        void handle_initialization(MonteSlave& slave);
-        void handle_run_data(MonteSlave& slave);
+        /**
+         * Gets the number of milliseconds #receive_results may wait before a dispatched run can time out.
+         *
+         * @return the wait in milliseconds
+         */
+        int get_poll_timeout();
+
+        /**
+         * Reads the machine name and port of an initializing slave from the specified device. The device becomes the
+         * slave's MonteSlave::connection.
+         *
+         * @param slave the initializing slave
+         * @param device the connection over which it initializes
+         */
+        void handle_initialization(MonteSlave& slave, TCDevice& device);
+
+        /** Adds the #local_workers to the #slaves. */
+        void add_local_workers();
+
+        /**
+         * Forks and executes the specified local worker with pipes to and from the master.
+         *
+         * @param slave the local worker
+         */
+        void spawn_local_worker(MonteSlave* slave);
+
+        /**
+         * Reads from a slave over the specified device, which is the slave's connection or a new connection from it.
+         *
+         * @return the number of bytes read
+         */
+        int read_from_slave(MonteSlave& slave, TCDevice& device, char* data, int size);
+
+        /**
+         * Writes to a slave over its MonteSlave::connection or, for a local worker, its MonteSlave::pipe_fd.
+         *
+         * @return the number of bytes written
+         */
+        int write_to_slave(MonteSlave& slave, char* data, int size);
+
+        /** Closes the connection to a slave. */
+        void disconnect_slave(MonteSlave& slave);
+
+        /**
+         * Reads a run's results from the specified device into #run_data and handles them.
+         *
+         * @param slave the slave returning results
+         * @param device the connection over which they are returned
+         */
+        void receive_run_data(MonteSlave& slave, TCDevice& device);
+
+        void handle_run_data(MonteSlave& slave, unsigned int run_id, int exit_status);
         void set_disconnected_state(MonteSlave& slave);
 
         /**
@@ -841,6 +1016,28 @@ namespace Trick {
          */
         MonteSlave *get_ready_slave();
 
+        /**
+         * Gets a slave to dispatch the next run to ahead of time, if #dispatch_ahead is set.
+         *
+         * @return a running slave with no MonteSlave::next_run, or <code>NULL</code> if there is none
+         */
+        MonteSlave *get_dispatch_ahead_slave();
+
+        /**
+         * Starts the specified slave's MonteSlave::next_run, if it has one, or puts it back in the queue.
+         *
+         * @param slave the slave
+         * @param requeue whether to put the run back in the queue rather than start it
+         */
+        void start_next_run(MonteSlave& slave, bool requeue = false);
+
+        /**
+         * Tells the specified slave not to process its MonteSlave::next_run and puts the run back in the queue.
+         *
+         * @param slave the slave
+         */
+        void cancel_next_run(MonteSlave& slave);
+
         /**
          * Gets the slave with the specified id.
          *
@@ -914,6 +1111,46 @@ namespace Trick {
         /** Processes an incoming run. */
         int slave_process_run();
 
+        /**
+         * Checks whether the master cancelled the specified run after dispatching it ahead. Any other command waiting
+         * on the connection is kept in #pending_command for #execute_as_slave.
+         *
+         * @param run_id the run
+         *
+         * @return whether a MonteSlave::MC_CANCEL_RUN for the run was waiting
+         */
+        bool slave_run_cancelled(int run_id);
+
+        /**
+         * Reads from the master over #connection_device.
+         *
+         * @return the number of bytes read
+         */
+        int read_from_master(char* data, int size);
+
+        /**
+         * Writes to the master over #connection_device or, for a local worker, #pipe_fd.
+         *
+         * @return the number of bytes written
+         */
+        int write_to_master(char* data, int size);
+
+        /**
+         * Copies every memory managed allocation to check with #check_initialized_state.
+         *
+         * @param copy the copies, keyed by the address of the allocation
+         */
+        void copy_initialized_state(std::map<void *, std::string>& copy);
+
+        /**
+         * Warns of any memory managed data that differs from the copy other than the Monte Carlo variables.
+         *
+         * @param copy the memory managed allocations, copied before the run's input was processed
+         *
+         * @return the number of allocations with differences
+         */
+        int check_initialized_state(const std::map<void *, std::string>& copy);
+
         /** Shuts down the slave. */
         void slave_shutdown();
 
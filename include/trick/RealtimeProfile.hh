@@ -0,0 +1,129 @@
+/*
+PURPOSE:
+    ( Real-time host profile: memory locking, prefaulting and thread CPU layout )
+*/
+
+#ifndef REALTIMEPROFILE_HH
+#define REALTIMEPROFILE_HH
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace Trick {
+
+    class ThreadBase ;
+
+    /**
+     * This class prepares the simulation process for deterministic real-time execution in one step.  When enabled,
+     * apply() runs at the end of initialization, after the scheduled threads are created, and:
+     *
+     * -# Locks the process memory with mlockall(), now and for future allocations.
+     * -# Faults in heap_reserve bytes of heap and keeps them in the process, so later allocations do not page fault.
+     * -# Faults in the MemoryManager allocations and stack_prefault bytes of the stack of every thread, when memory
+     *    is not locked.  The main thread and threads started later touch their own stacks.
+     * -# Pins every Trick::Threads, named Child_<id> with Child_0 the main thread, and every SysThread, such as
+     *    DR_Writer, VarServListen or MessageAsync, to the CPUs of the first layout entry whose pattern matches its
+     *    name.  Threads started later are pinned when they start.
+     * -# Verifies the result and publishes a warning for each problem: memory that could not be locked, a thread
+     *    not running on its CPUs or matched by no entry, a SysThread sharing a CPU with a scheduled thread, two
+     *    scheduled threads sharing a CPU, and a scheduled thread CPU that is not isolated from the kernel scheduler
+     *    or that receives interrupts.
+     *
+     * The layout is given with pin() in the order it should be matched, for instance:
+     * @code
+     * trick_sys.rt_profile.pin("Child_0", "2")
+     * trick_sys.rt_profile.pin("Child_*", "3-5")
+     * trick_sys.rt_profile.pin("*", "0-1")
+     * @endcode
+     *
+     * @date Oct. 2026
+     */
+    class RealtimeProfile {
+
+        public:
+
+            /** @userdesc Set to true to apply the profile at initialization (default false).\n */
+            bool enabled ;                      /**< trick_units(--) */
+
+            /** @userdesc Lock the process memory (default true).\n */
+            bool lock_memory ;                  /**< trick_units(--) */
+
+            /** @userdesc Fault in MemoryManager allocations and thread stacks (default true).\n */
+            bool prefault ;                     /**< trick_units(--) */
+
+            /** @userdesc Bytes of each thread's stack to fault in (default 256 KiB).\n */
+            size_t stack_prefault ;             /**< trick_units(--) */
+
+            /** @userdesc Bytes of heap to fault in and keep for later allocations (default 0).\n */
+            size_t heap_reserve ;               /**< trick_units(--) */
+
+            /** @userdesc Verify the layout after applying it (default true).\n */
+            bool verify ;                       /**< trick_units(--) */
+
+            /** True if the process memory is locked.\n */
+            bool memory_locked ;                /**< trick_units(--) */
+
+            /** Number of warnings published by the last verify_layout().\n */
+            unsigned int warnings ;             /**< trick_units(--) */
+
+            RealtimeProfile() ;
+            virtual ~RealtimeProfile() ;
+
+            /**
+             @brief @userdesc Command to add an entry to the thread layout.  Threads are pinned to the CPUs of the
+             first entry whose pattern matches their name.
+             @par Python Usage:
+             @code trick.exec_realtime_profile_pin("<thread name pattern>", "<cpu list>") @endcode
+             @param threads - shell wildcard pattern matched against thread names
+             @param cpus - list of CPUs, like "3" or "0-1,4"
+             @return 0, or -1 if the CPU list is not valid
+             */
+            int pin(std::string threads, std::string cpus) ;
+
+            /**
+             @brief Applies the profile if it is enabled.  Initialization job.
+             @return always 0
+             */
+            int apply() ;
+
+            /**
+             @brief Checks the memory lock, the thread layout, CPU sharing, CPU isolation and interrupt affinity and
+             publishes a warning for each problem.
+             @return the number of warnings
+             */
+            int verify_layout() ;
+
+            /**
+             @brief Parses a CPU list like "0-1,4".
+             @return 0, or -1 if the list is not valid
+             */
+            static int parse_cpu_list(std::string list, std::vector<unsigned int> & cpus) ;
+
+        protected:
+
+            /** The layout, pairs of a thread name pattern and its CPUs, in matching order.\n */
+            std::vector< std::pair< std::string , std::vector< unsigned int > > > layout ;   /**< trick_io(**) */
+
+            /**
+             @brief Returns the layout entry that matches a thread name, or NULL.
+             */
+            const std::vector< unsigned int > * find_cpus(const std::string & thread_name) ;
+
+            /**
+             @brief Sets the CPU affinity of a running thread to the CPUs of its layout entry.
+             @return true if the thread matched an entry
+             */
+            bool pin_thread(Trick::ThreadBase * thread) ;
+
+            /**
+             @brief Called by each thread started after apply().  Pins it and touches its stack.
+             */
+            static void thread_started(Trick::ThreadBase * thread) ;
+
+    } ;
+
+}
+
+#endif
@@ -10,6 +10,7 @@ PROGRAMMERS:
 
 #include "trick/Clock.hh"
 #include "trick/Timer.hh"
+#include "trick/JobShedder.hh"
 
 namespace Trick {
 
@@ -113,6 +114,32 @@ namespace Trick {
             /** The actual simulation time/wall clock time ratio\n */
             double actual_run_ratio ;           /**< trick_units(--) */
 
+            /** Time from the sleep timer waking up to the end of the frame in the last underrun frame the timer
+                slept in.  Negative if the timer woke after the end of the frame.\n */
+            double timer_wake_lead ;            /**< trick_units(s) */
+
+            /** Smallest timer_wake_lead since the wake up statistics were reset.\n */
+            double timer_wake_lead_min ;        /**< trick_units(s) */
+
+            /** Mean timer_wake_lead since the wake up statistics were reset.\n */
+            double timer_wake_lead_mean ;       /**< trick_units(s) */
+
+            /** How late the next frame started after the end of the last underrun frame the timer slept in.\n */
+            double wake_jitter ;                /**< trick_units(s) */
+
+            /** Largest wake_jitter since the wake up statistics were reset.\n */
+            double wake_jitter_max ;            /**< trick_units(s) */
+
+            /** Mean wake_jitter since the wake up statistics were reset.\n */
+            double wake_jitter_mean ;           /**< trick_units(s) */
+
+            /** Number of frames in the wake up statistics.\n */
+            unsigned long long wake_samples ;   /**< trick_units(--) */
+
+            /** Sheds low priority jobs on sustained overruns and restores them when the frames have headroom.  It
+                has no effect until groups of jobs are added to it.\n */
+            Trick::JobShedder job_shedder ;     /**< trick_units(--) */
+
             /**
              @brief This is the constructor of the RealtimeSync class.  It starts the RealtimeSync as
              disabled and sets the maximum overrun parameters to basically infinity.
@@ -166,6 +193,14 @@ namespace Trick {
              */
             int change_timer(Trick::Timer * in_sleep_timer) ;
 
+            /**
+             @brief @userdesc Command to clear the sleep timer wake up statistics.
+             @par Python Usage:
+             @code trick.real_time_reset_wake_stats() @endcode
+             @return always 0
+             */
+            int reset_wake_stats() ;
+
             /**
              @brief @userdesc Command to change the real time clock ratio
              @par Python Usage:
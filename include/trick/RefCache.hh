@@ -0,0 +1,99 @@
+#ifndef REFCACHE_HH
+#define REFCACHE_HH
+/*
+    PURPOSE: ( RefCache - least recently used cache of resolved variable references.)
+*/
+
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <pthread.h>
+
+#include "trick/attributes.h"
+#include "trick/reference.h"
+
+namespace Trick {
+
+/**
+ The RefCache remembers how MemoryManager::ref_attributes() resolved a reference
+ string (and each of its "." and "[]" prefixes) so that subsequent lookups of the
+ same name, or of names sharing a prefix, skip the parser and the per-level
+ searches. An entry stores the address path rather than the address, so pointers
+ along the path are followed again on every lookup.
+
+ Entries depend on the named allocations of the MemoryManager. The cache must be
+ invalidated whenever a named allocation is declared, deleted, renamed or resized.
+ */
+    class RefCache {
+
+        public:
+
+        /**
+         Constructor.
+         @param capacity - maximum number of cached references. 0 disables the cache.
+         */
+        RefCache( unsigned int capacity ) ;
+
+        ~RefCache() ;
+
+        /** Sets the maximum number of cached references, evicting entries as needed. 0 disables the cache. */
+        void set_capacity( unsigned int capacity ) ;
+
+        /** @return The maximum number of cached references. */
+        unsigned int get_capacity() ;
+
+        /** @return The number of cached references. */
+        unsigned int get_size() ;
+
+        /** Discards every entry. Entries being resolved when this is called will not be stored. */
+        void invalidate() ;
+
+        /**
+         @return Counter that changes every time the cache is invalidated. Pass the value read
+         before resolving a reference to put() so a stale resolution is never stored.
+         */
+        unsigned int get_generation() ;
+
+        /**
+         Populates R from the entry for key. R->reference and R->units are set to NULL.
+         R->address is recomputed by following the stored address path.
+         @return true if an entry was found and its address path resolves to a non-NULL address.
+         */
+        bool get( const std::string & key , REF2 * R ) ;
+
+        /**
+         Stores the resolution state of R under key.
+         @param generation - value of get_generation() read before R was resolved.
+         */
+        void put( const std::string & key , REF2 * R , unsigned int generation ) ;
+
+        private:
+
+        /** Resolution state of one reference string. */
+        struct Entry {
+            std::string key ;
+            ATTRIBUTES * attr ;            /* member ATTRIBUTES, NULL if attr_is_ref_attr */
+            ATTRIBUTES ref_attr ;          /* copy of the dynamically allocated reference ATTRIBUTES */
+            bool attr_is_ref_attr ;
+            int num_index ;
+            int num_index_left ;
+            int pointer_present ;
+            std::vector< ADDRESS_NODE > address_path ;
+        } ;
+
+        typedef std::list< Entry > ENTRY_LIST ;
+
+        /** Removes least recently used entries until the cache fits in capacity. Caller holds mutex. */
+        void evict() ;
+
+        unsigned int capacity ;     /**< ** maximum number of entries */
+        unsigned int generation ;   /**< ** invalidation counter */
+        ENTRY_LIST entries ;        /**< ** entries, most recently used first */
+        std::unordered_map< std::string , ENTRY_LIST::iterator > entry_map ; /**< ** key -> entry */
+        pthread_mutex_t mutex ;     /**< ** protects all of the above */
+    } ;
+
+}
+
+#endif
@@ -38,6 +38,9 @@ namespace Trick {
 
             static int ensureAllShutdown();
 
+            /** Copies the list of all system threads into threads. */
+            static int get_sys_threads(std::vector <SysThread *> & threads);
+
         protected:
             // Called from the main thread
             void force_thread_to_pause();
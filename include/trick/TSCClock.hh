@@ -0,0 +1,102 @@
+/*
+PURPOSE:
+    ( Time stamp counter Clock )
+*/
+
+#ifndef TSCCLOCK_HH
+#define TSCCLOCK_HH
+
+#include "trick/Clock.hh"
+
+namespace Trick {
+
+    /**
+     * This clock counts nanoseconds by reading the CPU time stamp counter (TSC) directly, which takes a few
+     * nanoseconds and no system call.  It is used only when the CPU advertises an invariant TSC, one that ticks at
+     * a constant rate in every power state and is synchronized across cores.  Otherwise it reads CLOCK_MONOTONIC,
+     * still in nanoseconds.
+     *
+     * clock_init() measures the TSC frequency against CLOCK_MONOTONIC over calibration_time.  Until then the clock
+     * reads CLOCK_MONOTONIC.  Every anchor_period the clock is anchored to CLOCK_MONOTONIC again: the frequency is
+     * measured over the whole run, and the rate is slewed so any difference from CLOCK_MONOTONIC is removed without
+     * the clock jumping.  The clock never goes back; only a clock far behind is stepped forward.
+     * Anchoring is done by whichever thread reads the clock when it is due, under a sequence lock, so readers on
+     * other threads never block.
+     *
+     * @date Oct. 2026
+     */
+    class TSCClock : public Clock {
+
+        public:
+
+            /** @userdesc Time spent measuring the TSC frequency in clock_init() (default 0.01).\n */
+            double calibration_time ;          /**< trick_units(s) */
+
+            /** @userdesc Time between anchors to CLOCK_MONOTONIC (default 1.0).\n */
+            double anchor_period ;             /**< trick_units(s) */
+
+            /** True if the TSC is read, false if CLOCK_MONOTONIC is read.\n */
+            bool use_tsc ;                     /**< trick_units(--) */
+
+            /** Measured TSC frequency.\n */
+            double tsc_frequency ;             /**< trick_units(1/s) */
+
+            /** CLOCK_MONOTONIC less this clock at the last anchor, in ns.\n */
+            long long anchor_error ;           /**< trick_units(--) */
+
+            TSCClock() ;
+
+            /** @brief Returns true if the CPU advertises an invariant TSC. */
+            static bool invariant_tsc_available() ;
+
+            /** @copybrief Trick::Clock::clock_init() */
+            virtual int clock_init() ;
+
+            /** @copybrief Trick::Clock::wall_clock_time() */
+            virtual long long wall_clock_time() ;
+
+            /** @copybrief Trick::Clock::clock_stop() */
+            virtual int clock_stop() ;
+
+        protected:
+
+            /** Odd while an anchor is being changed.\n */
+            unsigned int anchor_seq ;          /**< trick_io(**) */
+
+            /** TSC value of the anchor.\n */
+            unsigned long long anchor_tsc ;    /**< trick_io(**) */
+
+            /** Clock time in ns of the anchor.\n */
+            long long anchor_ns ;              /**< trick_io(**) */
+
+            /** ns per TSC tic since the anchor, times 2^32.\n */
+            unsigned long long anchor_mult ;   /**< trick_io(**) */
+
+            /** TSC value and CLOCK_MONOTONIC time at the start of calibration, the base of the frequency.\n */
+            unsigned long long first_tsc ;     /**< trick_io(**) */
+            long long first_ns ;               /**< trick_io(**) */
+
+            /** anchor_period in TSC tics, 0 until calibrated.\n */
+            unsigned long long period_tsc ;    /**< trick_io(**) */
+
+            /**
+             @brief Measures the TSC frequency and sets the first anchor.
+             @return always 0
+            */
+            int calibrate() ;
+
+            /** @brief Reads CLOCK_MONOTONIC in ns. */
+            static long long monotonic_ns() ;
+
+            /** @brief Reads CLOCK_MONOTONIC and the TSC value at the same moment. */
+            static void read_pair( unsigned long long & tsc , long long & ns ) ;
+
+            /** @brief Moves the anchor to the current TSC value.  Called holding the sequence lock. */
+            void anchor( unsigned long long curr_anchor_tsc , long long curr_anchor_ns ,
+             unsigned long long curr_anchor_mult ) ;
+
+    } ;
+
+}
+
+#endif
@@ -159,6 +159,12 @@ namespace Trick {
             virtual void thread_shutdown();
             virtual void thread_shutdown(void (*exit_handler) (void *), void * exit_arg);
 
+#ifndef SWIG
+            /** If set, called by every thread when it starts, after its priority and CPU affinity are set.
+                Used by Trick::RealtimeProfile to pin and prefault threads created after it is applied. */
+            static void (*start_hook)( Trick::ThreadBase * thread ) ;
+#endif
+
         protected:
 
             /** optional name of thread */
@@ -57,6 +57,12 @@ namespace Trick {
             */
             void set_active( bool in_active) ;
 
+            /**
+             @brief Gets the active flag
+             @return true if the timer will pause in the current frame
+            */
+            bool get_active() ;
+
             /**
              @brief Initializes the timer.  Timer hardware (if any) should be initialized here.
              the timer's frequency is set to the incoming in_frame_time.
@@ -74,6 +80,12 @@ namespace Trick {
              */
             virtual int reset(double frame_time) = 0 ;
 
+            /**
+             @brief Starts the timer after it has elapsed, late_time seconds after the end of the frame.  The
+             default ignores late_time and calls reset().
+             */
+            virtual int reset_late(double frame_time, double late_time) ;
+
             /**
              @brief Turns the timer off.
              */
@@ -0,0 +1,153 @@
+/*
+PURPOSE:
+    ( Streaming Chrome trace writer )
+*/
+
+#ifndef TRACEWRITER_HH
+#define TRACEWRITER_HH
+
+#include <stdio.h>
+#include <pthread.h>
+#include <set>
+#include <string>
+#include <vector>
+#include "trick/SysThread.hh"
+#include "trick/JobProfile.hh"
+
+namespace Trick {
+
+    struct TraceBuffer ;
+
+    /**
+     * This class streams a timeline of the simulation to a file in the Chrome Trace Event JSON format, which
+     * chrome://tracing and ui.perfetto.dev open.  It records job calls, child thread trigger fires and waits,
+     * data record group writes and variable server copies.
+     *
+     * Each thread that records an event gets its own single writer ring buffer, so recording takes no lock.  A
+     * background thread drains the rings every flush_period and appends the events to the file, so a run of any
+     * length may be traced.  If a ring fills before it is drained, further events from that thread are dropped
+     * and counted in events_dropped.  When a thread exits, its ring is freed once it has been drained.
+     *
+     * @date Oct. 2026
+     */
+    class TraceWriter : public Trick::SysThread {
+
+        public:
+
+            /** True while events are recorded.  Checked before recording anything.\n */
+            static bool active ;                 /**< trick_io(**) */
+
+            /** @userdesc Name of the trace file in the output directory (default "trace.json").\n */
+            std::string file_name ;              /**< trick_units(--) */
+
+            /** @userdesc Events each thread can hold between drains, rounded up to a power of 2 (default 65536).\n */
+            unsigned int buffer_size ;           /**< trick_units(--) */
+
+            /** @userdesc Time between drains of the buffers (default 0.1).\n */
+            double flush_period ;                /**< trick_units(s) */
+
+            /** Events written to the file.\n */
+            unsigned long long events_written ;  /**< trick_units(--) */
+
+            /** Events dropped because a buffer was full.\n */
+            unsigned long long events_dropped ;  /**< trick_units(--) */
+
+            TraceWriter() ;
+
+            /**
+             @brief @userdesc Command to start recording the trace.  The first call opens the file and starts the
+             writer thread.
+             @par Python Usage:
+             @code trick.trace_on() @endcode
+             @return 0, or -1 if the file could not be opened
+            */
+            int trace_on() ;
+
+            /**
+             @brief @userdesc Command to stop recording the trace.  Recorded events are still written.
+             @par Python Usage:
+             @code trick.trace_off() @endcode
+             @return always 0
+            */
+            int trace_off() ;
+
+            /**
+             @brief Stops recording, writes the remaining events and closes the file.
+             @return always 0
+            */
+            int shutdown() ;
+
+            /** @brief The trace clock, CLOCK_MONOTONIC_RAW in ns. */
+            static long long now() {
+                return Trick::JobProfile::now() ;
+            }
+
+            /**
+             @brief Records that name ran from start_ns to end_ns on the calling thread.  name and category must
+             stay valid until the trace is closed.
+            */
+            static void complete( const char * name , const char * category , long long start_ns , long long end_ns ) {
+                if ( active ) {
+                    record(name, category, start_ns, end_ns) ;
+                }
+            }
+
+            /**
+             @brief Returns a copy of str that stays valid until the simulation exits, for names whose own string
+             may be freed while the trace is written.
+            */
+            static const char * intern( const std::string & str ) ;
+
+            /** @brief Records that name happened now on the calling thread. */
+            static void instant( const char * name , const char * category ) {
+                if ( active ) {
+                    record(name, category, now(), -1) ;
+                }
+            }
+
+            /**
+             @brief Drains the buffers every flush_period.  The sleep is where the thread is cancelled at shutdown.
+            */
+            virtual void * thread_body() ;
+
+        private:
+
+            /** The trace file.\n */
+            FILE * fp ;                                      /**< trick_io(**) */
+
+            /** Trace clock time of trace_on(), subtracted from every timestamp.\n */
+            long long base_ns ;                              /**< trick_io(**) */
+
+            /** True until the first event is written.\n */
+            bool first_event ;                               /**< trick_io(**) */
+
+            /** Serializes writing the file between the writer thread and shutdown().\n */
+            pthread_mutex_t write_mutex ;                    /**< trick_io(**) */
+
+            /** Protects buffers and names.\n */
+            pthread_mutex_t buffers_mutex ;                  /**< trick_io(**) */
+
+            /** Names kept by intern().\n */
+            std::set< std::string > names ;                  /**< trick_io(**) */
+
+            /** The ring of every thread that has recorded an event.\n */
+            std::vector< Trick::TraceBuffer * > buffers ;    /**< trick_io(**) */
+
+            /** Events dropped by the rings already freed.\n */
+            unsigned long long freed_dropped ;               /**< trick_io(**) */
+
+            /** @brief Adds an event to the calling thread's ring, creating the ring the first time. */
+            static void record( const char * name , const char * category , long long start_ns , long long end_ns ) ;
+
+            /** @brief Writes the events in every ring to the file, and frees the rings of exited threads. */
+            void drain() ;
+
+            /** @brief Writes one JSON string, escaped. */
+            void write_string( const char * str ) ;
+
+            void operator =(const Trick::TraceWriter &) ;
+    } ;
+
+}
+
+#endif
@@ -61,6 +61,8 @@ extern "C" {
     int exec_set_thread_async_wait( unsigned int thread_id , int yes_no ) ;
     int exec_set_thread_rt_semaphores( unsigned int thread_id , int yes_no ) ;
     int exec_set_thread_cpu_affinity(unsigned int thread_id , int cpu_num) ;
+    int exec_set_realtime_profile(int yes_no) ;
+    int exec_realtime_profile_pin(const char * threads , const char * cpus) ;
     int exec_set_thread_priority(unsigned int thread_id , unsigned int req_priority) ;
     int exec_set_thread_process_type( unsigned int thread_id , int process_type ) ;
     int exec_set_time( double in_time ) ;
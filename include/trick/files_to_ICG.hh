@@ -3,9 +3,11 @@
 
 #include "trick/reference_frame.h"
 #include "trick/GetTimeOfDayClock.hh"
+#include "trick/TSCClock.hh"
 #include "trick/CommandLineArguments.hh"
 #include "trick/Executive.hh"
 #include "trick/ExecutiveException.hh"
+#include "trick/RealtimeProfile.hh"
 #include "trick/Environment.hh"
 #include "trick/Event.hh"
 #include "trick/EventProcessor.hh"
@@ -45,7 +47,9 @@
 #include "trick/PlaybackFile.hh"
 #include "trick/MonteCarlo.hh"
 #include "trick/RealtimeSync.hh"
+#include "trick/JobShedder.hh"
 #include "trick/ITimer.hh"
+#include "trick/HybridTimer.hh"
 #include "trick/VariableServer.hh"
 #include "trick/regula_falsi.h"
 #include "trick/Integrator.hh"
@@ -84,6 +88,8 @@
 #include "trick/DebugPause.hh"
 #include "trick/EchoJobs.hh"
 #include "trick/FrameLog.hh"
+#include "trick/JobProfiler.hh"
+#include "trick/TraceWriter.hh"
 #include "trick/UnitTest.hh"
 #include "trick/CheckPointRestart.hh"
 #include "trick/Sie.hh"
@@ -0,0 +1,20 @@
+#ifndef JOBPROFILER_PROTO_H
+#define JOBPROFILER_PROTO_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int job_profiler_on(void) ;
+int job_profiler_off(void) ;
+int job_profiler_reset(void) ;
+int job_profiler_update_stats(void) ;
+int job_profiler_get_index(const char * job_name) ;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
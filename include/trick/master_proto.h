@@ -8,6 +8,8 @@ extern "C" {
 
     int ms_master_enable(void) ;
     int ms_master_disable(void) ;
+    int ms_master_set_parallel_sync(int on_off) ;
+    int ms_master_print_sync_latency(void) ;
 
 #ifdef __cplusplus
 }
@@ -68,6 +68,14 @@ class MonteCarloMaster
       Defaults to 0. */
   size_t monte_run_number; /* (--)
       A unique identifying number for each run.*/
+  bool use_run_table; /* (--)
+      Flag selecting streaming generation.  When true, the assignments of
+      all runs are written to a single run table, monte_run_table, instead
+      of a RUN_<run_num> directory and monte-input file per run.  The runs
+      are then launched from the one generic monte-input file, which loads
+      the run named by the MONTE_RUN_NUMBER environment variable from the
+      table.  Each run creates its RUN_<run_num> directory when it starts.
+      Default: false.*/
 
  protected:
   bool input_files_prepared; /* (--)
@@ -90,6 +98,12 @@ class MonteCarloMaster
   unsigned int num_runs; /* (--)
       The number of runs to execute for this scenario.*/
 
+  std::string run_commands; /* (--)
+      The assignments of the run loaded from the run table.*/
+  std::string loaded_run_dir; /* (--)
+      The RUN_<run_num> directory of the run loaded from the run table.  It
+      is created when the run starts, see start_run.*/
+
  private:
   std::list< std::pair< std::string,
                         MonteCarloVariableFile *> > file_list; /* (--)
@@ -109,8 +123,13 @@ class MonteCarloMaster
   void set_num_runs( unsigned int num_runs);
   void execute();
   void collate_meta_data();
+  bool load_run( size_t run_num);
+  void start_run();
+  std::string get_run_commands() const {return run_commands;}
 
  private:
+  void prepare_run_table( int max_length);
+
   static bool seed_sort( std::pair< unsigned int, std::string> left,
                          std::pair< unsigned int, std::string> right)
   {
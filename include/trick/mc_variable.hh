@@ -57,6 +57,9 @@ class MonteCarloVariable
 
   virtual void generate_assignment() = 0;
   virtual void shutdown() {}; // deliberately empty
+  // Used by MonteCarloMaster when writing a run table, so that the value
+  // generated for a run depends only on the run number.
+  virtual void reseed_for_run( size_t) {}; // deliberately empty
 
   // These getters are intended to be used by the MonteCarloMaster class in
   // preparing the input files and summary data files.  They may also be used
@@ -40,6 +40,14 @@ class MonteCarloVariableRandom : public MonteCarloVariable
   virtual ~MonteCarloVariableRandom(){};
   unsigned int get_seed() const {return seed_m;} // override but SWIG cannot process the
                                                // override keyword
+  // Seeds the generator from both the seed and the run number, so a run's
+  // value does not depend on how many values were generated before it.
+  virtual void reseed_for_run( size_t run_num)
+  {
+    std::seed_seq seq{seed_m, static_cast<unsigned int>(run_num),
+                      static_cast<unsigned int>(run_num >> 16 >> 16)};
+    random_generator.seed(seq);
+  }
  private: // and undefined:
   MonteCarloVariableRandom( const MonteCarloVariableRandom & );
   MonteCarloVariableRandom& operator = (const MonteCarloVariableRandom&);
@@ -44,6 +44,7 @@ class MonteCarloVariableRandomNormal : public MonteCarloVariableRandom
 
   virtual ~MonteCarloVariableRandomNormal(){};
   virtual void generate_assignment();
+  virtual void reseed_for_run( size_t run_num);
   virtual std::string summarize_variable() const;
   void truncate(double limit, TruncationType type = StandardDeviation);
   void truncate(double min, double max, TruncationType type = StandardDeviation);
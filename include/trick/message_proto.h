@@ -14,6 +14,10 @@ int message_remove_subscriber( void * in_ms ) ;
 void * message_get_subscriber( const char * sub_name) ;
 int message_publish(int level, const char *format_msg, ...) ;
 int message_publish_standalone(int level, const char *format_msg, ...) ;
+int message_set_async(int yes_no) ;
+int message_flush(void) ;
+int message_set_rate_limit(int level, unsigned int max_count) ;
+int message_set_suppress_duplicates(int level, int yes_no) ;
 int send_hs(FILE * fp, const char *format_msg, ...) ;
 
 #ifndef SWIG
@@ -89,6 +89,42 @@ void mc_set_max_tries(unsigned int max_tries);
  */
 unsigned int mc_get_max_tries(void);
 
+/**
+ * @relates Trick::MonteCarlo
+ * @copydoc set_dispatch_ahead
+ */
+void mc_set_dispatch_ahead(int dispatch_ahead);
+
+/**
+ * @relates Trick::MonteCarlo
+ * @copydoc get_dispatch_ahead
+ */
+int mc_get_dispatch_ahead(void);
+
+/**
+ * @relates Trick::MonteCarlo
+ * @copydoc set_slave_init_once
+ */
+void mc_set_slave_init_once(int slave_init_once);
+
+/**
+ * @relates Trick::MonteCarlo
+ * @copydoc get_slave_init_once
+ */
+int mc_get_slave_init_once(void);
+
+/**
+ * @relates Trick::MonteCarlo
+ * @copydoc set_local_workers
+ */
+void mc_set_local_workers(int local_workers);
+
+/**
+ * @relates Trick::MonteCarlo
+ * @copydoc get_local_workers
+ */
+int mc_get_local_workers(void);
+
 /**
  * @relates Trick::MonteCarlo
  * @copydoc set_user_cmd_string
@@ -20,6 +20,9 @@ int is_real_time(void) ;
 const char * real_time_clock_get_name(void) ;
 int real_time_set_rt_clock_ratio(double in_clock_ratio) ;
 int real_time_lock_memory(int yes_no) ;
+int real_time_reset_wake_stats(void) ;
+int real_time_add_shed_group(const char * job_name, double cycle_factor) ;
+int real_time_restore_shed_groups(void) ;
 
 // Deprecated
 int exec_set_lock_memory(int yes_no) ;
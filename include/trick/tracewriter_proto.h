@@ -0,0 +1,17 @@
+#ifndef TRACEWRITER_PROTO_H
+#define TRACEWRITER_PROTO_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int trace_on(void) ;
+int trace_off(void) ;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
@@ -0,0 +1,87 @@
+#ifndef TRK_COLUMNS_H
+#define TRK_COLUMNS_H
+
+/*
+    PURPOSE: ( Layout, reader and writer of the columnar sidecar file of a Trick binary log.)
+    ICG: (No)
+*/
+
+#include <stdint.h>
+#include <sys/stat.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The sidecar file name is the log file name with this appended. */
+#define TRK_COLUMNS_SUFFIX ".col"
+
+/** Number of records between entries of the sparse time index. */
+#define TRK_COLUMNS_INDEX_STRIDE 1024
+
+/**
+ * Header of the columnar sidecar of a Trick binary log (.trk).
+ *
+ * The sidecar holds the same values as the log, converted to doubles and
+ * stored one parameter after the other so a reader touches only the columns
+ * it asks for. Everything is in the byte order named by the magic string.
+ * The header is followed by
+ * -# num_index doubles, the time stamp of every index_stride'th record.
+ * -# num_params columns of num_records doubles, in the order the parameters
+ *    appear in the log header. The first column is sys.exec.out.time.
+ *
+ * A sidecar is only used while trk_size and trk_mtime match the log file.
+ */
+typedef struct {
+    char magic[8] ;          /* "TrkCol-L" or "TrkCol-B" */
+    int64_t trk_size ;       /* size of the log file the sidecar was written from */
+    int64_t trk_mtime ;      /* modification time of that log file in nanoseconds, see trk_columns_mtime */
+    int64_t num_records ;    /* number of records in each column */
+    int32_t num_params ;     /* number of columns */
+    int32_t index_stride ;   /* records between time index entries */
+    int64_t num_index ;      /* number of time index entries */
+    int32_t time_sorted ;    /* 1 if no time stamp is less than the one before it */
+    int32_t reserved ;
+} TRK_COLUMNS_HEADER ;
+
+/** @return The modification time of a file in nanoseconds, as stored in trk_mtime. */
+int64_t trk_columns_mtime( const struct stat * st ) ;
+
+/** @return The magic string of a sidecar in the byte order of this machine. */
+const char * trk_columns_magic( void ) ;
+
+/**
+ * Decodes one recorded value.
+ * @param address - the value within a log record
+ * @param type - TRICK_TYPE of the value
+ * @param size - size of the value in bytes
+ * @param swap - nonzero if the log is in the other byte order
+ * @return The value as a double, 0.0 for types that are not numbers.
+ */
+double trk_columns_value( const char * address , int type , int size , int swap ) ;
+
+/**
+ * Writes the sidecar of a log.  The sidecar is written to a temporary file and
+ * renamed into place, so readers never map a partly written sidecar.
+ * @param col_name - name of the sidecar, the log file name with TRK_COLUMNS_SUFFIX
+ * @param records - the first record of the log
+ * @param num_records - number of complete records
+ * @param record_bytes - size of a record
+ * @param num_params - number of parameters in a record, the first is the time
+ * @param types - TRICK_TYPE of each parameter
+ * @param sizes - size of each parameter
+ * @param offsets - offset of each parameter within a record
+ * @param swap - nonzero if the log is in the other byte order
+ * @param trk_size - size of the log file
+ * @param trk_mtime - modification time of the log file from trk_columns_mtime
+ * @return 0 on success, -1 with errno set on failure.
+ */
+int trk_columns_write( const char * col_name , const char * records , int64_t num_records ,
+ int64_t record_bytes , int num_params , const int * types , const int * sizes , const int64_t * offsets ,
+ int swap , int64_t trk_size , int64_t trk_mtime ) ;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -65,11 +65,14 @@ remove_event = trick.event_manager_remove_event
 if hasattr(top.cvar, 'trick_em'):
     activate_event = top.cvar.trick_em.em.activate_event
     deactivate_event = top.cvar.trick_em.em.deactivate_event
+    set_event_async_evaluation = top.cvar.trick_em.em.set_async_evaluation
 
 # from real time
 if hasattr(top.cvar, 'trick_real_time'):
     itimer_enable = top.cvar.trick_real_time.itimer.enable
     itimer_disable = top.cvar.trick_real_time.itimer.disable
+    hybrid_timer_enable = top.cvar.trick_real_time.hybrid_timer.enable
+    hybrid_timer_disable = top.cvar.trick_real_time.hybrid_timer.disable
 
 # from variable server / sim_control panel
 if hasattr(top.cvar, 'trick_vs'):
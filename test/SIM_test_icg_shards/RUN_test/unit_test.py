@@ -0,0 +1,12 @@
+import os
+
+# The XML resources written by every ICG process are merged into build/classes.resource
+resource = open("build/classes.resource").read()
+for name in ("Alpha", "Beta", "Gamma", "Delta"):
+    if '<class name="' + name + '">' not in resource:
+        trick.exec_terminate_with_return(1, "unit_test.py", 8, "class " + name + " missing from build/classes.resource")
+for shard_file in os.listdir("build"):
+    if ".shard" in shard_file:
+        trick.exec_terminate_with_return(1, "unit_test.py", 11, "ICG shard file " + shard_file + " was not merged")
+
+trick.stop(3.0);
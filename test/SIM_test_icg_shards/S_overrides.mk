@@ -0,0 +1,4 @@
+
+TRICK_CFLAGS += -I./models
+TRICK_CXXFLAGS += -I./models
+TRICK_ICGFLAGS += -j 3
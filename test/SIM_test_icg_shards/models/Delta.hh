@@ -0,0 +1,23 @@
+// @trick_parse{everything}
+#include "Pair.hh"
+#include "trick/memorymanager_c_intf.h"
+
+class Delta {
+    public:
+    Pair<double> pair;
+    Color color;
+    int value;
+
+    Delta(): color(Blue), value(44) {}
+
+    int test_delta_member_value_correct_offset() {
+        char ref_name[] = "testShardsSimObject.delta.value";
+        REF2* ref = ref_attributes(ref_name);
+        if(ref != NULL and *((int*)ref->address) == value) {
+            return 0;
+        }
+        else {
+            return 1;
+        }
+    }
+};
@@ -0,0 +1,16 @@
+// @trick_parse{everything}
+#ifndef PAIR_HH
+#define PAIR_HH
+
+template <class T>
+class Pair {
+    public:
+    T first;
+    T second;
+
+    Pair() : first(), second() {}
+};
+
+enum Color { Red , Green , Blue } ;
+
+#endif
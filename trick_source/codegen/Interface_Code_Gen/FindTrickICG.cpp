@@ -23,6 +23,10 @@ void FindTrickICG::FileChanged(clang::SourceLocation Loc, FileChangeReason Reaso
             loc_str = PLoc.getFilename() ;
             switch (Reason) {
                 case EnterFile :
+                    // Record the include for the io_src cache keys.
+                    if ( ! included_files.empty() ) {
+                        hsd.addIncludedFile(included_files.back(), loc_str) ;
+                    }
                     included_files.push_back(loc_str) ;
                     break ;
                 case ExitFile :
@@ -57,6 +61,11 @@ void FindTrickICG::FileSkipped(const clang::FileEntryRef & SkippedFile, const cl
         }
     }
 
+    // The io_src of the including file still depends on the skipped header.
+    if ( ! included_files.empty() ) {
+        hsd.addIncludedFile(included_files.back(), file_name) ;
+    }
+
     // Check if skipped header is in Compat15
     if(hsd.isPathInCompat15(file_path)) {
         // for each header in the stack, mark them as being exposed to TRICK_ICG
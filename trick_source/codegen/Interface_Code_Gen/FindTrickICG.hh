@@ -9,6 +9,7 @@
    FindTrickICG searches preprocessor directives #if/#elif/#ifdef/#ifndef to see if they use TRICK_ICG
    If they do reference TRICK_ICG we need to mark the stack of incude files that include the TRICK_ICG.
    We also print a warning to the screen where the TRICK_ICG was found.
+   The stack of include files is also used to record which files each file includes.
  */
 
 class FindTrickICG : public clang::PPCallbacks {
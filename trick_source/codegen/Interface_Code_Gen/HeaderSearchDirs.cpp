@@ -405,3 +405,32 @@ void HeaderSearchDirs::addTrickICGFoundFile ( std::string file_name ) {
         free(rp) ;
     }
 }
+
+void HeaderSearchDirs::addIncludedFile ( const std::string& includer , const std::string& included ) {
+    char * includer_rp = almostRealPath(includer.c_str()) ;
+    char * included_rp = almostRealPath(included.c_str()) ;
+    if ( includer_rp != NULL and included_rp != NULL ) {
+        included_files[includer_rp].insert(included_rp) ;
+    }
+    free(includer_rp) ;
+    free(included_rp) ;
+}
+
+std::set< std::string > HeaderSearchDirs::getIncludedFiles ( const std::string& file_name ) {
+    std::set< std::string > all_included ;
+    std::vector< std::string > to_visit(1, file_name) ;
+    while ( ! to_visit.empty() ) {
+        std::string file = to_visit.back() ;
+        to_visit.pop_back() ;
+        std::map< std::string , std::set< std::string > >::iterator mit = included_files.find(file) ;
+        if ( mit != included_files.end() ) {
+            for ( const std::string & included : mit->second ) {
+                if ( all_included.insert(included).second ) {
+                    to_visit.push_back(included) ;
+                }
+            }
+        }
+    }
+    all_included.erase(file_name) ;
+    return all_included ;
+}
@@ -113,6 +113,18 @@ class HeaderSearchDirs {
           */
         void addTrickICGFoundFile ( std::string file_name ) ;
 
+        /** Record that a file includes another file.  Includes skipped by header guards are recorded too.
+            @param includer = file containing the #include
+            @param included = file included
+          */
+        void addIncludedFile ( const std::string& includer , const std::string& included ) ;
+
+        /** Returns every file a file includes, directly or through other files.
+            @param file_name = real path of the file
+            @return real paths of the included files, sorted.
+          */
+        std::set< std::string > getIncludedFiles ( const std::string& file_name ) ;
+
     private:
         /** Are we ICG'ing the sim_services files? */
         bool sim_services ;
@@ -171,6 +183,9 @@ class HeaderSearchDirs {
         /** Map of file names to in icg_nocomment_dir used as a cache */
         std::map< std::string , bool > icg_nocomment_files ;
 
+        /** Map of real file paths to the real paths of the files they include directly */
+        std::map< std::string , std::set< std::string > > included_files ;
+
 } ;
 
 #endif
@@ -2,10 +2,11 @@
 #include <iostream>
 #include "clang/AST/ASTContext.h"
 #include "ICGASTConsumer.hh"
+#include "PrintAttributes.hh"
 
 ICGASTConsumer::ICGASTConsumer( clang::CompilerInstance & in_ci , HeaderSearchDirs & in_hsd ,
  CommentSaver & in_cs , PrintAttributes & in_pa ) :
- ci(in_ci) , hsd(in_hsd) , tuv(in_ci, in_hsd, in_cs, in_pa) {}
+ ci(in_ci) , hsd(in_hsd) , pa(in_pa) , tuv(in_ci, in_hsd, in_cs, in_pa) {}
 
 TranslationUnitVisitor & ICGASTConsumer::getTranslationUnitVisitor() {
     return tuv ;
@@ -13,9 +14,11 @@ TranslationUnitVisitor & ICGASTConsumer::getTranslationUnitVisitor() {
 
 /**
 @details
+-# Fork the processes writing the other io_src shards now that the header is parsed.
 -# Traverse the translation unit declaration and everything it contains.
 */
 void ICGASTConsumer::HandleTranslationUnit(clang::ASTContext &Ctx) {
+    pa.startShards();
     tuv.TraverseDecl(Ctx.getTranslationUnitDecl());
 }
 
@@ -42,6 +42,9 @@ class ICGASTConsumer : public clang::SemaConsumer {
         /** The header search directories */
         HeaderSearchDirs & hsd ;
 
+        /** The attributes printer, forks the io_src shards before traversing */
+        PrintAttributes & pa ;
+
         /** The top level AST visitor. Called to parse tree in HandleTranslationUnit */
         TranslationUnitVisitor tuv ;
 
@@ -6,6 +6,8 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <sys/stat.h>
+#include <sys/wait.h>
+#include <utime.h>
 #include <stdio.h>
 #include <limits.h>
 
@@ -30,11 +32,17 @@ PrintAttributes::PrintAttributes(int in_attr_version , HeaderSearchDirs & in_hsd
    ci(in_ci) ,
    force(in_force) ,
    sim_services_flag( in_sim_services_flag ) ,
-   output_dir( in_output_dir )
+   output_dir( in_output_dir ) ,
+   shard_index(0) ,
+   shard_count(1) ,
+   first_unforked_shard(1)
 {
     printer = new PrintFileContents10() ;
 }
 
+/** The first line of every io_src file holds its cache key */
+static const std::string cache_key_prefix("// ICG cache key: ") ;
+
 void PrintAttributes::addIgnoreTypes() {
 
     char * env_var_contents = getenv("TRICK_ICG_IGNORE_TYPES") ;
@@ -52,6 +60,97 @@ void PrintAttributes::addIgnoreTypes() {
     }
 }
 
+void PrintAttributes::setCacheOptions( const std::string & options ) {
+    cache_options = options ;
+}
+
+void PrintAttributes::setJobs( unsigned int jobs ) {
+    shard_index = 0 ;
+    shard_count = ( jobs > 1 ) ? jobs : 1 ;
+}
+
+/**
+@details
+
+The header is parsed once.  Each forked process traverses the same AST so classes and templates
+are named the same in every process, but only writes the io_src files of its own shard.
+
+-# Flush buffered output so the forked processes do not write it again.
+-# Fork a process for each shard after the first.  The forked processes do not write the map files.
+-# If a fork fails, this process writes the shards that were not forked.
+*/
+void PrintAttributes::startShards() {
+    if ( shard_count <= 1 ) {
+        return ;
+    }
+    std::cout.flush() ;
+    std::cerr.flush() ;
+    class_map_outfile.flush() ;
+    enum_map_outfile.flush() ;
+    for ( unsigned int ii = 1 ; ii < shard_count ; ii++ ) {
+        pid_t pid = fork() ;
+        if ( pid == 0 ) {
+            shard_index = ii ;
+            shard_pids.clear() ;
+            class_map_outfile.close() ;
+            enum_map_outfile.close() ;
+            return ;
+        } else if ( pid < 0 ) {
+            std::cout << bold(color(WARNING, "Warning")) << "    Unable to fork ICG process: " << strerror(errno) << std::endl ;
+            return ;
+        }
+        shard_pids.push_back(pid) ;
+        first_unforked_shard = ii + 1 ;
+    }
+}
+
+/**
+@details
+
+-# A forked shard saves its XML resources next to the resource files and exits.
+-# The first shard waits for the forked shards.
+-# The XML resources of the forked shards are appended to the resource files in shard order.
+*/
+bool PrintAttributes::joinShards() {
+    if ( shard_index != 0 ) {
+        int ret = 0 ;
+        for ( auto & buffer : resource_buffers ) {
+            std::ofstream shard_file((buffer.first + ".shard" + std::to_string(shard_index)).c_str()) ;
+            shard_file << buffer.second ;
+            shard_file.close() ;
+            if ( shard_file.fail() ) {
+                std::cerr << bold(color(ERROR, "Error")) << "      Unable to write " << quote(bold(buffer.first)) << std::endl ;
+                ret = 1 ;
+            }
+        }
+        std::cout.flush() ;
+        std::cerr.flush() ;
+        _exit(ret) ;
+    }
+
+    bool ok = true ;
+    for ( pid_t pid : shard_pids ) {
+        int status ;
+        if ( waitpid(pid, &status, 0) < 0 or ! WIFEXITED(status) or WEXITSTATUS(status) != 0 ) {
+            ok = false ;
+        }
+    }
+
+    std::set< std::string > xml_file_names = { getSieClassFileName() , getSieEnumFileName() } ;
+    for ( unsigned int ii = 1 ; ii <= shard_pids.size() ; ii++ ) {
+        for ( const std::string & xml_file_name : xml_file_names ) {
+            const std::string shard_file_name = xml_file_name + ".shard" + std::to_string(ii) ;
+            std::string text ;
+            if ( readFileContents(shard_file_name, text) ) {
+                writeResource(xml_file_name, text) ;
+                remove(shard_file_name.c_str()) ;
+            }
+        }
+    }
+    shard_pids.clear() ;
+    return ok ;
+}
+
 /**
 @details
 
@@ -71,17 +170,61 @@ bool PrintAttributes::isIOFileOutOfDate(std::string header_file_name, std::strin
     struct stat io_stat ;
     int ret ;
 
+    const std::string cache_key = getCacheKey(header_file_name) ;
+    cache_keys[io_file_name] = cache_key ;
+
     stat( header_file_name.c_str() , &header_stat ) ;
     ret = stat( io_file_name.c_str() , &io_stat ) ;
 
     if ( ret == 0 ) {
         // If the force flag is true, return that the io file is out of date.
-        // Otherise test if the header is newer than the io file.
-        return ( force || (header_stat.st_mtime > io_stat.st_mtime) ) ;
+        if ( force ) {
+            return true ;
+        }
+        // Otherwise compare the cache key the io file was written with to the current one.
+        std::ifstream io_file(io_file_name.c_str()) ;
+        std::string first_line ;
+        std::getline(io_file, first_line) ;
+        if ( ! first_line.compare(0, cache_key_prefix.size(), cache_key_prefix) ) {
+            return first_line.compare(cache_key_prefix.size(), std::string::npos, cache_key) != 0 ;
+        }
+        // io files written without a cache key fall back to testing if the header is newer than the io file.
+        return header_stat.st_mtime > io_stat.st_mtime ;
     }
     return true ;
 }
 
+std::string PrintAttributes::getCacheKey(const std::string& header_file_name) {
+    // The generated code depends on the types declared in the included files too.
+    std::string key_text = cache_options + '\0' + getFileHash(header_file_name) ;
+    for ( const std::string & included : hsd.getIncludedFiles(header_file_name) ) {
+        key_text += '\0' + included + '\0' + getFileHash(included) ;
+    }
+    return contentHash(key_text) ;
+}
+
+const std::string & PrintAttributes::getFileHash(const std::string& file_name) {
+    std::map< std::string , std::string >::iterator mit = file_hashes.find(file_name) ;
+    if ( mit == file_hashes.end() ) {
+        std::string contents ;
+        readFileContents(file_name, contents) ;
+        mit = file_hashes.insert(std::make_pair(file_name, contentHash(contents))).first ;
+    }
+    return mit->second ;
+}
+
+bool PrintAttributes::isInShard(const std::string& io_file_name) {
+    if ( shard_count <= 1 ) {
+        return true ;
+    }
+    unsigned int io_file_shard = strtoull(contentHash(io_file_name).c_str(), NULL, 16) % shard_count ;
+    return io_file_shard == shard_index or ( shard_index == 0 and io_file_shard >= first_unforked_shard ) ;
+}
+
+std::string PrintAttributes::tempIOFileName(const std::string& io_file_name) {
+    return io_file_name + ".icg_tmp" ;
+}
+
 static void _mkdir(const char *dir) {
     char tmp[PATH_MAX];
     char *p = NULL;
@@ -122,7 +265,7 @@ bool PrintAttributes::openIOFile(const std::string& header_file_name) {
     if (visited_files.find(header_file_name) != visited_files.end()) {
         // We have visited this header before. If there is a valid name, append to the existing IO file.
         if (out_of_date_io_files.find(header_file_name) != out_of_date_io_files.end()) {
-            outfile.open(out_of_date_io_files[header_file_name].c_str(), std::fstream::app);
+            outfile.open(tempIOFileName(out_of_date_io_files[header_file_name]).c_str(), std::fstream::app);
             return true ;
         }
         return false;
@@ -144,8 +287,8 @@ bool PrintAttributes::openIOFile(const std::string& header_file_name) {
     _mkdir(dirname(name));
     free(name);
 
-    // no further processing is required if it's not out of date
-    if (!isIOFileOutOfDate(realPath, io_file_name)) {
+    // no further processing is required if another process writes it or it's not out of date
+    if (!isInShard(io_file_name) || !isIOFileOutOfDate(realPath, io_file_name)) {
         free(realPath);
         return false;
     }
@@ -154,9 +297,9 @@ bool PrintAttributes::openIOFile(const std::string& header_file_name) {
     // add it to the map of out of date IO files
     out_of_date_io_files[header_file_name] = io_file_name ;
 
-    // write header information
-    std::cout << color(INFO, "Writing    ") << out_of_date_io_files[header_file_name] << std::endl;
-    outfile.open(out_of_date_io_files[header_file_name].c_str());
+    // write header information to a temporary file, finishIOFiles moves it into place
+    outfile.open(tempIOFileName(io_file_name).c_str());
+    outfile << cache_key_prefix << cache_keys[io_file_name] << "\n" ;
     printer->printIOHeader(outfile, header_file_name);
     if (!cs.hasTrickHeader(header_file_name) ) {
         std::cout << bold(color(WARNING, "Warning    ") + header_file_name) << std::endl
@@ -166,6 +309,43 @@ bool PrintAttributes::openIOFile(const std::string& header_file_name) {
     return true ;
 }
 
+void PrintAttributes::finishIOFiles() {
+    std::map< std::string , std::string >::iterator mit = out_of_date_io_files.begin() ;
+    while ( mit != out_of_date_io_files.end() ) {
+        const std::string io_file_name = (*mit).second ;
+        const std::string temp_file_name = tempIOFileName(io_file_name) ;
+        std::string new_contents ;
+        std::string old_contents ;
+        struct stat io_stat ;
+        bool unchanged = false ;
+
+        // Compare the generated code following the cache key line to the existing io file.
+        readFileContents(temp_file_name, new_contents) ;
+        if ( stat(io_file_name.c_str(), &io_stat) == 0 && readFileContents(io_file_name, old_contents) ) {
+            size_t new_start = new_contents.find('\n') ;
+            size_t old_start = old_contents.find('\n') ;
+            unchanged = ( new_start != std::string::npos && old_start != std::string::npos &&
+             ! new_contents.compare(new_start, std::string::npos, old_contents, old_start, std::string::npos) ) ;
+        }
+
+        rename(temp_file_name.c_str(), io_file_name.c_str()) ;
+        if ( unchanged ) {
+            // Only the cache key changed.  Keep the old time stamp so the io file is not recompiled.
+            struct utimbuf times ;
+            times.actime = io_stat.st_atime ;
+            times.modtime = io_stat.st_mtime ;
+            utime(io_file_name.c_str(), &times) ;
+            if (verboseBuild) {
+                std::cout << skipping << "Unchanged: " << io_file_name << std::endl;
+            }
+            out_of_date_io_files.erase(mit++) ;
+        } else {
+            std::cout << color(INFO, "Writing    ") << io_file_name << std::endl;
+            ++mit ;
+        }
+    }
+}
+
 /** Determines the io_file_name based on the given header file name */
 std::string PrintAttributes::createIOFileName(std::string header_file_name) {
     std::string dir_name ;
@@ -273,7 +453,7 @@ void PrintAttributes::printEnum(EnumValues* ev) {
 }
 
 
-void PrintAttributes::printSieClass( ClassValues * cv ) {
+std::string PrintAttributes::getSieClassFileName() {
     std::string xmlFileName;
     if(sim_services_flag) {
     #ifdef EXTERNAL_BUILD
@@ -284,7 +464,37 @@ void PrintAttributes::printSieClass( ClassValues * cv ) {
     } else {
         xmlFileName = "build/classes.resource";
     }
-    std::ofstream ostream(xmlFileName, std::ofstream::app);
+    return xmlFileName;
+}
+
+std::string PrintAttributes::getSieEnumFileName() {
+    std::string xmlFileName;
+    if(sim_services_flag) {
+    #ifdef EXTERNAL_BUILD
+        xmlFileName = output_dir + "/sim_services_classes.resource";
+    #else
+        xmlFileName = std::string(getenv("TRICK_HOME")) + "/share/trick/xml/include/sim_services_classes.resource";
+    #endif
+
+    } else {
+        xmlFileName = "build/classes.resource";
+    }
+    return xmlFileName;
+}
+
+void PrintAttributes::writeResource( const std::string & xmlFileName , const std::string & text ) {
+    // Only the first shard writes the resource files, joinShards merges the text of the others.
+    if ( shard_index != 0 ) {
+        resource_buffers[xmlFileName] += text;
+        return;
+    }
+    std::ofstream resource(xmlFileName, std::ofstream::app);
+    resource << text;
+}
+
+void PrintAttributes::printSieClass( ClassValues * cv ) {
+    const std::string xmlFileName = getSieClassFileName();
+    std::ostringstream ostream;
     ostream << "  <class name=\"" << sanitize(cv->getFullyQualifiedMangledTypeName("__")) << "\">\n";
     for (FieldDescription* fdes : printer->getPrintableFields(*cv)) {
         std::string type = fdes->getFullyQualifiedMangledTypeName("__");
@@ -311,28 +521,18 @@ void PrintAttributes::printSieClass( ClassValues * cv ) {
         ostream << "    </member>\n";
     }
     ostream << "  </class>\n" << std::endl;
-    ostream.close();
+    writeResource(xmlFileName, ostream.str());
 }
 
 void PrintAttributes::printSieEnum( EnumValues * ev ) {
-    std::string xmlFileName;
-    if(sim_services_flag) {
-    #ifdef EXTERNAL_BUILD
-        xmlFileName = output_dir + "/sim_services_classes.resource";
-    #else
-        xmlFileName = std::string(getenv("TRICK_HOME")) + "/share/trick/xml/include/sim_services_classes.resource";
-    #endif
-
-    } else {
-        xmlFileName = "build/classes.resource";
-    }
-    std::ofstream ostream(xmlFileName, std::ofstream::app);
+    const std::string xmlFileName = getSieEnumFileName();
+    std::ostringstream ostream;
     ostream << "  <enumeration name=\"" << sanitize(ev->getFullyQualifiedTypeName("__")) << "\">\n";
     for(EnumValues::NameValuePair nvp : ev->getFullyQualifiedPairs()) {
         ostream << "    <pair label =\"" << nvp.first << "\" value=\"" << nvp.second << "\"/>\n";
     }
     ostream << "  </enumeration>\n" << std::endl;
-    ostream.close();
+    writeResource(xmlFileName, ostream.str());
 }
 
 void PrintAttributes::createMapFiles() {
@@ -369,22 +569,30 @@ void PrintAttributes::createMapFiles() {
 }
 
 void PrintAttributes::closeMapFiles() {
+    // The map files are only written by the first shard
+    if ( ! class_map_outfile.is_open() ) {
+        return ;
+    }
+
     printer->printClassMapFooter(class_map_outfile) ;
     class_map_outfile.close() ;
 
     printer->printEnumMapFooter(enum_map_outfile) ;
     enum_map_outfile.close() ;
 
-    // If we wrote any new io_src files, move the temporary class and enum map files to new location
-    if ( out_of_date_io_files.size() > 0 ) {
-        std::ifstream class_map(std::string(map_dir + "/.class_map.cpp").c_str()) ;
-        std::ifstream enum_map(std::string(map_dir + "/.enum_map.cpp").c_str()) ;
+    // Combine the temporary class and enum map files.  The io_src files of other shards may have changed,
+    // so the combined map is compared to the existing one instead of checking which io_src files we wrote.
+    std::string class_map ;
+    std::string enum_map ;
+    std::string existing_map ;
+    readFileContents(map_dir + "/.class_map.cpp", class_map) ;
+    readFileContents(map_dir + "/.enum_map.cpp", enum_map) ;
+    if ( ! readFileContents(map_dir + "/class_map.cpp", existing_map) || existing_map != class_map + enum_map ) {
         std::ofstream combined_map(std::string(map_dir + "/class_map.cpp").c_str()) ;
-        combined_map << class_map.rdbuf() << enum_map.rdbuf() ;
-    } else {
-        remove( std::string(map_dir + "/.class_map.cpp").c_str() ) ;
-        remove( std::string(map_dir + "/.enum_map.cpp").c_str() ) ;
+        combined_map << class_map << enum_map ;
     }
+    remove( std::string(map_dir + "/.class_map.cpp").c_str() ) ;
+    remove( std::string(map_dir + "/.enum_map.cpp").c_str() ) ;
 }
 
 // Make a list of the empty files we processed.
@@ -425,11 +633,14 @@ void PrintAttributes::printIOMakefile() {
     std::ofstream ICG_processed ;
     std::ofstream ext_lib ;
 
-    // Don't create a makefile if we didn't process any files.
-    if ( out_of_date_io_files.empty() ) {
+    // The makefiles list the io_src files of all shards, only the first shard writes them.
+    if ( shard_index != 0 ) {
        return ;
     }
 
+    // The makefiles are written even if no io_src file changed.  io_src files are only rewritten when
+    // their cache key changes, so the new makefile time stamp is what tells make that ICG is up to date.
+
     std::cout << color(INFO, "Writing") << "    Makefile_io_src" << std::endl ;
 
     makefile_io_src.open("build/Makefile_io_src") ;
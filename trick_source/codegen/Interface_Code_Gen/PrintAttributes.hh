@@ -8,6 +8,7 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <sys/types.h>
 #include "Utilities.hh"
 
 namespace clang {
@@ -42,6 +43,22 @@ class PrintAttributes {
         /** Adds construct names to ignore from TRICK_ICG_IGNORE_TYPES environment variable */
         void addIgnoreTypes() ;
 
+        /** Sets the ICG version and options that are part of the cache key of every io_src file */
+        void setCacheOptions( const std::string & options ) ;
+
+        /** Sets the number of processes writing io_src files */
+        void setJobs( unsigned int jobs ) ;
+
+        /** Forks the processes writing the io_src files of the other shards, called after parsing */
+        void startShards() ;
+
+        /** In a forked process exits after saving its XML resources.  In the first process waits
+            for the other shards and merges their XML resources.  Returns false if a shard failed. */
+        bool joinShards() ;
+
+        /** Moves the io_src files written during this run into place, leaving unchanged files untouched */
+        virtual void finishIOFiles() ;
+
         /** Prints all of the processed classes and enumerations */
         virtual void createMapFiles() ;
         virtual void closeMapFiles() ;
@@ -105,8 +122,49 @@ class PrintAttributes {
         /** We are specifying an output directory for all files */
         std::string output_dir ;
 
+        /** ICG version and options included in the cache key of every io_src file */
+        std::string cache_options ;
+
+        /** This process writes the io_src files of shard shard_index of shard_count */
+        unsigned int shard_index ;
+        unsigned int shard_count ;
+
+        /** Process ids of the forked shards, in shard order */
+        std::vector< pid_t > shard_pids ;
+
+        /** The first process also writes the shards from first_unforked_shard on if they could not be forked */
+        unsigned int first_unforked_shard ;
+
+        /** XML resource text of a forked shard keyed by resource file, merged by the first shard */
+        std::map< std::string , std::string > resource_buffers ;
+
+        /** map of file names to the hash of their contents */
+        std::map< std::string , std::string > file_hashes ;
+
         bool openIOFile(const std::string& header_file_name) ;
 
+        /** Returns the cache key of an io_src file: a hash of the cache options and the contents of
+            the header and of every file it includes */
+        std::string getCacheKey(const std::string& header_file_name) ;
+
+        /** Returns the hash of the contents of a file, computed once per file */
+        const std::string & getFileHash(const std::string& file_name) ;
+
+        /** Returns the XML resource file classes are written to */
+        std::string getSieClassFileName() ;
+
+        /** Returns the XML resource file enumerations are written to */
+        std::string getSieEnumFileName() ;
+
+        /** Appends text to an XML resource file, a forked shard buffers it for the first shard */
+        void writeResource(const std::string& xml_file_name, const std::string& text) ;
+
+        /** Returns true if the io_src file belongs to the shard written by this process */
+        bool isInShard(const std::string& io_file_name) ;
+
+        /** Returns the name of the temporary file an io_src file is written to */
+        std::string tempIOFileName(const std::string& io_file_name) ;
+
         bool isIOFileOutOfDate(std::string header_file_name, std::string io_file_name ) ;
         bool hasBeenProcessed(EnumValues& enumValues);
         bool hasBeenProcessed(ClassValues& classValues);
@@ -133,6 +191,9 @@ class PrintAttributes {
         /** map of open files to the out of date io_src file */
         std::map< std::string , std::string > out_of_date_io_files ;
 
+        /** map of io_src files to their cache keys */
+        std::map< std::string , std::string > cache_keys ;
+
         /** List of files that have ICG: No */
         std::vector< std::string > icg_no_files ;
 
@@ -239,9 +239,14 @@ void PrintFileContents10::print_io_src_sizeof( std::ostream & ostream , ClassVal
     ostream << "    return sizeof(" << cv->getFullyQualifiedNameIfEqual() << ") ;\n}\n\n" ;
 }
 
+/** Returns true if an io_src_allocate function is printed for the class */
+bool PrintFileContents10::has_io_src_allocate( ClassValues * cv ) {
+    return cv->isPOD() or ( !cv->isAbstract() and cv->getHasDefaultConstructor()) ;
+}
+
 /** Prints the io_src_allocate function */
 void PrintFileContents10::print_io_src_allocate( std::ostream & ostream , ClassValues * cv ) {
-    if ( cv->isPOD() or ( !cv->isAbstract() and cv->getHasDefaultConstructor()) ) {
+    if ( has_io_src_allocate(cv) ) {
         const std::string name = cv->getFullyQualifiedNameIfEqual();
         ostream << "void* io_src_allocate_" << cv->getFullyQualifiedMangledTypeName("__") <<  "(int num) {\n" ;
         ostream << "    " << name << "* temp = (" << name << "*)calloc(num, sizeof(" << name << "));\n" ;
@@ -371,9 +376,15 @@ void PrintFileContents10::printClassMapHeader( std::ostream & ostream , std::str
 "#include <string>\n\n"
 "#include \"trick/AttributesMap.hh\"\n"
 "#include \"trick/EnumAttributesMap.hh\"\n"
+"#include \"trick/IOSrcTypeRegistry.hh\"\n"
 "#include \"trick/attributes.h\"\n\n"
+"static void " << function_name << "_io_src_types() ;\n\n"
 "void " << function_name << "() {\n\n"
-"    Trick::AttributesMap * class_attribute_map = Trick::AttributesMap::attributes_map();\n\n" ;
+"    Trick::AttributesMap * class_attribute_map = Trick::AttributesMap::attributes_map();\n\n"
+"    " << function_name << "_io_src_types() ;\n\n" ;
+     class_registry_function_name = function_name + "_io_src_types" ;
+     class_registry_decls.str("") ;
+     class_registry_stmts.str("") ;
 }
 
 void PrintFileContents10::printClassMap( std::ostream & ostream , ClassValues * cv ) {
@@ -381,25 +392,70 @@ void PrintFileContents10::printClassMap( std::ostream & ostream , ClassValues *
     ostream << "    // " << cv->getFileName() << std::endl
             << "    extern ATTRIBUTES  attr" << name << "[] ;" << std::endl
             << "    class_attribute_map->add_attr(\"" << cv->getFullyQualifiedMangledTypeName() << "\" , attr" << name << ") ;" << std::endl ;
+
+    // The io_src code of the class is registered in a separate function printed by the footer,
+    // because the C linkage function declarations it needs cannot appear inside a function.
+    class_registry_decls << "void init_attr" << name << "_c_intf() ;\n"
+                         << "size_t io_src_sizeof_" << name << "() ;\n" ;
+    class_registry_stmts << "    extern ATTRIBUTES attr" << name << "[] ;\n"
+                         << "    io_src_type_registry->add_class(\"" << name << "\" , io_src_sizeof_" << name
+                         << " , attr" << name << " , init_attr" << name << "_c_intf , " ;
+    if ( has_io_src_allocate(cv) ) {
+        class_registry_decls << "void* io_src_allocate_" << name << "(int num) ;\n" ;
+        class_registry_stmts << "io_src_allocate_" << name << " , " ;
+    } else {
+        class_registry_stmts << "NULL , " ;
+    }
+    if ( cv->getHasPublicDestructor() ) {
+        class_registry_decls << "void io_src_destruct_" << name << "(void* address, int num) ;\n"
+                             << "void io_src_delete_" << name << "(void* address) ;\n" ;
+        class_registry_stmts << "io_src_destruct_" << name << " , io_src_delete_" << name << ") ;\n" ;
+    } else {
+        class_registry_stmts << "NULL , NULL) ;\n" ;
+    }
 }
 
 void PrintFileContents10::printClassMapFooter( std::ostream & ostream ) {
      ostream << "}" << std::endl << std::endl ;
+     print_registry_function(ostream, class_registry_function_name, class_registry_decls, class_registry_stmts) ;
+}
+
+/** Prints the C linkage declarations and the function that adds the io_src code to the IOSrcTypeRegistry */
+void PrintFileContents10::print_registry_function( std::ostream & ostream , std::string function_name ,
+ std::ostringstream & decls , std::ostringstream & stmts ) {
+     print_open_extern_c(ostream) ;
+     ostream << decls.str() ;
+     print_close_extern_c(ostream) ;
+     ostream << "static void " << function_name << "() {\n\n"
+             << "    Trick::IOSrcTypeRegistry * io_src_type_registry __attribute__((unused)) = Trick::IOSrcTypeRegistry::registry();\n\n"
+             << stmts.str()
+             << "}" << std::endl << std::endl ;
 }
 
 void PrintFileContents10::printEnumMapHeader( std::ostream & ostream , std::string function_name ) {
-     ostream << "void " << function_name << "() {\n"
-             << "    Trick::EnumAttributesMap* enum_attribute_map __attribute__((unused)) = Trick::EnumAttributesMap::attributes_map();\n\n" ;
+     ostream << "static void " << function_name << "_io_src_types() ;\n\n"
+             << "void " << function_name << "() {\n"
+             << "    Trick::EnumAttributesMap* enum_attribute_map __attribute__((unused)) = Trick::EnumAttributesMap::attributes_map();\n\n"
+             << "    " << function_name << "_io_src_types() ;\n\n" ;
+     enum_registry_function_name = function_name + "_io_src_types" ;
+     enum_registry_decls.str("") ;
+     enum_registry_stmts.str("") ;
 }
 
 void PrintFileContents10::printEnumMap( std::ostream & ostream , EnumValues * ev ) {
     std::string name = ev->getFullyQualifiedTypeName("__");
     ostream << "    extern ENUM_ATTR enum" << name << "[];" << std::endl
             << "    enum_attribute_map->add_attr(\"" << ev->getFullyQualifiedTypeName() << "\", enum" << name << ");" << std::endl ;
+
+    enum_registry_decls << "size_t io_src_sizeof_" << ev->getFullyQualifiedName("__") << "( void ) ;\n" ;
+    enum_registry_stmts << "    extern ENUM_ATTR enum" << name << "[] ;\n"
+                        << "    io_src_type_registry->add_enum(\"" << name << "\" , io_src_sizeof_"
+                        << ev->getFullyQualifiedName("__") << " , enum" << name << ") ;\n" ;
 }
 
 void PrintFileContents10::printEnumMapFooter( std::ostream & ostream ) {
      ostream << "}" << std::endl << std::endl ;
+     print_registry_function(ostream, enum_registry_function_name, enum_registry_decls, enum_registry_stmts) ;
 }
 
 void PrintFileContents10::printStlFunction(const std::string& name, const std::string& parameters, const std::string& call, std::ostream& ostream, FieldDescription& fieldDescription, ClassValues& classValues) {
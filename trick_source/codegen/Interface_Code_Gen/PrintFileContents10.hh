@@ -7,6 +7,7 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <sstream>
 
 #include "PrintFileContentsBase.hh"
 
@@ -77,6 +78,9 @@ class PrintFileContents10 : public PrintFileContentsBase {
         /** Prints the io_src_sizeof function */
         void print_io_src_sizeof(std::ostream & outfile , ClassValues * cv ) ;
 
+        /** Returns true if an io_src_allocate function is printed for the class */
+        bool has_io_src_allocate(ClassValues * cv ) ;
+
         /** Prints the io_src_allocate function */
         void print_io_src_allocate(std::ostream & outfile , ClassValues * cv ) ;
 
@@ -102,6 +106,20 @@ class PrintFileContents10 : public PrintFileContentsBase {
         void print_clear_stl(std::ostream & outfile , FieldDescription * fdes , ClassValues * in_class) ;
 
         void printStlFunction(const std::string& name, const std::string& parameters, const std::string& call, std::ostream& ostream, FieldDescription& fieldDescription, ClassValues& classValues);
+
+        /** Prints the function that adds the io_src code of the mapped types to the IOSrcTypeRegistry */
+        void print_registry_function(std::ostream & outfile , std::string function_name ,
+         std::ostringstream & decls , std::ostringstream & stmts ) ;
+
+        /** IOSrcTypeRegistry function name, C linkage declarations and statements for the class map */
+        std::string class_registry_function_name ;
+        std::ostringstream class_registry_decls ;
+        std::ostringstream class_registry_stmts ;
+
+        /** IOSrcTypeRegistry function name, C linkage declarations and statements for the enum map */
+        std::string enum_registry_function_name ;
+        std::ostringstream enum_registry_decls ;
+        std::ostringstream enum_registry_stmts ;
 } ;
 
 #endif
@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include <sstream>
 #include <cstring>
+#include <fstream>
 
 #include "Utilities.hh"
 
@@ -229,3 +230,27 @@ int gccVersionToIntOrDefault(const char* verno, int def) {
     }
     return result;
 }
+
+// Reads the whole file into contents.  Returns false if the file cannot be read.
+bool readFileContents(const std::string& file_name, std::string& contents) {
+    std::ifstream infile(file_name.c_str(), std::ios::in | std::ios::binary);
+    if (!infile) {
+        return false;
+    }
+    std::ostringstream oss;
+    oss << infile.rdbuf();
+    contents = oss.str();
+    return true;
+}
+
+// Returns the 64 bit FNV-1a hash of text as 16 hexadecimal characters.
+std::string contentHash(const std::string& text) {
+    unsigned long long hash = 14695981039346656037ULL;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    char buf[17];
+    snprintf(buf, sizeof(buf), "%016llx", hash);
+    return std::string(buf);
+}
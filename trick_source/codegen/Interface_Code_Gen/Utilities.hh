@@ -29,5 +29,7 @@ std::string underline(const std::string& text, unsigned length);
 std::string quote(const std::string& text);
 std::string & replace_special_chars( std::string & str);
 int gccVersionToIntOrDefault(const char* verno, int def);
+bool readFileContents(const std::string& file_name, std::string& contents);
+std::string contentHash(const std::string& text);
 
 #endif
@@ -56,6 +56,37 @@ llvm::cl::opt<bool> global_compat15("c", llvm::cl::desc("Print the offsetof calc
 llvm::cl::opt<llvm::cl::boolOrDefault> print_trick_icg("print-TRICK-ICG", llvm::cl::desc("Print warnings where TRICK_ICG may cause io_src inconsistencies")) ;
 llvm::cl::alias compat15_alias ("compat15" , llvm::cl::desc("Alias for -c") , llvm::cl::aliasopt(global_compat15)) ;
 llvm::cl::opt<bool> m32("m32", llvm::cl::desc("Generate io code for use with 32bit mode"), llvm::cl::init(false), llvm::cl::ZeroOrMore) ;
+llvm::cl::opt<unsigned> jobs("j", llvm::cl::desc("Number of processes writing io_src files after the header is parsed"), llvm::cl::init(1), llvm::cl::ZeroOrMore) ;
+
+/**
+Returns the ICG version and the options that change the generated code.  These are part
+of the cache key of every io_src file so changing any of them regenerates the io_src files.
+*/
+std::string get_cache_options() {
+    std::ostringstream oss ;
+    oss << TRICK_VERSION << " -v" << attr_version << " -icg-std=" << standard_version
+        << " -m32=" << m32 << " -c=" << global_compat15 << " -sim_services=" << sim_services_flag << " -o=" << output_dir ;
+    for ( const std::string & dir : include_dirs ) {
+        oss << " -I" << dir ;
+    }
+    for ( const std::string & dir : isystem_dirs ) {
+        oss << " -isystem" << dir ;
+    }
+    for ( const std::string & define : defines ) {
+        oss << " -D" << define ;
+    }
+    for ( const std::string & option : f_options ) {
+        oss << " -f" << option ;
+    }
+    for ( const std::string & header : pre_compiled_headers ) {
+        oss << " -include" << header ;
+    }
+    for ( const char * env_var : { "TRICK_ICG_IGNORE_TYPES" , "TRICK_ICG_COMPAT15" , "TRICK_ICG_NOCOMMENT" } ) {
+        const char * value = getenv(env_var) ;
+        oss << " " << env_var << "=" << ( value ? value : "" ) ;
+    }
+    return oss.str() ;
+}
 
 
 void set_lang_opts(clang::CompilerInstance & ci) {
@@ -279,6 +310,8 @@ int main(int argc, char * argv[]) {
     PrintAttributes printAttributes(attr_version, hsd, cs, ci, force, sim_services_flag, output_dir);
 
     printAttributes.addIgnoreTypes() ;
+    printAttributes.setCacheOptions(get_cache_options()) ;
+    printAttributes.setJobs(jobs) ;
     // Create new class and enum map files
     if (create_map) {
         printAttributes.createMapFiles();
@@ -330,6 +363,15 @@ int main(int argc, char * argv[]) {
     clang::ParseAST(ci.getSema());
     ci.getDiagnosticClient().EndSourceFile();
 
+    // Move the io_src files into place, leaving those whose generated code did not change untouched.
+    printAttributes.finishIOFiles();
+
+    // Forked shards exit here.  Wait for them before writing the makefiles that list all io_src files.
+    if (!printAttributes.joinShards()) {
+        std::cout << color(ERROR, "Trick build was terminated due to an error writing io_src files!") << std::endl;
+        exit(-1);
+    }
+
     if (!sim_services_flag) {
         printAttributes.printIOMakefile();
     }
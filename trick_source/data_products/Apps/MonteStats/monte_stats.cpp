@@ -0,0 +1,159 @@
+#include <vector>
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <string.h>
+#include <stdlib.h>
+#include "Log/MonteStats.hh"
+
+static const char *usage_doc[] = {
+"----------------------------------------------------------------------------",
+" trick-montestats -                                                         ",
+"                                                                            ",
+" USAGE:  trick-montestats [options] -var <name> [-var <name> ...] <dirs>    ",
+"                                                                            ",
+" Reads the variables from every RUN directory in lockstep and writes the   ",
+" count, mean, standard deviation, minimum, maximum and quantiles of each   ",
+" variable across the runs, per time bin, to a Trick binary log. A MONTE_   ",
+" directory stands for all of the RUN_ directories in it.                   ",
+"                                                                            ",
+" Options:                                                                   ",
+"     -help                Print this message and exit.                      ",
+"     -var <name>          A variable to compute statistics of.              ",
+"     -o <file_name>       The log to write (default log_envelope.trk).      ",
+"     -bin <seconds>       Width of the time bins. By default every logged   ",
+"                          time stamp is a bin.                              ",
+"     -quantiles <q,q,..>  Quantiles in [0,1] to write (default 0.05,0.5,0.95)",
+"     -compression <c>     t-digest compression (default 100). Larger values ",
+"                          give more accurate quantiles.                     ",
+"                                                                            ",
+"----------------------------------------------------------------------------"};
+#define N_USAGE_LINES (sizeof(usage_doc)/sizeof(usage_doc[0]))
+
+void print_doc(char *doc[], int nlines) {
+    int i;
+    for (i=0; i < nlines; i++) {
+        cerr << doc[i] << '\n';
+    }
+    cerr.flush();
+}
+
+void usage() {
+    print_doc((char **)usage_doc,N_USAGE_LINES);
+}
+
+/* Adds dir, or the RUN_ directories in it if it is a MONTE_ directory */
+int add_runs(MonteStats & monte_stats, const string & dir) {
+
+    DIR *dirp;
+    struct dirent *dp;
+    struct stat st;
+    vector <string> runs;
+    string base = dir.substr(dir.find_last_of('/', dir.size() - 2) + 1);
+
+    if (base.compare(0, 6, "MONTE_") != 0) {
+        monte_stats.addRun(dir.c_str());
+        return 1;
+    }
+
+    if ((dirp = opendir(dir.c_str())) == NULL) {
+        cerr << "Couldn't open \"" << dir << "\" for reading.\n";
+        return 0;
+    }
+    while ((dp = readdir(dirp)) != NULL) {
+        string run = dir + "/" + dp->d_name;
+        if (!strncmp(dp->d_name, "RUN_", 4) && stat(run.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+            runs.push_back(run);
+        }
+    }
+    closedir(dirp);
+
+    // The same runs in the same order every time
+    sort(runs.begin(), runs.end());
+    for (unsigned int i = 0; i < runs.size(); i++) {
+        monte_stats.addRun(runs[i].c_str());
+    }
+    return (int)runs.size();
+}
+
+int main(int argc, char* argv[])
+{
+    MonteStats monte_stats;
+    string out_file_name("log_envelope.trk");
+    int num_vars = 0;
+    int num_runs = 0;
+    char *prog_name = argv[0];
+    long num_records;
+
+    if (argc <= 1 ) {
+        cerr << prog_name << ": No arguments were supplied.\n";
+        cerr.flush();
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    int i = 1;
+    string option;
+    while ( i < argc ) {
+        option = argv[i++];
+
+        if (option == "-help") {
+            usage();
+            exit(EXIT_SUCCESS);
+        } else if (option[0] == '-' && i >= argc) {
+            cerr << "\"" << option.c_str() << "\" needs a value.\n";
+            cerr.flush();
+            usage();
+            exit(EXIT_FAILURE);
+        } else if (option == "-var") {
+            monte_stats.addVariable(argv[i++]);
+            num_vars++;
+        } else if (option == "-o") {
+            out_file_name = argv[i++];
+        } else if (option == "-bin") {
+            monte_stats.setBinWidth(strtod(argv[i++], NULL));
+        } else if (option == "-compression") {
+            monte_stats.setCompression(strtod(argv[i++], NULL));
+        } else if (option == "-quantiles") {
+            vector <double> quantiles;
+            char *list = strdup(argv[i++]);
+            for (char *tok = strtok(list, ","); tok != NULL; tok = strtok(NULL, ",")) {
+                double q = strtod(tok, NULL);
+                if (q < 0.0 || q > 1.0) {
+                    cerr << "Quantile " << tok << " is not in [0,1].\n";
+                    cerr.flush();
+                    exit(EXIT_FAILURE);
+                }
+                quantiles.push_back(q);
+            }
+            free(list);
+            monte_stats.setQuantiles(quantiles);
+        } else if (option[0] == '-') {
+            cerr << "\"" << option.c_str() << "\" is not a valid option.\n";
+            cerr.flush();
+            usage();
+            exit(EXIT_FAILURE);
+        } else {
+            num_runs += add_runs(monte_stats, option);
+        }
+    }
+
+    if (num_vars == 0 || num_runs == 0) {
+        cerr << prog_name << ": At least one -var and one RUN directory are needed.\n";
+        cerr.flush();
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    if ((num_records = monte_stats.write(out_file_name.c_str())) < 0) {
+        exit(EXIT_FAILURE);
+    }
+
+    cerr << "Wrote " << num_records << " records of statistics across " << num_runs
+         << " runs to " << out_file_name << "\n";
+    cerr.flush();
+
+    return 0;
+}
@@ -2,6 +2,7 @@
 #include <vector>
 #include <iostream>
 #include "Log/TrickBinary.hh"
+#include "Log/TrickBinaryLog.hh"
 #include <string.h>
 #include <stdlib.h>
 
@@ -20,6 +21,9 @@ static const char *usage_doc[] = {
 "     -xml                 Generates an extensible markup language (XML)     ",
 "                          file from a Trick binary data file. XML files may ",
 "                          be used for sharing data between NExIOM devices.  ",
+"     -columns             Writes the columnar sidecar (<trk_file_name>.col) ",
+"                          of a Trick binary data file and exits. Plotting  ",
+"                          tools read the sidecar instead of the log.        ",
 "     delimiter=\"<_delimit_string_>\"                                         ",
 "                          Change the default delimiter used in 'csv' & 'fix'",
 "                          ascii formats from comma separated \",\" to another ",
@@ -50,7 +54,7 @@ int main(int argc, char* argv[])
     int number_of_parameters;
     char ** param_names;
     char ** param_units;
-    enum {CSV, FIX, XML};
+    enum {CSV, FIX, XML, COLUMNS};
     int Format=0;  /* default to csv */
     string delimiter(",");  /* default delimter */
 
@@ -93,6 +97,8 @@ int main(int argc, char* argv[])
                 if (i<argc  &&  (next_option.find(".trk") == string::npos)) {
                     ascii_file_name = argv[i++];
                 }
+            } else if (option == "-columns") {
+                Format = COLUMNS;
             } else if (option.find(".trk") != string::npos) {
                 trk_file_name = strdup( option.c_str() );
             } else if (option.find("delim") != string::npos) {
@@ -116,6 +122,23 @@ int main(int argc, char* argv[])
         exit(EXIT_FAILURE);
     }
 
+    if (Format == COLUMNS) {
+        TrickBinaryLog * log = TrickBinaryLog::open(trk_file_name);
+        if (log == NULL) {
+            cerr << "Couldn't read \"" << trk_file_name << "\" as a Trick binary data file\n";
+            cerr.flush();
+            exit(EXIT_FAILURE);
+        }
+        if (log->writeColumns() != 0) {
+            cerr << "Couldn't write the columns of \"" << trk_file_name << "\"\n";
+            cerr.flush();
+            TrickBinaryLog::close(log);
+            exit(EXIT_FAILURE);
+        }
+        TrickBinaryLog::close(log);
+        exit(EXIT_SUCCESS);
+    }
+
     if (ascii_file_name != NULL) {
         if (( fp = fopen(ascii_file_name, "w") ) == 0) {
             cerr << "Couldn't open \" << ascii_file_name << \" for writing\n";
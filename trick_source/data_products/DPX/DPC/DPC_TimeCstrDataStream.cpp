@@ -14,6 +14,8 @@
 
 #include "DPC/DPC_TimeCstrDataStream.hh"
 
+#define DPC_TIMECSTR_BLOCK_SIZE 1024
+
 // CONSTRUCTOR
 DPC_TimeCstrDataStream::DPC_TimeCstrDataStream(DataStream* in_ds,
                            DPM_time_constraints *time_constraints ) {
@@ -22,6 +24,10 @@ DPC_TimeCstrDataStream::DPC_TimeCstrDataStream(DataStream* in_ds,
   this->period = time_constraints->getPeriod();
 
   this->ds = in_ds;
+  this->blk_time.resize(DPC_TIMECSTR_BLOCK_SIZE);
+  this->blk_value.resize(DPC_TIMECSTR_BLOCK_SIZE);
+  this->blk_ix = 0;
+  this->blk_n = 0;
   this->bix = 0;
   this->eos[0] = 0;
   this->eos[1] = 0;
@@ -74,12 +80,23 @@ std::string DPC_TimeCstrDataStream::getTimeUnit() {
 
 // MEMBER FUNCTION
 void DPC_TimeCstrDataStream::begin() {
+  seekTime(tstart);
+}
+
+// MEMBER FUNCTION
+int DPC_TimeCstrDataStream::seekTime(double timestamp) {
+
+  int ret;
 
   bix = 0;
   eos[0] = 0;
   eos[1] = 0;
-  ds->begin();
+  blk_ix = 0;
+  blk_n = 0;
+  // Skip the values before tstart without reading them if the source can seek
+  ret = ds->seekTime((timestamp > tstart) ? timestamp : tstart);
   step();
+  return (ret);
 }
 
 // MEMBER FUNCTION
@@ -93,7 +110,7 @@ int DPC_TimeCstrDataStream::step() {
 
   if (eos[!bix]) return (0);
   do {
-    if (! ds->get(&time[bix], &value[bix])) {
+    if (! next(&time[bix], &value[bix])) {
       eos[bix] = 1;
     }
     // times in log file may not be sequential
@@ -101,3 +118,17 @@ int DPC_TimeCstrDataStream::step() {
   bix = !bix;
   return (1);
 }
+
+// MEMBER FUNCTION
+int DPC_TimeCstrDataStream::next(double* timestamp, double* paramValue) {
+
+  if (blk_ix == blk_n) {
+    blk_ix = 0;
+    blk_n = ds->getBlock(&blk_time[0], &blk_value[0], DPC_TIMECSTR_BLOCK_SIZE);
+    if (blk_n == 0) return (0);
+  }
+  *timestamp = blk_time[blk_ix];
+  *paramValue = blk_value[blk_ix];
+  blk_ix++;
+  return (1);
+}
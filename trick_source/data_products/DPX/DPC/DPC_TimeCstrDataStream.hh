@@ -4,6 +4,7 @@
 #include <iostream> // FOR DEBUGGING
 
 #include <string>
+#include <vector>
 #include "DPM/DPM_time_constraints.hh"
 #include "../Log/DataStream.hh"
 
@@ -71,6 +72,13 @@ public:
    */
   void begin();
 
+  /**
+   * Set the DataStream to read from the first value at or after timestamp
+   * and tstart.
+   * @return 1 if the source DataStream seeked, 0 if it began at the beginning.
+   */
+  int seekTime(double timestamp);
+
   /**
    * Test for the end of the DataStream.
    * @return 1 if the end of the DataStream has been reached, 0 otherwise.
@@ -85,6 +93,13 @@ public:
 
 private:
 
+  /**
+   * Get the next time/value pair from the source DataStream. Pairs are
+   * read from the source a block at a time.
+   * @return 1 if a time/value pair was returned, 0 otherwise.
+   */
+  int next(double* timestamp, double* paramValue);
+
   DataStream *ds;
   double tstart;
   double tstop;
@@ -93,6 +108,10 @@ private:
   int eos[2];
   double time[2];
   double value[2];
+  std::vector<double> blk_time;
+  std::vector<double> blk_value;
+  int blk_ix;
+  int blk_n;
 };
 
 #endif
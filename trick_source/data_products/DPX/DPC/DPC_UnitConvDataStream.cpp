@@ -2,6 +2,7 @@
 #include <string.h>
 #include <udunits2.h>
 #include "DPC/DPC_UnitConvDataStream.hh"
+#include "DPC/DPC_curve_loader.hh"
 
 extern ut_system * u_system ;
 
@@ -11,6 +12,7 @@ DPC_UnitConvDataStream::DPC_UnitConvDataStream(DataStream* ds, const char *ToUni
 
     ut_unit * to = NULL ;
     ut_unit * from = NULL ;
+    DPC_units_lock units_lock ;
     
     std::string recorded_units = ds->getUnit();
 
@@ -123,6 +125,20 @@ int DPC_UnitConvDataStream::peek(double* timestamp, double* paramValue) {
     }
 }
 
+// MEMBER FUNCTION
+int DPC_UnitConvDataStream::getBlock(double* timestamps, double* paramValues, int max) {
+    int num ;
+
+    num = source_ds->getBlock(timestamps, paramValues, max) ;
+    cv_convert_doubles(cf, paramValues, (size_t)num, paramValues) ;
+    return num ;
+}
+
+// MEMBER FUNCTION
+int DPC_UnitConvDataStream::seekTime(double timestamp) {
+    return( source_ds->seekTime(timestamp));
+}
+
 // MEMBER FUNCTION
 std::string DPC_UnitConvDataStream::getFileName() {
     return( source_ds->getFileName());
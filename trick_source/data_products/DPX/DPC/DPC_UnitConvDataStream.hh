@@ -55,6 +55,18 @@ public:
      */
     int peek(double* timestamp, double* paramValue);
 
+    /**
+     * Get up to max timestamp/value pairs, converting the values as a block.
+     * @return the number of time/value pairs returned.
+     */
+    int getBlock(double* timestamps, double* paramValues, int max);
+
+    /**
+     * Position the source DataStream at the first value at or after timestamp.
+     * @return 1 if the source DataStream seeked, 0 if it began at the beginning.
+     */
+    int seekTime(double timestamp);
+
     /**
      * Return the name of the file from which the data is being streamed.
      */
@@ -0,0 +1,136 @@
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <iostream>
+#include "DPC/DPC_curve_loader.hh"
+#include "DPC/DPC_std_curve.hh"
+
+pthread_mutex_t DPC_units_lock::mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// CONSTRUCTOR
+DPC_units_lock::DPC_units_lock() {
+    pthread_mutex_lock(&mutex);
+}
+
+// DESTRUCTOR
+DPC_units_lock::~DPC_units_lock() {
+    pthread_mutex_unlock(&mutex);
+}
+
+// CONSTRUCTOR
+DPC_curve_loader::DPC_curve_loader( DPC_datastream_supplier *DS_Supplier,
+                                    DPM_time_constraints    *Time_constraints ) {
+
+    ds_supplier = DS_Supplier;
+    time_constraints = Time_constraints;
+    next_job = 0;
+}
+
+// MEMBER FUNCTION
+void DPC_curve_loader::add( DPM_curve *Curve_spec, DPM_run *Run ) {
+
+    Job job;
+    job.curve_spec = Curve_spec;
+    job.run = Run;
+    job.curve = NULL;
+    jobs.push_back(job);
+}
+
+// MEMBER FUNCTION
+unsigned int DPC_curve_loader::getMaxThreads() {
+
+    const char *env = getenv("TRICK_DP_THREADS");
+    long n_threads = 0;
+
+    if (env != NULL) {
+        n_threads = strtol(env, NULL, 10);
+    } else {
+        n_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (n_threads < 1) {
+        n_threads = 1;
+    }
+    return ((unsigned int)n_threads);
+}
+
+// MEMBER FUNCTION
+std::vector <DPC_curve *> DPC_curve_loader::load() {
+
+    std::vector <pthread_t> threads;
+    std::vector <DPC_curve *> curves;
+    unsigned int n_threads, i;
+
+    n_threads = getMaxThreads();
+    if (n_threads > jobs.size()) {
+        n_threads = (unsigned int)jobs.size();
+    }
+
+    next_job = 0;
+    pthread_mutex_init(&job_mutex, NULL);
+
+    // The calling thread is one of the workers.
+    for (i = 1 ; i < n_threads ; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, worker, this) == 0) {
+            threads.push_back(thread);
+        }
+    }
+    worker(this);
+    for (i = 0 ; i < threads.size() ; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&job_mutex);
+
+    // Report errors in the order the curves were added, regardless of
+    // which thread built them.
+    for (i = 0 ; i < jobs.size() ; i++) {
+        if (!jobs[i].error.empty()) {
+            std::cerr << jobs[i].error << std::endl;
+        }
+        curves.push_back(jobs[i].curve);
+    }
+    jobs.clear();
+
+    return (curves);
+}
+
+// MEMBER FUNCTION
+void *DPC_curve_loader::worker( void *arg ) {
+
+    DPC_curve_loader *loader = (DPC_curve_loader *)arg;
+    size_t job_ix;
+
+    while (1) {
+        pthread_mutex_lock(&loader->job_mutex);
+        job_ix = loader->next_job++;
+        pthread_mutex_unlock(&loader->job_mutex);
+
+        if (job_ix >= loader->jobs.size()) {
+            break;
+        }
+        loader->build(&loader->jobs[job_ix]);
+    }
+    return (NULL);
+}
+
+// MEMBER FUNCTION
+void DPC_curve_loader::build( Job *job ) {
+
+    DPC_std_curve *curve;
+
+    try {
+        curve = new DPC_std_curve( job->curve_spec,
+                                   job->run,
+                                   ds_supplier,
+                                   time_constraints );
+    } catch (const std::logic_error& error) {
+        job->error = error.what();
+        return;
+    }
+
+    // Read the points of the curve on this thread. The renderer gets them
+    // from memory.
+    curve->buffer();
+    job->curve = curve;
+}
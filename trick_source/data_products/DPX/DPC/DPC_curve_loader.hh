@@ -0,0 +1,92 @@
+
+#ifndef DPC_CURVE_LOADER_HH
+#define DPC_CURVE_LOADER_HH
+
+#include <pthread.h>
+#include <string>
+#include <vector>
+#include "DPM/DPM_run.hh"
+#include "DPM/DPM_curve.hh"
+#include "DPM/DPM_time_constraints.hh"
+#include "DPC/DPC_curve.hh"
+#include "DPC/DPC_datastream_supplier.hh"
+
+/**
+ * This class builds the curves of a plot concurrently.
+ *
+ * Curves are queued with add() and built by load() on a bounded pool of
+ * threads. Each thread opens the DataStreams of a curve and reads all of
+ * its points into memory (see DPC_std_curve::buffer), so rendering the
+ * curve does not read the log files again. Logs shared by several curves are opened once (see
+ * TrickBinaryLog). load() returns the curves in the order they were added,
+ * so the result does not depend on the number of threads.
+ *
+ * The number of threads is the number of processors, or the value of the
+ * TRICK_DP_THREADS environment variable if it is set.
+ */
+class DPC_curve_loader {
+
+public:
+
+    /**
+     * Constructor.
+     */
+    DPC_curve_loader( DPC_datastream_supplier *DS_Supplier,
+                      DPM_time_constraints    *Time_constraints );
+
+    /**
+     * Destructor.
+     */
+    ~DPC_curve_loader() {}
+
+    /**
+     * Queue the curve of the given specification for the given RUN.
+     */
+    void add( DPM_curve *Curve_spec, DPM_run *Run );
+
+    /**
+     * Build all of the queued curves.
+     * @return the curves in the order they were added. The entry of a curve
+     * that could not be built is NULL, and the reason is printed to std::cerr.
+     */
+    std::vector <DPC_curve *> load();
+
+    /**
+     * Return the number of threads load() uses at most.
+     */
+    static unsigned int getMaxThreads();
+
+private:
+
+    struct Job {
+        DPM_curve *curve_spec;
+        DPM_run   *run;
+        DPC_curve *curve;
+        std::string error;
+    };
+
+    static void *worker( void *arg );
+    void build( Job *job );
+
+    DPC_datastream_supplier *ds_supplier;
+    DPM_time_constraints *time_constraints;
+    std::vector <Job> jobs;
+    size_t next_job;
+    pthread_mutex_t job_mutex;
+};
+
+/**
+ * The udunits2 library is not thread safe. Any code that may run on a
+ * DPC_curve_loader thread holds one of these while it calls into udunits2.
+ */
+class DPC_units_lock {
+
+public:
+    DPC_units_lock();
+    ~DPC_units_lock();
+
+private:
+    static pthread_mutex_t mutex;
+};
+
+#endif
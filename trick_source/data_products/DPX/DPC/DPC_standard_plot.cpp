@@ -1,6 +1,6 @@
 
 #include "DPC/DPC_standard_plot.hh"
-#include "DPC/DPC_std_curve.hh"
+#include "DPC/DPC_curve_loader.hh"
 #include "DPM/DPM_var.hh"
 #include "DPM/DPM_axis.hh"
 
@@ -33,29 +33,23 @@ DPC_standard_plot::DPC_standard_plot(
 
     n_curves = Relation->NumberOfCurves();
 
-    // for each of the RUNs
+    // Queue a curve for each curve specification of each of the RUNs, then
+    // build them all at once.
+    DPC_curve_loader loader( DS_Supplier, &total_time_constraints );
     for (runix = 0 ; runix < n_runs ; runix++) {
-        // for each of the curves
         for (cix = 0 ; cix < n_curves ; cix ++ ) {
-            DPC_curve *curve;
-            DPM_curve *curve_spec = Relation->getCurve(cix);
-            try {
-                // Make a curve.
-                curve = new DPC_std_curve( curve_spec,
-                                           (*RunListp)[runix],
-                                           DS_Supplier,
-                                           &total_time_constraints );
-            } catch (const std::logic_error& error) {
-                curve = NULL;
-                std::cerr << error.what() << std::endl;
-            }
+            loader.add( Relation->getCurve(cix), (*RunListp)[runix] );
+        }
+    }
+    std::vector <DPC_curve *> curves = loader.load();
 
-            // Put that new curve object into the curve list.
-            if ( curve) {
-                if ( add_curve( curve) < 0 ) {
-                    std::cerr << "ERROR: Rejecting curve." << std::endl;
-                    delete curve;
-                }
+    // Put the new curve objects into the curve list.
+    for (cix = 0 ; cix < (int)curves.size() ; cix++ ) {
+        DPC_curve *curve = curves[cix];
+        if ( curve) {
+            if ( add_curve( curve) < 0 ) {
+                std::cerr << "ERROR: Rejecting curve." << std::endl;
+                delete curve;
             }
         }
     }
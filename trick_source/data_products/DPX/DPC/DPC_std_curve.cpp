@@ -2,8 +2,11 @@
 #include <udunits2.h>
 
 #include "DPC/DPC_std_curve.hh"
+#include "DPC/DPC_curve_loader.hh"
 #include "math.h"
 
+#define DPC_CURVE_BLOCK_SIZE 1024
+
 extern ut_system * u_system ;
 
 // CONSTRUCTOR
@@ -27,6 +30,15 @@ DPC_std_curve::DPC_std_curve(
 
     data_src_label = NULL;
     time_conversion = NULL;
+    buffered = false;
+    buf_ix = 0;
+
+    for (int ii = 0; ii < 2; ii++) {
+        blk_time[ii].resize(DPC_CURVE_BLOCK_SIZE);
+        blk_value[ii].resize(DPC_CURVE_BLOCK_SIZE);
+        blk_ix[ii] = 0;
+        blk_n[ii] = 0;
+    }
 
     // While we haven't found found a variable-pair that works for
     // this RUN and we haven't exhausted all of the variable-pairs.
@@ -60,6 +72,7 @@ DPC_std_curve::DPC_std_curve(
 
                 ut_unit *to;
                 ut_unit *from;
+                DPC_units_lock units_lock;
 
                 to = ut_parse(u_system, x_var_units, UT_ASCII) ;
                 if ( ! to ) {
@@ -233,17 +246,32 @@ const char *DPC_std_curve::getDataSrcLbl() {
 // MEMBER FUNCTION
 int DPC_std_curve::getXY(double *X_value, double *Y_value) {
 
+    if (buffered) {
+        if (buf_ix < buf_x.size()) {
+            *X_value = buf_x[buf_ix];
+            *Y_value = buf_y[buf_ix];
+            buf_ix++;
+            return(1);
+        }
+        return(0);
+    }
+    return( readXY( X_value, Y_value));
+}
+
+// MEMBER FUNCTION
+int DPC_std_curve::readXY(double *X_value, double *Y_value) {
+
     double t1,t2,v1,v2;
     int eos;
 
     if (ds[0]) {
         if (ds[1]) {
-            eos = !(ds[0]->get( &t1, &v1) && ds[1]->get( &t2, &v2));
+            eos = !(next( 0, &t1, &v1) && next( 1, &t2, &v2));
             while (!eos && ( fabs( t1 - t2) > T_TOLERANCE )) {
                 if (t1 < t2) {
-                    eos = ! ds[0]->get( &t1, &v1);
+                    eos = ! next( 0, &t1, &v1);
                 } else {
-                    eos = ! ds[1]->get( &t2, &v2);
+                    eos = ! next( 1, &t2, &v2);
                 }
             }
             *X_value = v1;
@@ -252,7 +280,7 @@ int DPC_std_curve::getXY(double *X_value, double *Y_value) {
                 return(1);
             }
         } else {
-            eos = !ds[0]->get( &t1, &v1);
+            eos = !next( 0, &t1, &v1);
             *X_value = cv_convert_double(time_conversion,t1);
             *Y_value = v1;
             if (!eos) {
@@ -265,7 +293,43 @@ int DPC_std_curve::getXY(double *X_value, double *Y_value) {
 
 // MEMBER FUNCTION
 void DPC_std_curve::begin() {
+    if (buffered) {
+        buf_ix = 0;
+        return;
+    }
+    blk_ix[0] = blk_n[0] = 0;
+    blk_ix[1] = blk_n[1] = 0;
     if (ds[0]) ds[0]->begin();
     if (ds[1]) ds[1]->begin();
 }
 
+// MEMBER FUNCTION
+void DPC_std_curve::buffer() {
+
+    double x, y;
+
+    begin();
+    while (readXY(&x, &y)) {
+        buf_x.push_back(x);
+        buf_y.push_back(y);
+    }
+    buffered = true;
+    buf_ix = 0;
+}
+
+// MEMBER FUNCTION
+int DPC_std_curve::next(int ix, double *time, double *value) {
+
+    if (blk_ix[ix] == blk_n[ix]) {
+        blk_ix[ix] = 0;
+        blk_n[ix] = ds[ix]->getBlock( &blk_time[ix][0], &blk_value[ix][0], DPC_CURVE_BLOCK_SIZE);
+        if (blk_n[ix] == 0) {
+            return(0);
+        }
+    }
+    *time = blk_time[ix][blk_ix[ix]];
+    *value = blk_value[ix][blk_ix[ix]];
+    blk_ix[ix]++;
+    return(1);
+}
+
@@ -9,6 +9,7 @@
 #include "DPC/DPC_datastream_supplier.hh"
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 /**
  * This class provides all of the data necessary to represent a curve of a plot.
@@ -59,12 +60,45 @@ public:
      */
     void begin();
 
+    /**
+     * Read all of the points of the curve into memory. From then on getXY()
+     * and begin() use the buffered points instead of the DataStreams, so a
+     * curve may be buffered on one thread and rendered on another.
+     */
+    void buffer();
+
+    /**
+     * @return true if the points of the curve have been buffered.
+     */
+    bool isBuffered() { return buffered; }
+
 private:
 
+    /**
+     * Get the next (X, Y) pair from the DataStreams.
+     * @return 1 if data was returned in x_value and y_value, 0 otherwise.
+     */
+    int readXY(double *x_value, double *y_value);
+
+    /**
+     * Get the next time/value pair from ds[ix]. Pairs are read from the
+     * DataStream a block at a time.
+     * @return 1 if a time/value pair was returned, 0 otherwise.
+     */
+    int next(int ix, double *time, double *value);
+
     DataStream *ds[2];
+    std::vector<double> blk_time[2];
+    std::vector<double> blk_value[2];
+    int blk_ix[2];
+    int blk_n[2];
     char * x_actual_units;
     char * y_actual_units;
     char * data_src_label;
     cv_converter * time_conversion;
+    bool buffered;
+    std::vector<double> buf_x;
+    std::vector<double> buf_y;
+    size_t buf_ix;
 };
 #endif
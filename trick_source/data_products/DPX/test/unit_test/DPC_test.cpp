@@ -1,10 +1,13 @@
 #define protected public
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <libxml/parser.h>
 #include <libxml/tree.h>
 #include <string.h>
 #include "DPC/DPC_product.hh"
+#include "DPC/DPC_curve_loader.hh"
+#include "DPC/DPC_std_curve.hh"
 #include "DPM/DPM_parse_tree.hh"
 #include "DPM/DPM_session.hh"
 #include "test_view.hh"
@@ -685,6 +688,68 @@ TEST_F(DPCTest, ComparisonCurves) {
     EXPECT_EQ(result, 0);
 }
 
+// Session 9_1, loading the curves on one thread and on several
+TEST_F(DPCTest, ParallelCurves) {
+
+    setenv("TRICK_DP_THREADS", "1", 1);
+    std::string serial = parseDPCData(testxml[10].c_str());
+    setenv("TRICK_DP_THREADS", "4", 1);
+    std::string parallel = parseDPCData(testxml[10].c_str());
+    unsetenv("TRICK_DP_THREADS");
+
+    EXPECT_EQ(serial, parallel);
+}
+
+// Curves built by the loader hand the renderer the points read on the loader threads
+TEST_F(DPCTest, LoadedCurves) {
+
+    DPM_parse_tree *session_tree = new DPM_parse_tree(testxml[10].c_str());
+    DPM_session *session = new DPM_session( NULL, session_tree->getRootNode() );
+    delete session_tree;
+    DPM_parse_tree *product_tree = new DPM_parse_tree("../TEST_DATA/product_9.xml");
+    DPM_product *product = new DPM_product( session, product_tree->getRootNode() );
+    delete product_tree;
+    DPC_datastream_supplier supplier( product );
+    DPM_relation *relation = product->getPage(0)->getRelation(0);
+    double x, y, lx, ly;
+    unsigned int ii;
+
+    setenv("TRICK_DP_THREADS", "4", 1);
+    DPC_curve_loader loader( &supplier, session->time_constraints );
+    for (ii = 0 ; ii < session->run_list.size() ; ii++) {
+        loader.add( relation->getCurve(0), session->run_list[ii] );
+    }
+    std::vector <DPC_curve *> curves = loader.load();
+    unsetenv("TRICK_DP_THREADS");
+
+    ASSERT_EQ(session->run_list.size(), curves.size());
+    for (ii = 0 ; ii < curves.size() ; ii++) {
+        DPC_std_curve *loaded = dynamic_cast<DPC_std_curve *>(curves[ii]);
+        ASSERT_TRUE(loaded != NULL);
+        EXPECT_TRUE(loaded->isBuffered());
+
+        // The same points as a curve read straight from its DataStreams, every time it is read
+        DPC_std_curve direct( relation->getCurve(0), session->run_list[ii], &supplier, session->time_constraints );
+        for (int pass = 0 ; pass < 2 ; pass++) {
+            int n_points = 0;
+            loaded->begin();
+            direct.begin();
+            while (direct.getXY(&x, &y)) {
+                ASSERT_EQ(1, loaded->getXY(&lx, &ly));
+                EXPECT_EQ(x, lx);
+                EXPECT_EQ(y, ly);
+                n_points++;
+            }
+            EXPECT_EQ(0, loaded->getXY(&lx, &ly));
+            EXPECT_GT(n_points, 0);
+        }
+        delete loaded;
+    }
+
+    delete product;
+    delete session;
+}
+
 // Session 9_2
 TEST_F(DPCTest, DeltaCurves) {
 	//req.add_requirement("2904854297");
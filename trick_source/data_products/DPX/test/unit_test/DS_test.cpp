@@ -2,8 +2,17 @@
 
 #include <iostream>
 #include <string.h>
+#include <unistd.h>
+#include <utime.h>
+#include <time.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
 #include "Log/DataStream.hh"
 #include "Log/DataStreamFactory.hh"
+#include "Log/MonteStats.hh"
+#include "Log/TDigest.hh"
+#include "trick/trk_columns.h"
 #include "DPC/DPC_UnitConvDataStream.hh"
 #include "DPC/DPC_TimeCstrDataStream.hh"
 #include "DPM/DPM_time_constraints.hh"
@@ -425,5 +434,329 @@ TEST_F(DSTest, DataStream_DPCTimeCstr) {
 	delete testds;
 }
 
+// TRICK BINARY BLOCK READS
+TEST_F(DSTest, DataStream_BinaryBlock) {
+
+	int i, num;
+	double time, value;
+	double times[100], values[100];
+	DataStream *otherds;
+
+	RUN_dir = "../TEST_DATA/RUN_BINARY";
+	VarName = "sun_predictor.sun.solar_elevation";
+
+	data_stream_factory = new DataStreamFactory();
+	testds = data_stream_factory->create(RUN_dir, VarName, NULL);
+	otherds = data_stream_factory->create(RUN_dir, "sun_predictor.sun.solar_azimuth", NULL);
+
+	// Both streams read the same mapping of the log file
+	TrickBinaryLog *log = TrickBinaryLog::open("../TEST_DATA/RUN_BINARY/log_helios.trk");
+	ASSERT_TRUE(log != NULL);
+	EXPECT_EQ(log, ((TrickBinary *)testds)->getLog());
+	EXPECT_EQ(log, ((TrickBinary *)otherds)->getLog());
+
+	// A block holds the same pairs as successive gets
+	EXPECT_EQ(2, testds->get(&time, &value) + otherds->get(&time, &value));
+	num = testds->getBlock(times, values, 100);
+	EXPECT_EQ(num, 100);
+	testds->begin();
+	testds->step();
+	for (i = 0; i < num; i++) {
+		testds->get(&time, &value);
+		EXPECT_EQ(times[i], time);
+		EXPECT_EQ(values[i], value);
+	}
+
+	// Several columns extracted in one pass
+	int params[2] = { log->findParam(VarName), log->findParam("sun_predictor.sun.solar_azimuth") };
+	double elevation[100], azimuth[100];
+	double *columns[2] = { elevation, azimuth };
+	ASSERT_EQ(100, log->extractColumns(2, params, 0, 100, columns));
+	otherds->begin();
+	for (i = 0; i < 100; i++) {
+		otherds->get(&time, &value);
+		EXPECT_EQ(log->getTime(i), time);
+		EXPECT_EQ(azimuth[i], value);
+		EXPECT_EQ(log->getValue(i, params[0]), elevation[i]);
+	}
+
+	// The last block is short
+	testds->begin();
+	num = 0;
+	while ((i = testds->getBlock(times, values, 100)) > 0) {
+		num += i;
+	}
+	EXPECT_EQ(log->getNumRecords(), num);
+	EXPECT_EQ(1, testds->end());
+
+	TrickBinaryLog::close(log);
+	delete otherds;
+	delete testds;
+	delete data_stream_factory;
+}
+
+TEST_F(DSTest, DataStream_BinarySeek) {
+
+	double time, value, seek_time;
+
+	RUN_dir = "../TEST_DATA/RUN_BINARY";
+	VarName = "sun_predictor.sun.solar_elevation";
+
+	data_stream_factory = new DataStreamFactory();
+	testds = data_stream_factory->create(RUN_dir, VarName, NULL);
+	TrickBinaryLog *log = ((TrickBinary *)testds)->getLog();
+	ASSERT_TRUE(log != NULL);
+
+	// Seeking lands on the first record at or after the time
+	seek_time = (log->getTime(500) + log->getTime(501)) / 2;
+	EXPECT_EQ(1, testds->seekTime(seek_time));
+	testds->get(&time, &value);
+	EXPECT_EQ(log->getTime(501), time);
+	EXPECT_EQ(log->getValue(501, log->findParam(VarName)), value);
+
+	EXPECT_EQ(1, testds->seekTime(log->getTime(500)));
+	testds->get(&time, &value);
+	EXPECT_EQ(log->getTime(500), time);
+
+	EXPECT_EQ(0, log->findTime(-1.0));
+	EXPECT_EQ(log->getNumRecords(), log->findTime(log->getTime(log->getNumRecords() - 1) + 1.0));
+
+	// getValueAtTime gives the same answer reading from the seek point
+	EXPECT_EQ(1, testds->getValueAtTime(log->getTime(700), &value));
+	EXPECT_EQ(log->getValue(700, log->findParam(VarName)), value);
+
+	delete testds;
+	delete data_stream_factory;
+}
+
+// A log truncated or rewritten while it is open
+TEST_F(DSTest, DataStream_BinaryChanged) {
+
+	const char *file_name = "log_changed_test.trk";
+	std::vector<char> contents;
+	FILE *fp = fopen("../TEST_DATA/RUN_BINARY/log_helios.trk", "r");
+	ASSERT_TRUE(fp != NULL);
+	int ch;
+	while ((ch = fgetc(fp)) != EOF) {
+		contents.push_back((char)ch);
+	}
+	fclose(fp);
+
+	fp = fopen(file_name, "w");
+	fwrite(&contents[0], 1, contents.size(), fp);
+	fclose(fp);
+
+	TrickBinaryLog *log = TrickBinaryLog::open(file_name);
+	ASSERT_TRUE(log != NULL);
+	long num_records = log->getNumRecords();
+	int param = log->findParam("sun_predictor.sun.solar_elevation");
+	ASSERT_GT(num_records, 100);
+	double last_value = log->getValue(num_records - 1, param);
+
+	// A log just written may still be recording.  It is read into memory, not mapped, so truncating it
+	// does not change what was read.
+	ASSERT_EQ(0, truncate(file_name, 64));
+	double value = log->getValue(num_records - 1, param);
+	EXPECT_NE(0.0, last_value);
+	EXPECT_EQ(last_value, value);
+
+	// The next open sees the change and reads the file again
+	fp = fopen(file_name, "w");
+	fwrite(&contents[0], 1, contents.size() / 2, fp);
+	fclose(fp);
+	TrickBinaryLog *changed = TrickBinaryLog::open(file_name);
+	ASSERT_TRUE(changed != NULL);
+	EXPECT_NE(log, changed);
+	EXPECT_LT(changed->getNumRecords(), num_records);
+
+	// A rewrite of the same size within the same second is seen too
+	usleep(20000);
+	fp = fopen(file_name, "w");
+	fwrite(&contents[0], 1, contents.size() / 2, fp);
+	fclose(fp);
+	TrickBinaryLog *rewritten = TrickBinaryLog::open(file_name);
+	ASSERT_TRUE(rewritten != NULL);
+	EXPECT_NE(changed, rewritten);
+
+	// A log that settled is mapped, and reads the same
+	fp = fopen(file_name, "w");
+	fwrite(&contents[0], 1, contents.size(), fp);
+	fclose(fp);
+	struct utimbuf settled_times;
+	settled_times.actime = settled_times.modtime = time(NULL) - 60;
+	ASSERT_EQ(0, utime(file_name, &settled_times));
+	TrickBinaryLog *settled = TrickBinaryLog::open(file_name);
+	ASSERT_TRUE(settled != NULL);
+	EXPECT_EQ(num_records, settled->getNumRecords());
+	EXPECT_EQ(last_value, settled->getValue(num_records - 1, param));
+
+	TrickBinaryLog::close(settled);
+	TrickBinaryLog::close(rewritten);
+	TrickBinaryLog::close(changed);
+	TrickBinaryLog::close(log);
+	unlink(file_name);
+}
+
+// The columnar sidecar holds the same values and goes stale when the log changes
+TEST_F(DSTest, DataStream_BinaryColumns) {
+
+	const char *file_name = "log_columns_test.trk";
+	std::string col_name = std::string(file_name) + TRK_COLUMNS_SUFFIX;
+	std::vector<char> contents;
+	FILE *fp = fopen("../TEST_DATA/RUN_BINARY/log_helios.trk", "r");
+	ASSERT_TRUE(fp != NULL);
+	int ch;
+	while ((ch = fgetc(fp)) != EOF) {
+		contents.push_back((char)ch);
+	}
+	fclose(fp);
+
+	fp = fopen(file_name, "w");
+	fwrite(&contents[0], 1, contents.size(), fp);
+	fclose(fp);
+	unlink(col_name.c_str());
+
+	TrickBinaryLog *log = TrickBinaryLog::open(file_name);
+	ASSERT_TRUE(log != NULL);
+	EXPECT_FALSE(log->hasColumns());
+	ASSERT_EQ(0, log->writeColumns());
+	EXPECT_NE(0, access((col_name + ".tmp").c_str(), F_OK));
+	TrickBinaryLog::close(log);
+
+	// A rewrite of the same size within the same second makes the sidecar stale
+	usleep(20000);
+	fp = fopen(file_name, "w");
+	fwrite(&contents[0], 1, contents.size(), fp);
+	fclose(fp);
+	TrickBinaryLog *columns = TrickBinaryLog::open(file_name);
+	ASSERT_TRUE(columns != NULL);
+	EXPECT_FALSE(columns->hasColumns());
+	ASSERT_EQ(0, columns->writeColumns());
+	TrickBinaryLog::close(columns);
+
+	columns = TrickBinaryLog::open(file_name);
+	ASSERT_TRUE(columns != NULL);
+	EXPECT_TRUE(columns->hasColumns());
+	log = TrickBinaryLog::open("../TEST_DATA/RUN_BINARY/log_helios.trk");
+	ASSERT_TRUE(log != NULL);
+	EXPECT_FALSE(log->hasColumns());
+	ASSERT_EQ(log->getNumRecords(), columns->getNumRecords());
+	ASSERT_EQ(log->getNumParams(), columns->getNumParams());
+	for (long ii = 0; ii < log->getNumRecords(); ii += 97) {
+		EXPECT_EQ(log->getTime(ii), columns->getTime(ii));
+		for (int jj = 0; jj < log->getNumParams(); jj++) {
+			EXPECT_EQ(log->getValue(ii, jj), columns->getValue(ii, jj));
+		}
+	}
+
+	TrickBinaryLog::close(log);
+	TrickBinaryLog::close(columns);
+	unlink(col_name.c_str());
+	unlink(file_name);
+}
+
+TEST_F(DSTest, TDigest_Quantiles) {
+
+	TDigest digest;
+	std::vector<double> values;
+	int i;
+
+	EXPECT_EQ(0.0, digest.quantile(0.5));
+
+	// A scrambled ramp, so the exact quantiles are known
+	for (i = 0; i < 100000; i++) {
+		double value = (double)((i * 7919L) % 100000);
+		digest.add(value);
+		values.push_back(value);
+	}
+	std::sort(values.begin(), values.end());
+
+	EXPECT_EQ(100000.0, digest.getCount());
+	EXPECT_EQ(values.front(), digest.quantile(0.0));
+	EXPECT_EQ(values.back(), digest.quantile(1.0));
+	EXPECT_NEAR(values[50000], digest.quantile(0.5), 500.0);
+	EXPECT_NEAR(values[5000], digest.quantile(0.05), 100.0);
+	EXPECT_NEAR(values[99900], digest.quantile(0.999), 50.0);
+
+	digest.clear();
+	digest.add(3.0);
+	EXPECT_EQ(3.0, digest.quantile(0.5));
+}
+
+TEST_F(DSTest, MonteStats_Envelope) {
+
+	MonteStats monte_stats;
+	const char *runs[] = { "../TEST_DATA/BUNCHORUNS/RUN1", "../TEST_DATA/BUNCHORUNS/RUN2",
+	                       "../TEST_DATA/BUNCHORUNS/RUN3", "../TEST_DATA/BUNCHORUNS/RUN4",
+	                       "../TEST_DATA/BUNCHORUNS/RUN5", "../TEST_DATA/BUNCHORUNS/RUN6" };
+	// Both variables are in the same log of each run and share its reader.
+	const char *vars[] = { "sun_predictor.sun.solar_elevation", "sun_predictor.sun.solar_azimuth" };
+	const char *envelope = "/tmp/DS_test_envelope.trk";
+	int i, v, num_runs = 6, num_vars = 2;
+	long records;
+
+	for (i = 0; i < num_runs; i++) {
+		monte_stats.addRun(runs[i]);
+	}
+	for (v = 0; v < num_vars; v++) {
+		monte_stats.addVariable(vars[v]);
+	}
+	records = monte_stats.write(envelope);
+	ASSERT_GT(records, 0);
+
+	TrickBinaryLog *log = TrickBinaryLog::open(envelope);
+	ASSERT_TRUE(log != NULL);
+	EXPECT_EQ(records, log->getNumRecords());
+
+	// Compare every bin with the values read from the runs directly. The
+	// runs end at different times, so later bins have fewer runs.
+	data_stream_factory = new DataStreamFactory();
+	for (v = 0; v < num_vars; v++) {
+		std::string name = vars[v];
+		int count = log->findParam((name + ".count").c_str());
+		int mean = log->findParam((name + ".mean").c_str());
+		int std = log->findParam((name + ".std").c_str());
+		int min = log->findParam((name + ".min").c_str());
+		int max = log->findParam((name + ".max").c_str());
+		int median = log->findParam((name + ".p50").c_str());
+		ASSERT_TRUE(count >= 0 && mean >= 0 && std >= 0 && min >= 0 && max >= 0 && median >= 0);
+
+		for (long rec = 0; rec < records; rec++) {
+			double time = log->getTime(rec);
+			std::vector<double> values;
+			for (i = 0; i < num_runs; i++) {
+				double value;
+				testds = data_stream_factory->create(runs[i], vars[v], NULL);
+				if (testds->getValueAtTime(time, &value)) {
+					values.push_back(value);
+				}
+				delete testds;
+			}
+			ASSERT_EQ((double)values.size(), log->getValue(rec, count));
+
+			double sum = 0.0, sum_sq = 0.0;
+			for (i = 0; i < (int)values.size(); i++) {
+				sum += values[i];
+			}
+			for (i = 0; i < (int)values.size(); i++) {
+				sum_sq += (values[i] - sum / values.size()) * (values[i] - sum / values.size());
+			}
+			std::sort(values.begin(), values.end());
+			EXPECT_NEAR(sum / values.size(), log->getValue(rec, mean), 1.0e-9);
+			if (values.size() > 1) {
+				EXPECT_NEAR(sqrt(sum_sq / (values.size() - 1)), log->getValue(rec, std), 1.0e-9);
+			}
+			EXPECT_EQ(values.front(), log->getValue(rec, min));
+			EXPECT_EQ(values.back(), log->getValue(rec, max));
+			EXPECT_LE(values.front(), log->getValue(rec, median));
+			EXPECT_GE(values.back(), log->getValue(rec, median));
+		}
+	}
+
+	TrickBinaryLog::close(log);
+	unlink(envelope);
+	delete data_stream_factory;
+}
+
 }
 
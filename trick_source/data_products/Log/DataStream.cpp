@@ -12,12 +12,29 @@ DataStream::~DataStream()
         // Nada
 }
 
+int DataStream::getBlock(double * times , double * values , int max ) {
+
+        int num = 0 ;
+
+        while ( num < max && get( &times[num] , &values[num] )) {
+                num++ ;
+        }
+
+        return(num) ;
+}
+
+int DataStream::seekTime(double time ) {
+
+        begin() ;
+        return(0) ;
+}
+
 int DataStream::getValueAtTime(double time , double * value ) {
 
         double value_time ;
         int ret = 0 ;
 
-        begin() ;
+        seekTime( time - 1e-9 ) ;
         while ( (ret = get( &value_time , value )) &&
                 (fabs( value_time - time ) > 1e-9 )) ;
 
@@ -15,6 +15,15 @@ class DataStream {
                virtual int get(double * timeStamp , double * paramValue) = 0 ;
                virtual int peek(double * timeStamp , double * paramValue) = 0 ;
 
+               // Gets up to max time/value pairs, as if calling get() until it
+               // returns 0.  Returns the number of pairs read.
+               virtual int getBlock(double * timeStamps , double * paramValues , int max ) ;
+
+               // Positions the stream at the first value whose time stamp is
+               // >= timeStamp.  Streams that can not seek just begin() and
+               // return 0.  Returns 1 if the stream seeked.
+               virtual int seekTime(double timeStamp) ;
+
                int getValueAtTime(double timeStamp, double *paramValue ) ;
 
                virtual string getFileName() ;
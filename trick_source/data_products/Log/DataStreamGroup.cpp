@@ -36,13 +36,18 @@ void DataStreamGroup::setStopTime( double time ) {
 
 void DataStreamGroup::add( DataStream* ds ) {
 
+        struct LastRead last_read = { 0.0 , 0.0 } ;
+
         dataStreams_.push_back(ds) ;
         currTime_.push_back(0.0);
+        lastRead_.push_back(last_read);
 }
 
 void DataStreamGroup::clear()
 {
         dataStreams_.clear() ;
+        currTime_.clear() ;
+        lastRead_.clear() ;
 }
 
 void DataStreamGroup::setPreserveTimeOn() {
@@ -89,8 +94,8 @@ void DataStreamGroup::begin()
 
         // Grab data from each stream without stepping
         for ( ii = 0; ii < dataStreams_.size(); ii++ ) {
-                dataStreams_[ii]->peek(&lastRead_[dataStreams_[ii]].time,
-                                       &lastRead_[dataStreams_[ii]].value);
+                dataStreams_[ii]->peek(&lastRead_[ii].time,
+                                       &lastRead_[ii].value);
 
         }
 }
@@ -301,13 +306,13 @@ int DataStreamGroup::matchTimeStamps() {
 
                         // get the next record out of the file and find the maximum time stamp
                         for ( ii = 0 ; ii < dataStreams_.size() ; ii++ ) {
-                                if ( ! dataStreams_[ii]->get(&lastRead_[dataStreams_[ii]].time,
-                                        &lastRead_[dataStreams_[ii]].value) ) {
+                                if ( ! dataStreams_[ii]->get(&lastRead_[ii].time,
+                                        &lastRead_[ii].value) ) {
                                         isEOF_ = 1 ;
                                         return(0) ;
                                 }
-                                if (lastRead_[dataStreams_[ii]].time > maxTime ) {
-                                        maxTime = lastRead_[dataStreams_[ii]].time ;
+                                if (lastRead_[ii].time > maxTime ) {
+                                        maxTime = lastRead_[ii].time ;
                                 }
                         }
 
@@ -320,9 +325,9 @@ int DataStreamGroup::matchTimeStamps() {
                         // keep getting records from the all streams until we past the largest time step
                         for ( ii = 0 ; ii < dataStreams_.size() ; ii++ ) {
                                 while ( maxTime -
-                                        lastRead_[dataStreams_[ii]].time > timeMatchTolerance_ ) {
-                                        if ( ! dataStreams_[ii]->get(&lastRead_[dataStreams_[ii]].time,
-                                                &lastRead_[dataStreams_[ii]].value)) {
+                                        lastRead_[ii].time > timeMatchTolerance_ ) {
+                                        if ( ! dataStreams_[ii]->get(&lastRead_[ii].time,
+                                                &lastRead_[ii].value)) {
                                                 isEOF_ = 1 ;
                                                 return(0) ;
                                         }
@@ -333,7 +338,7 @@ int DataStreamGroup::matchTimeStamps() {
                         // check to see if all the time stamps match or not
                         matched_time_stamps = 1 ;
                         for ( ii = 0 ; ii < dataStreams_.size() ; ii++ ) {
-                                if ( DPLOG_ABS(lastRead_[dataStreams_[ii]].time - maxTime) > timeMatchTolerance_ ) {
+                                if ( DPLOG_ABS(lastRead_[ii].time - maxTime) > timeMatchTolerance_ ) {
                                         matched_time_stamps = 0 ;
                                         break ;
                                 }
@@ -360,8 +365,22 @@ int DataStreamGroup::matchTimeStamps() {
 
 int DataStreamGroup::getLastRead( DataStream *ds , double *time , double *value) {
 
-        *time = lastRead_[ds].time ;
-        *value = lastRead_[ds].value ;
+        unsigned int ii ;
+
+        for ( ii = 0 ; ii < dataStreams_.size() ; ii++ ) {
+                if ( dataStreams_[ii] == ds ) {
+                        return getLastRead( ii , time , value ) ;
+                }
+        }
+        *time = 0.0 ;
+        *value = 0.0 ;
+        return (1) ;
+}
+
+int DataStreamGroup::getLastRead( unsigned int index , double *time , double *value) {
+
+        *time = lastRead_[index].time ;
+        *value = lastRead_[index].value ;
         return (1) ;
 }
 
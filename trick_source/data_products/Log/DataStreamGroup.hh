@@ -4,7 +4,6 @@
 
 #include <iostream>
 #include <vector>
-#include <map>
 using namespace std;
 
 #include "DataStream.hh"
@@ -28,6 +27,7 @@ class DataStreamGroup {
         int matchTimeStamps();
         void setTimeMatchTolerance(const double tolerance);
         int getLastRead(DataStream *, double * time , double * value);
+        int getLastRead(unsigned int index, double * time , double * value);
 
         void begin();
         bool end();
@@ -44,7 +44,7 @@ class DataStreamGroup {
 
         vector < DataStream* >dataStreams_;
         vector < double > currTime_ ;
-        map    < DataStream * , struct LastRead > lastRead_ ;
+        vector < struct LastRead > lastRead_ ;  // indexed like dataStreams_
 
         bool preserveTime_ ;    // While iterating, step() insures all time
                                 // stamps are same.  step() will skip points
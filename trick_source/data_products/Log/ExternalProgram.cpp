@@ -108,7 +108,7 @@ int ExternalProgram::getOutputValue( double* timeStamp, double* outputValue )
         int ret ;
 
         for ( ii = 0 ; ii < nInputs_ ; ii++ ) {
-                dsg_.getLastRead(istreams_[ii], timeStamp, &input_[ii] ) ;
+                dsg_.getLastRead(ii, timeStamp, &input_[ii] ) ;
         }
 
         ret = external_program(input_, nInputs_, output_, nOutputs_);
@@ -0,0 +1,341 @@
+
+#include <math.h>
+#include <float.h>
+#include <string.h>
+#include "MonteStats.hh"
+#include "DataStreamFactory.hh"
+#include "TrickBinary.hh"
+#include "trick_byte_order.h"
+#include "trick/parameter_types.h"
+
+void MonteStats::Stats::clear() {
+
+        count = 0 ;
+        mean = 0.0 ;
+        m2 = 0.0 ;
+        min = DBL_MAX ;
+        max = -DBL_MAX ;
+        digest.clear() ;
+}
+
+void MonteStats::Stats::add( double value ) {
+
+        double delta ;
+
+        count++ ;
+        delta = value - mean ;
+        mean += delta / count ;
+        m2 += delta * (value - mean) ;
+        if ( value < min ) {
+                min = value ;
+        }
+        if ( value > max ) {
+                max = value ;
+        }
+        digest.add(value) ;
+}
+
+MonteStats::MonteStats()
+{
+        binWidth_ = 0.0 ;
+        timeMatchTolerance_ = 1.0e-9 ;
+        compression_ = 100.0 ;
+        quantiles_.push_back(0.05) ;
+        quantiles_.push_back(0.5) ;
+        quantiles_.push_back(0.95) ;
+}
+
+MonteStats::~MonteStats() {
+        closeStreams_() ;
+}
+
+void MonteStats::addRun( const char * runDir ) {
+        runDirs_.push_back(runDir) ;
+}
+
+void MonteStats::addVariable( const char * paramName ) {
+        paramNames_.push_back(paramName) ;
+}
+
+void MonteStats::setBinWidth( double width ) {
+        binWidth_ = ( width > 0.0 ) ? width : 0.0 ;
+}
+
+void MonteStats::setTimeMatchTolerance( double tolerance ) {
+        timeMatchTolerance_ = tolerance ;
+}
+
+void MonteStats::setQuantiles( const vector< double > & quantiles ) {
+        quantiles_ = quantiles ;
+}
+
+void MonteStats::setCompression( double compression ) {
+        compression_ = compression ;
+}
+
+bool MonteStats::Source::peek( double * time , double * value ) {
+
+        if ( log == NULL ) {
+                return( stream->peek(time , value) != 0 ) ;
+        }
+        if ( record >= log->getNumRecords() ) {
+                return(false) ;
+        }
+        *time = log->getTime(record) ;
+        *value = 0.0 ;
+        return(true) ;
+}
+
+bool MonteStats::openStreams_() {
+
+        DataStreamFactory factory ;
+        DataStream * ds ;
+        TrickBinary * binary ;
+        unsigned int ii , jj , kk ;
+        int num_streams = 0 ;
+
+        closeStreams_() ;
+        sources_.resize(runDirs_.size()) ;
+        paramUnits_.assign(paramNames_.size() , "--") ;
+
+        for ( jj = 0 ; jj < runDirs_.size() ; jj++ ) {
+                vector< Source > & sources = sources_[jj] ;
+                for ( ii = 0 ; ii < paramNames_.size() ; ii++ ) {
+                        ds = factory.create(runDirs_[jj].c_str() , paramNames_[ii].c_str() ,
+                                            "sys.exec.out.time") ;
+                        if ( ds == NULL ) {
+                                cerr << "WARNING: \"" << paramNames_[ii] << "\" was not found in \""
+                                     << runDirs_[jj] << "\"." << endl ;
+                                continue ;
+                        }
+                        if ( paramUnits_[ii] == "--" && ! ds->getUnit().empty() ) {
+                                paramUnits_[ii] = ds->getUnit() ;
+                        }
+                        num_streams++ ;
+
+                        // A variable in a log already read by this run shares its reader
+                        binary = dynamic_cast< TrickBinary * >(ds) ;
+                        TrickBinaryLog * log = ( binary != NULL ) ? binary->getLog() : NULL ;
+                        int param = ( log != NULL ) ? log->findParam(paramNames_[ii].c_str()) : -1 ;
+                        if ( log != NULL && param < 0 ) {
+                                log = NULL ;
+                        }
+                        for ( kk = 0 ; log != NULL && kk < sources.size() ; kk++ ) {
+                                if ( sources[kk].log == log ) {
+                                        break ;
+                                }
+                        }
+                        if ( log != NULL && kk < sources.size() ) {
+                                sources[kk].vars.push_back(ii) ;
+                                sources[kk].params.push_back(param) ;
+                                delete ds ;
+                                continue ;
+                        }
+
+                        Source source ;
+                        source.stream = ds ;
+                        source.log = log ;
+                        source.record = 0 ;
+                        source.vars.push_back(ii) ;
+                        source.params.push_back(param) ;
+                        ds->begin() ;
+                        sources.push_back(source) ;
+                }
+        }
+
+        return( num_streams > 0 ) ;
+}
+
+void MonteStats::closeStreams_() {
+
+        unsigned int ii , jj ;
+
+        for ( ii = 0 ; ii < sources_.size() ; ii++ ) {
+                for ( jj = 0 ; jj < sources_[ii].size() ; jj++ ) {
+                        delete sources_[ii][jj].stream ;
+                }
+        }
+        sources_.clear() ;
+}
+
+// The earliest time stamp not read yet in any run
+bool MonteStats::nextTime_( double * time ) {
+
+        unsigned int ii , jj ;
+        double t , v ;
+        bool found = false ;
+
+        *time = DBL_MAX ;
+        for ( ii = 0 ; ii < sources_.size() ; ii++ ) {
+                for ( jj = 0 ; jj < sources_[ii].size() ; jj++ ) {
+                        if ( sources_[ii][jj].peek(&t , &v) ) {
+                                if ( t < *time ) {
+                                        *time = t ;
+                                }
+                                found = true ;
+                        }
+                }
+        }
+        return( found ) ;
+}
+
+bool MonteStats::writeHeader_( FILE * fp ) {
+
+        vector< string > names ;
+        vector< string > units ;
+        unsigned int ii , jj ;
+        int byte_order ;
+        int num_params , len , type , size ;
+        char suffix[32] ;
+        bool ok ;
+
+        names.push_back("sys.exec.out.time") ;
+        units.push_back("s") ;
+        for ( ii = 0 ; ii < paramNames_.size() ; ii++ ) {
+                names.push_back(paramNames_[ii] + ".count") ;
+                units.push_back("--") ;
+                names.push_back(paramNames_[ii] + ".mean") ;
+                names.push_back(paramNames_[ii] + ".std") ;
+                names.push_back(paramNames_[ii] + ".min") ;
+                names.push_back(paramNames_[ii] + ".max") ;
+                units.insert(units.end() , 4 , paramUnits_[ii]) ;
+                for ( jj = 0 ; jj < quantiles_.size() ; jj++ ) {
+                        // p05, p50, p99_9 ...
+                        snprintf(suffix , sizeof(suffix) , ".p%02g" , quantiles_[jj] * 100.0) ;
+                        for ( char * cp = suffix + 2 ; *cp ; cp++ ) {
+                                if ( *cp == '.' ) {
+                                        *cp = '_' ;
+                                }
+                        }
+                        names.push_back(paramNames_[ii] + suffix) ;
+                        units.push_back(paramUnits_[ii]) ;
+                }
+        }
+
+        TRICK_GET_BYTE_ORDER(byte_order) ;
+        ok = ( fwrite(( byte_order == TRICK_LITTLE_ENDIAN ) ? "Trick-10-L" : "Trick-10-B" , 10 , 1 , fp ) == 1 ) ;
+
+        num_params = (int)names.size() ;
+        ok = ok && ( fwrite(&num_params , 4 , 1 , fp) == 1 ) ;
+        type = TRICK_DOUBLE ;
+        size = sizeof(double) ;
+        for ( ii = 0 ; ok && ii < names.size() ; ii++ ) {
+                len = (int)names[ii].size() ;
+                ok = ( fwrite(&len , 4 , 1 , fp) == 1 && fwrite(names[ii].c_str() , len , 1 , fp) == 1 ) ;
+                len = (int)units[ii].size() ;
+                ok = ok && ( fwrite(&len , 4 , 1 , fp) == 1 && fwrite(units[ii].c_str() , len , 1 , fp) == 1 ) ;
+                ok = ok && ( fwrite(&type , 4 , 1 , fp) == 1 && fwrite(&size , 4 , 1 , fp) == 1 ) ;
+        }
+        return( ok ) ;
+}
+
+long MonteStats::write( const char * fileName ) {
+
+        FILE * fp ;
+        vector< Stats * > stats ;
+        vector< double > record ;
+        unsigned int ii , jj , kk ;
+        double time , bin_end ;
+        double t , v , last ;
+        bool have_value ;
+        long num_records = 0 ;
+
+        if ( ! openStreams_() ) {
+                cerr << "ERROR: None of the variables were found in the runs." << endl ;
+                closeStreams_() ;
+                return(-1) ;
+        }
+
+        if ((fp = fopen(fileName , "w")) == NULL ) {
+                cerr << "ERROR: Couldn't open \"" << fileName << "\" for writing." << endl ;
+                closeStreams_() ;
+                return(-1) ;
+        }
+
+        if ( ! writeHeader_(fp) ) {
+                num_records = -1 ;
+        }
+
+        for ( ii = 0 ; ii < paramNames_.size() ; ii++ ) {
+                stats.push_back(new Stats(compression_)) ;
+        }
+        record.resize(1 + paramNames_.size() * (5 + quantiles_.size())) ;
+
+        while ( num_records >= 0 && nextTime_(&time) ) {
+
+                // The bin starts at the earliest unread time stamp, or the
+                // start of the fixed width bin holding it.
+                if ( binWidth_ > 0.0 ) {
+                        time = floor(time / binWidth_ + timeMatchTolerance_ / binWidth_) * binWidth_ ;
+                        bin_end = time + binWidth_ - timeMatchTolerance_ ;
+                } else {
+                        bin_end = time + timeMatchTolerance_ ;
+                }
+
+                record[0] = time ;
+
+                // Each run contributes the last value it logged in the bin
+                for ( jj = 0 ; jj < sources_.size() ; jj++ ) {
+                        for ( kk = 0 ; kk < sources_[jj].size() ; kk++ ) {
+                                Source & source = sources_[jj][kk] ;
+                                have_value = false ;
+                                last = 0.0 ;
+                                if ( source.log != NULL ) {
+                                        while ( source.peek(&t , &v) && t <= bin_end ) {
+                                                source.record++ ;
+                                                have_value = true ;
+                                        }
+                                        for ( ii = 0 ; have_value && ii < source.vars.size() ; ii++ ) {
+                                                stats[source.vars[ii]]->add(
+                                                 source.log->getValue(source.record - 1 , source.params[ii])) ;
+                                        }
+                                } else {
+                                        while ( source.peek(&t , &v) && t <= bin_end ) {
+                                                source.stream->get(&t , &last) ;
+                                                have_value = true ;
+                                        }
+                                        if ( have_value ) {
+                                                stats[source.vars[0]]->add(last) ;
+                                        }
+                                }
+                        }
+                }
+
+                kk = 1 ;
+                for ( ii = 0 ; ii < paramNames_.size() ; ii++ ) {
+                        Stats & s = *stats[ii] ;
+                        record[kk++] = s.count ;
+                        if ( s.count > 0 ) {
+                                record[kk++] = s.mean ;
+                                record[kk++] = ( s.count > 1 ) ? sqrt(s.m2 / (s.count - 1)) : 0.0 ;
+                                record[kk++] = s.min ;
+                                record[kk++] = s.max ;
+                                for ( jj = 0 ; jj < quantiles_.size() ; jj++ ) {
+                                        record[kk++] = s.digest.quantile(quantiles_[jj]) ;
+                                }
+                        } else {
+                                for ( jj = 0 ; jj < 4 + quantiles_.size() ; jj++ ) {
+                                        record[kk++] = NAN ;
+                                }
+                        }
+                        s.clear() ;
+                }
+
+                if ( fwrite(&record[0] , sizeof(double) , record.size() , fp) != record.size() ) {
+                        num_records = -1 ;
+                } else {
+                        num_records++ ;
+                }
+        }
+
+        for ( ii = 0 ; ii < stats.size() ; ii++ ) {
+                delete stats[ii] ;
+        }
+        closeStreams_() ;
+
+        if ( fclose(fp) != 0 || num_records < 0 ) {
+                cerr << "ERROR: Couldn't write \"" << fileName << "\"." << endl ;
+                return(-1) ;
+        }
+        return(num_records) ;
+}
@@ -0,0 +1,98 @@
+
+#ifndef MONTESTATS_HH
+#define MONTESTATS_HH
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "DataStream.hh"
+#include "TrickBinaryLog.hh"
+#include "TDigest.hh"
+
+// Statistics of variables across the runs of a Monte Carlo campaign.
+//
+// All runs are read in lockstep, one time bin at a time, and each variable's
+// values in the bin are folded into running statistics: count, mean and
+// standard deviation (Welford), minimum, maximum and t-digest quantiles.
+// A bin's statistics are written as soon as the bin is complete, so the
+// statistics take the same memory for 10 runs or 10000.  Each run keeps one
+// reader and one position per log file it is read from, shared by all of the
+// variables in that log, so a run costs the same for 1 variable or 100.
+//
+// The result is an "envelope" Trick binary log with sys.exec.out.time and,
+// for each variable <var>, the parameters <var>.count, <var>.mean,
+// <var>.std, <var>.min, <var>.max and <var>.p<NN> for each quantile.
+class MonteStats {
+
+      public:
+
+        MonteStats() ;
+        ~MonteStats() ;
+
+        void addRun( const char * runDir ) ;
+        void addVariable( const char * paramName ) ;
+
+        // Width of the time bins.  With the default of 0, each distinct
+        // time stamp is a bin.  Otherwise a run contributes the last value
+        // it logged in each bin.
+        void setBinWidth( double width ) ;
+
+        // Time stamps within the tolerance are the same time stamp.
+        void setTimeMatchTolerance( double tolerance ) ;
+
+        // Quantiles in [0,1] to write, 0.05, 0.5 and 0.95 by default.
+        void setQuantiles( const vector< double > & quantiles ) ;
+
+        // t-digest compression, larger is more accurate and slower.
+        void setCompression( double compression ) ;
+
+        // Reads all runs and writes the envelope log.  Returns the number
+        // of records written, -1 if no variable could be read or the log
+        // could not be written.
+        long write( const char * fileName ) ;
+
+      private:
+
+        struct Stats {
+                Stats( double compression ) : digest(compression) { clear() ; }
+                void clear() ;
+                void add( double value ) ;
+
+                long count ;
+                double mean ;
+                double m2 ;     // sum of squared differences from the mean
+                double min ;
+                double max ;
+                TDigest digest ;
+        } ;
+
+        // A log file of a run and the variables read from it.  The
+        // variables of a Trick binary log are read straight from the log
+        // shared by its stream, other streams hold a single variable.
+        struct Source {
+                DataStream * stream ;
+                TrickBinaryLog * log ;  // the stream's log, NULL if not a Trick binary log
+                long record ;           // next record of log
+                vector< int > vars ;    // index of each variable in paramNames_
+                vector< int > params ;  // and its parameter in log
+                bool peek( double * time , double * value ) ;
+        } ;
+
+        bool openStreams_() ;
+        void closeStreams_() ;
+        bool nextTime_( double * time ) ;
+        bool writeHeader_( FILE * fp ) ;
+
+        vector< string > runDirs_ ;
+        vector< string > paramNames_ ;
+        vector< string > paramUnits_ ;
+        vector< double > quantiles_ ;
+        vector< vector< Source > > sources_ ;   // [run][log file]
+        double binWidth_ ;
+        double timeMatchTolerance_ ;
+        double compression_ ;
+} ;
+
+#endif
@@ -0,0 +1,140 @@
+
+#include <math.h>
+#include <float.h>
+#include <algorithm>
+#include "TDigest.hh"
+
+TDigest::TDigest( double compression ) {
+
+        compression_ = ( compression < 10.0 ) ? 10.0 : compression ;
+        bufferSize_ = (size_t)compression_ * 5 ;
+        centroids_.reserve((size_t)compression_ * 2) ;
+        buffer_.reserve(bufferSize_ + centroids_.capacity()) ;
+        clear() ;
+}
+
+void TDigest::clear() {
+
+        centroids_.clear() ;
+        buffer_.clear() ;
+        totalWeight_ = 0.0 ;
+        bufferWeight_ = 0.0 ;
+        min_ = DBL_MAX ;
+        max_ = -DBL_MAX ;
+}
+
+void TDigest::add( double value , double weight ) {
+
+        Centroid c ;
+
+        if ( isnan(value) || weight <= 0.0 ) {
+                return ;
+        }
+        c.mean = value ;
+        c.weight = weight ;
+        buffer_.push_back(c) ;
+        bufferWeight_ += weight ;
+        if ( value < min_ ) {
+                min_ = value ;
+        }
+        if ( value > max_ ) {
+                max_ = value ;
+        }
+        if ( buffer_.size() >= bufferSize_ ) {
+                merge_() ;
+        }
+}
+
+// The largest quantile the centroid starting at quantile q may reach.  This
+// is the k1 scale function of the paper, k(q) = compression/(2 pi) asin(2q - 1),
+// stepped by one.
+double TDigest::maxQuantile_( double q ) const {
+
+        double k = compression_ / (2.0 * M_PI) * asin(2.0 * q - 1.0) + 1.0 ;
+
+        if ( k >= compression_ / 4.0 ) {
+                return 1.0 ;
+        }
+        return ( sin(k * 2.0 * M_PI / compression_) + 1.0 ) / 2.0 ;
+}
+
+void TDigest::merge_() {
+
+        unsigned int ii ;
+        double total ;
+        double weight_so_far ;
+        double q_limit ;
+        Centroid cur ;
+
+        if ( buffer_.empty() ) {
+                return ;
+        }
+
+        buffer_.insert(buffer_.end() , centroids_.begin() , centroids_.end()) ;
+        std::sort(buffer_.begin() , buffer_.end()) ;
+        total = totalWeight_ + bufferWeight_ ;
+
+        merged_.clear() ;
+        cur = buffer_[0] ;
+        weight_so_far = 0.0 ;
+        q_limit = maxQuantile_(0.0) ;
+        for ( ii = 1 ; ii < buffer_.size() ; ii++ ) {
+                if ( (weight_so_far + cur.weight + buffer_[ii].weight) / total <= q_limit ) {
+                        cur.mean += (buffer_[ii].mean - cur.mean) * buffer_[ii].weight /
+                                    (cur.weight + buffer_[ii].weight) ;
+                        cur.weight += buffer_[ii].weight ;
+                } else {
+                        weight_so_far += cur.weight ;
+                        merged_.push_back(cur) ;
+                        q_limit = maxQuantile_(weight_so_far / total) ;
+                        cur = buffer_[ii] ;
+                }
+        }
+        merged_.push_back(cur) ;
+
+        centroids_.swap(merged_) ;
+        totalWeight_ = total ;
+        buffer_.clear() ;
+        bufferWeight_ = 0.0 ;
+}
+
+double TDigest::quantile( double q ) {
+
+        unsigned int ii ;
+        double target ;
+        double left , right ;
+
+        merge_() ;
+
+        if ( centroids_.empty() ) {
+                return(0.0) ;
+        }
+        if ( centroids_.size() == 1 || q <= 0.0 ) {
+                return( q <= 0.0 ? min_ : centroids_[0].mean ) ;
+        }
+        if ( q >= 1.0 ) {
+                return(max_) ;
+        }
+
+        // Each centroid's mean sits at the middle of its weight.  Interpolate
+        // between the neighboring centroid middles, or between the extreme
+        // values and the outer centroids at the tails.
+        target = q * totalWeight_ ;
+        left = centroids_[0].weight / 2.0 ;
+        if ( target < left ) {
+                return( min_ + (centroids_[0].mean - min_) * target / left ) ;
+        }
+        for ( ii = 1 ; ii < centroids_.size() ; ii++ ) {
+                right = left + (centroids_[ii - 1].weight + centroids_[ii].weight) / 2.0 ;
+                if ( target < right ) {
+                        return( centroids_[ii - 1].mean + (centroids_[ii].mean - centroids_[ii - 1].mean) *
+                                (target - left) / (right - left) ) ;
+                }
+                left = right ;
+        }
+        right = totalWeight_ ;
+        if ( right <= left ) {
+                return(max_) ;
+        }
+        return( centroids_.back().mean + (max_ - centroids_.back().mean) * (target - left) / (right - left) ) ;
+}
@@ -0,0 +1,50 @@
+
+#ifndef TDIGEST_HH
+#define TDIGEST_HH
+
+#include <vector>
+
+// A merging t-digest (Dunning and Ertl) for estimating quantiles of a stream
+// of values in bounded memory.
+//
+// Values are buffered and merged into at most about compression centroids.
+// Centroids near the tails hold few values, so extreme quantiles stay
+// accurate.  Memory does not grow with the number of values added.
+class TDigest {
+
+       public:
+
+               TDigest( double compression = 100.0 ) ;
+
+               void add( double value , double weight = 1.0 ) ;
+
+               // Returns the estimated value at quantile q in [0,1], 0 if
+               // nothing was added.
+               double quantile( double q ) ;
+
+               double getCount() const { return totalWeight_ + bufferWeight_ ; }
+               void clear() ;
+
+       private:
+
+               struct Centroid {
+                       double mean ;
+                       double weight ;
+                       bool operator<( const Centroid & other ) const { return mean < other.mean ; }
+               } ;
+
+               void merge_() ;
+               double maxQuantile_( double q ) const ;
+
+               double compression_ ;
+               std::vector< Centroid > centroids_ ;   // sorted by mean
+               std::vector< Centroid > buffer_ ;      // not merged yet
+               std::vector< Centroid > merged_ ;      // scratch space for merge_()
+               size_t bufferSize_ ;                   // values buffered before merging
+               double totalWeight_ ;                  // of centroids_
+               double bufferWeight_ ;
+               double min_ ;
+               double max_ ;
+} ;
+
+#endif
@@ -4,6 +4,7 @@
 
 #include <stdio.h>
 #include "DataStream.hh"
+#include "TrickBinaryLog.hh"
 
 class TrickBinary : public DataStream {
 
@@ -13,23 +14,20 @@ class TrickBinary : public DataStream {
 
                int get(double * time , double * value ) ;
                int peek(double * time , double * value ) ;
+               int getBlock(double * times , double * values , int max ) ;
+               int seekTime(double time ) ;
 
                void begin() ;
                int end() ;
                int step() ;
 
+               // The log shared by all streams reading this file
+               TrickBinaryLog * getLog() { return log_ ; }
+
        private:
-               FILE *fp_ ;
-               int swap_ ;
-               int time_size_ ;
-               int num_params_ ;
-               int record_offset_ ;
-               int record_size_ ;
-               char * record_ ;
-               int type_ ;
-               int size_ ;
-
-               int data_offset_ ;
+               TrickBinaryLog * log_ ;  // shared with other streams reading this file
+               int param_ ;
+               long record_ ;           // next record get() returns
 
 } ;
 
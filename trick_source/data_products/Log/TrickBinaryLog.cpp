@@ -0,0 +1,565 @@
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "TrickBinaryLog.hh"
+#include "trick/parameter_types.h"
+#include "trick_byteswap.h"
+#include "trick/units_conv.h"
+#include "trick/trk_columns.h"
+
+// Logs currently open, by file name
+static std::map< std::string , TrickBinaryLog * > open_logs ;
+static pthread_mutex_t open_logs_mutex = PTHREAD_MUTEX_INITIALIZER ;
+
+// A log modified less than this many seconds ago may still be recorded, and
+// is read into memory instead of mapped
+static const time_t settle_seconds = 2 ;
+
+// The recorded types for 05 & 07 are 1 less than Trick10 types
+static int seven_to_ten_type( int type ) {
+
+        switch ( type ) {
+                case 0: return TRICK_CHARACTER ;
+                case 1: return TRICK_UNSIGNED_CHARACTER ;
+                case 2: return TRICK_STRING ;
+                case 3: return TRICK_SHORT ;
+                case 4: return TRICK_UNSIGNED_SHORT ;
+                case 5: return TRICK_INTEGER ;
+                case 6: return TRICK_UNSIGNED_INTEGER ;
+                case 7: return TRICK_LONG ;
+                case 8: return TRICK_UNSIGNED_LONG ;
+                case 9: return TRICK_FLOAT ;
+                case 10: return TRICK_DOUBLE ;
+                case 11: return TRICK_BITFIELD ;
+                case 12: return TRICK_UNSIGNED_BITFIELD ;
+                case 13: return TRICK_LONG_LONG ;
+                case 14: return TRICK_UNSIGNED_LONG_LONG ;
+                case 15: return TRICK_FILE_PTR ;
+                case 16: return TRICK_VOID ;
+                case 17: return TRICK_BOOLEAN ;
+                // 18 = TRICK_COMPLX , 19 = TRICK_DBL_COMPLX , 20 = TRICK_REF. These don't exist in 10
+                case 21: return TRICK_WCHAR ;
+                case 22: return TRICK_WSTRING ;
+                case 99: return TRICK_VOID_PTR ;
+                case 102: return TRICK_ENUMERATED ;
+                case 103: return TRICK_STRUCTURED ;
+                default: return TRICK_VOID ;
+        }
+}
+
+TrickBinaryLog * TrickBinaryLog::open( const char * file_name ) {
+
+        struct stat st ;
+        TrickBinaryLog * log ;
+        std::map< std::string , TrickBinaryLog * >::iterator it ;
+
+        int fd = ::open(file_name , O_RDONLY) ;
+        if ( fd < 0 || fstat(fd , &st) != 0 ) {
+                std::cerr << "ERROR:  Couldn't open \"" << file_name << "\": " << std::strerror(errno) << std::endl;
+                if ( fd >= 0 ) {
+                        ::close(fd) ;
+                }
+                return NULL ;
+        }
+
+        pthread_mutex_lock(&open_logs_mutex) ;
+
+        it = open_logs.find(file_name) ;
+        if ( it != open_logs.end() ) {
+                log = it->second ;
+                if ( log->dev_ == st.st_dev && log->ino_ == st.st_ino &&
+                     log->fileSize_ == st.st_size && log->mtime_ == trk_columns_mtime(&st) ) {
+                        log->refCount_++ ;
+                        pthread_mutex_unlock(&open_logs_mutex) ;
+                        ::close(fd) ;
+                        return log ;
+                }
+                // The file was rewritten.  Current readers keep the old mapping.
+                open_logs.erase(it) ;
+        }
+
+        log = new TrickBinaryLog(file_name) ;
+
+        if ( ! log->load_(fd , st) || ! log->parseHeader_() ) {
+                delete log ;
+                log = NULL ;
+        } else {
+                log->mapColumns_() ;
+                open_logs[file_name] = log ;
+        }
+
+        pthread_mutex_unlock(&open_logs_mutex) ;
+        ::close(fd) ;
+        return log ;
+}
+
+void TrickBinaryLog::close( TrickBinaryLog * log ) {
+
+        std::map< std::string , TrickBinaryLog * >::iterator it ;
+
+        if ( log == NULL ) {
+                return ;
+        }
+
+        pthread_mutex_lock(&open_logs_mutex) ;
+        if ( --log->refCount_ == 0 ) {
+                it = open_logs.find(log->fileName_) ;
+                if ( it != open_logs.end() && it->second == log ) {
+                        open_logs.erase(it) ;
+                }
+                delete log ;
+        }
+        pthread_mutex_unlock(&open_logs_mutex) ;
+}
+
+TrickBinaryLog::TrickBinaryLog( const char * file_name ) :
+ fileName_(file_name) , refCount_(1) , dev_(0) , ino_(0) , fileSize_(0) , mtime_(0) ,
+ map_addr_(NULL) , map_size_(0) , mapped_(false) , swap_(0) , timeSize_(8) , timeParam_(-1) ,
+ recordSize_(0) , dataOffset_(0) , numRecords_(0) ,
+ colAddr_(NULL) , colSize_(0) , colIndex_(NULL) , colIndexStride_(0) , colNumIndex_(0) ,
+ colData_(NULL) , timeSorted_(false) {
+}
+
+// Called with open_logs_mutex held, by close() or when open() fails
+TrickBinaryLog::~TrickBinaryLog() {
+        if ( map_addr_ ) {
+                if ( mapped_ ) {
+                        munmap(map_addr_ , map_size_) ;
+                } else {
+                        delete [] map_addr_ ;
+                }
+        }
+        if ( colAddr_ ) {
+                munmap(colAddr_ , colSize_) ;
+        }
+}
+
+// Maps the file if it is stable, else reads it into memory.  A file is
+// stable if it was last modified settle_seconds ago and does not change while
+// it is mapped.  A file still being recorded may be truncated or rewritten,
+// and reading a mapped page past the end of a file raises SIGBUS, so only
+// stable files are mapped.  st is the fstat of fd taken before the call.
+bool TrickBinaryLog::load_( int fd , const struct stat & st ) {
+
+        struct stat now ;
+
+        dev_ = st.st_dev ;
+        ino_ = st.st_ino ;
+        fileSize_ = st.st_size ;
+        mtime_ = trk_columns_mtime(&st) ;
+
+        if ( st.st_size <= 0 ) {
+                return false ;
+        }
+        if ( time(NULL) - st.st_mtime >= settle_seconds && map_(fd , (size_t)st.st_size) ) {
+                // Only trust the mapping if the file is still the size it was mapped at
+                if ( fstat(fd , &now) == 0 && now.st_size == st.st_size && trk_columns_mtime(&now) == mtime_ ) {
+                        return true ;
+                }
+                munmap(map_addr_ , map_size_) ;
+                map_addr_ = NULL ;
+                map_size_ = 0 ;
+                mapped_ = false ;
+        }
+
+        // The file is being written.  Read what is there now; fileSize_ and mtime_
+        // are from before the read so open() reads it again once it changes.
+        if ( fstat(fd , &now) != 0 || now.st_size <= 0 ) {
+                return false ;
+        }
+        fileSize_ = now.st_size ;
+        mtime_ = trk_columns_mtime(&now) ;
+        return read_(fd , (size_t)now.st_size) ;
+}
+
+bool TrickBinaryLog::map_( int fd , size_t size ) {
+
+        void * addr ;
+
+        if ((addr = mmap(NULL , size , PROT_READ , MAP_PRIVATE , fd , 0)) == MAP_FAILED ) {
+                return false ;
+        }
+        map_addr_ = (char *)addr ;
+        map_size_ = size ;
+        mapped_ = true ;
+        return true ;
+}
+
+bool TrickBinaryLog::read_( int fd , size_t size ) {
+
+        size_t pos = 0 ;
+        ssize_t num ;
+
+        map_addr_ = new char[size] ;
+        mapped_ = false ;
+        while ( pos < size && (num = pread(fd , map_addr_ + pos , size - pos , pos)) != 0 ) {
+                if ( num < 0 ) {
+                        if ( errno == EINTR ) {
+                                continue ;
+                        }
+                        std::cerr << "ERROR:  Couldn't read \"" << fileName_ << "\": " << std::strerror(errno) << std::endl;
+                        return false ;
+                }
+                pos += num ;
+        }
+        // A file truncated while it was read ends where the read ended
+        map_size_ = pos ;
+        return pos > 0 ;
+}
+
+bool TrickBinaryLog::parseHeader_() {
+
+        const size_t file_type_len = 10 ;
+        char file_type[file_type_len + 1] ;
+        int my_byte_order ;
+        int num_params ;
+        int len ;
+        int ii ;
+        size_t pos ;
+
+#define TBL_READ(dest, num) \
+        if ( (num) < 0 || pos + (size_t)(num) > map_size_ ) { return false ; } \
+        memcpy((dest) , map_addr_ + pos , (num)) ; \
+        pos += (num) ;
+
+#define TBL_READ_INT(dest) \
+        TBL_READ(&(dest), 4) \
+        if ( swap_ ) { dest = trick_byteswap_int(dest) ; }
+
+        pos = 0 ;
+        TBL_READ(file_type , (int)file_type_len) ;
+        file_type[file_type_len] = '\0' ;
+
+        if ( strncmp( file_type , "Trick-05" , 8 ) &&
+             strncmp( file_type , "Trick-07" , 8 ) &&
+             strncmp( file_type , "Trick-10" , 8 ) ) {
+                return false ;
+        }
+
+        TRICK_GET_BYTE_ORDER(my_byte_order) ;
+        switch ( file_type[file_type_len - 1] ) {
+            case 'L':
+                    swap_ = ( my_byte_order == TRICK_LITTLE_ENDIAN ) ? 0 : 1 ;
+                    break ;
+            case 'B':
+                    swap_ = ( my_byte_order == TRICK_BIG_ENDIAN ) ? 0 : 1 ;
+                    break ;
+        }
+
+        TBL_READ_INT(num_params) ;
+        if ( num_params < 0 ) {
+                return false ;
+        }
+
+        recordSize_ = 0 ;
+        for ( ii = 0  ; ii < num_params ; ii++ ) {
+
+                Param param ;
+
+                // name
+                TBL_READ_INT(len) ;
+                if ( len < 0 || pos + len > map_size_ ) {
+                        return false ;
+                }
+                param.name.assign(map_addr_ + pos , len) ;
+                pos += len ;
+
+                // units
+                TBL_READ_INT(len) ;
+                if ( len < 0 || pos + len > map_size_ ) {
+                        return false ;
+                }
+                param.units.assign(map_addr_ + pos , len) ;
+                pos += len ;
+
+                // If this is an 05 log file, we need to convert the units to 07 units
+                // ( where explicit asterisk for multiplication is required. )
+                if ( !strncmp( file_type , "Trick-05" , 8 ) )  {
+                        char new_units_spec[100];
+                        new_units_spec[0] = 0;
+                        if ( convert_units_spec (param.units.c_str(), new_units_spec) != 0 ) {
+                                printf (" ERROR: Attempt to convert Trick-05 units spec \"%s\" failed.\n\n",param.units.c_str());
+                        }
+                        param.units = new_units_spec ;
+                }
+
+                // type of param
+                TBL_READ_INT(param.type) ;
+                if ( strncmp( file_type , "Trick-10" , 8 ) )  {
+                        param.type = seven_to_ten_type(param.type) ;
+                }
+
+                // size of param
+                TBL_READ_INT(param.size) ;
+                if ( param.size < 0 ) {
+                        return false ;
+                }
+
+                // correct the "type" according to the size recorded
+                switch ( param.type ) {
+                    case TRICK_LONG:
+                        if ( param.size == 4 ) {
+                            param.type = TRICK_INTEGER ;
+                        } else if ( param.size == 8 ) {
+                            param.type = TRICK_LONG_LONG ;
+                        }
+                        break ;
+                    case TRICK_UNSIGNED_LONG:
+                        if ( param.size == 4 ) {
+                            param.type = TRICK_UNSIGNED_INTEGER ;
+                        } else if ( param.size == 8 ) {
+                            param.type = TRICK_UNSIGNED_LONG_LONG ;
+                        }
+                        break ;
+                    default:
+                        break ;
+                }
+
+                if ( param.name == "sys.exec.out.time" ) {
+                        timeSize_ = param.size ;
+                        timeParam_ = ii ;
+                }
+
+                param.offset = recordSize_ ;
+                recordSize_ += param.size ;
+
+                // The first occurrence of a name wins, as it did when searching the header
+                paramIndex_.insert(std::pair< std::string , int >(param.name , ii)) ;
+                params_.push_back(param) ;
+        }
+
+#undef TBL_READ_INT
+#undef TBL_READ
+
+        dataOffset_ = pos ;
+        if ( recordSize_ > 0 ) {
+                // A partially written last record is not read
+                numRecords_ = (map_size_ - dataOffset_) / recordSize_ ;
+        }
+
+        return true ;
+}
+
+bool TrickBinaryLog::mapColumns_() {
+
+        std::string col_name = fileName_ + TRK_COLUMNS_SUFFIX ;
+        TRK_COLUMNS_HEADER header ;
+        struct stat st ;
+        void * addr ;
+        int fd ;
+
+        if ((fd = ::open(col_name.c_str() , O_RDONLY)) < 0 ) {
+                return false ;
+        }
+        if ( fstat(fd , &st) != 0 || (size_t)st.st_size < sizeof(header) ||
+             read(fd , &header , sizeof(header)) != (ssize_t)sizeof(header) ) {
+                ::close(fd) ;
+                return false ;
+        }
+
+        // Only use the sidecar if it was written from the log as it is now
+        if ( memcmp(header.magic , trk_columns_magic() , 8 ) ||
+             header.trk_size != (int64_t)fileSize_ || header.trk_mtime != mtime_ ||
+             header.num_params != (int32_t)params_.size() || header.num_records != numRecords_ ||
+             header.index_stride <= 0 ||
+             header.num_index != (numRecords_ + header.index_stride - 1) / header.index_stride ||
+             (int64_t)st.st_size != (int64_t)(sizeof(header) +
+              (header.num_index + header.num_params * header.num_records) * sizeof(double)) ) {
+                ::close(fd) ;
+                return false ;
+        }
+
+        addr = mmap(NULL , st.st_size , PROT_READ , MAP_PRIVATE , fd , 0) ;
+        ::close(fd) ;
+        if ( addr == MAP_FAILED ) {
+                return false ;
+        }
+
+        colAddr_ = (char *)addr ;
+        colSize_ = st.st_size ;
+        colIndex_ = (const double *)(colAddr_ + sizeof(header)) ;
+        colIndexStride_ = header.index_stride ;
+        colNumIndex_ = header.num_index ;
+        colData_ = colIndex_ + colNumIndex_ ;
+        timeSorted_ = ( header.time_sorted != 0 ) ;
+        return true ;
+}
+
+int TrickBinaryLog::findParam( const char * name ) const {
+
+        std::map< std::string , int >::const_iterator it = paramIndex_.find(name) ;
+        if ( it == paramIndex_.end() ) {
+                return -1 ;
+        }
+        return it->second ;
+}
+
+// The sidecar holds values decoded the same way, see trick/trk_columns.h
+double TrickBinaryLog::decode_( const char * ptr , int type , int size ) const {
+        return trk_columns_value(ptr , type , size , swap_) ;
+}
+
+double TrickBinaryLog::getTime( long record ) const {
+        if ( colData_ ) {
+                return colData_[record] ;
+        }
+        const char * ptr = map_addr_ + dataOffset_ + record * recordSize_ ;
+        return decode_(ptr , ( timeSize_ == 8 ) ? TRICK_DOUBLE : TRICK_FLOAT , timeSize_) ;
+}
+
+long TrickBinaryLog::extractTimes( long first , long count , double * out ) const {
+
+        long ii ;
+        const char * ptr ;
+
+        if ( first < 0 || first >= numRecords_ || count <= 0 ) {
+                return 0 ;
+        }
+        if ( count > numRecords_ - first ) {
+                count = numRecords_ - first ;
+        }
+
+        if ( colData_ ) {
+                memcpy(out , colData_ + first , count * sizeof(double)) ;
+                return count ;
+        }
+
+        ptr = map_addr_ + dataOffset_ + first * recordSize_ ;
+        if ( timeSize_ == 8 && ! swap_ ) {
+                for ( ii = 0 ; ii < count ; ii++ , ptr += recordSize_ ) {
+                        memcpy(&out[ii] , ptr , sizeof(double)) ;
+                }
+        } else {
+                for ( ii = 0 ; ii < count ; ii++ , ptr += recordSize_ ) {
+                        out[ii] = decode_(ptr , ( timeSize_ == 8 ) ? TRICK_DOUBLE : TRICK_FLOAT , timeSize_) ;
+                }
+        }
+        return count ;
+}
+
+double TrickBinaryLog::getValue( long record , int param ) const {
+        if ( colData_ ) {
+                return colData_[param * numRecords_ + record] ;
+        }
+        const Param & p = params_[param] ;
+        return decode_(map_addr_ + dataOffset_ + record * recordSize_ + p.offset , p.type , p.size) ;
+}
+
+long TrickBinaryLog::extractColumn( int param , long first , long count , double * out ) const {
+        return extractColumns( 1 , &param , first , count , &out ) ;
+}
+
+long TrickBinaryLog::extractColumns( int num_params , const int * params ,
+                                     long first , long count , double ** out ) const {
+
+        long ii ;
+        int jj ;
+        const char * record ;
+
+        if ( first < 0 || first >= numRecords_ || count <= 0 ) {
+                return 0 ;
+        }
+        if ( count > numRecords_ - first ) {
+                count = numRecords_ - first ;
+        }
+
+        if ( colData_ ) {
+                for ( jj = 0 ; jj < num_params ; jj++ ) {
+                        memcpy(out[jj] , colData_ + params[jj] * numRecords_ + first , count * sizeof(double)) ;
+                }
+                return count ;
+        }
+
+        record = map_addr_ + dataOffset_ + first * recordSize_ ;
+
+        // Native doubles are by far the most common, copy them without decoding
+        if ( num_params == 1 && ! swap_ &&
+             params_[params[0]].type == TRICK_DOUBLE && params_[params[0]].size == sizeof(double) ) {
+                const char * ptr = record + params_[params[0]].offset ;
+                double * dest = out[0] ;
+                for ( ii = 0 ; ii < count ; ii++ , ptr += recordSize_ ) {
+                        memcpy(&dest[ii] , ptr , sizeof(double)) ;
+                }
+                return count ;
+        }
+
+        for ( ii = 0 ; ii < count ; ii++ , record += recordSize_ ) {
+                for ( jj = 0 ; jj < num_params ; jj++ ) {
+                        const Param & p = params_[params[jj]] ;
+                        out[jj][ii] = decode_(record + p.offset , p.type , p.size) ;
+                }
+        }
+        return count ;
+}
+
+long TrickBinaryLog::findTime( double time ) const {
+
+        long low , high , mid ;
+
+        if ( ! timeSorted_ ) {
+                // Records may be out of time order, look at every one
+                for ( low = 0 ; low < numRecords_ && getTime(low) < time ; low++ ) ;
+                return low ;
+        }
+
+        // Narrow the search to one stride of records with the sparse index ...
+        low = 0 ;
+        high = colNumIndex_ ;
+        while ( low < high ) {
+                mid = (low + high) / 2 ;
+                if ( colIndex_[mid] < time ) {
+                        low = mid + 1 ;
+                } else {
+                        high = mid ;
+                }
+        }
+        // ... index entry low is the first >= time, the record is after the entry before it
+        high = ( low < colNumIndex_ ) ? low * colIndexStride_ : numRecords_ ;
+        low = ( low > 0 ) ? (low - 1) * colIndexStride_ : 0 ;
+
+        // ... then search the time column within it
+        while ( low < high ) {
+                mid = (low + high) / 2 ;
+                if ( colData_[mid] < time ) {
+                        low = mid + 1 ;
+                } else {
+                        high = mid ;
+                }
+        }
+        return low ;
+}
+
+int TrickBinaryLog::writeColumns() const {
+
+        std::string col_name = fileName_ + TRK_COLUMNS_SUFFIX ;
+        const int num_params = params_.size() ;
+        std::vector< int > types(num_params) ;
+        std::vector< int > sizes(num_params) ;
+        std::vector< int64_t > offsets(num_params) ;
+        int jj ;
+
+        // The time is always the first parameter of a record
+        for ( jj = 0 ; jj < num_params ; jj++ ) {
+                types[jj] = params_[jj].type ;
+                sizes[jj] = params_[jj].size ;
+                offsets[jj] = params_[jj].offset ;
+        }
+
+        // Written beside and renamed over the sidecar, which may be mapped by readers
+        if ( num_params == 0 ||
+             trk_columns_write(col_name.c_str() , map_addr_ + dataOffset_ , numRecords_ , recordSize_ ,
+              num_params , &types[0] , &sizes[0] , &offsets[0] , swap_ , fileSize_ , mtime_) != 0 ) {
+                std::cerr << "ERROR:  Couldn't write \"" << col_name << "\": " << std::strerror(errno) << std::endl;
+                return -1 ;
+        }
+        return 0 ;
+}
@@ -0,0 +1,132 @@
+
+#ifndef TRICKBINARYLOG_HH
+#define TRICKBINARYLOG_HH
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+
+// A Trick binary log file (.trk) mapped into memory.
+//
+// All DataStreams reading the same file share one TrickBinaryLog, so the
+// header is parsed once and records are read straight out of the mapping.
+// Logs are reference counted, get one with open() and give it back with
+// close().
+//
+// If the log has an up to date columnar sidecar (see trick/trk_columns.h),
+// values are read from its columns and its time index is used to seek.
+//
+// Only logs that are not being recorded are mapped.  A log modified in the
+// last few seconds, or that changes while it is being opened, is read into
+// memory instead, and the next open() sees any later change and reads the
+// file again.  Sidecars are replaced by rename, never rewritten in place, so
+// they are always mapped.
+class TrickBinaryLog {
+
+       public:
+
+               struct Param {
+                       std::string name ;
+                       std::string units ;   // as recorded, Trick-05 units converted
+                       int type ;            // TRICK_TYPE, corrected for its size
+                       int size ;
+                       int offset ;          // offset within a record
+               } ;
+
+               // Returns the shared log for file_name, or NULL if it is not
+               // a readable Trick binary log.  A log is mapped again if the
+               // file changed since it was last mapped.
+               static TrickBinaryLog * open( const char * file_name ) ;
+               static void close( TrickBinaryLog * log ) ;
+
+               const std::string & getFileName() const { return fileName_ ; }
+
+               int getNumParams() const { return (int)params_.size() ; }
+               const Param & getParam( int index ) const { return params_[index] ; }
+
+               // Returns the index of the named parameter, -1 if not found.
+               int findParam( const char * name ) const ;
+
+               // Returns the index of sys.exec.out.time, -1 if not found.
+               int getTimeParam() const { return timeParam_ ; }
+
+               long getNumRecords() const { return numRecords_ ; }
+
+               // Returns true if values come from the columnar sidecar.
+               bool hasColumns() const { return colAddr_ != NULL ; }
+
+               // Returns the first record whose time stamp is >= time, or
+               // getNumRecords() if there is none.  This is a binary search
+               // when the sidecar shows the time stamps are sorted, a scan
+               // otherwise.
+               long findTime( double time ) const ;
+
+               // Writes the columnar sidecar of this log.  Returns 0 on success.
+               int writeColumns() const ;
+
+               // Time stamp of a record.  The time stamp is the first
+               // value of each record.
+               double getTime( long record ) const ;
+
+               // Copies up to count time stamps starting at record first into
+               // out.  Returns the number of time stamps copied.
+               long extractTimes( long first , long count , double * out ) const ;
+
+               double getValue( long record , int param ) const ;
+
+               // Copies up to count values of param starting at record first
+               // into out.  Returns the number of values copied.
+               long extractColumn( int param , long first , long count , double * out ) const ;
+
+               // Same as extractColumn for several parameters, reading each
+               // record once.  out[ii] receives the values of params[ii].
+               long extractColumns( int num_params , const int * params ,
+                                    long first , long count , double ** out ) const ;
+
+       private:
+
+               TrickBinaryLog( const char * file_name ) ;
+               ~TrickBinaryLog() ;
+
+               bool load_( int fd , const struct stat & st ) ;
+               bool map_( int fd , size_t size ) ;
+               bool read_( int fd , size_t size ) ;
+               bool parseHeader_() ;
+               bool mapColumns_() ;
+               double decode_( const char * ptr , int type , int size ) const ;
+
+               std::string fileName_ ;
+               int refCount_ ;
+               dev_t dev_ ;
+               ino_t ino_ ;
+               off_t fileSize_ ;
+               int64_t mtime_ ;     // nanoseconds
+
+               char * map_addr_ ;
+               size_t map_size_ ;
+               bool mapped_ ;       // map_addr_ is a mapping, not a copy read into memory
+
+               int swap_ ;
+               int timeSize_ ;
+               int timeParam_ ;
+               std::vector< Param > params_ ;
+               std::map< std::string , int > paramIndex_ ;
+
+               long recordSize_ ;
+               long dataOffset_ ;
+               long numRecords_ ;
+
+               // Columnar sidecar, if there is a current one
+               char * colAddr_ ;
+               size_t colSize_ ;
+               const double * colIndex_ ;   // time of every colIndexStride_'th record
+               long colIndexStride_ ;
+               long colNumIndex_ ;
+               const double * colData_ ;    // numRecords_ values of each param in turn
+               bool timeSorted_ ;
+} ;
+
+#endif
@@ -1,4 +1,5 @@
 #include "trick/MemoryManager.hh"
+#include "trick/AttributesIndex.hh"
 #include "trick/parameter_types.h"
 #include "trick/io_alloc.h"
 #include "trick/wcs_ext.h"
@@ -144,60 +145,6 @@ void Trick::ClassicCheckPointAgent::write_decl(std::ostream& chkpnt_os, ALLOC_IN
 }
 
 
-// STATIC FUNCTION
-/* 
-   Given an offset, that is within the bounds of a composite
-   object (i.e., a struct or class instance), return the corresponding 
-   ATTRIBUTES pointer (singular).
-
-   Helper function for getCompositeSubReference.
-.
-*/
-
-static ATTRIBUTES* findMember(ATTRIBUTES* A, long referenceOffset) {
-    int i = 0;
-    int j;
-    int temp_size;
-    /* Find the member which contains the address pointed to by rAddr */
-    while ((A[i].name[0] != '\0')) {
-
-        // if mod bit 0 is set, A[i] is a reference. Width of reference is stored
-        // in mod bits 3-8. We could use sizeof(void*), but that is implementation
-        // specific and not required by C++ standard.
-        if ((A[i].mods & 1) == 1) {
-          temp_size = ((A[i].mods >> 3) & 0x3F);
-          // Calculate the size (temp_size) of the referenced member variable.
-        } else if (A[i].num_index != 0) {
-            // if size of last valid index is 0, then we are looking at a pointer
-            if (A[i].index[A[i].num_index - 1].size == 0) {
-                temp_size = sizeof(void*);
-            } else {
-                temp_size = A[i].size;
-            }
-            for (j = 0; j < A[i].num_index; j++) {
-                if (A[i].index[j].size != 0) {
-                    temp_size *= A[i].index[j].size;
-                } else {
-                    break;
-                }
-            }
-        } else {
-            temp_size = A[i].size;
-        }
-
-        // if the reference is not to this member variable, move on to the next member variable.
-        if ( ( referenceOffset <  (long) ( A[i].offset)   ) ||
-             ( referenceOffset >= (long) ( A[i].offset + temp_size))
-           ) {
-            i++;
-        } else {
-            break;
-        }
-    }
-
-    return &(A[i]);
-}
-
 // STATIC FUNCTION
 /*
    Given an address, that is within the bounds of a composite
@@ -250,7 +197,7 @@ static int getCompositeSubReference(
 
     // Find the structure member that corresponds to the reference address.
     // If name is empty, we have failed. 
-    Ai = findMember(A, referenceOffset);
+    Ai = Trick::AttributesIndex::get_index(A)->find_offset(referenceOffset);
 
 /******If failed to find member, set reference_name to offset only and return ****/
     if (Ai->name[0] == '\0') {
@@ -0,0 +1,244 @@
+/*
+PURPOSE:
+    ( Time stamp counter Clock )
+*/
+
+#include <time.h>
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define TRICK_HAS_TSC 1
+#endif
+
+#include "trick/TSCClock.hh"
+#include "trick/message_proto.h"
+#include "trick/message_type.h"
+
+/*
+ * Largest rate change used to remove an anchor error, in parts per million.  A clock further behind than this
+ * removes in one anchor_period is stepped forward.  A clock ahead is never stepped back, it runs this much slower
+ * until CLOCK_MONOTONIC catches up.
+ */
+#define TSC_MAX_SLEW_PPM 500
+
+/** @brief Reads the TSC after all earlier instructions have completed. */
+static inline unsigned long long read_tsc() {
+#if TRICK_HAS_TSC
+    _mm_lfence() ;
+    return __rdtsc() ;
+#else
+    return 0 ;
+#endif
+}
+
+/**
+@details
+-# Calls the base Clock constructor with nanosecond tics
+-# Choose the TSC if the CPU advertises an invariant one
+*/
+Trick::TSCClock::TSCClock() : Clock(1000000000ULL, "TSC") ,
+ calibration_time(0.01) ,
+ anchor_period(1.0) ,
+ use_tsc(invariant_tsc_available()) ,
+ tsc_frequency(0.0) ,
+ anchor_error(0) ,
+ anchor_seq(0) ,
+ anchor_tsc(0) ,
+ anchor_ns(0) ,
+ anchor_mult(0) ,
+ first_tsc(0) ,
+ first_ns(0) ,
+ period_tsc(0) {
+    if ( ! use_tsc ) {
+        name = "TSC - CLOCK_MONOTONIC" ;
+    }
+}
+
+/**
+@details
+-# On x86, the invariant TSC bit is bit 8 of EDX from CPUID leaf 0x80000007.
+-# Other processors report false.
+*/
+bool Trick::TSCClock::invariant_tsc_available() {
+#if TRICK_HAS_TSC
+    unsigned int eax , ebx , ecx , edx ;
+    if ( __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) ) {
+        return (edx & (1 << 8)) != 0 ;
+    }
+#endif
+    return false ;
+}
+
+long long Trick::TSCClock::monotonic_ns() {
+    struct timespec tp ;
+    clock_gettime(CLOCK_MONOTONIC, &tp) ;
+    return (long long)tp.tv_sec * 1000000000LL + tp.tv_nsec ;
+}
+
+/**
+@details
+-# Read CLOCK_MONOTONIC between two TSC reads, and pair it with the TSC value halfway between them.
+-# Keep the tightest of a few tries, so a preemption during one does not skew the pair.
+*/
+void Trick::TSCClock::read_pair( unsigned long long & tsc , long long & ns ) {
+    unsigned long long best_window = ~0ULL ;
+    int ii ;
+    for ( ii = 0 ; ii < 5 ; ii++ ) {
+        unsigned long long before = read_tsc() ;
+        long long curr_ns = monotonic_ns() ;
+        unsigned long long after = read_tsc() ;
+        if ( after - before < best_window ) {
+            best_window = after - before ;
+            tsc = before + best_window / 2 ;
+            ns = curr_ns ;
+        }
+    }
+}
+
+/**
+@details
+-# Set the global "the_clock" pointer to this instance
+-# Calibrate the TSC if it has not been calibrated
+*/
+int Trick::TSCClock::clock_init() {
+    set_global_clock() ;
+    if ( __atomic_load_n(&period_tsc, __ATOMIC_ACQUIRE) == 0 ) {
+        calibrate() ;
+    }
+    return 0 ;
+}
+
+/**
+@details
+-# If the TSC is used, read the TSC and CLOCK_MONOTONIC, sleep calibration_time, and read them again.  The TSC
+   frequency is the ratio of the differences.  If it is not sensible, use CLOCK_MONOTONIC.
+-# Anchor the clock at the second reading.  Setting period_tsc last publishes the anchor to the readers, which
+   read CLOCK_MONOTONIC until then.
+*/
+int Trick::TSCClock::calibrate() {
+
+    unsigned long long end_tsc ;
+    long long end_ns ;
+    struct timespec sleep_time ;
+
+    if ( ! use_tsc ) {
+        return 0 ;
+    }
+
+    read_pair(first_tsc, first_ns) ;
+    sleep_time.tv_sec = (time_t)calibration_time ;
+    sleep_time.tv_nsec = (long)((calibration_time - sleep_time.tv_sec) * 1000000000.0) ;
+    nanosleep(&sleep_time, NULL) ;
+    read_pair(end_tsc, end_ns) ;
+
+    if ( end_tsc <= first_tsc or end_ns <= first_ns ) {
+        message_publish(MSG_WARNING, "TSC clock calibration failed, using CLOCK_MONOTONIC\n") ;
+        use_tsc = false ;
+        name = "TSC - CLOCK_MONOTONIC" ;
+        return 0 ;
+    }
+
+    tsc_frequency = (end_tsc - first_tsc) * 1.0e9 / (end_ns - first_ns) ;
+    anchor_error = 0 ;
+    __atomic_store_n(&anchor_tsc, end_tsc, __ATOMIC_RELAXED) ;
+    __atomic_store_n(&anchor_ns, end_ns, __ATOMIC_RELAXED) ;
+    __atomic_store_n(&anchor_mult, (unsigned long long)(4294967296.0e9 / tsc_frequency), __ATOMIC_RELAXED) ;
+    __atomic_store_n(&period_tsc, (unsigned long long)(anchor_period * tsc_frequency), __ATOMIC_RELEASE) ;
+    return 0 ;
+}
+
+/**
+@details
+-# Read the time the clock shows now, and CLOCK_MONOTONIC.
+-# Measure the TSC frequency again over the whole time since calibration.
+-# If the clock is further behind CLOCK_MONOTONIC than TSC_MAX_SLEW_PPM of anchor_period, step it forward to
+   CLOCK_MONOTONIC.  Otherwise keep the clock continuous, so it never goes back, and adjust the rate so it reaches
+   CLOCK_MONOTONIC at the next anchor, by at most TSC_MAX_SLEW_PPM either way.
+*/
+void Trick::TSCClock::anchor( unsigned long long curr_anchor_tsc , long long curr_anchor_ns ,
+ unsigned long long curr_anchor_mult ) {
+
+    unsigned long long curr_tsc ;
+    long long mono_ns , clock_ns , max_error ;
+    double mult , slew ;
+
+    read_pair(curr_tsc, mono_ns) ;
+    if ( curr_tsc < curr_anchor_tsc ) {
+        curr_tsc = curr_anchor_tsc ;
+    }
+    clock_ns = curr_anchor_ns + (long long)(((unsigned __int128)(curr_tsc - curr_anchor_tsc) * curr_anchor_mult) >> 32) ;
+
+    anchor_error = mono_ns - clock_ns ;
+    tsc_frequency = (curr_tsc - first_tsc) * 1.0e9 / (mono_ns - first_ns) ;
+    mult = 4294967296.0e9 / tsc_frequency ;
+    max_error = (long long)(anchor_period * 1.0e9 * TSC_MAX_SLEW_PPM / 1.0e6) ;
+
+    if ( anchor_error > max_error ) {
+        __atomic_store_n(&anchor_ns, mono_ns, __ATOMIC_RELAXED) ;
+    } else {
+        __atomic_store_n(&anchor_ns, clock_ns, __ATOMIC_RELAXED) ;
+        slew = anchor_error / (anchor_period * 1.0e9) ;
+        if ( slew < -TSC_MAX_SLEW_PPM / 1.0e6 ) {
+            slew = -TSC_MAX_SLEW_PPM / 1.0e6 ;
+        }
+        mult *= 1.0 + slew ;
+    }
+    __atomic_store_n(&anchor_tsc, curr_tsc, __ATOMIC_RELAXED) ;
+    __atomic_store_n(&anchor_mult, (unsigned long long)mult, __ATOMIC_RELAXED) ;
+}
+
+/**
+@details
+-# If the TSC is not used, or clock_init() has not calibrated it yet, return CLOCK_MONOTONIC in ns.
+-# Read the anchor and the TSC, retrying if the anchor changed while it was read.
+-# If anchor_period has passed since the anchor and no other thread is anchoring, take the sequence lock and
+   anchor again.
+-# Return the anchor time plus the TSC tics since the anchor converted to ns.
+*/
+long long Trick::TSCClock::wall_clock_time() {
+
+    unsigned int seq ;
+    unsigned long long curr_tsc , curr_anchor_tsc , curr_anchor_mult , curr_period_tsc ;
+    long long curr_anchor_ns ;
+
+    // read before clock_init(), e.g. by a FrameLog given this clock
+    curr_period_tsc = __atomic_load_n(&period_tsc, __ATOMIC_ACQUIRE) ;
+    if ( ! use_tsc or curr_period_tsc == 0 ) {
+        return monotonic_ns() ;
+    }
+
+    do {
+        seq = __atomic_load_n(&anchor_seq, __ATOMIC_ACQUIRE) ;
+        curr_anchor_tsc = __atomic_load_n(&anchor_tsc, __ATOMIC_RELAXED) ;
+        curr_anchor_ns = __atomic_load_n(&anchor_ns, __ATOMIC_RELAXED) ;
+        curr_anchor_mult = __atomic_load_n(&anchor_mult, __ATOMIC_RELAXED) ;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE) ;
+    } while ( (seq & 1) or seq != __atomic_load_n(&anchor_seq, __ATOMIC_RELAXED) ) ;
+
+    curr_tsc = read_tsc() ;
+    if ( curr_tsc < curr_anchor_tsc ) {
+        curr_tsc = curr_anchor_tsc ;
+    }
+
+    if ( curr_tsc - curr_anchor_tsc >= curr_period_tsc and
+         __atomic_compare_exchange_n(&anchor_seq, &seq, seq + 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) ) {
+        anchor(curr_anchor_tsc, curr_anchor_ns, curr_anchor_mult) ;
+        __atomic_store_n(&anchor_seq, seq + 2, __ATOMIC_RELEASE) ;
+        curr_anchor_tsc = __atomic_load_n(&anchor_tsc, __ATOMIC_RELAXED) ;
+        curr_anchor_ns = __atomic_load_n(&anchor_ns, __ATOMIC_RELAXED) ;
+        curr_anchor_mult = __atomic_load_n(&anchor_mult, __ATOMIC_RELAXED) ;
+        if ( curr_tsc < curr_anchor_tsc ) {
+            curr_tsc = curr_anchor_tsc ;
+        }
+    }
+
+    return curr_anchor_ns + (long long)(((unsigned __int128)(curr_tsc - curr_anchor_tsc) * curr_anchor_mult) >> 32) ;
+}
+
+/**
+@details
+-# This function is empty
+*/
+int Trick::TSCClock::clock_stop() {
+    return 0 ;
+}
@@ -0,0 +1,110 @@
+#include <iostream>
+#include <time.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+#define protected public
+#include "trick/TSCClock.hh"
+
+#define TIME_TOL 1e5
+
+// Stub for message_publish
+extern "C" int message_publish(int level, const char * format_msg, ...) { (void)level; (void)format_msg; return 0; }
+
+static long long monotonic_ns() {
+    struct timespec tp ;
+    clock_gettime(CLOCK_MONOTONIC, &tp) ;
+    return (long long)tp.tv_sec * 1000000000LL + tp.tv_nsec ;
+}
+
+class TSCClockTest : public ::testing::Test {
+
+    protected:
+        TSCClockTest() {}
+        ~TSCClockTest() {}
+        virtual void SetUp() {}
+        virtual void TearDown() {}
+} ;
+
+/* The clock counts nanoseconds of CLOCK_MONOTONIC */
+TEST_F(TSCClockTest, Initialize) {
+
+    Trick::TSCClock * tsc_clk = new Trick::TSCClock;
+
+    EXPECT_EQ(tsc_clk->clock_tics_per_sec, 1000000000ULL);
+    EXPECT_EQ(tsc_clk->use_tsc, Trick::TSCClock::invariant_tsc_available());
+
+    tsc_clk->clock_init();
+    if ( tsc_clk->use_tsc ) {
+        EXPECT_STREQ(tsc_clk->get_name(), "TSC");
+        EXPECT_GT(tsc_clk->tsc_frequency, 1.0e6);
+    } else {
+        EXPECT_STREQ(tsc_clk->get_name(), "TSC - CLOCK_MONOTONIC");
+    }
+
+    EXPECT_NEAR(tsc_clk->wall_clock_time(), monotonic_ns(), TIME_TOL);
+
+    delete tsc_clk;
+}
+
+/* Reads never go backwards and stay with CLOCK_MONOTONIC across anchors */
+TEST_F(TSCClockTest, Anchor) {
+
+    Trick::TSCClock * tsc_clk = new Trick::TSCClock;
+    long long prev_time , curr_time , end_time ;
+
+    tsc_clk->anchor_period = 0.05;
+    tsc_clk->clock_init();
+
+    prev_time = tsc_clk->wall_clock_time();
+    end_time = monotonic_ns() + 300000000LL;
+    while ( monotonic_ns() < end_time ) {
+        curr_time = tsc_clk->wall_clock_time();
+        ASSERT_GE(curr_time, prev_time);
+        prev_time = curr_time;
+    }
+    EXPECT_NEAR(tsc_clk->wall_clock_time(), monotonic_ns(), TIME_TOL);
+    EXPECT_LT(llabs(tsc_clk->anchor_error), TIME_TOL);
+
+    delete tsc_clk;
+}
+
+/* A clock ahead of CLOCK_MONOTONIC is slowed down rather than stepped back */
+TEST_F(TSCClockTest, AheadSlews) {
+
+    Trick::TSCClock * tsc_clk = new Trick::TSCClock;
+    long long prev_time , curr_time , end_time , worst_error = 0 ;
+
+    tsc_clk->anchor_period = 0.05;
+    tsc_clk->clock_init();
+    if ( tsc_clk->use_tsc ) {
+        /* 200 us ahead is more than one anchor_period of slewing removes */
+        tsc_clk->anchor_ns += 200000LL;
+        prev_time = tsc_clk->wall_clock_time();
+        end_time = monotonic_ns() + 1000000000LL;
+        while ( monotonic_ns() < end_time ) {
+            curr_time = tsc_clk->wall_clock_time();
+            ASSERT_GE(curr_time, prev_time);
+            prev_time = curr_time;
+            if ( tsc_clk->anchor_error < worst_error ) {
+                worst_error = tsc_clk->anchor_error;
+            }
+        }
+        EXPECT_LT(worst_error, -150000LL);
+        EXPECT_LT(llabs(tsc_clk->anchor_error), TIME_TOL);
+    }
+
+    delete tsc_clk;
+}
+
+/* A clock read before clock_init() reads CLOCK_MONOTONIC without calibrating */
+TEST_F(TSCClockTest, ReadBeforeInit) {
+
+    Trick::TSCClock * tsc_clk = new Trick::TSCClock;
+
+    EXPECT_NEAR(tsc_clk->wall_clock_time(), monotonic_ns(), TIME_TOL);
+    EXPECT_EQ(tsc_clk->period_tsc, 0ULL);
+    EXPECT_EQ(tsc_clk->tsc_frequency, 0.0);
+
+    delete tsc_clk;
+}
@@ -10,24 +10,35 @@ PROGRAMMERS:
 #include <stdlib.h>
 #include <string.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <vector>
 
 #include "trick/DRBinary.hh"
 #include "trick/command_line_protos.h"
 #include "trick/memorymanager_c_intf.h"
 #include "trick/bitfield_proto.h"
+#include "trick/message_proto.h"
+#include "trick/message_type.h"
+#include "trick/trk_columns.h"
 
 /*
    Other classes inherit from DRBinary. In these cases, we don't want to register the memory as DRBinary,
    so register_group will be set to false.
 */
-Trick::DRBinary::DRBinary( std::string in_name , bool register_group ) : Trick::DataRecordGroup(in_name) {
+Trick::DRBinary::DRBinary( std::string in_name , bool register_group ) : Trick::DataRecordGroup(in_name) ,
+ write_columns(false) , header_bytes(0) {
     if ( register_group ) {
         register_group_with_mm(this, "Trick::DRBinary") ;
     }
 }
 
+int Trick::DRBinary::set_write_columns( bool in_write_columns ) {
+    write_columns = in_write_columns ;
+    return(0) ;
+}
+
 int Trick::DRBinary::format_specific_header( std::fstream & out_stream ) {
     out_stream << " byte_order is " << byte_order << std::endl ;
     return(0) ;
@@ -116,6 +127,11 @@ int Trick::DRBinary::format_specific_init() {
         bytes += write( fd , &rec_buffer[jj]->ref->attr->size , sizeof(int)) ;
     }
     total_bytes_written += bytes;
+    header_bytes = bytes ;
+
+    /* A columnar copy of a previous log by this name no longer matches it */
+    unlink((file_name + TRK_COLUMNS_SUFFIX).c_str()) ;
+
     return(0) ;
 }
 
@@ -183,11 +199,71 @@ int Trick::DRBinary::format_specific_write_data(unsigned int writer_offset) {
 /**
 @details
 -# Close the output file stream
+-# Write the columnar copy of the log if requested
 */
 int Trick::DRBinary::format_specific_shutdown() {
 
     if ( inited ) {
         close(fd) ;
+        if ( write_columns ) {
+            write_columns_file() ;
+        }
     }
     return(0) ;
-}
\ No newline at end of file
+}
+
+/**
+@details
+-# Map the closed log file
+-# Write its columns with trk_columns_write, see trick/trk_columns.h
+*/
+int Trick::DRBinary::write_columns_file() {
+
+    std::string col_name = file_name + TRK_COLUMNS_SUFFIX ;
+    struct stat st ;
+    unsigned int ii ;
+    int64_t record_bytes = 0 ;
+    std::vector< int > types ;
+    std::vector< int > sizes ;
+    std::vector< int64_t > offsets ;
+
+    /* the first parameter is always the time */
+    for ( ii = 0 ; ii < rec_buffer.size() ; ii++ ) {
+        types.push_back(rec_buffer[ii]->ref->attr->type) ;
+        sizes.push_back(rec_buffer[ii]->ref->attr->size) ;
+        offsets.push_back(record_bytes) ;
+        record_bytes += rec_buffer[ii]->ref->attr->size ;
+    }
+
+    int trk_fd = open(file_name.c_str(), O_RDONLY) ;
+    if ( trk_fd == -1 or fstat(trk_fd, &st) != 0 or record_bytes == 0 or (size_t)st.st_size < header_bytes ) {
+        if ( trk_fd != -1 ) {
+            close(trk_fd) ;
+        }
+        message_publish(MSG_ERROR, "Can't read Data Record file %s to write its columns.\n", file_name.c_str()) ;
+        return(-1) ;
+    }
+
+    int64_t num_records = (st.st_size - header_bytes) / record_bytes ;
+    char * trk_data = NULL ;
+    if ( num_records > 0 ) {
+        trk_data = (char *)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, trk_fd, 0) ;
+    }
+    close(trk_fd) ;
+    if ( trk_data == MAP_FAILED ) {
+        message_publish(MSG_ERROR, "Can't read Data Record file %s to write its columns.\n", file_name.c_str()) ;
+        return(-1) ;
+    }
+
+    int ret = trk_columns_write(col_name.c_str(), trk_data + header_bytes, num_records, record_bytes,
+     rec_buffer.size(), &types[0], &sizes[0], &offsets[0], 0, st.st_size, trk_columns_mtime(&st)) ;
+
+    if ( trk_data ) {
+        munmap(trk_data, st.st_size) ;
+    }
+    if ( ret != 0 ) {
+        message_publish(MSG_ERROR, "Error writing Data Record file %s.\n", col_name.c_str()) ;
+        return(-1) ;
+    }
+    return(0) ;
+}
@@ -18,6 +18,7 @@
 #include "trick/memorymanager_c_intf.h"
 #include "trick/message_proto.h"
 #include "trick/message_type.h"
+#include "trick/TraceWriter.hh"
 
 /**
 @details
@@ -708,9 +709,12 @@ int Trick::DataRecordGroup::write_data(bool must_write) {
     unsigned int local_buffer_num ;
     unsigned int num_to_write ;
     unsigned int writer_offset ;
+    long long start_ns ;
 
     if ( record and inited and (buffer_type == DR_No_Buffer or must_write) and (total_bytes_written <= max_file_size)) {
 
+        start_ns = Trick::TraceWriter::active ? Trick::TraceWriter::now() : 0 ;
+
         // buffer_mutex is used in this one place to prevent forced calls of write_data
         // to not overwrite data being written by the asynchronous thread.
         pthread_mutex_lock(&buffer_mutex) ;
@@ -742,6 +746,11 @@ int Trick::DataRecordGroup::write_data(bool must_write) {
 
         pthread_mutex_unlock(&buffer_mutex) ;
 
+        // the group may be deleted before the trace is written, so its name is interned
+        if ( Trick::TraceWriter::active and num_to_write > 0 ) {
+            Trick::TraceWriter::complete(Trick::TraceWriter::intern(group_name), "data_record", start_ns,
+             Trick::TraceWriter::now()) ;
+        }
     }
 
     return 0 ;
@@ -246,6 +246,13 @@ void Trick::EventManager::add_event_processor(Trick::EventProcessor * in_ep) {
     event_processors.push_back(in_ep) ;
 }
 
+int Trick::EventManager::set_async_evaluation( bool on_off ) {
+    for ( unsigned int ii = 0 ; ii < event_processors.size() ; ii++ ) {
+        event_processors[ii]->set_async_evaluation(on_off) ;
+    }
+    return 0 ;
+}
+
 //Executive time_tic changed.  Update all event times
 int Trick::EventManager::time_tic_changed() {
 
@@ -8,12 +8,82 @@
 */
 
 #include <iostream>
+#include <algorithm>
 
 #include "trick/EventProcessor.hh"
 #include "trick/TrickConstant.hh"
 #include "trick/message_proto.h"
 #include "trick/message_type.h"
 
+Trick::EventEvaluationThread::EventEvaluationThread() :
+ Trick::SysThread("EventEval") ,
+ events(NULL) ,
+ eval_tics(0) ,
+ busy(false) {
+    pthread_mutex_init(&work_mutex, NULL) ;
+    pthread_cond_init(&work_cv, NULL) ;
+}
+
+Trick::EventEvaluationThread::~EventEvaluationThread() {
+    if ( created ) {
+        cancel_thread() ;
+        join_thread() ;
+    }
+    pthread_cond_destroy(&work_cv) ;
+    pthread_mutex_destroy(&work_mutex) ;
+}
+
+void Trick::EventEvaluationThread::start( std::vector< Trick::Event * > & in_events , long long curr_tics ) {
+    pthread_mutex_lock(&work_mutex) ;
+    events = &in_events ;
+    eval_tics = curr_tics ;
+    busy = true ;
+    pthread_cond_broadcast(&work_cv) ;
+    pthread_mutex_unlock(&work_mutex) ;
+}
+
+void Trick::EventEvaluationThread::wait() {
+    pthread_mutex_lock(&work_mutex) ;
+    while ( busy ) {
+        pthread_cond_wait(&work_cv, &work_mutex) ;
+    }
+    pthread_mutex_unlock(&work_mutex) ;
+}
+
+static void unlock_mutex( void * mutex ) {
+    pthread_mutex_unlock((pthread_mutex_t *)mutex) ;
+}
+
+/**
+@details
+-# Wait for start().  The wait is where the thread is cancelled at shutdown.
+-# Evaluate the deferred conditions of the events in order, outside of the mutex.
+-# Mark the work done and wake the waiting processor.
+*/
+void * Trick::EventEvaluationThread::thread_body() {
+    pthread_mutex_lock(&work_mutex) ;
+    pthread_cleanup_push(unlock_mutex, &work_mutex) ;
+    while ( true ) {
+        while ( ! busy ) {
+            pthread_cond_wait(&work_cv, &work_mutex) ;
+        }
+        pthread_mutex_unlock(&work_mutex) ;
+        for ( unsigned int ii = 0 ; ii < events->size() ; ii++ ) {
+            (*events)[ii]->evaluate(eval_tics, true) ;
+        }
+        pthread_mutex_lock(&work_mutex) ;
+        busy = false ;
+        pthread_cond_broadcast(&work_cv) ;
+    }
+    pthread_cleanup_pop(1) ;
+    return NULL ;
+}
+
+Trick::EventProcessor::EventProcessor() :
+ process_event_job(NULL) ,
+ commit_events_job(NULL) ,
+ async_evaluation(false) {}
+
 /**
 @details
 -# Add the incoming event to the list of events to be added to the processor.
@@ -24,11 +94,16 @@ void Trick::EventProcessor::add_event(Trick::Event * in_event) {
 
 /**
 @details
--# Remove the incoming event from the set of events being processed
+-# Remove the incoming event from the set of events being processed, and from the deferred events
 -# If the event set is not empty set the process_event job to the first event's next job call time.
 -# Else set the process_event job to maximum time
 */
 void Trick::EventProcessor::remove_event(Trick::Event * in_event) {
+    if ( ! deferred_events.empty() ) {
+        evaluation_thread.wait() ;
+        deferred_events.erase(std::remove(deferred_events.begin(), deferred_events.end(), in_event),
+         deferred_events.end()) ;
+    }
     std::multiset< Trick::Event *, CompareEventPtrs >::iterator sit = event_set.begin() ;
     for (sit=event_set.begin(); sit!=event_set.end(); ++sit) {
         if ((*sit) == in_event) {
@@ -70,7 +145,41 @@ void Trick::EventProcessor::add_pending_events( long long curr_tics , bool is_re
     }
 }
 
-//Automatic job to process input file events.
+/**
+@details
+-# With asynchronous evaluation on, look for a pending or scheduled event that is deferrable.
+-# Create the evaluation thread if one is found.  Events added later are deferred only if the thread exists, so the
+   thread is never created while the sim runs.
+*/
+int Trick::EventProcessor::create_evaluation_thread() {
+
+    if ( ! async_evaluation or commit_events_job == NULL or evaluation_thread.is_created() ) {
+        return 0 ;
+    }
+    bool deferrable = false ;
+    for ( unsigned int ii = 0 ; ii < pending_events.size() and ! deferrable ; ii++ ) {
+        deferrable = pending_events[ii]->deferrable() ;
+    }
+    std::multiset< Trick::Event *, CompareEventPtrs >::iterator sit ;
+    for ( sit = event_set.begin() ; sit != event_set.end() and ! deferrable ; ++sit ) {
+        deferrable = (*sit)->deferrable() ;
+    }
+    if ( deferrable ) {
+        evaluation_thread.create_thread() ;
+    }
+    return 0 ;
+}
+
+/**
+@details
+-# Process each active event that matches the current time.  With asynchronous evaluation and the evaluation
+   thread created at initialization, an event that is deferrable has its other conditions evaluated and the
+   variables of its python conditions taken now, and is deferred.  Its python conditions are evaluated on
+   the helper thread, and it is committed by commit_events() at the end of the time step.
+-# Reschedule cyclic events.
+-# Start the helper thread on the deferred events after all the events that were not deferred have run, and
+   schedule commit_events() for this time step.
+*/
 int Trick::EventProcessor::process_event( long long curr_tics ) {
 
     std::multiset< Trick::Event *, CompareEventPtrs >::iterator sit = event_set.begin() ;
@@ -84,7 +193,12 @@ int Trick::EventProcessor::process_event( long long curr_tics ) {
 
         // if the event is active process it
         if ( curr_event->is_active() ) {
-            curr_event->process(curr_tics) ;
+            if ( async_evaluation and evaluation_thread.is_created() and curr_event->deferrable() ) {
+                curr_event->evaluate(curr_tics, false) ;
+                deferred_events.push_back(curr_event) ;
+            } else {
+                curr_event->process(curr_tics) ;
+            }
         }
 
         // if the event has a cycle time, update the time and put the item back in the set
@@ -97,6 +211,11 @@ int Trick::EventProcessor::process_event( long long curr_tics ) {
         sit = event_set.begin() ;
     }
 
+    if ( !deferred_events.empty() ) {
+        evaluation_thread.start(deferred_events, curr_tics) ;
+        commit_events_job->next_tics = curr_tics ;
+    }
+
     if ( !event_set.empty() ) {
         // set the next call time to the first item of the set.
         process_event_job->next_tics = (*(event_set.begin()))->get_next_tics() ;
@@ -109,6 +228,34 @@ int Trick::EventProcessor::process_event( long long curr_tics ) {
 
 }
 
+/**
+@details
+-# Wait for the helper thread to finish evaluating the deferred events.
+-# Commit them in the order they were processed, so their actions run at the same point of the time step
+   every run no matter how long the evaluation took.
+-# Unschedule this job until more events are deferred.
+*/
+int Trick::EventProcessor::commit_events( long long curr_tics ) {
+
+    if ( !deferred_events.empty() ) {
+        evaluation_thread.wait() ;
+        // take each event off the list before committing it, an action may remove events from the list.
+        while ( !deferred_events.empty() ) {
+            Trick::Event * curr_event = deferred_events.front() ;
+            deferred_events.erase(deferred_events.begin()) ;
+            curr_event->commit(curr_tics) ;
+        }
+    }
+    if ( commit_events_job != NULL ) {
+        commit_events_job->next_tics = TRICK_MAX_LONG_LONG ;
+    }
+    return 0 ;
+}
+
 void Trick::EventProcessor::preload_checkpoint() {
+    if ( !deferred_events.empty() ) {
+        evaluation_thread.wait() ;
+        deferred_events.clear() ;
+    }
     event_set.clear() ;
 }
@@ -0,0 +1,141 @@
+#include <pthread.h>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "trick/EventProcessor.hh"
+#include "trick/Executive.hh"
+#include "trick/TrickConstant.hh"
+
+namespace Trick {
+
+/* An event that logs how it is processed.  A deferrable event is evaluated when due, then on the helper. */
+class LogEvent : public Trick::Event {
+    public:
+        LogEvent(std::string in_name, std::vector<std::string> & in_log, bool in_deferrable) :
+         Trick::Event(in_name, 0.0) , log(in_log) , can_defer(in_deferrable) , due_evaluations(0) ,
+         helper_evaluations(0) {
+            activate() ;
+            helper = pthread_self() ;
+        }
+
+        virtual int process( long long ) { log.push_back("process " + name) ; return 0 ; }
+        virtual bool deferrable() { return can_defer ; }
+        virtual void evaluate( long long , bool on_helper ) {
+            if ( on_helper ) {
+                helper = pthread_self() ;
+                helper_evaluations++ ;
+            } else {
+                due_evaluations++ ;
+            }
+        }
+        virtual int commit( long long ) { log.push_back("commit " + name) ; return 0 ; }
+        virtual void add() {}
+        virtual void remove() {}
+        virtual void restart() {}
+
+        std::vector<std::string> & log ;
+        bool can_defer ;
+        int due_evaluations ;
+        int helper_evaluations ;
+        pthread_t helper ;
+} ;
+
+class EventProcessorTest : public ::testing::Test {
+
+    protected:
+        Trick::Executive exec ;
+        Trick::EventProcessor ep ;
+        Trick::JobData process_event_job ;
+        Trick::JobData commit_events_job ;
+        std::vector<std::string> log ;
+
+        EventProcessorTest() {}
+        ~EventProcessorTest() {}
+
+        virtual void SetUp() {
+            ep.set_process_event_job(&process_event_job) ;
+            ep.set_commit_events_job(&commit_events_job) ;
+            commit_events_job.next_tics = TRICK_MAX_LONG_LONG ;
+        }
+} ;
+
+TEST_F(EventProcessorTest , NoThreadWithoutAsyncEvaluation) {
+    LogEvent event("a", log, true) ;
+    ep.add_event(&event) ;
+    ep.create_evaluation_thread() ;
+    ep.add_pending_events(0) ;
+
+    ep.process_event(0) ;
+    EXPECT_EQ(event.due_evaluations, 0) ;
+    ASSERT_EQ(log.size(), 1u) ;
+    EXPECT_EQ(log[0], "process a") ;
+    EXPECT_EQ(commit_events_job.next_tics, TRICK_MAX_LONG_LONG) ;
+}
+
+TEST_F(EventProcessorTest , NoThreadWithoutDeferrableEvents) {
+    LogEvent event("a", log, false) ;
+    ep.set_async_evaluation(true) ;
+    ep.add_event(&event) ;
+    ep.create_evaluation_thread() ;
+    ep.add_pending_events(0) ;
+
+    // An event that becomes deferrable after initialization is still processed when due.
+    event.can_defer = true ;
+    ep.process_event(0) ;
+    EXPECT_EQ(event.due_evaluations, 0) ;
+    ASSERT_EQ(log.size(), 1u) ;
+    EXPECT_EQ(log[0], "process a") ;
+}
+
+TEST_F(EventProcessorTest , CommitsDeferredEventsInOrder) {
+    LogEvent first("first", log, true) ;
+    LogEvent second("second", log, false) ;
+    LogEvent third("third", log, true) ;
+    first.set_next_tics(10) ;
+    second.set_next_tics(10) ;
+    third.set_next_tics(10) ;
+    ep.set_async_evaluation(true) ;
+    ep.add_event(&first) ;
+    ep.add_event(&second) ;
+    ep.add_event(&third) ;
+    ep.add_pending_events(0) ;
+    ep.create_evaluation_thread() ;
+
+    ep.process_event(10) ;
+    // The event that is not deferred runs when due, the others wait for commit_events.
+    ASSERT_EQ(log.size(), 1u) ;
+    EXPECT_EQ(log[0], "process second") ;
+    EXPECT_EQ(first.due_evaluations, 1) ;
+    EXPECT_EQ(third.due_evaluations, 1) ;
+    EXPECT_EQ(commit_events_job.next_tics, 10) ;
+    EXPECT_EQ(process_event_job.next_tics, TRICK_MAX_LONG_LONG) ;
+
+    ep.commit_events(10) ;
+    ASSERT_EQ(log.size(), 3u) ;
+    EXPECT_EQ(log[1], "commit first") ;
+    EXPECT_EQ(log[2], "commit third") ;
+    EXPECT_EQ(first.helper_evaluations, 1) ;
+    EXPECT_EQ(third.helper_evaluations, 1) ;
+    EXPECT_FALSE(pthread_equal(first.helper, pthread_self())) ;
+    EXPECT_TRUE(pthread_equal(first.helper, third.helper)) ;
+    EXPECT_EQ(commit_events_job.next_tics, TRICK_MAX_LONG_LONG) ;
+}
+
+TEST_F(EventProcessorTest , RemoveDeferredEvent) {
+    LogEvent first("first", log, true) ;
+    LogEvent second("second", log, true) ;
+    ep.set_async_evaluation(true) ;
+    ep.add_event(&first) ;
+    ep.add_event(&second) ;
+    ep.add_pending_events(0) ;
+    ep.create_evaluation_thread() ;
+
+    ep.process_event(0) ;
+    ep.remove_event(&first) ;
+    ep.commit_events(0) ;
+    ASSERT_EQ(log.size(), 1u) ;
+    EXPECT_EQ(log[0], "commit second") ;
+}
+
+}
@@ -4,12 +4,14 @@
 #include <string>
 
 #include "trick/Executive.hh"
+#include "trick/RealtimeProfile.hh"
 #include "trick/ExecutiveException.hh"
 #include "trick/exec_proto.h"
 #include "trick/exec_proto.hh"
 
 /* Global singleton pointer to the executive */
 extern Trick::Executive * the_exec ;
+extern Trick::RealtimeProfile * the_realtime_profile ;
 
 /**
  * @relates Trick::Executive
@@ -914,6 +916,30 @@ extern "C" int exec_set_thread_cpu_affinity(unsigned int thread_id , int cpu_num
     return -1 ;
 }
 
+/**
+ * @relates Trick::RealtimeProfile
+ * Turns the real-time profile on or off.  The profile is applied at the end of initialization.
+ */
+extern "C" int exec_set_realtime_profile(int yes_no) {
+    if ( the_realtime_profile != NULL ) {
+        the_realtime_profile->enabled = (yes_no != 0) ;
+        return 0 ;
+    }
+    return -1 ;
+}
+
+/**
+ * @relates Trick::RealtimeProfile
+ * @copydoc Trick::RealtimeProfile::pin
+ * C wrapper for Trick::RealtimeProfile::pin
+ */
+extern "C" int exec_realtime_profile_pin(const char * threads , const char * cpus) {
+    if ( the_realtime_profile != NULL and threads != NULL and cpus != NULL ) {
+        return the_realtime_profile->pin(threads, cpus) ;
+    }
+    return -1 ;
+}
+
 /**
  * @relates Trick::Executive
  * @copydoc Trick::Executive::set_thread_priority
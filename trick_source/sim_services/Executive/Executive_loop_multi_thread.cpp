@@ -6,6 +6,7 @@
 #include "trick/Executive.hh"
 #include "trick/exec_proto.h"
 #include "trick/release.h"
+#include "trick/TraceWriter.hh"
 
 /**
 @details
@@ -133,6 +134,7 @@ int Trick::Executive::loop_multi_thread() {
                 curr_thread->child_complete = false ;
                 curr_thread->amf_next_tics += curr_thread->amf_cycle_tics ;
                 curr_thread->trigger_container.getThreadTrigger()->fire() ;
+                Trick::TraceWriter::instant("trigger fire", "thread") ;
 
             }
         }
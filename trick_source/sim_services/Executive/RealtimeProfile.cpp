@@ -0,0 +1,556 @@
+/*
+PURPOSE:
+    ( Real-time host profile: memory locking, prefaulting and thread CPU layout )
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <fnmatch.h>
+#include <dirent.h>
+#include <alloca.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#if __linux
+#include <sys/mman.h>
+#include <sys/resource.h>
+#endif
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "trick/RealtimeProfile.hh"
+#include "trick/SysThread.hh"
+#include "trick/Threads.hh"
+#include "trick/MemoryManager.hh"
+#include "trick/exec_proto.h"
+#include "trick/exec_proto.hh"
+#include "trick/message_proto.h"
+#include "trick/message_type.h"
+
+Trick::RealtimeProfile * the_realtime_profile = NULL ;
+
+/* A thread to check in verify_layout(). */
+struct ProfileThread {
+    std::string name ;
+    bool scheduled ;
+    pid_t pid ;
+    const std::vector< unsigned int > * cpus ;
+} ;
+
+static void profile_warning( unsigned int & count , const char * format , ... ) {
+    char msg[512] ;
+    va_list args ;
+    va_start(args, format) ;
+    vsnprintf(msg, sizeof(msg), format, args) ;
+    va_end(args) ;
+    message_publish(MSG_WARNING, "Warning: Real-time profile: %s", msg) ;
+    count++ ;
+}
+
+/* Formats CPUs as a list like "0-1,4". */
+static std::string format_cpu_list( const std::vector< unsigned int > & cpus ) {
+    std::ostringstream oss ;
+    unsigned int ii = 0 ;
+    while ( ii < cpus.size() ) {
+        unsigned int jj = ii ;
+        while ( jj + 1 < cpus.size() and cpus[jj + 1] == cpus[jj] + 1 ) {
+            jj++ ;
+        }
+        if ( ii != 0 ) {
+            oss << "," ;
+        }
+        oss << cpus[ii] ;
+        if ( jj != ii ) {
+            oss << "-" << cpus[jj] ;
+        }
+        ii = jj + 1 ;
+    }
+    return oss.str() ;
+}
+
+/* Faults in the pages of a range without changing their contents. */
+static int populate_range( void * addr , size_t length ) {
+#if __linux
+    size_t page = (size_t)sysconf(_SC_PAGESIZE) ;
+    char * start = (char *)((size_t)addr & ~(page - 1)) ;
+    length = (((char *)addr + length) - start + page - 1) & ~(page - 1) ;
+#ifdef MADV_POPULATE_WRITE
+    if ( madvise(start, length, MADV_POPULATE_WRITE) == 0 ) {
+        return 0 ;
+    }
+#endif
+    // locking a range faults it in, and the pages stay when it is unlocked
+    if ( mlock(start, length) == 0 ) {
+        munlock(start, length) ;
+        return 0 ;
+    }
+#else
+    (void)addr ;
+    (void)length ;
+#endif
+    return -1 ;
+}
+
+/* Writes to the next size bytes of the calling thread's stack, up to half of the stack. */
+static void __attribute__((noinline)) touch_stack( size_t size ) {
+#if __linux
+    pthread_attr_t attr ;
+    void * stack_addr ;
+    size_t stack_size ;
+    if ( pthread_getattr_np(pthread_self(), &attr) == 0 ) {
+        if ( pthread_attr_getstack(&attr, &stack_addr, &stack_size) == 0 and size > stack_size / 2 ) {
+            size = stack_size / 2 ;
+        }
+        pthread_attr_destroy(&attr) ;
+    }
+#endif
+    size_t page = (size_t)sysconf(_SC_PAGESIZE) ;
+    volatile char * buf = (volatile char *)alloca(size) ;
+    size_t ii ;
+    for ( ii = 0 ; ii < size ; ii += page ) {
+        buf[ii] = 0 ;
+    }
+}
+
+/* Faults in the top size bytes of the stack of another running thread. */
+static int populate_stack( pthread_t thread , size_t size ) {
+    int ret = -1 ;
+#if __linux
+    pthread_attr_t attr ;
+    void * stack_addr ;
+    size_t stack_size ;
+    if ( pthread_getattr_np(thread, &attr) == 0 ) {
+        if ( pthread_attr_getstack(&attr, &stack_addr, &stack_size) == 0 ) {
+            if ( size > stack_size / 2 ) {
+                size = stack_size / 2 ;
+            }
+            ret = populate_range((char *)stack_addr + stack_size - size, size) ;
+        }
+        pthread_attr_destroy(&attr) ;
+    }
+#else
+    (void)thread ;
+    (void)size ;
+#endif
+    return ret ;
+}
+
+/* Reads the CPU list in a file like /sys/devices/system/cpu/isolated.  Returns -1 if the file cannot be read. */
+static int read_cpu_list_file( const char * file_name , std::vector< unsigned int > & cpus ) {
+    std::ifstream file(file_name) ;
+    std::string list ;
+    cpus.clear() ;
+    if ( ! file.is_open() ) {
+        return -1 ;
+    }
+    std::getline(file, list) ;
+    if ( list.empty() ) {
+        return 0 ;
+    }
+    return Trick::RealtimeProfile::parse_cpu_list(list, cpus) ;
+}
+
+Trick::RealtimeProfile::RealtimeProfile() :
+ enabled(false) ,
+ lock_memory(true) ,
+ prefault(true) ,
+ stack_prefault(256 * 1024) ,
+ heap_reserve(0) ,
+ verify(true) ,
+ memory_locked(false) ,
+ warnings(0) {
+    the_realtime_profile = this ;
+}
+
+Trick::RealtimeProfile::~RealtimeProfile() {
+    if ( Trick::ThreadBase::start_hook == thread_started ) {
+        Trick::ThreadBase::start_hook = NULL ;
+    }
+    if ( the_realtime_profile == this ) {
+        the_realtime_profile = NULL ;
+    }
+}
+
+/**
+@details
+-# Split the list at commas.  Each item is a CPU number or a range of CPU numbers like "4-7".
+-# Return the CPUs sorted, without duplicates.
+*/
+int Trick::RealtimeProfile::parse_cpu_list(std::string list, std::vector<unsigned int> & cpus) {
+
+    std::istringstream iss(list) ;
+    std::string item ;
+    unsigned int first , last , ii ;
+    char * end ;
+
+    cpus.clear() ;
+    while ( std::getline(iss, item, ',') ) {
+        item.erase(0, item.find_first_not_of(" \t\n")) ;
+        item.erase(item.find_last_not_of(" \t\n") + 1) ;
+        if ( item.empty() or ! isdigit((unsigned char)item[0]) ) {
+            return -1 ;
+        }
+        first = last = (unsigned int)strtoul(item.c_str(), &end, 10) ;
+        if ( *end == '-' ) {
+            if ( ! isdigit((unsigned char)end[1]) ) {
+                return -1 ;
+            }
+            last = (unsigned int)strtoul(end + 1, &end, 10) ;
+        }
+        if ( *end != '\0' or last < first ) {
+            return -1 ;
+        }
+        for ( ii = first ; ii <= last ; ii++ ) {
+            cpus.push_back(ii) ;
+        }
+    }
+    if ( cpus.empty() ) {
+        return -1 ;
+    }
+    std::sort(cpus.begin(), cpus.end()) ;
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end()) ;
+    return 0 ;
+}
+
+/**
+@details
+-# Parse the CPU list.  If it is not valid, warn and do not add the entry.
+-# Warn about CPUs that are not online; the entry is still added.
+-# Add the entry after the previous ones.
+*/
+int Trick::RealtimeProfile::pin(std::string threads, std::string cpus) {
+
+    std::vector< unsigned int > cpu_list ;
+    long num_cpus = sysconf(_SC_NPROCESSORS_ONLN) ;
+
+    if ( parse_cpu_list(cpus, cpu_list) != 0 ) {
+        message_publish(MSG_WARNING, "Warning: Invalid CPU list \"%s\" in RealtimeProfile::pin for %s\n" ,
+         cpus.c_str(), threads.c_str()) ;
+        return -1 ;
+    }
+    if ( cpu_list.back() >= (unsigned int)num_cpus ) {
+        message_publish(MSG_WARNING, "Warning: CPU %u in RealtimeProfile::pin for %s is out of range (0 through %ld)\n" ,
+         cpu_list.back(), threads.c_str(), num_cpus - 1) ;
+    }
+    layout.push_back(std::make_pair(threads, cpu_list)) ;
+    return 0 ;
+}
+
+const std::vector< unsigned int > * Trick::RealtimeProfile::find_cpus(const std::string & thread_name) {
+    unsigned int ii ;
+    for ( ii = 0 ; ii < layout.size() ; ii++ ) {
+        if ( fnmatch(layout[ii].first.c_str(), thread_name.c_str(), 0) == 0 ) {
+            return &layout[ii].second ;
+        }
+    }
+    return NULL ;
+}
+
+/**
+@details
+-# Find the layout entry of the thread.  If there is none, the thread is left as it is.
+-# Replace the CPU set of the thread with the CPUs of the entry.
+-# If the thread is running, set its affinity now.  A thread not started yet sets it when it starts.
+*/
+bool Trick::RealtimeProfile::pin_thread(Trick::ThreadBase * thread) {
+
+    const std::vector< unsigned int > * cpus = find_cpus(thread->get_name()) ;
+
+    if ( cpus == NULL ) {
+        return false ;
+    }
+#if __linux
+    unsigned int max_cpu = (unsigned int)sysconf(_SC_NPROCESSORS_ONLN) ;
+    unsigned int ii ;
+#ifdef CPU_ALLOC
+    cpu_set_t * set = CPU_ALLOC(max_cpu) ;
+    CPU_ZERO_S(CPU_ALLOC_SIZE(max_cpu), set) ;
+    for ( ii = 0 ; ii < cpus->size() ; ii++ ) {
+        if ( (*cpus)[ii] < max_cpu ) {
+            CPU_SET_S((*cpus)[ii], CPU_ALLOC_SIZE(max_cpu), set) ;
+        }
+    }
+    thread->copy_cpus(set) ;
+    CPU_FREE(set) ;
+#else
+    cpu_set_t set ;
+    CPU_ZERO(&set) ;
+    for ( ii = 0 ; ii < cpus->size() ; ii++ ) {
+        if ( (*cpus)[ii] < max_cpu ) {
+            CPU_SET((*cpus)[ii], &set) ;
+        }
+    }
+    thread->copy_cpus(&set) ;
+#endif
+    if ( thread->get_pid() != 0 ) {
+        thread->execute_cpu_affinity() ;
+    }
+#endif
+    return true ;
+}
+
+/**
+@details
+-# Pin the new thread by its layout entry and touch stack_prefault bytes of its stack.
+*/
+void Trick::RealtimeProfile::thread_started(Trick::ThreadBase * thread) {
+    Trick::RealtimeProfile * profile = the_realtime_profile ;
+    if ( profile != NULL ) {
+        profile->pin_thread(thread) ;
+        if ( profile->prefault ) {
+            touch_stack(profile->stack_prefault) ;
+        }
+    }
+}
+
+/**
+@details
+-# Lock current and future memory with mlockall().  Locking faults in every page mapped now and every page mapped
+   later, so the memory needs no other prefaulting.
+-# Allocate heap_reserve bytes, write to each page and free them.  With glibc, the heap is first told never to
+   give memory back to the system and not to use mmap() for large allocations, so the pages stay in the heap for
+   later allocations.
+-# If memory is not locked, fault in each MemoryManager allocation and the stacks of the running threads.  The
+   MemoryManager maps are locked while their allocations are faulted in.  Touch the stack of the main thread, which
+   grows as it is used.
+-# Pin every Trick::Threads and every SysThread by the layout, and have threads started later pin themselves and
+   touch their stacks.
+-# Verify the result.
+*/
+int Trick::RealtimeProfile::apply() {
+
+    std::vector< Trick::SysThread * > sys_threads ;
+    unsigned int ii , num_threads ;
+    unsigned int num_prefaulted = 0 , num_failed = 0 ;
+
+    if ( ! enabled ) {
+        return 0 ;
+    }
+
+#if __linux
+    if ( lock_memory and ! memory_locked ) {
+        if ( mlockall(MCL_CURRENT | MCL_FUTURE) == 0 ) {
+            memory_locked = true ;
+            message_publish(MSG_INFO, "Real-time profile: memory locked\n") ;
+        } else {
+            struct rlimit limit ;
+            getrlimit(RLIMIT_MEMLOCK, &limit) ;
+            message_publish(MSG_WARNING, "Warning: Real-time profile: memory not locked: %s (RLIMIT_MEMLOCK %llu)\n" ,
+             strerror(errno), (unsigned long long)limit.rlim_cur) ;
+        }
+    }
+
+    if ( heap_reserve > 0 ) {
+#ifdef __GLIBC__
+        mallopt(M_TRIM_THRESHOLD, -1) ;
+        mallopt(M_MMAP_MAX, 0) ;
+#endif
+        volatile char * reserve = (volatile char *)malloc(heap_reserve) ;
+        if ( reserve != NULL ) {
+            size_t page = (size_t)sysconf(_SC_PAGESIZE) ;
+            size_t jj ;
+            for ( jj = 0 ; jj < heap_reserve ; jj += page ) {
+                reserve[jj] = 0 ;
+            }
+            free((void *)reserve) ;
+            message_publish(MSG_INFO, "Real-time profile: %zu bytes of heap reserved\n" , heap_reserve) ;
+        }
+    }
+
+    if ( prefault and ! memory_locked and trick_MM != NULL ) {
+        Trick::ALLOC_INFO_MAP_ITER it ;
+        trick_MM->lock_maps() ;
+        for ( it = trick_MM->alloc_info_map_begin() ; it != trick_MM->alloc_info_map_end() ; ++it ) {
+            ALLOC_INFO * alloc_info = it->second ;
+            if ( alloc_info->start != NULL and alloc_info->size > 0 and alloc_info->num > 0 ) {
+                if ( populate_range(alloc_info->start, (size_t)alloc_info->size * alloc_info->num) == 0 ) {
+                    num_prefaulted++ ;
+                } else {
+                    num_failed++ ;
+                }
+            }
+        }
+        trick_MM->unlock_maps() ;
+        message_publish(MSG_INFO, "Real-time profile: %u MemoryManager allocations prefaulted\n" , num_prefaulted) ;
+        if ( num_failed != 0 ) {
+            message_publish(MSG_WARNING, "Warning: Real-time profile: %u MemoryManager allocations could not be "
+             "prefaulted\n" , num_failed) ;
+        }
+    }
+    if ( prefault ) {
+        touch_stack(stack_prefault) ;
+    }
+
+    Trick::ThreadBase::start_hook = thread_started ;
+
+    num_threads = exec_get_num_threads() ;
+    for ( ii = 0 ; ii < num_threads ; ii++ ) {
+        Trick::Threads * thread = exec_get_thread(ii) ;
+        pin_thread(thread) ;
+        if ( ii != 0 and prefault and ! memory_locked and thread->get_pthread_id() != 0 ) {
+            populate_stack(thread->get_pthread_id(), stack_prefault) ;
+        }
+    }
+    Trick::SysThread::get_sys_threads(sys_threads) ;
+    for ( ii = 0 ; ii < sys_threads.size() ; ii++ ) {
+        pin_thread(sys_threads[ii]) ;
+        if ( prefault and ! memory_locked and sys_threads[ii]->get_pthread_id() != 0 ) {
+            populate_stack(sys_threads[ii]->get_pthread_id(), stack_prefault) ;
+        }
+    }
+
+    if ( verify ) {
+        verify_layout() ;
+    }
+#else
+    message_publish(MSG_WARNING, "Warning: Trick on Darwin does not yet support the real-time profile.\n") ;
+#endif
+    return 0 ;
+}
+
+/**
+@details
+-# Warn if memory was to be locked and is not.
+-# Warn about each thread no layout entry matches, and each running thread whose affinity is not the CPUs of its
+   entry.
+-# Warn about each CPU two scheduled threads are pinned to, and each CPU a SysThread shares with a scheduled
+   thread.
+-# Warn about each CPU of a scheduled thread that is not in /sys/devices/system/cpu/isolated, and each one that
+   is in the affinity of interrupts in /proc/irq.
+-# Publish a summary.
+*/
+int Trick::RealtimeProfile::verify_layout() {
+
+    std::vector< ProfileThread > threads ;
+    std::vector< Trick::SysThread * > sys_threads ;
+    std::vector< unsigned int > sched_cpus , cpus ;
+    std::vector< std::string > sched_names ;
+    unsigned int ii , jj , kk , num_threads ;
+
+    warnings = 0 ;
+
+#if __linux
+    if ( lock_memory and ! memory_locked ) {
+        profile_warning(warnings, "memory is not locked\n") ;
+    }
+
+    num_threads = exec_get_num_threads() ;
+    for ( ii = 0 ; ii < num_threads ; ii++ ) {
+        Trick::Threads * thread = exec_get_thread(ii) ;
+        ProfileThread pt = { thread->get_name() , true , thread->get_pid() , find_cpus(thread->get_name()) } ;
+        threads.push_back(pt) ;
+    }
+    Trick::SysThread::get_sys_threads(sys_threads) ;
+    for ( ii = 0 ; ii < sys_threads.size() ; ii++ ) {
+        ProfileThread pt = { sys_threads[ii]->get_name() , false , sys_threads[ii]->get_pid() ,
+         find_cpus(sys_threads[ii]->get_name()) } ;
+        threads.push_back(pt) ;
+    }
+
+    unsigned int max_cpu = (unsigned int)sysconf(_SC_NPROCESSORS_CONF) ;
+    for ( ii = 0 ; ii < threads.size() ; ii++ ) {
+        if ( threads[ii].cpus == NULL ) {
+            profile_warning(warnings, "thread %s matches no entry of the layout and may run on any CPU\n" ,
+             threads[ii].name.c_str()) ;
+        } else if ( threads[ii].pid != 0 ) {
+            cpu_set_t * set = CPU_ALLOC(max_cpu) ;
+            size_t set_size = CPU_ALLOC_SIZE(max_cpu) ;
+            CPU_ZERO_S(set_size, set) ;
+            if ( sched_getaffinity(threads[ii].pid, set_size, set) == 0 ) {
+                cpus.clear() ;
+                for ( kk = 0 ; kk < max_cpu ; kk++ ) {
+                    if ( CPU_ISSET_S(kk, set_size, set) ) {
+                        cpus.push_back(kk) ;
+                    }
+                }
+                if ( cpus != *threads[ii].cpus ) {
+                    profile_warning(warnings, "thread %s runs on CPUs %s, the layout gives %s\n" ,
+                     threads[ii].name.c_str(), format_cpu_list(cpus).c_str(),
+                     format_cpu_list(*threads[ii].cpus).c_str()) ;
+                }
+            }
+            CPU_FREE(set) ;
+        }
+    }
+
+    for ( ii = 0 ; ii < threads.size() ; ii++ ) {
+        if ( ! threads[ii].scheduled or threads[ii].cpus == NULL ) {
+            continue ;
+        }
+        for ( jj = 0 ; jj < threads.size() ; jj++ ) {
+            if ( jj == ii or threads[jj].cpus == NULL or ( threads[jj].scheduled and jj < ii ) ) {
+                continue ;
+            }
+            for ( kk = 0 ; kk < threads[ii].cpus->size() ; kk++ ) {
+                unsigned int cpu = (*threads[ii].cpus)[kk] ;
+                if ( std::binary_search(threads[jj].cpus->begin(), threads[jj].cpus->end(), cpu) ) {
+                    if ( threads[jj].scheduled ) {
+                        profile_warning(warnings, "scheduled threads %s and %s share CPU %u\n" ,
+                         threads[ii].name.c_str(), threads[jj].name.c_str(), cpu) ;
+                    } else {
+                        profile_warning(warnings, "thread %s shares CPU %u with scheduled thread %s\n" ,
+                         threads[jj].name.c_str(), cpu, threads[ii].name.c_str()) ;
+                    }
+                }
+            }
+        }
+        for ( kk = 0 ; kk < threads[ii].cpus->size() ; kk++ ) {
+            if ( std::find(sched_cpus.begin(), sched_cpus.end(), (*threads[ii].cpus)[kk]) == sched_cpus.end() ) {
+                sched_cpus.push_back((*threads[ii].cpus)[kk]) ;
+                sched_names.push_back(threads[ii].name) ;
+            }
+        }
+    }
+
+    if ( read_cpu_list_file("/sys/devices/system/cpu/isolated", cpus) == 0 ) {
+        for ( ii = 0 ; ii < sched_cpus.size() ; ii++ ) {
+            if ( ! std::binary_search(cpus.begin(), cpus.end(), sched_cpus[ii]) ) {
+                profile_warning(warnings, "CPU %u of scheduled thread %s is not isolated (isolcpus), other "
+                 "processes may run on it\n" , sched_cpus[ii], sched_names[ii].c_str()) ;
+            }
+        }
+    }
+
+    DIR * irq_dir = opendir("/proc/irq") ;
+    if ( irq_dir != NULL and ! sched_cpus.empty() ) {
+        std::vector< unsigned int > irq_counts(sched_cpus.size(), 0) ;
+        struct dirent * entry ;
+        while ( (entry = readdir(irq_dir)) != NULL ) {
+            if ( ! isdigit((unsigned char)entry->d_name[0]) ) {
+                continue ;
+            }
+            std::string file_name = std::string("/proc/irq/") + entry->d_name + "/smp_affinity_list" ;
+            if ( read_cpu_list_file(file_name.c_str(), cpus) == 0 ) {
+                for ( ii = 0 ; ii < sched_cpus.size() ; ii++ ) {
+                    if ( std::binary_search(cpus.begin(), cpus.end(), sched_cpus[ii]) ) {
+                        irq_counts[ii]++ ;
+                    }
+                }
+            }
+        }
+        for ( ii = 0 ; ii < sched_cpus.size() ; ii++ ) {
+            if ( irq_counts[ii] != 0 ) {
+                profile_warning(warnings, "%u interrupts may be delivered to CPU %u of scheduled thread %s\n" ,
+                 irq_counts[ii], sched_cpus[ii], sched_names[ii].c_str()) ;
+            }
+        }
+    }
+    if ( irq_dir != NULL ) {
+        closedir(irq_dir) ;
+    }
+
+    if ( warnings == 0 ) {
+        message_publish(MSG_INFO, "Real-time profile: layout verified, %d threads pinned\n" , (int)threads.size()) ;
+    } else {
+        message_publish(MSG_WARNING, "Warning: Real-time profile: %u problems found in the layout\n" , warnings) ;
+    }
+#endif
+    return warnings ;
+}
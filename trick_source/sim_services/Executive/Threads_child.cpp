@@ -26,6 +26,7 @@
 #include "trick/exec_proto.h"
 #include "trick/TrickConstant.hh"
 #include "trick/message_proto.h"
+#include "trick/TraceWriter.hh"
 
 
 /**
@@ -94,6 +95,8 @@ static int call_next_job(Trick::JobData * curr_job, Trick::ScheduledJobQueue & j
 */
 void * Trick::Threads::thread_body() {
 
+    long long wait_start_ns ;
+
     /* Lock the go mutex so the master has to wait until this child is ready before staring execution. */
     trigger_container.getThreadTrigger()->init() ;
 
@@ -105,7 +108,11 @@ void * Trick::Threads::thread_body() {
         do {
 
             /* Block child on trigger until master signals. */
+            wait_start_ns = Trick::TraceWriter::active ? Trick::TraceWriter::now() : 0 ;
             trigger_container.getThreadTrigger()->wait() ;
+            if ( Trick::TraceWriter::active ) {
+                Trick::TraceWriter::complete("trigger wait", "thread", wait_start_ns, Trick::TraceWriter::now()) ;
+            }
 
             if ( enabled ) {
 
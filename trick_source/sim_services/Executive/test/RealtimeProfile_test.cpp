@@ -0,0 +1,100 @@
+#include <pthread.h>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#define private public
+#define protected public
+#include "trick/RealtimeProfile.hh"
+#include "trick/Executive.hh"
+#include "trick/MemoryManager.hh"
+
+namespace Trick {
+
+class RealtimeProfileTest : public ::testing::Test {
+
+    protected:
+        Trick::RealtimeProfile profile ;
+        std::vector< unsigned int > cpus ;
+
+        RealtimeProfileTest() {}
+        ~RealtimeProfileTest() {}
+
+        std::vector< unsigned int > make_cpus( unsigned int num , const unsigned int * list ) {
+            return std::vector< unsigned int >(list, list + num) ;
+        }
+} ;
+
+TEST_F(RealtimeProfileTest , ParseSingleCpus) {
+    const unsigned int expected[] = { 3 } ;
+    EXPECT_EQ(RealtimeProfile::parse_cpu_list("3", cpus), 0) ;
+    EXPECT_EQ(cpus, make_cpus(1, expected)) ;
+    const unsigned int expected_list[] = { 0 , 2 , 7 } ;
+    EXPECT_EQ(RealtimeProfile::parse_cpu_list("7,0,2", cpus), 0) ;
+    EXPECT_EQ(cpus, make_cpus(3, expected_list)) ;
+}
+
+TEST_F(RealtimeProfileTest , ParseRanges) {
+    // Ranges and single CPUs are merged, sorted and without duplicates.  Spaces around items are ignored.
+    const unsigned int expected[] = { 0 , 1 , 4 , 5 , 6 , 7 , 10 } ;
+    EXPECT_EQ(RealtimeProfile::parse_cpu_list("4-7, 0-1 ,5,10\n", cpus), 0) ;
+    EXPECT_EQ(cpus, make_cpus(7, expected)) ;
+    const unsigned int expected_one[] = { 2 } ;
+    EXPECT_EQ(RealtimeProfile::parse_cpu_list("2-2", cpus), 0) ;
+    EXPECT_EQ(cpus, make_cpus(1, expected_one)) ;
+}
+
+TEST_F(RealtimeProfileTest , ParseInvalidLists) {
+    const char * invalid[] = { "" , "," , "1,," , "a" , "-1" , "1-" , "3-1" , "1-2-3" , "1.5" , "2x" , "0,-" } ;
+    for ( unsigned int ii = 0 ; ii < sizeof(invalid) / sizeof(invalid[0]) ; ii++ ) {
+        cpus.assign(1, 99) ;
+        EXPECT_EQ(RealtimeProfile::parse_cpu_list(invalid[ii], cpus), -1) << invalid[ii] ;
+    }
+}
+
+TEST_F(RealtimeProfileTest , PinRejectsInvalidList) {
+    EXPECT_EQ(profile.pin("Child_*", "1-"), -1) ;
+    EXPECT_EQ(profile.layout.size(), 0u) ;
+    EXPECT_EQ(profile.pin("Child_*", "0"), 0) ;
+    EXPECT_EQ(profile.layout.size(), 1u) ;
+}
+
+TEST_F(RealtimeProfileTest , FindCpusFirstMatch) {
+    profile.pin("Child_0", "0") ;
+    profile.pin("Child_*", "0-1") ;
+    profile.pin("DR_*", "0,2") ;
+
+    EXPECT_EQ(profile.find_cpus("Child_0"), &profile.layout[0].second) ;
+    EXPECT_EQ(profile.find_cpus("Child_1"), &profile.layout[1].second) ;
+    EXPECT_EQ(profile.find_cpus("Child_12"), &profile.layout[1].second) ;
+    EXPECT_EQ(profile.find_cpus("DR_Writer"), &profile.layout[2].second) ;
+    EXPECT_TRUE(profile.find_cpus("VarServListen") == NULL) ;
+    EXPECT_TRUE(profile.find_cpus("child_1") == NULL) ;
+
+    // A catch all entry matches every thread the entries before it do not.
+    profile.pin("*", "1") ;
+    EXPECT_EQ(profile.find_cpus("VarServListen"), &profile.layout[3].second) ;
+    EXPECT_EQ(profile.find_cpus("Child_0"), &profile.layout[0].second) ;
+}
+
+TEST_F(RealtimeProfileTest , PrefaultReleasesMemoryManager) {
+    Trick::Executive exec ;
+    Trick::MemoryManager mm ;
+    int cdims[1] = { 1000 } ;
+    ASSERT_TRUE(mm.declare_var(TRICK_DOUBLE, "", 0, "profile_test_array", 1, cdims) != NULL) ;
+
+    profile.enabled = true ;
+    profile.lock_memory = false ;
+    profile.verify = false ;
+    profile.stack_prefault = 16 * 1024 ;
+    EXPECT_EQ(profile.apply(), 0) ;
+    EXPECT_FALSE(profile.memory_locked) ;
+
+    // The maps are unlocked after the allocations are faulted in.
+    ASSERT_EQ(pthread_mutex_trylock(&mm.mm_mutex), 0) ;
+    pthread_mutex_unlock(&mm.mm_mutex) ;
+    EXPECT_TRUE(mm.declare_var(TRICK_DOUBLE, "", 0, "profile_test_after", 1, cdims) != NULL) ;
+}
+
+}
@@ -34,7 +34,7 @@ Trick::FrameLog::FrameLog(Trick::Clock & in_clock) :
  log_init_end(false),
  fp_time_main(NULL),
  fp_time_other(NULL),
- clock(in_clock) {
+ clock(&in_clock) {
 
     time_value_attr.type = TRICK_DOUBLE;
     time_value_attr.size = sizeof(double);
@@ -348,7 +348,7 @@ int Trick::FrameLog::frame_clock_start(Trick::JobData * curr_job ) {
     /** @par Detailed Design: */
     if ( target_job != NULL ) {
         /** @li Set target job's start time. */
-        target_job->rt_start_time = clock.clock_time() ;
+        target_job->rt_start_time = clock->clock_time() ;
     }
 
     return(0) ;
@@ -366,7 +366,7 @@ int Trick::FrameLog::frame_clock_stop(Trick::JobData * curr_job) {
     if ( target_job != NULL ) {
         if ( target_job->rt_start_time >= 0 ) {
             /** @li Set current job's stop time and frame time. */
-            target_job->rt_stop_time = clock.clock_time() ;
+            target_job->rt_stop_time = clock->clock_time() ;
             time_scale = 1.0 / target_job->time_tic_value;
             target_job->frame_time += (target_job->rt_stop_time - target_job->rt_start_time);
             target_job->frame_time_seconds = target_job->frame_time * time_scale;
@@ -501,7 +501,7 @@ void Trick::FrameLog::default_data() {
     add_recording_vars_for_jobs() ;
     add_recording_vars_for_frame() ;
     // reset clock before frame logging
-    clock.clock_reset(0);
+    clock->clock_reset(0);
 }
 
 /**
@@ -691,8 +691,16 @@ int Trick::FrameLog::shutdown() {
 
 }
 
+/**
+@details
+-# Give the new clock the simulation time tic ratio, and set it to the time of the current clock so times already
+   logged stay comparable.
+-# Read times from the new clock.
+*/
 void Trick::FrameLog::set_clock(Trick::Clock & in_clock) {
-    clock = in_clock ;
+    in_clock.calc_sim_time_ratio(exec_get_time_tic_value()) ;
+    in_clock.clock_reset(clock->clock_time()) ;
+    clock = &in_clock ;
 }
 
 //Call all the Create routines for the DP directory and all DP files.
@@ -0,0 +1,311 @@
+#include <stdio.h>
+
+#include "trick/JobProfiler.hh"
+#include "trick/JobProfile.hh"
+#include "trick/exec_proto.hh"
+#include "trick/exec_proto.h"
+#include "trick/command_line_protos.h"
+#include "trick/memorymanager_c_intf.h"
+#include "trick/message_proto.h"
+#include "trick/message_type.h"
+
+Trick::JobProfiler * the_jp = NULL ;
+
+unsigned long long Trick::JobProfile::frame_number = 0 ;
+
+Trick::JobProfiler::JobProfiler(Trick::RealtimeSync & in_rt_sync) :
+ enabled(true),
+ stats_period(1.0),
+ max_overrun_records(1000),
+ num_jobs(0),
+ stats(NULL),
+ num_overruns(0),
+ rt_sync(in_rt_sync),
+ last_total_overrun(0),
+ next_stats_tics(0) {
+    the_jp = this ;
+}
+
+/**
+@details
+-# Give every job without a profile a new one and add it to the profiled jobs.
+-# If the number of profiled jobs changed, reallocate stats through the memory manager so the variable server
+   can find it, and give each entry a copy of its job's name, also from the memory manager.
+*/
+void Trick::JobProfiler::attach_profiles() {
+
+    std::vector<Trick::JobData *> all_jobs_vector ;
+    unsigned int ii ;
+
+    exec_get_all_jobs_vector(all_jobs_vector) ;
+    for ( ii = 0 ; ii < all_jobs_vector.size() ; ii++ ) {
+        Trick::JobData * job = all_jobs_vector[ii] ;
+        unsigned int jj ;
+        for ( jj = 0 ; jj < jobs.size() and jobs[jj] != job ; jj++ ) ;
+        if ( jj == jobs.size() ) {
+            jobs.push_back(job) ;
+            profiles.push_back(new Trick::JobProfile()) ;
+        }
+        job->profile = profiles[jj] ;
+    }
+
+    if ( num_jobs != jobs.size() or stats == NULL ) {
+        if ( stats != NULL ) {
+            for ( ii = 0 ; ii < num_jobs ; ii++ ) {
+                if ( stats[ii].name != NULL ) {
+                    TMM_delete_var_a(stats[ii].name) ;
+                }
+            }
+            TMM_delete_var_a(stats) ;
+        }
+        num_jobs = jobs.size() ;
+        stats = (num_jobs > 0) ? (Trick::JobProfileStats *)TMM_declare_var_1d("Trick::JobProfileStats", num_jobs) : NULL ;
+        for ( ii = 0 ; ii < num_jobs ; ii++ ) {
+            stats[ii].name = TMM_strdup((char *)jobs[ii]->name.c_str()) ;
+        }
+    }
+    update_stats() ;
+}
+
+int Trick::JobProfiler::profiler_on() {
+    enabled = true ;
+    attach_profiles() ;
+    return(0) ;
+}
+
+/**
+@details
+-# Detach each profile from its job.  The profiles are kept, so a job in the middle of recording on another
+   thread still writes to valid memory, and turning profiling back on continues the same histograms.
+*/
+int Trick::JobProfiler::profiler_off() {
+    unsigned int ii ;
+    enabled = false ;
+    for ( ii = 0 ; ii < jobs.size() ; ii++ ) {
+        jobs[ii]->profile = NULL ;
+    }
+    return(0) ;
+}
+
+/**
+@details
+-# Clear every profile and the overrun records.  A job recording on another thread at the same moment may leave
+   one sample partly counted.
+*/
+int Trick::JobProfiler::reset() {
+    unsigned int ii ;
+    for ( ii = 0 ; ii < profiles.size() ; ii++ ) {
+        profiles[ii]->reset() ;
+    }
+    overrun_records.clear() ;
+    num_overruns = 0 ;
+    update_stats() ;
+    return(0) ;
+}
+
+int Trick::JobProfiler::get_index(std::string job_name) {
+    unsigned int ii ;
+    for ( ii = 0 ; ii < jobs.size() ; ii++ ) {
+        if ( jobs[ii]->name == job_name ) {
+            return ii ;
+        }
+    }
+    return(-1) ;
+}
+
+int Trick::JobProfiler::initialize() {
+    if ( enabled ) {
+        attach_profiles() ;
+    }
+    return(0) ;
+}
+
+/**
+@details
+-# If real-time synchronization counted a new overrun this frame, attribute it.  rt_monitor must run before this
+   job.
+-# Advance the profile frame number so each job starts its next frame time from 0.
+-# Update the counts of stats every stats_period.  The percentiles are left to update_stats().
+*/
+int Trick::JobProfiler::end_of_frame() {
+
+    long long curr_tics ;
+
+    if ( rt_sync.total_overrun != last_total_overrun ) {
+        last_total_overrun = rt_sync.total_overrun ;
+        if ( enabled ) {
+            attribute_overrun() ;
+        }
+    }
+
+    if ( ! enabled ) {
+        return(0) ;
+    }
+
+    Trick::JobProfile::frame_number++ ;
+
+    curr_tics = exec_get_time_tics() ;
+    if ( curr_tics >= next_stats_tics ) {
+        update_counts() ;
+        next_stats_tics = curr_tics + (long long)(stats_period * exec_get_time_tic_value()) ;
+    }
+
+    return(0) ;
+}
+
+/**
+@details
+-# Find the three jobs that took the most time in the current profile frame.  Jobs that have not run since the
+   frame number last advanced are skipped by their frame stamp, so nothing is cleared each frame.
+-# Charge the overrun to the longest job, and remember the three in the overrun ring.
+*/
+void Trick::JobProfiler::attribute_overrun() {
+
+    Trick::JobProfileOverrun record ;
+    unsigned int ii , jj , kk ;
+    unsigned long long curr_frame = Trick::JobProfile::frame_number ;
+
+    record.sim_time = exec_get_sim_time() ;
+    record.overrun = rt_sync.frame_overrun ;
+    for ( jj = 0 ; jj < 3 ; jj++ ) {
+        record.job[jj] = -1 ;
+        record.job_time[jj] = 0.0 ;
+    }
+
+    for ( ii = 0 ; ii < profiles.size() ; ii++ ) {
+        if ( profiles[ii]->frame != curr_frame ) {
+            continue ;
+        }
+        double frame_time = profiles[ii]->frame_ns * 1.0e-9 ;
+        for ( jj = 0 ; jj < 3 ; jj++ ) {
+            if ( record.job[jj] < 0 or frame_time > record.job_time[jj] ) {
+                for ( kk = 2 ; kk > jj ; kk-- ) {
+                    record.job[kk] = record.job[kk - 1] ;
+                    record.job_time[kk] = record.job_time[kk - 1] ;
+                }
+                record.job[jj] = ii ;
+                record.job_time[jj] = frame_time ;
+                break ;
+            }
+        }
+    }
+
+    if ( record.job[0] >= 0 ) {
+        profiles[record.job[0]]->overruns++ ;
+    }
+    if ( max_overrun_records > 0 ) {
+        if ( overrun_records.size() < max_overrun_records ) {
+            overrun_records.push_back(record) ;
+        } else {
+            overrun_records[num_overruns % max_overrun_records] = record ;
+        }
+    }
+    num_overruns++ ;
+}
+
+void Trick::JobProfiler::update_counts() {
+
+    unsigned int ii ;
+
+    for ( ii = 0 ; ii < num_jobs and ii < profiles.size() ; ii++ ) {
+        Trick::JobProfile * profile = profiles[ii] ;
+        Trick::JobProfileStats & curr = stats[ii] ;
+        curr.thread = jobs[ii]->thread ;
+        curr.count = profile->count ;
+        curr.mean = (profile->count > 0) ? profile->total_ns * 1.0e-9 / profile->count : 0.0 ;
+        curr.min = profile->min_ns * 1.0e-9 ;
+        curr.max = profile->max_ns * 1.0e-9 ;
+        curr.overruns = profile->overruns ;
+    }
+}
+
+/**
+@details
+-# Update the counts of stats.
+-# Compute the four percentiles of each job in one scan of its histogram.
+*/
+int Trick::JobProfiler::update_stats() {
+
+    static const double pct[4] = { 50.0 , 90.0 , 99.0 , 99.9 } ;
+    long long values[4] ;
+    unsigned int ii ;
+
+    update_counts() ;
+    for ( ii = 0 ; ii < num_jobs and ii < profiles.size() ; ii++ ) {
+        Trick::JobProfileStats & curr = stats[ii] ;
+        profiles[ii]->percentiles(pct, values, 4) ;
+        curr.p50 = values[0] * 1.0e-9 ;
+        curr.p90 = values[1] * 1.0e-9 ;
+        curr.p99 = values[2] * 1.0e-9 ;
+        curr.p999 = values[3] * 1.0e-9 ;
+    }
+    return(0) ;
+}
+
+/**
+@details
+-# The jobs and their profiles survive a checkpoint reload, but enabled, num_jobs and stats are replaced by the
+   checkpointed ones.  If the checkpoint was profiling, reattach the profiles, which reallocates stats if it is
+   missing or sized for other jobs.  Otherwise detach them.
+*/
+int Trick::JobProfiler::restart() {
+    if ( enabled ) {
+        attach_profiles() ;
+    } else {
+        profiler_off() ;
+    }
+    return(0) ;
+}
+
+/**
+@details
+-# Update stats one last time and write one line per job that ran to job_profile.csv.
+-# Write the remembered overruns, oldest first, to job_profile_overruns.csv.
+*/
+int Trick::JobProfiler::shutdown() {
+
+    char file_name[1024] ;
+    FILE * fp ;
+    unsigned int ii , jj , first ;
+
+    if ( jobs.empty() ) {
+        return(0) ;
+    }
+    update_stats() ;
+
+    snprintf(file_name, sizeof(file_name), "%s/job_profile.csv", command_line_args_get_output_dir()) ;
+    if ((fp = fopen(file_name, "w")) == NULL) {
+        message_publish(MSG_ERROR, "Could not open %s for the job profile\n", file_name) ;
+        return(0) ;
+    }
+    fprintf(fp, "job,thread,class,count,mean {s},min {s},p50 {s},p90 {s},p99 {s},p99.9 {s},max {s},overruns\n") ;
+    for ( ii = 0 ; ii < num_jobs ; ii++ ) {
+        if ( stats[ii].count == 0 ) {
+            continue ;
+        }
+        fprintf(fp, "%s,%u,%s,%llu,%.9f,%.9f,%.9f,%.9f,%.9f,%.9f,%.9f,%u\n", jobs[ii]->name.c_str(),
+         stats[ii].thread, jobs[ii]->job_class_name.c_str(), stats[ii].count, stats[ii].mean, stats[ii].min,
+         stats[ii].p50, stats[ii].p90, stats[ii].p99, stats[ii].p999, stats[ii].max, stats[ii].overruns) ;
+    }
+    fclose(fp) ;
+
+    snprintf(file_name, sizeof(file_name), "%s/job_profile_overruns.csv", command_line_args_get_output_dir()) ;
+    if ((fp = fopen(file_name, "w")) == NULL) {
+        message_publish(MSG_ERROR, "Could not open %s for the job profile\n", file_name) ;
+        return(0) ;
+    }
+    fprintf(fp, "sim_time {s},overrun {s},job_1,time_1 {s},job_2,time_2 {s},job_3,time_3 {s}\n") ;
+    first = (overrun_records.size() < max_overrun_records) ? 0 : num_overruns % max_overrun_records ;
+    for ( ii = 0 ; ii < overrun_records.size() ; ii++ ) {
+        Trick::JobProfileOverrun & record = overrun_records[(first + ii) % overrun_records.size()] ;
+        fprintf(fp, "%.6f,%.9f", record.sim_time, record.overrun) ;
+        for ( jj = 0 ; jj < 3 ; jj++ ) {
+            fprintf(fp, ",%s,%.9f", (record.job[jj] >= 0) ? jobs[record.job[jj]]->name.c_str() : "",
+             record.job_time[jj]) ;
+        }
+        fprintf(fp, "\n") ;
+    }
+    fclose(fp) ;
+
+    return(0) ;
+}
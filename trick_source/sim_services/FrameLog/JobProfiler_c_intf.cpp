@@ -0,0 +1,69 @@
+#include "trick/JobProfiler.hh"
+#include "trick/jobprofiler_proto.h"
+
+/* Global singleton pointer to the job profiler class */
+extern Trick::JobProfiler * the_jp ;
+
+/*************************************************************************/
+/* These routines are the "C" interface to the job profiler              */
+/*************************************************************************/
+
+/**
+ * @relates Trick::JobProfiler
+ * @copydoc Trick::JobProfiler::profiler_on
+ * C wrapper for Trick::JobProfiler::profiler_on
+ */
+extern "C" int job_profiler_on(void) {
+    if (the_jp != NULL) {
+        return the_jp->profiler_on() ;
+    }
+    return(0) ;
+}
+
+/**
+ * @relates Trick::JobProfiler
+ * @copydoc Trick::JobProfiler::profiler_off
+ * C wrapper for Trick::JobProfiler::profiler_off
+ */
+extern "C" int job_profiler_off(void) {
+    if (the_jp != NULL) {
+        return the_jp->profiler_off() ;
+    }
+    return(0) ;
+}
+
+/**
+ * @relates Trick::JobProfiler
+ * @copydoc Trick::JobProfiler::reset
+ * C wrapper for Trick::JobProfiler::reset
+ */
+extern "C" int job_profiler_reset(void) {
+    if (the_jp != NULL) {
+        return the_jp->reset() ;
+    }
+    return(0) ;
+}
+
+/**
+ * @relates Trick::JobProfiler
+ * @copydoc Trick::JobProfiler::update_stats
+ * C wrapper for Trick::JobProfiler::update_stats
+ */
+extern "C" int job_profiler_update_stats(void) {
+    if (the_jp != NULL) {
+        return the_jp->update_stats() ;
+    }
+    return(0) ;
+}
+
+/**
+ * @relates Trick::JobProfiler
+ * @copydoc Trick::JobProfiler::get_index
+ * C wrapper for Trick::JobProfiler::get_index
+ */
+extern "C" int job_profiler_get_index(const char * job_name) {
+    if (the_jp != NULL) {
+        return the_jp->get_index(job_name) ;
+    }
+    return(-1) ;
+}
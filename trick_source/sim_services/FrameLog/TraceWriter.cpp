@@ -0,0 +1,290 @@
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#if __linux
+#include <sys/syscall.h>
+#endif
+
+#include "trick/TraceWriter.hh"
+#include "trick/command_line_protos.h"
+#include "trick/message_proto.h"
+#include "trick/message_type.h"
+
+namespace Trick {
+
+    /** One recorded event.  end_ns is -1 for an instant event. */
+    struct TraceEvent {
+        long long start_ns ;
+        long long end_ns ;
+        const char * name ;
+        const char * category ;
+    } ;
+
+    /** A single writer, single reader ring of one thread's events.  head counts the events recorded and tail
+        the events drained; each is changed only by its own side.  retired is set when the thread exits, after
+        its last event. */
+    struct TraceBuffer {
+        TraceEvent * events ;
+        unsigned int mask ;
+        unsigned int head ;
+        unsigned int tail ;
+        unsigned long long dropped ;
+        long tid ;
+        char thread_name[32] ;
+        bool named ;
+        bool retired ;
+    } ;
+
+}
+
+Trick::TraceWriter * the_tw = NULL ;
+bool Trick::TraceWriter::active = false ;
+
+/* The calling thread's ring, once it has recorded an event. */
+static __thread Trick::TraceBuffer * thread_buffer = NULL ;
+
+/* Also holds the calling thread's ring, so that the ring is retired when the thread exits. */
+static pthread_key_t buffer_key ;
+static pthread_once_t buffer_key_once = PTHREAD_ONCE_INIT ;
+
+/* Called when a thread that recorded exits.  Forget its ring, so an event it records later gets a new one, and
+   mark the ring retired after the thread's last event.  The writer frees it once it is drained. */
+static void retire_buffer( void * buffer ) {
+    thread_buffer = NULL ;
+    __atomic_store_n(&((Trick::TraceBuffer *)buffer)->retired, true, __ATOMIC_RELEASE) ;
+}
+
+static void create_buffer_key() {
+    pthread_key_create(&buffer_key, retire_buffer) ;
+}
+
+Trick::TraceWriter::TraceWriter() :
+ Trick::SysThread("TraceWriter") ,
+ file_name("trace.json") ,
+ buffer_size(65536) ,
+ flush_period(0.1) ,
+ events_written(0) ,
+ events_dropped(0) ,
+ fp(NULL) ,
+ base_ns(0) ,
+ first_event(true) ,
+ freed_dropped(0) {
+    pthread_mutex_init(&write_mutex, NULL) ;
+    pthread_mutex_init(&buffers_mutex, NULL) ;
+    pthread_once(&buffer_key_once, create_buffer_key) ;
+    the_tw = this ;
+}
+
+/**
+@details
+-# The first time, open the file in the output directory, start the JSON array, and start the writer thread.
+-# Set active so events are recorded.
+*/
+int Trick::TraceWriter::trace_on() {
+
+    if ( fp == NULL ) {
+        std::string path = std::string(command_line_args_get_output_dir()) + "/" + file_name ;
+        if ((fp = fopen(path.c_str(), "w")) == NULL) {
+            message_publish(MSG_ERROR, "Could not open %s for the trace\n", path.c_str()) ;
+            return(-1) ;
+        }
+        // the JSON array format, which viewers read even without the closing bracket of a run that crashed
+        fprintf(fp, "[\n") ;
+        base_ns = now() ;
+        if ( ! created ) {
+            create_thread() ;
+        }
+    }
+    active = true ;
+    return(0) ;
+}
+
+int Trick::TraceWriter::trace_off() {
+    active = false ;
+    return(0) ;
+}
+
+/**
+@details
+-# The first time a thread records, allocate its ring and add it to buffers.  This is the only lock taken on the
+   recording side.  The ring is also set in buffer_key, whose destructor retires it when the thread exits.
+-# If the ring is full, count the event as dropped.
+-# Otherwise fill the slot at head, then publish it by advancing head.
+*/
+void Trick::TraceWriter::record( const char * name , const char * category , long long start_ns , long long end_ns ) {
+
+    Trick::TraceBuffer * buffer = thread_buffer ;
+
+    if ( buffer == NULL ) {
+        if ( the_tw == NULL ) {
+            return ;
+        }
+        unsigned int size = 1 ;
+        while ( size < the_tw->buffer_size ) {
+            size <<= 1 ;
+        }
+        buffer = new Trick::TraceBuffer() ;
+        buffer->events = new Trick::TraceEvent[size] ;
+        buffer->mask = size - 1 ;
+        buffer->head = 0 ;
+        buffer->tail = 0 ;
+        buffer->dropped = 0 ;
+        buffer->retired = false ;
+#if __linux
+        buffer->tid = syscall(SYS_gettid) ;
+        buffer->named = (pthread_getname_np(pthread_self(), buffer->thread_name, sizeof(buffer->thread_name)) == 0) ;
+#else
+        buffer->tid = (long)getpid() ;
+        buffer->named = false ;
+#endif
+        pthread_mutex_lock(&the_tw->buffers_mutex) ;
+        the_tw->buffers.push_back(buffer) ;
+        pthread_mutex_unlock(&the_tw->buffers_mutex) ;
+        pthread_setspecific(buffer_key, buffer) ;
+        thread_buffer = buffer ;
+    }
+
+    unsigned int head = buffer->head ;
+    if ( head - __atomic_load_n(&buffer->tail, __ATOMIC_ACQUIRE) > buffer->mask ) {
+        buffer->dropped++ ;
+        return ;
+    }
+    Trick::TraceEvent & event = buffer->events[head & buffer->mask] ;
+    event.start_ns = start_ns ;
+    event.end_ns = end_ns ;
+    event.name = name ;
+    event.category = category ;
+    __atomic_store_n(&buffer->head, head + 1, __ATOMIC_RELEASE) ;
+}
+
+/**
+@details
+-# Return the copy of str kept in names, adding it the first time.
+*/
+const char * Trick::TraceWriter::intern( const std::string & str ) {
+    const char * ret ;
+    if ( the_tw == NULL ) {
+        return "" ;
+    }
+    pthread_mutex_lock(&the_tw->buffers_mutex) ;
+    ret = the_tw->names.insert(str).first->c_str() ;
+    pthread_mutex_unlock(&the_tw->buffers_mutex) ;
+    return ret ;
+}
+
+void Trick::TraceWriter::write_string( const char * str ) {
+    fputc('"', fp) ;
+    for ( ; *str != '\0' ; str++ ) {
+        if ( *str == '"' or *str == '\\' ) {
+            fputc('\\', fp) ;
+            fputc(*str, fp) ;
+        } else if ( (unsigned char)*str < 0x20 ) {
+            fprintf(fp, "\\u%04x", (unsigned char)*str) ;
+        } else {
+            fputc(*str, fp) ;
+        }
+    }
+    fputc('"', fp) ;
+}
+
+/**
+@details
+-# Copy the list of rings, so threads may add theirs while this one writes.
+-# For each ring, write a thread name metadata event the first time, then each event up to the current head as
+   a complete ("X") or instant ("i") event with microsecond timestamps, then free the slots by advancing tail.
+-# A ring seen retired before its head was read holds no more events once drained.  Remove it from buffers and
+   free it, keeping its dropped count.
+-# Flush the file so the trace on disk is never more than one drain behind.
+*/
+void Trick::TraceWriter::drain() {
+
+    std::vector< Trick::TraceBuffer * > curr_buffers ;
+    unsigned int ii ;
+    int pid = (int)getpid() ;
+
+    pthread_mutex_lock(&buffers_mutex) ;
+    curr_buffers = buffers ;
+    pthread_mutex_unlock(&buffers_mutex) ;
+
+    events_dropped = freed_dropped ;
+    for ( ii = 0 ; ii < curr_buffers.size() ; ii++ ) {
+        Trick::TraceBuffer * buffer = curr_buffers[ii] ;
+        bool retired = __atomic_load_n(&buffer->retired, __ATOMIC_ACQUIRE) ;
+        unsigned int tail = buffer->tail ;
+        unsigned int head = __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE) ;
+
+        if ( buffer->named ) {
+            fprintf(fp, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%ld,\"args\":{\"name\":",
+             first_event ? "" : ",\n", pid, buffer->tid) ;
+            write_string(buffer->thread_name) ;
+            fprintf(fp, "}}") ;
+            first_event = false ;
+            buffer->named = false ;
+        }
+        for ( ; tail != head ; tail++ ) {
+            Trick::TraceEvent & event = buffer->events[tail & buffer->mask] ;
+            fprintf(fp, "%s{\"name\":", first_event ? "" : ",\n") ;
+            write_string(event.name) ;
+            fprintf(fp, ",\"cat\":") ;
+            write_string(event.category) ;
+            if ( event.end_ns < 0 ) {
+                fprintf(fp, ",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":%d,\"tid\":%ld}",
+                 (event.start_ns - base_ns) / 1000.0, pid, buffer->tid) ;
+            } else {
+                fprintf(fp, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%ld}",
+                 (event.start_ns - base_ns) / 1000.0, (event.end_ns - event.start_ns) / 1000.0, pid, buffer->tid) ;
+            }
+            first_event = false ;
+            events_written++ ;
+        }
+        __atomic_store_n(&buffer->tail, tail, __ATOMIC_RELEASE) ;
+        events_dropped += buffer->dropped ;
+        if ( retired ) {
+            pthread_mutex_lock(&buffers_mutex) ;
+            buffers.erase(std::find(buffers.begin(), buffers.end(), buffer)) ;
+            pthread_mutex_unlock(&buffers_mutex) ;
+            freed_dropped += buffer->dropped ;
+            delete [] buffer->events ;
+            delete buffer ;
+        }
+    }
+    fflush(fp) ;
+}
+
+static void unlock_mutex( void * mutex ) {
+    pthread_mutex_unlock((pthread_mutex_t *)mutex) ;
+}
+
+void * Trick::TraceWriter::thread_body() {
+    while ( true ) {
+        usleep((useconds_t)(flush_period * 1000000.0)) ;
+        pthread_mutex_lock(&write_mutex) ;
+        pthread_cleanup_push(unlock_mutex, &write_mutex) ;
+        if ( fp != NULL ) {
+            drain() ;
+        }
+        pthread_cleanup_pop(1) ;
+    }
+    return NULL ;
+}
+
+/**
+@details
+-# Stop recording, write what the rings still hold, close the JSON array and the file.
+*/
+int Trick::TraceWriter::shutdown() {
+    active = false ;
+    pthread_mutex_lock(&write_mutex) ;
+    if ( fp != NULL ) {
+        drain() ;
+        fprintf(fp, "\n]\n") ;
+        fclose(fp) ;
+        fp = NULL ;
+        if ( events_dropped > 0 ) {
+            message_publish(MSG_WARNING, "Trace dropped %llu events because a buffer was full.  Increase "
+             "buffer_size or decrease flush_period.\n", events_dropped) ;
+        }
+    }
+    pthread_mutex_unlock(&write_mutex) ;
+    return(0) ;
+}
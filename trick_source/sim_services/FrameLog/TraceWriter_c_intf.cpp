@@ -0,0 +1,33 @@
+#include "trick/TraceWriter.hh"
+#include "trick/tracewriter_proto.h"
+
+/* Global singleton pointer to the trace writer class */
+extern Trick::TraceWriter * the_tw ;
+
+/*************************************************************************/
+/* These routines are the "C" interface to the trace writer              */
+/*************************************************************************/
+
+/**
+ * @relates Trick::TraceWriter
+ * @copydoc Trick::TraceWriter::trace_on
+ * C wrapper for Trick::TraceWriter::trace_on
+ */
+extern "C" int trace_on(void) {
+    if (the_tw != NULL) {
+        return the_tw->trace_on() ;
+    }
+    return(0) ;
+}
+
+/**
+ * @relates Trick::TraceWriter
+ * @copydoc Trick::TraceWriter::trace_off
+ * C wrapper for Trick::TraceWriter::trace_off
+ */
+extern "C" int trace_off(void) {
+    if (the_tw != NULL) {
+        return the_tw->trace_off() ;
+    }
+    return(0) ;
+}
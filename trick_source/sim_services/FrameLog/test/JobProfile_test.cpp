@@ -0,0 +1,179 @@
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "trick/JobProfile.hh"
+#include "trick/JobData.hh"
+#include "trick/InstrumentBase.hh"
+#include "trick/SimObject.hh"
+
+namespace Trick {
+
+/* A sim object whose job returns a value and counts its calls. */
+class CountingSimObject : public Trick::SimObject {
+    public:
+        int calls ;
+        CountingSimObject() : calls(0) {}
+        virtual int call_function( Trick::JobData * ) { calls++ ; return 3 ; }
+        virtual double call_function_double( Trick::JobData * ) { calls++ ; return 1.5 ; }
+} ;
+
+/* An instrumentation job that counts its calls. */
+class CountingInstrument : public Trick::InstrumentBase {
+    public:
+        int calls ;
+        CountingInstrument() : calls(0) {}
+        virtual int call() { calls++ ; return 0 ; }
+} ;
+
+class JobProfileTest : public ::testing::Test {
+
+    protected:
+        Trick::JobProfile profile ;
+
+        JobProfileTest() {}
+        ~JobProfileTest() {}
+
+        /* The exact value at a percentile of sorted times, found the way JobProfile counts. */
+        long long exact_percentile(std::vector<long long> & sorted, double pct) {
+            size_t target = (size_t)(pct / 100.0 * sorted.size() + 0.5) ;
+            return sorted[(target == 0) ? 0 : target - 1] ;
+        }
+} ;
+
+TEST_F(JobProfileTest , BucketOfSmallTimes) {
+    // Below JOB_PROFILE_SUB_BUCKETS ns, each nanosecond has its own bucket.
+    for ( long long ns = 0 ; ns < JOB_PROFILE_SUB_BUCKETS ; ns++ ) {
+        EXPECT_EQ(JobProfile::bucket_of(ns), ns) ;
+        EXPECT_EQ(JobProfile::bucket_value((int)ns), ns) ;
+    }
+    EXPECT_EQ(JobProfile::bucket_of(-5), 0) ;
+}
+
+TEST_F(JobProfileTest , BucketOfPowersOfTwo) {
+    // Each power of two starts a new run of JOB_PROFILE_SUB_BUCKETS buckets.
+    EXPECT_EQ(JobProfile::bucket_of(16), 16) ;
+    EXPECT_EQ(JobProfile::bucket_of(31), 31) ;
+    EXPECT_EQ(JobProfile::bucket_of(32), 32) ;
+    EXPECT_EQ(JobProfile::bucket_of(33), 32) ;
+    EXPECT_EQ(JobProfile::bucket_of(34), 33) ;
+    EXPECT_EQ(JobProfile::bucket_of(63), 47) ;
+    EXPECT_EQ(JobProfile::bucket_of(64), 48) ;
+    EXPECT_EQ(JobProfile::bucket_of(1LL << JOB_PROFILE_MAX_MAGNITUDE),
+     JOB_PROFILE_BUCKETS - JOB_PROFILE_SUB_BUCKETS) ;
+    EXPECT_EQ(JobProfile::bucket_of((2LL << JOB_PROFILE_MAX_MAGNITUDE) - 1), JOB_PROFILE_BUCKETS - 1) ;
+    EXPECT_EQ(JobProfile::bucket_of(2LL << JOB_PROFILE_MAX_MAGNITUDE), JOB_PROFILE_BUCKETS - 1) ;
+    EXPECT_EQ(JobProfile::bucket_of(0x7fffffffffffffffLL), JOB_PROFILE_BUCKETS - 1) ;
+}
+
+TEST_F(JobProfileTest , BucketsAreOrderedAndPrecise) {
+    // Bucket indexes never decrease with time, and the middle of a bucket is within 1/32 of any time in it.
+    int last = 0 ;
+    for ( long long ns = 1 ; ns < (2LL << JOB_PROFILE_MAX_MAGNITUDE) ; ns += ns / 7 + 1 ) {
+        int bucket = JobProfile::bucket_of(ns) ;
+        ASSERT_GE(bucket, last) << ns ;
+        ASSERT_LT(bucket, JOB_PROFILE_BUCKETS) << ns ;
+        last = bucket ;
+        long long value = JobProfile::bucket_value(bucket) ;
+        EXPECT_LE(llabs(value - ns), ns / (2 * JOB_PROFILE_SUB_BUCKETS) + 1) << ns ;
+        EXPECT_EQ(JobProfile::bucket_of(value), bucket) << ns ;
+    }
+}
+
+TEST_F(JobProfileTest , Record) {
+    profile.record(100) ;
+    profile.record(300) ;
+    profile.record(200) ;
+    EXPECT_EQ(profile.count, 3u) ;
+    EXPECT_EQ(profile.total_ns, 600) ;
+    EXPECT_EQ(profile.min_ns, 100) ;
+    EXPECT_EQ(profile.max_ns, 300) ;
+    EXPECT_EQ(profile.buckets[JobProfile::bucket_of(200)], 1u) ;
+    profile.reset() ;
+    EXPECT_EQ(profile.count, 0u) ;
+    EXPECT_EQ(profile.buckets[JobProfile::bucket_of(200)], 0u) ;
+}
+
+TEST_F(JobProfileTest , PercentileOfOneValue) {
+    // Clamping to the extremes makes a single time exact.
+    profile.record(1000003) ;
+    EXPECT_EQ(profile.percentile(0.0), 1000003) ;
+    EXPECT_EQ(profile.percentile(50.0), 1000003) ;
+    EXPECT_EQ(profile.percentile(100.0), 1000003) ;
+}
+
+TEST_F(JobProfileTest , PercentileWithoutCalls) {
+    EXPECT_EQ(profile.percentile(50.0), 0) ;
+}
+
+TEST_F(JobProfileTest , PercentilesMatchSortedTimes) {
+    std::vector<long long> times ;
+    srand(42) ;
+    for ( int ii = 0 ; ii < 100000 ; ii++ ) {
+        // mostly about 20 us with a long tail
+        long long ns = 20000 + rand() % 5000 ;
+        if ( ii % 100 == 0 ) {
+            ns *= 10 + rand() % 50 ;
+        }
+        times.push_back(ns) ;
+        profile.record(ns) ;
+    }
+    std::sort(times.begin(), times.end()) ;
+
+    const double pct[] = { 0.0 , 1.0 , 50.0 , 90.0 , 99.0 , 99.9 , 100.0 } ;
+    long long values[7] ;
+    profile.percentiles(pct, values, 7) ;
+    for ( int ii = 0 ; ii < 7 ; ii++ ) {
+        long long exact = exact_percentile(times, pct[ii]) ;
+        // within the bucket precision, and the same as asked one at a time
+        EXPECT_LE(llabs(values[ii] - exact), exact / (2 * JOB_PROFILE_SUB_BUCKETS) + 1) << pct[ii] ;
+        EXPECT_EQ(values[ii], profile.percentile(pct[ii])) << pct[ii] ;
+    }
+    EXPECT_EQ(values[0], times.front()) ;
+    EXPECT_EQ(values[6], times.back()) ;
+}
+
+TEST_F(JobProfileTest , PercentilesInOneBucket) {
+    // Several percentiles that fall in the same bucket all get it.  A bucket middle below the shortest time
+    // is clamped to it.
+    for ( int ii = 0 ; ii < 10 ; ii++ ) {
+        profile.record(5000) ;
+    }
+    profile.record(90000) ;
+    profile.record(100000) ;
+    const double pct[] = { 50.0 , 80.0 , 90.0 , 99.0 } ;
+    long long values[4] ;
+    profile.percentiles(pct, values, 4) ;
+    EXPECT_LT(JobProfile::bucket_value(JobProfile::bucket_of(5000)), 5000) ;
+    EXPECT_EQ(values[0], 5000) ;
+    EXPECT_EQ(values[1], 5000) ;
+    EXPECT_EQ(values[2], JobProfile::bucket_value(JobProfile::bucket_of(90000))) ;
+    EXPECT_EQ(values[3], 100000) ;
+}
+
+TEST_F(JobProfileTest , JobCallsRecordProfile) {
+    CountingSimObject obj ;
+    CountingInstrument before , after ;
+    Trick::JobData job ;
+    job.parent_object = &obj ;
+    job.add_inst_before(&before) ;
+    job.add_inst_after(&after) ;
+
+    // Without a profile the job is only called.
+    EXPECT_EQ(job.call(), 3) ;
+    EXPECT_EQ(profile.count, 0u) ;
+
+    // Both kinds of job call run the instrumentation and record the job itself.
+    job.profile = &profile ;
+    EXPECT_EQ(job.call(), 3) ;
+    EXPECT_EQ(job.call_double(), 1.5) ;
+    EXPECT_EQ(obj.calls, 3) ;
+    EXPECT_EQ(before.calls, 3) ;
+    EXPECT_EQ(after.calls, 3) ;
+    EXPECT_EQ(profile.count, 2u) ;
+    EXPECT_EQ(profile.frame, JobProfile::frame_number) ;
+    EXPECT_LE(profile.min_ns, profile.max_ns) ;
+}
+
+}
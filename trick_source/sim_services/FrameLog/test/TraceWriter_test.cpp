@@ -0,0 +1,190 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#define private public
+#include "trick/TraceWriter.hh"
+#include "trick/JobData.hh"
+#include "trick/SimObject.hh"
+#include "trick/CommandLineArguments.hh"
+
+namespace Trick {
+
+/* A sim object whose job does nothing. */
+class EmptySimObject : public Trick::SimObject {
+    public:
+        virtual int call_function( Trick::JobData * ) { return 0 ; }
+        virtual double call_function_double( Trick::JobData * ) { return 0.0 ; }
+} ;
+
+class TraceWriterTest : public ::testing::Test {
+
+    protected:
+        Trick::CommandLineArguments cmd_args ;
+        Trick::TraceWriter tw ;
+        std::string dir ;
+
+        TraceWriterTest() {}
+        ~TraceWriterTest() {}
+
+        virtual void SetUp() {
+            char dir_template[] = "/tmp/trace_writer_XXXXXX" ;
+            dir = mkdtemp(dir_template) ;
+            cmd_args.output_dir = dir ;
+            // drains are made by the tests
+            tw.flush_period = 1000.0 ;
+        }
+        virtual void TearDown() {
+            tw.shutdown() ;
+            tw.cancel_thread() ;
+            tw.join_thread() ;
+            std::string command = "rm -rf " + dir ;
+            system(command.c_str()) ;
+        }
+
+        /* Drains the rings the way the writer thread does. */
+        void drain() {
+            pthread_mutex_lock(&tw.write_mutex) ;
+            tw.drain() ;
+            pthread_mutex_unlock(&tw.write_mutex) ;
+        }
+
+        std::string read_trace() {
+            std::ifstream file((dir + "/trace.json").c_str()) ;
+            std::stringstream contents ;
+            contents << file.rdbuf() ;
+            return contents.str() ;
+        }
+} ;
+
+/* Records num events on a thread that then exits.  Each test records on its own threads, since a thread keeps
+   its ring for the TraceWriter it first recorded for. */
+static void record_and_exit( int num ) {
+    std::thread thread([num]() {
+        for ( int ii = 0 ; ii < num ; ii++ ) {
+            Trick::TraceWriter::instant("from_thread", "test") ;
+        }
+    }) ;
+    thread.join() ;
+}
+
+TEST_F(TraceWriterTest , InternKeepsOneCopy) {
+    std::string name("sim_obj.job") ;
+    const char * first = TraceWriter::intern(name) ;
+    const char * second = TraceWriter::intern(std::string("sim_obj.job")) ;
+    EXPECT_EQ(first, second) ;
+    EXPECT_STREQ(first, "sim_obj.job") ;
+    name = "changed" ;
+    EXPECT_STREQ(first, "sim_obj.job") ;
+    EXPECT_NE(TraceWriter::intern("other"), first) ;
+}
+
+TEST_F(TraceWriterTest , WritesJobs) {
+    ASSERT_EQ(tw.trace_on(), 0) ;
+    std::thread thread([]() {
+        EmptySimObject obj ;
+        Trick::JobData * job = new Trick::JobData() ;
+        job->name = "sim_obj.\"quoted\"" ;
+        job->parent_object = &obj ;
+        job->call() ;
+        job->call_double() ;
+        // The trace has the name the job had when it was called, even after the job is gone.
+        job->name = "renamed" ;
+        delete job ;
+        Trick::TraceWriter::instant("marker", "test") ;
+    }) ;
+    thread.join() ;
+    tw.shutdown() ;
+
+    std::string trace = read_trace() ;
+    EXPECT_EQ(tw.events_written, 3u) ;
+    EXPECT_EQ(tw.events_dropped, 0u) ;
+    EXPECT_EQ(trace.compare(0, 2, "[\n"), 0) ;
+    EXPECT_EQ(trace.compare(trace.size() - 3, 3, "\n]\n"), 0) ;
+    size_t first = trace.find("{\"name\":\"sim_obj.\\\"quoted\\\"\",\"cat\":\"job\",\"ph\":\"X\"") ;
+    ASSERT_NE(first, std::string::npos) << trace ;
+    EXPECT_NE(trace.find("{\"name\":\"sim_obj.\\\"quoted\\\"\",\"cat\":\"job\",\"ph\":\"X\"", first + 1),
+     std::string::npos) << trace ;
+    EXPECT_NE(trace.find("{\"name\":\"marker\",\"cat\":\"test\",\"ph\":\"i\""), std::string::npos) << trace ;
+    EXPECT_EQ(trace.find("renamed"), std::string::npos) ;
+}
+
+TEST_F(TraceWriterTest , CountsDroppedEvents) {
+    tw.buffer_size = 3 ;
+    ASSERT_EQ(tw.trace_on(), 0) ;
+    pthread_barrier_t drained ;
+    pthread_barrier_init(&drained, NULL, 2) ;
+    std::thread thread([&drained]() {
+        for ( int ii = 0 ; ii < 6 ; ii++ ) {
+            Trick::TraceWriter::instant("event", "test") ;
+        }
+        pthread_barrier_wait(&drained) ;
+        pthread_barrier_wait(&drained) ;
+        Trick::TraceWriter::instant("event", "test") ;
+    }) ;
+
+    // The ring of 4 events holds the first 4 of 6.
+    pthread_barrier_wait(&drained) ;
+    drain() ;
+    EXPECT_EQ(tw.events_written, 4u) ;
+    EXPECT_EQ(tw.events_dropped, 2u) ;
+
+    // Drained slots are used again.
+    pthread_barrier_wait(&drained) ;
+    thread.join() ;
+    drain() ;
+    EXPECT_EQ(tw.events_written, 5u) ;
+    EXPECT_EQ(tw.events_dropped, 2u) ;
+
+    // The drops of a freed ring are still counted.
+    record_and_exit(5) ;
+    drain() ;
+    EXPECT_EQ(tw.buffers.size(), 0u) ;
+    EXPECT_EQ(tw.events_written, 9u) ;
+    EXPECT_EQ(tw.events_dropped, 3u) ;
+    pthread_barrier_destroy(&drained) ;
+}
+
+TEST_F(TraceWriterTest , FreesRingOfExitedThread) {
+    ASSERT_EQ(tw.trace_on(), 0) ;
+    pthread_barrier_t recorded ;
+    pthread_barrier_init(&recorded, NULL, 2) ;
+    std::thread running([&recorded]() {
+        Trick::TraceWriter::instant("from_running", "test") ;
+        pthread_barrier_wait(&recorded) ;
+        pthread_barrier_wait(&recorded) ;
+    }) ;
+    pthread_barrier_wait(&recorded) ;
+    record_and_exit(1) ;
+    EXPECT_EQ(tw.buffers.size(), 2u) ;
+
+    // The exited thread's ring is written, then freed.  The ring of the running thread is kept.
+    drain() ;
+    EXPECT_EQ(tw.events_written, 2u) ;
+    EXPECT_EQ(tw.buffers.size(), 1u) ;
+
+    record_and_exit(1) ;
+    tw.shutdown() ;
+    EXPECT_EQ(tw.events_written, 3u) ;
+    EXPECT_EQ(tw.buffers.size(), 1u) ;
+    pthread_barrier_wait(&recorded) ;
+    running.join() ;
+    pthread_barrier_destroy(&recorded) ;
+
+    std::string trace = read_trace() ;
+    size_t first = trace.find("\"from_thread\"") ;
+    ASSERT_NE(first, std::string::npos) ;
+    EXPECT_NE(trace.find("\"from_thread\"", first + 1), std::string::npos) ;
+    EXPECT_NE(trace.find("\"from_running\""), std::string::npos) ;
+}
+
+}
@@ -0,0 +1,635 @@
+/*
+   PURPOSE: ( Simple event condition expressions evaluated without Python )
+   REFERENCE: ( Trick Simulation Environment )
+   ASSUMPTIONS AND LIMITATIONS: ( None )
+   CLASS: ( N/A )
+   LIBRARY DEPENDENCY: ( None )
+*/
+
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sstream>
+
+#include "trick/EventExpression.hh"
+#include "trick/memorymanager_c_intf.h"
+#include "trick/parameter_types.h"
+
+namespace Trick {
+
+/* Recursive descent parser for the Python subset:
+     or_expr    : and_expr ( "or" and_expr )*
+     and_expr   : not_expr ( "and" not_expr )*
+     not_expr   : "not" not_expr | comparison
+     comparison : operand ( compare_op operand )*
+     operand    : number | "True" | "False" | variable | "(" or_expr ")"
+   Every failure returns -1 and the whole string is left to Python, which also reports real syntax errors. */
+class EventExpressionParser {
+
+    public:
+
+        EventExpressionParser(EventExpression * in_expr, const std::string & str) : expr(in_expr), p(str.c_str()) {}
+
+        /* Returns the root node index, or -1 if the string is not a simple expression. */
+        int parse() {
+            int root = or_expr() ;
+            skip_space() ;
+            return (*p == '\0') ? root : -1 ;
+        }
+
+    private:
+
+        EventExpression * expr ;
+        const char * p ;
+
+        void skip_space() {
+            while ( isspace(*p) ) {
+                p++ ;
+            }
+        }
+
+        /* Consumes keyword kw if it is the next whole word. */
+        bool keyword(const char * kw) {
+            skip_space() ;
+            size_t len = strlen(kw) ;
+            if ( ! strncmp(p, kw, len) and ! (isalnum(p[len]) or p[len] == '_' or p[len] == '.' or p[len] == '[') ) {
+                p += len ;
+                return true ;
+            }
+            return false ;
+        }
+
+        int or_expr() {
+            int left = and_expr() ;
+            while ( left >= 0 and keyword("or") ) {
+                int right = and_expr() ;
+                left = (right < 0) ? -1 : expr->add_node(EventExpression::OR, NULL, left, right) ;
+            }
+            return left ;
+        }
+
+        int and_expr() {
+            int left = not_expr() ;
+            while ( left >= 0 and keyword("and") ) {
+                int right = not_expr() ;
+                left = (right < 0) ? -1 : expr->add_node(EventExpression::AND, NULL, left, right) ;
+            }
+            return left ;
+        }
+
+        int not_expr() {
+            if ( keyword("not") ) {
+                int operand = not_expr() ;
+                return (operand < 0) ? -1 : expr->add_node(EventExpression::NOT, NULL, operand, -1) ;
+            }
+            return comparison() ;
+        }
+
+        /* Reads the next comparison operator, if any. */
+        bool compare_op(EventExpression::NodeType & type) {
+            skip_space() ;
+            if ( p[0] == '<' and p[1] == '=' ) { type = EventExpression::LE ; p += 2 ; }
+            else if ( p[0] == '>' and p[1] == '=' ) { type = EventExpression::GE ; p += 2 ; }
+            else if ( p[0] == '=' and p[1] == '=' ) { type = EventExpression::EQ ; p += 2 ; }
+            else if ( p[0] == '!' and p[1] == '=' ) { type = EventExpression::NE ; p += 2 ; }
+            else if ( p[0] == '<' and p[1] != '>' ) { type = EventExpression::LT ; p += 1 ; }
+            else if ( p[0] == '>' ) { type = EventExpression::GT ; p += 1 ; }
+            else { return false ; }
+            return true ;
+        }
+
+        /* A chained comparison "a < b < c" is "a < b and b < c", as in Python: b is read once and c only if
+           a < b. */
+        int comparison() {
+            EventExpression::NodeType type ;
+            int left = operand() ;
+            int result = left ;
+            bool chained = false ;
+            while ( left >= 0 and compare_op(type) ) {
+                int right = operand() ;
+                if ( right < 0 ) {
+                    return -1 ;
+                }
+                int compare = expr->add_node(type, NULL, left, right) ;
+                result = chained ? expr->add_node(EventExpression::AND, NULL, result, compare) : compare ;
+                chained = true ;
+                left = right ;
+            }
+            return left < 0 ? -1 : result ;
+        }
+
+        int operand() {
+            skip_space() ;
+            if ( *p == '(' ) {
+                p++ ;
+                int inner = or_expr() ;
+                skip_space() ;
+                if ( inner < 0 or *p != ')' ) {
+                    return -1 ;
+                }
+                p++ ;
+                return inner ;
+            }
+            if ( isdigit(*p) or (*p == '.' and isdigit(p[1])) or (*p == '-' and (isdigit(p[1]) or p[1] == '.')) ) {
+                return number() ;
+            }
+            if ( keyword("True") ) {
+                return int_constant(1) ;
+            }
+            if ( keyword("False") ) {
+                return int_constant(0) ;
+            }
+            return variable() ;
+        }
+
+        int int_constant(long long value) {
+            EventExpression::Value constant ;
+            constant.is_int = true ;
+            constant.i = value ;
+            constant.d = 0.0 ;
+            return expr->add_constant(constant) ;
+        }
+
+        /* Appends a run of digits of the base to out, dropping single underscores between digits as Python does.
+           Returns false if there is no digit. */
+        bool digits(int base, std::string & out) {
+            size_t start = out.size() ;
+            while ( true ) {
+                if ( is_digit(*p, base) ) {
+                    out += *p++ ;
+                } else if ( *p == '_' and out.size() > start and is_digit(p[1], base) ) {
+                    p++ ;
+                } else {
+                    break ;
+                }
+            }
+            return out.size() > start ;
+        }
+
+        static bool is_digit(char c, int base) {
+            switch ( base ) {
+                case 2 : return c == '0' or c == '1' ;
+                case 8 : return c >= '0' and c <= '7' ;
+                case 16 : return isxdigit(c) ;
+                default : return isdigit(c) ;
+            }
+        }
+
+        /* A number literal with an optional leading minus, read as Python reads it: decimal, 0x, 0o and 0b ints,
+           and decimal floats, all with optional underscores between digits.  Literals Python rejects, such as
+           010, and ints that do not fit in an int64 return -1. */
+        int number() {
+            std::string text ;
+            bool negative = false ;
+            bool is_float = false ;
+            int base = 10 ;
+
+            if ( *p == '-' ) {
+                negative = true ;
+                p++ ;
+            }
+            if ( p[0] == '0' and p[1] != '\0' and strchr("xXoObB", p[1]) ) {
+                base = (tolower(p[1]) == 'x') ? 16 : (tolower(p[1]) == 'o') ? 8 : 2 ;
+                p += 2 ;
+                // one underscore may follow the prefix
+                if ( *p == '_' ) {
+                    p++ ;
+                }
+                if ( ! digits(base, text) ) {
+                    return -1 ;
+                }
+            } else {
+                if ( isdigit(*p) ) {
+                    digits(10, text) ;
+                }
+                if ( *p == '.' ) {
+                    is_float = true ;
+                    text += *p++ ;
+                    if ( isdigit(*p) ) {
+                        digits(10, text) ;
+                    }
+                }
+                if ( (*p == 'e' or *p == 'E') and
+                     (isdigit(p[1]) or ((p[1] == '+' or p[1] == '-') and isdigit(p[2]))) ) {
+                    is_float = true ;
+                    text += *p++ ;
+                    if ( *p == '+' or *p == '-' ) {
+                        text += *p++ ;
+                    }
+                    digits(10, text) ;
+                }
+                // Python 3 has no leading zeros in a decimal int other than zero itself.
+                if ( ! is_float and text.size() > 1 and text[0] == '0' and
+                     text.find_first_not_of('0') != std::string::npos ) {
+                    return -1 ;
+                }
+            }
+            // A name character or a second point right after a literal (1j, 1_, 0x1p3, 1.5.real) is not ours.
+            if ( isalnum(*p) or *p == '_' or *p == '.' ) {
+                return -1 ;
+            }
+
+            EventExpression::Value constant ;
+            constant.i = 0 ;
+            constant.d = 0.0 ;
+            constant.is_int = ! is_float ;
+            if ( is_float ) {
+                constant.d = strtod(text.c_str(), NULL) ;
+                if ( negative ) {
+                    constant.d = -constant.d ;
+                }
+            } else {
+                errno = 0 ;
+                unsigned long long magnitude = strtoull(text.c_str(), NULL, base) ;
+                if ( errno == ERANGE or magnitude > (unsigned long long)LLONG_MAX + (negative ? 1 : 0) ) {
+                    return -1 ;
+                }
+                constant.i = negative ? (long long)(0 - magnitude) : (long long)magnitude ;
+            }
+            return expr->add_constant(constant) ;
+        }
+
+        /* A dotted name with constant indexes, resolved by the memory manager to a scalar of a numeric type. */
+        int variable() {
+            const char * start = p ;
+            bool expect_name = true ;
+            while ( true ) {
+                if ( expect_name ) {
+                    if ( ! (isalpha(*p) or *p == '_') ) {
+                        return -1 ;
+                    }
+                    while ( isalnum(*p) or *p == '_' ) {
+                        p++ ;
+                    }
+                    expect_name = false ;
+                } else if ( *p == '.' ) {
+                    p++ ;
+                    expect_name = true ;
+                } else if ( *p == '[' ) {
+                    p++ ;
+                    if ( ! isdigit(*p) ) {
+                        return -1 ;
+                    }
+                    while ( isdigit(*p) ) {
+                        p++ ;
+                    }
+                    if ( *p++ != ']' ) {
+                        return -1 ;
+                    }
+                } else {
+                    break ;
+                }
+            }
+            std::string name(start, p - start) ;
+            const char * next = p ;
+            while ( isspace(*next) ) {
+                next++ ;
+            }
+            // Function calls and the Python keywords other than ours belong to Python.
+            if ( *next == '(' or name == "is" or name == "in" or name == "None" or name == "if" or name == "else" ) {
+                return -1 ;
+            }
+
+            REF2 * ref = EventExpression::resolve(name) ;
+            if ( ref == NULL ) {
+                return -1 ;
+            }
+            return expr->add_node(EventExpression::VARIABLE, ref, -1, -1) ;
+        }
+} ;
+
+}
+
+Trick::EventExpression::EventExpression() {}
+
+Trick::EventExpression::~EventExpression() {
+    for ( unsigned int ii = 0 ; ii < nodes.size() ; ii++ ) {
+        if ( nodes[ii].ref != NULL ) {
+            ref_free(nodes[ii].ref) ;
+            free(nodes[ii].ref) ;
+        }
+    }
+}
+
+/**
+@details
+-# Parse the string, resolving each variable reference as it is found.
+-# If any part of the string is outside the supported subset, delete the partial expression and return NULL.
+*/
+Trick::EventExpression * Trick::EventExpression::parse(const std::string & str) {
+    EventExpression * expr = new EventExpression() ;
+    EventExpressionParser parser(expr, str) ;
+    if ( parser.parse() < 0 ) {
+        delete expr ;
+        return NULL ;
+    }
+    return expr ;
+}
+
+/**
+@details
+-# Resolve the name with the memory manager.
+-# Keep it only if it is a scalar whose type Python reads as a number that fits an int64 or a double.
+*/
+REF2 * Trick::EventExpression::resolve(const std::string & name) {
+    REF2 * ref = ref_attributes(name.c_str()) ;
+    if ( ref == NULL ) {
+        return NULL ;
+    }
+    bool numeric ;
+    switch ( ref->attr->type ) {
+        case TRICK_UNSIGNED_CHARACTER :
+        case TRICK_SHORT :
+        case TRICK_UNSIGNED_SHORT :
+        case TRICK_INTEGER :
+        case TRICK_UNSIGNED_INTEGER :
+        case TRICK_LONG :
+        case TRICK_LONG_LONG :
+        case TRICK_FLOAT :
+        case TRICK_DOUBLE :
+        case TRICK_BOOLEAN :
+            numeric = true ;
+            break ;
+        // Python would compare values above the int64 range exactly.
+        case TRICK_UNSIGNED_LONG :
+        case TRICK_UNSIGNED_LONG_LONG :
+            numeric = (ref->attr->size < 8) ;
+            break ;
+        case TRICK_ENUMERATED :
+            numeric = (ref->attr->size == 1 or ref->attr->size == 2 or ref->attr->size == 4 or
+                       ref->attr->size == 8) ;
+            break ;
+        default :
+            numeric = false ;
+            break ;
+    }
+    if ( ! numeric or ref->num_index != ref->attr->num_index ) {
+        ref_free(ref) ;
+        free(ref) ;
+        return NULL ;
+    }
+    return ref ;
+}
+
+/**
+@details
+-# Variables behind pointers have their address followed each time, as condition_var() does.  A NULL address
+   reads as 0.
+-# Integer, bool and enum variables are ints, float and double variables are floats.
+*/
+Trick::EventExpression::Value Trick::EventExpression::read(REF2 * ref) {
+    Value result ;
+    result.is_int = true ;
+    result.i = 0 ;
+    result.d = 0.0 ;
+    if ( ref->pointer_present ) {
+        ref->address = follow_address_path(ref) ;
+    }
+    if ( ref->address == NULL ) {
+        return result ;
+    }
+    switch ( ref->attr->type ) {
+        case TRICK_UNSIGNED_CHARACTER : result.i = *(unsigned char *)ref->address ; break ;
+        case TRICK_SHORT : result.i = *(short *)ref->address ; break ;
+        case TRICK_UNSIGNED_SHORT : result.i = *(unsigned short *)ref->address ; break ;
+        case TRICK_INTEGER : result.i = *(int *)ref->address ; break ;
+        case TRICK_UNSIGNED_INTEGER : result.i = *(unsigned int *)ref->address ; break ;
+        case TRICK_LONG : result.i = *(long *)ref->address ; break ;
+        case TRICK_UNSIGNED_LONG : result.i = *(unsigned long *)ref->address ; break ;
+        case TRICK_LONG_LONG : result.i = *(long long *)ref->address ; break ;
+        case TRICK_UNSIGNED_LONG_LONG : result.i = *(unsigned long long *)ref->address ; break ;
+        case TRICK_BOOLEAN : result.i = *(bool *)ref->address ; break ;
+        case TRICK_FLOAT : result.is_int = false ; result.d = *(float *)ref->address ; break ;
+        case TRICK_DOUBLE : result.is_int = false ; result.d = *(double *)ref->address ; break ;
+        case TRICK_ENUMERATED :
+            switch ( ref->attr->size ) {
+                case 1 : result.i = *(signed char *)ref->address ; break ;
+                case 2 : result.i = *(short *)ref->address ; break ;
+                case 4 : result.i = *(int *)ref->address ; break ;
+                default : result.i = *(long long *)ref->address ; break ;
+            }
+            break ;
+        default :
+            break ;
+    }
+    return result ;
+}
+
+int Trick::EventExpression::add_node(NodeType type, REF2 * ref, int left, int right) {
+    Node node ;
+    node.type = type ;
+    node.value.is_int = true ;
+    node.value.i = 0 ;
+    node.value.d = 0.0 ;
+    node.ref = ref ;
+    node.left = left ;
+    node.right = right ;
+    nodes.push_back(node) ;
+    return (int)nodes.size() - 1 ;
+}
+
+int Trick::EventExpression::add_constant(Value value) {
+    int ii = add_node(CONSTANT, NULL, -1, -1) ;
+    nodes[ii].value = value ;
+    return ii ;
+}
+
+bool Trick::EventExpression::truth(const Value & value) {
+    return value.is_int ? (value.i != 0) : (value.d != 0.0) ;
+}
+
+/**
+@details
+-# Two ints or two floats compare directly.  A NaN is unordered with everything.
+-# An int and a float compare exactly, as in Python: the float is split into its integer part, which fits in an
+   int64 whenever the float is within the int64 range, and its fraction.
+*/
+int Trick::EventExpression::compare(const Value & left, const Value & right) {
+    if ( left.is_int and right.is_int ) {
+        return (left.i < right.i) ? -1 : (left.i > right.i) ;
+    }
+    if ( ! left.is_int and ! right.is_int ) {
+        if ( left.d != left.d or right.d != right.d ) {
+            return 2 ;
+        }
+        return (left.d < right.d) ? -1 : (left.d > right.d) ;
+    }
+    if ( ! left.is_int ) {
+        int reversed = compare(right, left) ;
+        return (reversed == 2) ? 2 : -reversed ;
+    }
+    double d = right.d ;
+    if ( d != d ) {
+        return 2 ;
+    }
+    if ( d >= 9223372036854775808.0 ) {
+        return -1 ;
+    }
+    if ( d < -9223372036854775808.0 ) {
+        return 1 ;
+    }
+    long long whole = (long long)d ;
+    if ( left.i != whole ) {
+        return (left.i < whole) ? -1 : 1 ;
+    }
+    double fraction = d - (double)whole ;
+    return (fraction > 0.0) ? -1 : (fraction < 0.0) ;
+}
+
+/**
+@details
+-# Variables are read with read().
+-# not yields a bool.  and/or evaluate their right side only when needed and yield the operand that decided them.
+-# Comparisons yield bools.
+*/
+Trick::EventExpression::Value Trick::EventExpression::value_of(int ii) {
+    Node & node = nodes[ii] ;
+    Value result ;
+    result.is_int = true ;
+    result.i = 0 ;
+    result.d = 0.0 ;
+    switch ( node.type ) {
+        case CONSTANT :
+            return node.value ;
+        case VARIABLE :
+            return read(node.ref) ;
+        case NOT :
+            result.i = ! truth(value_of(node.left)) ;
+            return result ;
+        case AND :
+            result = value_of(node.left) ;
+            return truth(result) ? value_of(node.right) : result ;
+        case OR :
+            result = value_of(node.left) ;
+            return truth(result) ? result : value_of(node.right) ;
+        case LT :
+        case LE :
+        case GT :
+        case GE :
+        case EQ :
+        case NE : {
+            int order = compare(value_of(node.left), value_of(node.right)) ;
+            switch ( node.type ) {
+                case LT : result.i = (order == -1) ; break ;
+                case LE : result.i = (order == -1 or order == 0) ; break ;
+                case GT : result.i = (order == 1) ; break ;
+                case GE : result.i = (order == 1 or order == 0) ; break ;
+                case EQ : result.i = (order == 0) ; break ;
+                default : result.i = (order != 0) ; break ;
+            }
+            return result ;
+        }
+    }
+    return result ;
+}
+
+bool Trick::EventExpression::evaluate() {
+    return truth(value_of((int)nodes.size() - 1)) ;
+}
+
+/**
+@details
+-# Copy the condition, replacing each dotted name with constant indexes that EventExpression::resolve() accepts by
+   the name of its value.  A variable read twice has one value.
+-# Keep numbers, operators, keywords, the allowed calls and the math module.
+-# Return NULL for anything else: strings, comments, subscripts and attributes of other expressions, other names and
+   calls.
+*/
+Trick::EventSnapshot * Trick::EventSnapshot::parse(const std::string & str) {
+    static const char * keywords[] = { "and" , "or" , "not" , "True" , "False" , "None" , "is" , "in" , "if" , "else" ,
+                                       NULL } ;
+    static const char * calls[] = { "abs" , "min" , "max" , "round" , "int" , "float" , "bool" , NULL } ;
+
+    EventSnapshot * snapshot = new EventSnapshot() ;
+    const char * p = str.c_str() ;
+    while ( *p != '\0' ) {
+        if ( isdigit(*p) or (*p == '.' and isdigit(p[1])) ) {
+            // A number is copied as it is written, with the sign of its exponent.
+            const char * start = p ;
+            while ( isalnum(*p) or *p == '_' or *p == '.' or
+                    ((*p == '+' or *p == '-') and (p[-1] == 'e' or p[-1] == 'E')) ) {
+                p++ ;
+            }
+            snapshot->str.append(start, p - start) ;
+        } else if ( isalpha(*p) or *p == '_' ) {
+            const char * start = p ;
+            while ( true ) {
+                while ( isalnum(*p) or *p == '_' ) {
+                    p++ ;
+                }
+                if ( p[0] == '.' and (isalpha(p[1]) or p[1] == '_') ) {
+                    p++ ;
+                } else if ( p[0] == '[' and isdigit(p[1]) ) {
+                    const char * index = p + 1 ;
+                    while ( isdigit(*index) ) {
+                        index++ ;
+                    }
+                    if ( *index != ']' ) {
+                        break ;
+                    }
+                    p = index + 1 ;
+                } else {
+                    break ;
+                }
+            }
+            std::string name(start, p - start) ;
+            const char * next = p ;
+            while ( isspace(*next) ) {
+                next++ ;
+            }
+            bool allowed = ! name.compare(0, 5, "math.") ;
+            for ( int ii = 0 ; keywords[ii] != NULL and ! allowed ; ii++ ) {
+                allowed = (name == keywords[ii]) ;
+            }
+            for ( int ii = 0 ; calls[ii] != NULL and ! allowed and *next == '(' ; ii++ ) {
+                allowed = (name == calls[ii]) ;
+            }
+            if ( allowed ) {
+                snapshot->str += name ;
+                continue ;
+            }
+            if ( *next == '(' ) {
+                delete snapshot ;
+                return NULL ;
+            }
+            unsigned int jj ;
+            for ( jj = 0 ; jj < snapshot->variables.size() and snapshot->variables[jj] != name ; jj++ ) ;
+            if ( jj == snapshot->variables.size() ) {
+                REF2 * ref = EventExpression::resolve(name) ;
+                if ( ref == NULL ) {
+                    delete snapshot ;
+                    return NULL ;
+                }
+                std::ostringstream value_name ;
+                value_name << "_trick_event_value_" << jj ;
+                snapshot->variables.push_back(name) ;
+                snapshot->names.push_back(value_name.str()) ;
+                snapshot->refs.push_back(ref) ;
+            }
+            snapshot->str += snapshot->names[jj] ;
+        } else if ( strchr("'\"#.[]{}:;@`\\", *p) ) {
+            delete snapshot ;
+            return NULL ;
+        } else {
+            snapshot->str += *p++ ;
+        }
+    }
+    snapshot->values.resize(snapshot->refs.size()) ;
+    snapshot->take() ;
+    return snapshot ;
+}
+
+Trick::EventSnapshot::~EventSnapshot() {
+    for ( unsigned int ii = 0 ; ii < refs.size() ; ii++ ) {
+        ref_free(refs[ii]) ;
+        free(refs[ii]) ;
+    }
+}
+
+void Trick::EventSnapshot::take() {
+    for ( unsigned int ii = 0 ; ii < refs.size() ; ii++ ) {
+        values[ii] = EventExpression::read(refs[ii]) ;
+    }
+}
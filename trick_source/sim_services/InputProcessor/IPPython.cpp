@@ -18,6 +18,7 @@
 #include <stdio.h>
 
 #include "trick/IPPython.hh"
+#include "trick/EventExpression.hh"
 #include "trick/MemoryManager.hh"
 #include "trick/exec_proto.hh"
 #include "trick/exec_proto.h"
@@ -196,6 +197,139 @@ int Trick::IPPython::parse_condition(std::string in_string, int & cond_return_va
 
 }
 
+/**
+ @details
+ Event conditions and actions are run every time their event is evaluated.  Compiling their strings once saves the
+ python compile that parse() and parse_condition() do on every call.
+
+-# Strip the surrounding white space that a triple quoted string leaves, python expressions may not be indented.
+-# Compile a condition as an expression and an action as statements.
+-# If the string does not compile, clear the error and return NULL.  The caller parses the string instead, which
+   reports the error as before.
+*/
+void * Trick::IPPython::compile(std::string in_string, bool is_condition) {
+
+    size_t first = in_string.find_first_not_of(" \t\r\n") ;
+    size_t last = in_string.find_last_not_of(" \t\r\n") ;
+    if ( first == std::string::npos ) {
+        return NULL ;
+    }
+    if ( is_condition ) {
+        in_string = in_string.substr(first, last - first + 1) ;
+    } else {
+        in_string += "\n" ;
+    }
+
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    PyObject * code = Py_CompileString(in_string.c_str(), is_condition ? "<event condition>" : "<event action>",
+                                       is_condition ? Py_eval_input : Py_file_input) ;
+    if ( code == NULL ) {
+        PyErr_Clear() ;
+    }
+    PyGILState_Release(gstate);
+
+    return code ;
+}
+
+/* Evaluates compiled code in the __main__ namespace, where parse() runs strings.  Call with the GIL held. */
+static PyObject * eval_code(void * code) {
+    PyObject * globals = PyModule_GetDict(PyImport_AddModule("__main__")) ;
+#if PY_VERSION_HEX < 0x03020000
+    return PyEval_EvalCode((PyCodeObject *)code, globals, globals) ;
+#else
+    return PyEval_EvalCode((PyObject *)code, globals, globals) ;
+#endif
+}
+
+int Trick::IPPython::parse_code(void * code) {
+
+    int ret = 0 ;
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    PyObject * result = eval_code(code) ;
+    if ( result == NULL ) {
+        PyErr_Print() ;
+        ret = -1 ;
+    }
+    Py_XDECREF(result) ;
+    PyGILState_Release(gstate);
+
+    return ret ;
+}
+
+/**
+ @details
+-# Evaluate the compiled expression.
+-# Return its python truth in cond_return_val.  Unlike parse_condition(), no assignment to return_val is needed.
+*/
+int Trick::IPPython::parse_condition_code(void * code, int & cond_return_val) {
+
+    int ret = 0 ;
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    PyObject * result = eval_code(code) ;
+    if ( result == NULL or (cond_return_val = PyObject_IsTrue(result)) < 0 ) {
+        PyErr_Print() ;
+        cond_return_val = 0 ;
+        ret = -1 ;
+    }
+    Py_XDECREF(result) ;
+    PyGILState_Release(gstate);
+
+    return ret ;
+}
+
+/**
+ @details
+-# Bind the name of each value of the snapshot to a python int or float in a dictionary of locals.  Names the
+   condition does not bind, such as math, are still found in __main__.
+-# Evaluate the compiled expression with those locals and return its python truth in cond_return_val.
+*/
+int Trick::IPPython::parse_condition_snapshot(void * code, const Trick::EventSnapshot & snapshot,
+ int & cond_return_val) {
+
+    int ret = 0 ;
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    PyObject * globals = PyModule_GetDict(PyImport_AddModule("__main__")) ;
+    PyObject * locals = PyDict_New() ;
+    PyObject * result = NULL ;
+    for ( unsigned int ii = 0 ; locals != NULL and ii < snapshot.size() ; ii++ ) {
+        const Trick::EventExpression::Value & value = snapshot.value(ii) ;
+        PyObject * number = value.is_int ? PyLong_FromLongLong(value.i) : PyFloat_FromDouble(value.d) ;
+        if ( number == NULL or PyDict_SetItemString(locals, snapshot.name(ii).c_str(), number) < 0 ) {
+            Py_XDECREF(number) ;
+            Py_CLEAR(locals) ;
+            break ;
+        }
+        Py_DECREF(number) ;
+    }
+    if ( locals != NULL ) {
+#if PY_VERSION_HEX < 0x03020000
+        result = PyEval_EvalCode((PyCodeObject *)code, globals, locals) ;
+#else
+        result = PyEval_EvalCode((PyObject *)code, globals, locals) ;
+#endif
+    }
+    if ( result == NULL or (cond_return_val = PyObject_IsTrue(result)) < 0 ) {
+        PyErr_Print() ;
+        cond_return_val = 0 ;
+        ret = -1 ;
+    }
+    Py_XDECREF(result) ;
+    Py_XDECREF(locals) ;
+    PyGILState_Release(gstate);
+
+    return ret ;
+}
+
+void Trick::IPPython::free_code(void * code) {
+
+    // Code still held at shutdown is released by Py_Finalize.
+    if ( code != NULL and Py_IsInitialized() ) {
+        PyGILState_STATE gstate = PyGILState_Ensure();
+        Py_DECREF((PyObject *)code) ;
+        PyGILState_Release(gstate);
+    }
+}
+
 //Restart job that reloads event_list from checkpointable structures
 int Trick::IPPython::restart() {
     /* Make shortcut names for all known sim_objects. */
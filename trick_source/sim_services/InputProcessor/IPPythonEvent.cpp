@@ -14,6 +14,7 @@
 
 #include "trick/IPPythonEvent.hh"
 #include "trick/IPPython.hh"
+#include "trick/EventExpression.hh"
 #include "trick/MemoryManager.hh"
 #include "trick/exec_proto.h"
 #include "trick/message_proto.h"
@@ -39,6 +40,11 @@ Trick::condition_t::condition_t() {
     fired_time = -1.0 ;
     ref = NULL ;
     job = NULL ;
+    code = NULL ;
+    expr = NULL ;
+    snapshot = NULL ;
+    snapshot_code = NULL ;
+    eval_val = 0 ;
 }
 
 Trick::action_t::action_t() {
@@ -48,6 +54,7 @@ Trick::action_t::action_t() {
     ran_time = -1.0 ;
     job = NULL ;
     act_type = 0 ;
+    code = NULL ;
 }
 
 //Constructor
@@ -69,10 +76,13 @@ Trick::IPPythonEvent::IPPythonEvent() {
     ran = false ;
     action_list = NULL;
     condition_list = NULL;
+    python_error = 0 ;
 }
 
 Trick::IPPythonEvent::~IPPythonEvent() {
 
+    free_compiled() ;
+
     if (TMM_is_alloced((char *)condition_list))
     {
        for (int ii=0; ii<condition_count; ii++) {
@@ -177,6 +187,9 @@ void Trick::IPPythonEvent::terminate_on_event_parse_error(bool on_off) {
 void Trick::IPPythonEvent::restart() {
     int jj ;
 
+    // Conditions resolve their variables again when next evaluated.
+    free_compiled() ;
+
     for (jj=0; jj<condition_count; jj++) {
         if (condition_list[jj]->cond_type==1) { // condition variable
             condition_list[jj]->ref = ref_attributes(condition_list[jj]->str.c_str());
@@ -193,6 +206,73 @@ void Trick::IPPythonEvent::restart() {
 
 }
 
+/**
+@details
+-# Release the old code or expression and remember the string they are built from.
+-# Try to build a native expression first, it needs neither python nor its lock to evaluate.
+-# Otherwise compile the string.  If it does not compile, both stay NULL and the string is parsed each time, which
+   reports its error.
+-# A compiled condition that only reads sim variables also gets a snapshot and the code that reads it, which let
+   it be evaluated on a helper thread.
+*/
+void Trick::IPPythonEvent::compile_condition(condition_t * cond) {
+    ip->free_code(cond->code) ;
+    ip->free_code(cond->snapshot_code) ;
+    delete cond->expr ;
+    delete cond->snapshot ;
+    cond->code = NULL ;
+    cond->snapshot = NULL ;
+    cond->snapshot_code = NULL ;
+    cond->code_str = cond->str ;
+    cond->expr = EventExpression::parse(cond->str) ;
+    if ( cond->expr == NULL ) {
+        cond->code = ip->compile(cond->str, true) ;
+    }
+    if ( cond->code != NULL ) {
+        cond->snapshot = EventSnapshot::parse(cond->str) ;
+        if ( cond->snapshot != NULL ) {
+            cond->snapshot_code = ip->compile(cond->snapshot->get_str(), true) ;
+            if ( cond->snapshot_code == NULL ) {
+                delete cond->snapshot ;
+                cond->snapshot = NULL ;
+            }
+        }
+    }
+}
+
+void Trick::IPPythonEvent::compile_action(action_t * act) {
+    ip->free_code(act->code) ;
+    act->code_str = act->str ;
+    act->code = ip->compile(act->str, false) ;
+}
+
+void Trick::IPPythonEvent::free_compiled() {
+    int jj ;
+
+    for (jj=0; jj<condition_count; jj++) {
+        if (condition_list[jj]->code != NULL) {
+            ip->free_code(condition_list[jj]->code) ;
+            condition_list[jj]->code = NULL ;
+        }
+        if (condition_list[jj]->snapshot_code != NULL) {
+            ip->free_code(condition_list[jj]->snapshot_code) ;
+            condition_list[jj]->snapshot_code = NULL ;
+        }
+        delete condition_list[jj]->expr ;
+        condition_list[jj]->expr = NULL ;
+        delete condition_list[jj]->snapshot ;
+        condition_list[jj]->snapshot = NULL ;
+        condition_list[jj]->code_str.clear() ;
+    }
+    for (jj=0; jj<action_count; jj++) {
+        if (action_list[jj]->code != NULL) {
+            ip->free_code(action_list[jj]->code) ;
+            action_list[jj]->code = NULL ;
+        }
+        action_list[jj]->code_str.clear() ;
+    }
+}
+
 //Command to create a new condition using a model variable (or reset an existing condition variable), num is index starting at 0.
 int Trick::IPPythonEvent::condition_var(int num, std::string varname, std::string comment) {
     /** @par Detailed Design: */
@@ -540,13 +620,138 @@ int Trick::IPPythonEvent::process( long long curr_time ) {
 
 bool Trick::IPPythonEvent::process_user_event( long long curr_time ) {
 
+    /** @li No need to evaluate any conditions if in manual mode. */
+    if (! manual) {
+        evaluate_conditions(true, true) ;
+    }
+    return commit_user_event(curr_time) ;
+}
+
+bool Trick::IPPythonEvent::deferrable() {
+
+    int ii ;
+    bool python = false ;
+
+    if (! is_user_event or manual) {
+        return false ;
+    }
+    for (ii=0; ii<condition_count; ii++) {
+        condition_t * cond = condition_list[ii] ;
+        if (cond->enabled and ! (cond->hold and cond->fired) and cond->ref == NULL and cond->job == NULL) {
+            if (cond->code_str != cond->str) {
+                compile_condition(cond) ;
+            }
+            if (cond->expr == NULL) {
+                // a condition without a snapshot reads memory on its own, so it is evaluated when due.
+                if (cond->snapshot == NULL) {
+                    return false ;
+                }
+                python = true ;
+            }
+        }
+    }
+    return python ;
+}
+
+void Trick::IPPythonEvent::evaluate( long long curr_time __attribute__((unused)) , bool on_helper ) {
+    evaluate_conditions(! on_helper, on_helper, true) ;
+}
+
+int Trick::IPPythonEvent::commit( long long curr_time ) {
+    commit_user_event(curr_time) ;
+    return 0 ;
+}
+
+/**
+@details
+-# Loop thru all enabled conditions.  Skip a condition that previously fired and has hold on.
+-# Evaluate the condition if it is of a requested kind, and keep the result for commit_user_event().  Python
+   conditions are those evaluated with python, others are variables, jobs and native expressions.
+-# With from_snapshot, python conditions read the values of their snapshots: the native pass, run when the event is
+   due, takes the values, and the python pass evaluates the condition from them.
+-# Keep the first python error.  The sim is terminated for it when the event commits, if requested.
+*/
+void Trick::IPPythonEvent::evaluate_conditions( bool native , bool python , bool from_snapshot ) {
+
+    int ii ;
+
+    for (ii=0; ii<condition_count; ii++) {
+        condition_t * cond = condition_list[ii] ;
+        if (! cond->enabled or (cond->hold and cond->fired)) {
+            continue ;
+        }
+        if (cond->ref != NULL) {
+        // if it's a variable, get it as a boolean
+            if (native) {
+                cond->eval_val = 0 ;
+                if ( cond->ref->pointer_present ) {
+                    cond->ref->address = follow_address_path(cond->ref) ;
+                }
+                if ( cond->ref->address != NULL ) {
+                    cond->eval_val = *(bool *)cond->ref->address ;
+                }
+            }
+        } else if (cond->job != NULL) {
+        // if it's a job, get its return value
+            if (native) {
+                bool save_disabled_state = cond->job->disabled;
+                cond->job->disabled = false;
+                cond->eval_val = cond->job->call();
+                cond->job->disabled = save_disabled_state;
+            }
+        } else {
+        // otherwise evaluate the string natively or with its compiled python code
+            if (cond->code_str != cond->str) {
+                compile_condition(cond) ;
+            }
+            if (cond->expr != NULL) {
+                if (native) {
+                    cond->eval_val = cond->expr->evaluate() ;
+                }
+            } else if (from_snapshot and cond->snapshot != NULL) {
+                if (native) {
+                    cond->snapshot->take() ;
+                }
+                if (python) {
+                    cond->eval_val = 0 ;
+                    int python_ret = ip->parse_condition_snapshot(cond->snapshot_code, *cond->snapshot,
+                                                                  cond->eval_val) ;
+                    if (python_ret != 0 and python_error == 0) {
+                        python_error = python_ret ;
+                    }
+                }
+            } else if (python) {
+                int python_ret ;
+                cond->eval_val = 0 ;
+                if (cond->code != NULL) {
+                    python_ret = ip->parse_condition_code(cond->code, cond->eval_val) ;
+                } else {
+                    python_ret = ip->parse_condition(cond->str, cond->eval_val) ;
+                }
+                if (python_ret != 0 and python_error == 0) {
+                    python_error = python_ret ;
+                }
+            }
+        }
+    }
+}
+
+bool Trick::IPPythonEvent::commit_user_event( long long curr_time ) {
+
     int ii ;
-    int return_val ;
     bool it_fired, it_ran;
 
+    if (python_error != 0) {
+        int ret = python_error ;
+        python_error = 0 ;
+        if (terminate_sim_on_event_python_error) {
+            exec_terminate_with_return( ret , __FILE__ , __LINE__ , "Python error in event condition processing" ) ;
+        }
+    }
+
     fired = false ;
     ran = false ;
-    /** @li No need to evaluate any conditions if in manual mode. */
+    /** @li No need to look at any conditions if in manual mode. */
     if (! manual) {
         hold = false ;
         /** @li Loop thru all conditions. */
@@ -556,36 +761,13 @@ bool Trick::IPPythonEvent::process_user_event( long long curr_time ) {
                 condition_list[ii]->fired = false ;
                 continue ;
             }
-            /** @li No need to evaluate condition if previously fired and hold is on. */
+            /** @li Condition stays fired if previously fired and hold is on. */
             if (condition_list[ii]->hold && condition_list[ii]->fired) {
                 ;
             } else {
-                /** @li Evaluate the condition and set its fired state. */
+                /** @li Set the condition's fired state from its evaluation. */
                 condition_list[ii]->fired = false ;
-                return_val = 0 ;
-                if (condition_list[ii]->ref != NULL) {
-                // if it's a variable, get it as a boolean
-                    if ( condition_list[ii]->ref->pointer_present ) {
-                        condition_list[ii]->ref->address = follow_address_path(condition_list[ii]->ref) ;
-                    }
-                    if ( condition_list[ii]->ref->address != NULL ) {
-                        return_val = *(bool *)condition_list[ii]->ref->address ;
-                    }
-                } else if (condition_list[ii]->job != NULL) {
-                // if it's a job, get its return value
-                    bool save_disabled_state = condition_list[ii]->job->disabled;
-                    condition_list[ii]->job->disabled = false;
-                    return_val = condition_list[ii]->job->call();
-                    condition_list[ii]->job->disabled = save_disabled_state;
-                } else {
-                // otherwise use python to evaluate string
-                    std::string full_in_string ;
-                    int python_ret = ip->parse_condition(condition_list[ii]->str, return_val) ;
-                    if (python_ret != 0 && terminate_sim_on_event_python_error) {
-                        exec_terminate_with_return( python_ret , __FILE__ , __LINE__ , "Python error in event condition processing" ) ;
-                    }
-                }
-                if (return_val) {
+                if (condition_list[ii]->eval_val) {
                 //TODO: write to log/send_hs that trigger fired
                     condition_list[ii]->fired = true ;
                     condition_list[ii]->fired_count++ ;
@@ -650,8 +832,16 @@ bool Trick::IPPythonEvent::process_user_event( long long curr_time ) {
                         break;
                 }
             } else {
-                // otherwise use python to evaluate string
-                int ret = ip->parse(action_list[ii]->str) ;
+                // otherwise run the compiled python code of the string
+                int ret ;
+                if (action_list[ii]->code_str != action_list[ii]->str) {
+                    compile_action(action_list[ii]) ;
+                }
+                if (action_list[ii]->code != NULL) {
+                    ret = ip->parse_code(action_list[ii]->code) ;
+                } else {
+                    ret = ip->parse(action_list[ii]->str) ;
+                }
                 if (ret != 0 && terminate_sim_on_event_python_error) {
                     exec_terminate_with_return( ret , __FILE__ , __LINE__ , "Python error in event action processing" ) ;
                 }
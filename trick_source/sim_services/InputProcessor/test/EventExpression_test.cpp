@@ -0,0 +1,216 @@
+
+#include <Python.h>
+#include <cmath>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "trick/EventExpression.hh"
+#include "trick/MemoryManager.hh"
+
+namespace Trick {
+
+/* A condition, and whether it is simple enough to be evaluated without Python. */
+struct ExpressionCase {
+    const char * str ;
+    bool native ;
+} ;
+
+/* The native result of every expression must match Python's with the same variable values.  Expressions Python
+   rejects must be left to Python to report. */
+static const ExpressionCase cases[] = {
+    // numbers and truthiness
+    { "1" , true } ,
+    { "0" , true } ,
+    { "0.0" , true } ,
+    { "-0.0" , true } ,
+    { "0.5" , true } ,
+    { "d_nan" , true } ,
+    { "True" , true } ,
+    { "False" , true } ,
+    { "i_zero" , true } ,
+    { "flag" , true } ,
+    { "f_third" , true } ,
+    // literals as Python reads them
+    { "0x10 == 16" , true } ,
+    { "0X_ff == 255" , true } ,
+    { "0o17 == 15" , true } ,
+    { "0b101 == 5" , true } ,
+    { "1_000_000 == 1000000" , true } ,
+    { "1_0.2_5 == 10.25" , true } ,
+    { "1e1_0 == 1e10" , true } ,
+    { "-.5 < 0" , true } ,
+    { "5. == 5" , true } ,
+    { "1.e2 == 100" , true } ,
+    { "000 == 0" , true } ,
+    { "0_0 == 0" , true } ,
+    { "010.5 == 10.5" , true } ,
+    { "010e1 == 100" , true } ,
+    { "-0x8000000000000000 < 0" , true } ,
+    { "010 == 8" , false } ,
+    { "010 == 10" , false } ,
+    { "0_1 == 1" , false } ,
+    { "1_ == 1" , false } ,
+    { "1__0 == 10" , false } ,
+    { "0x == 0" , false } ,
+    { "0b102 == 2" , false } ,
+    { "0x1p3 == 8" , false } ,
+    { "1j == 1" , false } ,
+    { "1.5.real" , false } ,
+    // ints beyond 53 bits compare exactly
+    { "big == 9007199254740993" , true } ,
+    { "big == 9007199254740992" , true } ,
+    { "big > 9007199254740992.0" , true } ,
+    { "big == 9007199254740992.0" , true } ,
+    { "9007199254740993 == 9007199254740992.0" , true } ,
+    { "9007199254740993 > 9007199254740992.0" , true } ,
+    { "0x7fffffffffffffff > 9223372036854775807.0" , true } ,
+    { "0x7fffffffffffffff < 9223372036854775808.0" , true } ,
+    { "-0x7fffffffffffffff - 1 < 0" , false } ,
+    { "18446744073709551616 > 0" , false } ,
+    { "9223372036854775808 > 0" , false } ,
+    { "-9223372036854775808 < 0" , true } ,
+    { "big_neg < -9007199254740992.0" , true } ,
+    { "big_neg == -9007199254740993" , true } ,
+    // comparisons with NaN and infinities
+    { "d_nan == d_nan" , true } ,
+    { "d_nan != d_nan" , true } ,
+    { "d_nan < 1" , true } ,
+    { "d_nan >= 1" , true } ,
+    { "i_five != d_nan" , true } ,
+    { "i_five < 1e400" , true } ,
+    { "big > -1e400" , true } ,
+    // chained comparisons
+    { "1 < 2 < 3" , true } ,
+    { "1 < 3 < 2" , true } ,
+    { "3 > 2 > 1" , true } ,
+    { "1 < 2 == True" , true } ,
+    { "(1 < 2) == True" , true } ,
+    { "i_zero < i_five <= 5 < d_half * 20" , false } ,
+    { "i_zero < i_five <= 5 != 6" , true } ,
+    { "i_zero <= d_half < i_five == 5.0" , true } ,
+    { "0 < d_nan < 1" , true } ,
+    { "1 == 1.0 == True" , true } ,
+    // not, and, or and their operand results
+    { "not i_zero" , true } ,
+    { "not not i_five" , true } ,
+    { "not d_nan" , true } ,
+    { "not i_five == 5" , true } ,
+    { "(i_zero or 7) == 7" , true } ,
+    { "(i_five or 7) == 5" , true } ,
+    { "(i_five and 7) == 7" , true } ,
+    { "(i_zero and 7) == 0" , true } ,
+    { "(d_half and i_zero) == 0" , true } ,
+    { "(i_zero or d_half) == 0.5" , true } ,
+    { "(0.0 or False) == 0" , true } ,
+    { "(flag and 2) > 1" , true } ,
+    { "i_zero or i_zero" , true } ,
+    { "i_zero and d_nan" , true } ,
+    { "d_nan and i_five" , true } ,
+    { "i_zero or d_nan" , true } ,
+    { "not i_zero and i_five < 3 or d_half > 0.25" , true } ,
+    { "not (i_zero and i_five < 3 or d_half > 0.25)" , true } ,
+    { "i_zero or i_five and d_nan != d_nan" , true } ,
+    { "True == (not False)" , true } ,
+    { "1 < (2 < 3)" , true } ,
+    { "(i_five > 2) + 1 == 2" , false } ,
+    // Python syntax errors are Python's to report
+    { "i_five == not i_zero" , false } ,
+    { "i_five <> 5" , false } ,
+    { "i_five < " , false } ,
+    { "(i_five < 6" , false } ,
+    { "i_five and" , false } ,
+    // left to Python
+    { "abs(i_five) == 5" , false } ,
+    { "i_five in (5, 6)" , false } ,
+    { "i_five is not None" , false } ,
+    { "unknown_var < 1" , false } ,
+    { "'a' < 'b'" , false } ,
+} ;
+
+class EventExpressionTest : public ::testing::Test {
+
+    protected:
+        Trick::MemoryManager mm ;
+        PyObject * globals ;
+
+        EventExpressionTest() {}
+        ~EventExpressionTest() {}
+
+        virtual void SetUp() {
+            *(int *)mm.declare_var("int i_zero") = 0 ;
+            *(int *)mm.declare_var("int i_five") = 5 ;
+            *(double *)mm.declare_var("double d_half") = 0.5 ;
+            *(double *)mm.declare_var("double d_nan") = NAN ;
+            *(float *)mm.declare_var("float f_third") = 1.0f / 3.0f ;
+            *(bool *)mm.declare_var("bool flag") = true ;
+            *(long long *)mm.declare_var("long long big") = 9007199254740993LL ;
+            *(long long *)mm.declare_var("long long big_neg") = -9007199254740993LL ;
+
+            Py_Initialize() ;
+            globals = PyDict_New() ;
+            PyDict_SetItemString(globals, "__builtins__", PyEval_GetBuiltins()) ;
+            set_python("i_zero", PyLong_FromLong(0)) ;
+            set_python("i_five", PyLong_FromLong(5)) ;
+            set_python("d_half", PyFloat_FromDouble(0.5)) ;
+            set_python("d_nan", PyFloat_FromDouble(NAN)) ;
+            set_python("f_third", PyFloat_FromDouble(1.0f / 3.0f)) ;
+            set_python("flag", PyBool_FromLong(1)) ;
+            set_python("big", PyLong_FromLongLong(9007199254740993LL)) ;
+            set_python("big_neg", PyLong_FromLongLong(-9007199254740993LL)) ;
+        }
+
+        virtual void TearDown() {
+            Py_DECREF(globals) ;
+        }
+
+        void set_python(const char * name, PyObject * value) {
+            PyDict_SetItemString(globals, name, value) ;
+            Py_DECREF(value) ;
+        }
+
+        /* Python's truth of the expression: 1 or 0, or -1 if Python does not accept it. */
+        int python_truth(const char * str) {
+            PyObject * result = PyRun_String(str, Py_eval_input, globals, globals) ;
+            int truth = -1 ;
+            if ( result != NULL ) {
+                truth = PyObject_IsTrue(result) ;
+                Py_DECREF(result) ;
+            } else {
+                PyErr_Clear() ;
+            }
+            return truth ;
+        }
+} ;
+
+TEST_F(EventExpressionTest , MatchesPython) {
+    for ( unsigned int ii = 0 ; ii < sizeof(cases) / sizeof(cases[0]) ; ii++ ) {
+        const char * str = cases[ii].str ;
+        int truth = python_truth(str) ;
+        EventExpression * expr = EventExpression::parse(str) ;
+        if ( cases[ii].native ) {
+            ASSERT_NE(truth, -1) << str ;
+            ASSERT_TRUE(expr != NULL) << str ;
+            EXPECT_EQ(expr->evaluate(), (bool)truth) << str ;
+        } else {
+            EXPECT_TRUE(expr == NULL) << str ;
+        }
+        delete expr ;
+    }
+}
+
+TEST_F(EventExpressionTest , ReadsVariablesEachTime) {
+    int * i_five = (int *)mm.ref_attributes("i_five")->address ;
+    EventExpression * expr = EventExpression::parse("i_five > 4 and i_five < 6") ;
+    ASSERT_TRUE(expr != NULL) ;
+    EXPECT_TRUE(expr->evaluate()) ;
+    *i_five = 7 ;
+    EXPECT_FALSE(expr->evaluate()) ;
+    delete expr ;
+}
+
+TEST_F(EventExpressionTest , UnsignedLongLongLeftToPython) {
+    *(unsigned long long *)mm.declare_var("unsigned long long ull") = 18446744073709551615ULL ;
+    EXPECT_TRUE(EventExpression::parse("ull > 0") == NULL) ;
+}
+
+}
@@ -0,0 +1,140 @@
+#include <Python.h>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "trick/EventExpression.hh"
+#include "trick/IPPython.hh"
+#include "trick/MemoryManager.hh"
+
+namespace Trick {
+
+/* Conditions that only read sim variables, evaluated from a snapshot.  Each must give Python's result for the
+   same variable values. */
+static const char * snapshot_cases[] = {
+    "abs(d_neg) > 0.5 * d_half" ,
+    "d_half < 1e-3" ,
+    "d_half + d_neg * 2.5E+1 < i_five" ,
+    "i_five // 2 == 2 and i_five % 2 == 1" ,
+    "min(i_five, d_half) < max(i_zero, 1)" ,
+    "round(d_neg) == -1 or int(d_half) == 0" ,
+    "math.sqrt(i_five) > 2 and math.pi > 3" ,
+    "i_five if flag else i_zero" ,
+    "i_zero is not None" ,
+    "not flag or (i_five in (4, 5))" ,
+    "i_five == i_five == 5" ,
+} ;
+
+class EventSnapshotTest : public ::testing::Test {
+
+    protected:
+        Trick::MemoryManager mm ;
+        Trick::IPPython ip ;
+        int * i_five ;
+        double * d_half ;
+
+        EventSnapshotTest() {}
+        ~EventSnapshotTest() {}
+
+        virtual void SetUp() {
+            *(int *)mm.declare_var("int i_zero") = 0 ;
+            i_five = (int *)mm.declare_var("int i_five") ;
+            *i_five = 5 ;
+            d_half = (double *)mm.declare_var("double d_half") ;
+            *d_half = 0.5 ;
+            *(double *)mm.declare_var("double d_neg") = -1.25 ;
+            *(bool *)mm.declare_var("bool flag") = true ;
+
+            Py_Initialize() ;
+            PyRun_SimpleString("import math\n"
+                               "i_zero = 0\n"
+                               "i_five = 5\n"
+                               "d_half = 0.5\n"
+                               "d_neg = -1.25\n"
+                               "flag = True\n") ;
+        }
+
+        /* Python's truth of the condition with the python variables of the same names. */
+        int python_truth(const char * str) {
+            int truth = -1 ;
+            PyObject * globals = PyModule_GetDict(PyImport_AddModule("__main__")) ;
+            PyObject * result = PyRun_String(str, Py_eval_input, globals, globals) ;
+            if ( result != NULL ) {
+                truth = PyObject_IsTrue(result) ;
+                Py_DECREF(result) ;
+            } else {
+                PyErr_Clear() ;
+            }
+            return truth ;
+        }
+
+        /* The truth of the condition evaluated from its snapshot. */
+        int snapshot_truth(EventSnapshot * snapshot) {
+            int truth = -1 ;
+            void * code = ip.compile(snapshot->get_str(), true) ;
+            if ( code != NULL ) {
+                if ( ip.parse_condition_snapshot(code, *snapshot, truth) != 0 ) {
+                    truth = -1 ;
+                }
+                ip.free_code(code) ;
+            }
+            return truth ;
+        }
+} ;
+
+TEST_F(EventSnapshotTest , MatchesPython) {
+    for ( unsigned int ii = 0 ; ii < sizeof(snapshot_cases) / sizeof(snapshot_cases[0]) ; ii++ ) {
+        const char * str = snapshot_cases[ii] ;
+        EventSnapshot * snapshot = EventSnapshot::parse(str) ;
+        ASSERT_TRUE(snapshot != NULL) << str ;
+        int truth = python_truth(str) ;
+        ASSERT_NE(truth, -1) << str ;
+        snapshot->take() ;
+        EXPECT_EQ(snapshot_truth(snapshot), truth) << str ;
+        delete snapshot ;
+    }
+}
+
+TEST_F(EventSnapshotTest , ReplacesVariables) {
+    EventSnapshot * snapshot = EventSnapshot::parse("abs(d_neg) > 1.5e-1 * i_five and d_neg != i_five") ;
+    ASSERT_TRUE(snapshot != NULL) ;
+    EXPECT_EQ(snapshot->get_str(),
+     "abs(_trick_event_value_0) > 1.5e-1 * _trick_event_value_1 and _trick_event_value_0 != _trick_event_value_1") ;
+    ASSERT_EQ(snapshot->size(), 2u) ;
+    EXPECT_EQ(snapshot->name(0), "_trick_event_value_0") ;
+    EXPECT_FALSE(snapshot->value(0).is_int) ;
+    EXPECT_EQ(snapshot->value(0).d, -1.25) ;
+    EXPECT_TRUE(snapshot->value(1).is_int) ;
+    EXPECT_EQ(snapshot->value(1).i, 5) ;
+    delete snapshot ;
+}
+
+TEST_F(EventSnapshotTest , ReadsTakenValues) {
+    EventSnapshot * snapshot = EventSnapshot::parse("i_five > 4 and d_half < 1") ;
+    ASSERT_TRUE(snapshot != NULL) ;
+    snapshot->take() ;
+    // The variables change after the values are taken, while the condition is evaluated.
+    *i_five = 3 ;
+    *d_half = 2.0 ;
+    EXPECT_EQ(snapshot_truth(snapshot), 1) ;
+    snapshot->take() ;
+    EXPECT_EQ(snapshot_truth(snapshot), 0) ;
+    delete snapshot ;
+}
+
+TEST_F(EventSnapshotTest , RejectsOtherState) {
+    // Python variables, strings, other calls and anything that may read memory that is not taken.
+    EXPECT_TRUE(EventSnapshot::parse("unknown_var < 1") == NULL) ;
+    EXPECT_TRUE(EventSnapshot::parse("'a' < 'b'") == NULL) ;
+    EXPECT_TRUE(EventSnapshot::parse("i_five < 1 # comment") == NULL) ;
+    EXPECT_TRUE(EventSnapshot::parse("len(i_five) > 0") == NULL) ;
+    EXPECT_TRUE(EventSnapshot::parse("trick.exec_get_sim_time() > 1") == NULL) ;
+    EXPECT_TRUE(EventSnapshot::parse("i_five.real > 1") == NULL) ;
+    EXPECT_TRUE(EventSnapshot::parse("(i_five).real > 1") == NULL) ;
+    EXPECT_TRUE(EventSnapshot::parse("[i_five][0] == 5") == NULL) ;
+    EXPECT_TRUE(EventSnapshot::parse("{i_five} == {5}") == NULL) ;
+    EXPECT_TRUE(EventSnapshot::parse("(lambda: i_five)() == 5") == NULL) ;
+    EXPECT_TRUE(EventSnapshot::parse("any(x for x in (i_five,))") == NULL) ;
+    EXPECT_TRUE(EventSnapshot::parse("abs") == NULL) ;
+}
+
+}
@@ -292,3 +292,13 @@ int Trick::MSSharedMem::write_name(char * in_data, size_t size) {
     /** @li Return the number of bytes written */
     return(size);
 }
+
+bool Trick::MSSharedMem::command_ready() {
+
+    /** @par Detailed Design */
+    /** @li The master reads the slave's command queue and the slave reads the master's. */
+    if (getpid() == shm_addr->master_pid) {
+        return(!MSQ_ISEMPTY(shm_addr->slave_command)) ;
+    }
+    return(!MSQ_ISEMPTY(shm_addr->master_command)) ;
+}
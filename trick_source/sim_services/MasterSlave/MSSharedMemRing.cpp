@@ -0,0 +1,278 @@
+#include <cstring> // for memcpy
+#include <time.h>
+#include <unistd.h>
+
+#include "trick/MSSharedMemRing.hh"
+#include "trick/tsm_proto.h"
+#include "trick/release.h" // for RELEASE()
+
+#if __linux__
+#include <linux/futex.h>
+#include <syscall.h>
+
+/* Sleeps while *addr == val, at most timeout seconds.  Timeouts of a day or more are infinite. */
+static void futex_wait(unsigned int * addr, unsigned int val, double timeout) {
+    struct timespec ts ;
+    ts.tv_sec = (time_t)timeout ;
+    ts.tv_nsec = (long)((timeout - ts.tv_sec) * 1000000000.0) ;
+    syscall(SYS_futex, addr, FUTEX_WAIT, val, (timeout < 86400.0) ? &ts : NULL, NULL, 0) ;
+}
+
+static void futex_wake(unsigned int * addr) {
+    syscall(SYS_futex, addr, FUTEX_WAKE, 1, NULL, NULL, 0) ;
+}
+#else
+static void futex_wait(unsigned int *, unsigned int, double) {
+    RELEASE() ;
+}
+
+static void futex_wake(unsigned int *) {}
+#endif
+
+static inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause() ;
+#endif
+}
+
+static double seconds_since(const struct timespec & start) {
+    struct timespec now ;
+    clock_gettime(CLOCK_MONOTONIC, &now) ;
+    return (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) / 1000000000.0 ;
+}
+
+Trick::MSSharedMemRing::MSSharedMemRing() : tsm_dev(), shm_addr(NULL) {
+    tsm_dev.default_val = -1;
+
+    // default is a non-zero sync wait limit; helpful when slave reading initial data from master
+    sync_wait_limit = 5.0 ;
+    // spinning only helps when the partner can run on another processor
+    spin_wait_limit = (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? 0.00005 : 0.0 ;
+}
+
+Trick::MSSharedMemRing::~MSSharedMemRing() {
+    // detach shared memory
+    tsm_disconnect(&tsm_dev);
+}
+
+int Trick::MSSharedMemRing::set_sync_wait_limit(double in_limit) {
+    /** @par Detailed Design */
+    if ( in_limit > 0.0 ) {
+        /** @li if the incoming limit time is greater than zero, use it as the longest a read waits */
+        sync_wait_limit = in_limit ;
+    } else {
+        /** @li if the incoming limit time is less than or equal to zero, wait forever */
+        sync_wait_limit = TSM_MAX_TIMEOUT_LIMIT;
+    }
+    return(0) ;
+}
+
+std::string Trick::MSSharedMemRing::add_sim_args(std::string slave_type __attribute__((unused))) {
+    /** @par Detailed Design */
+    /** @li nothing to do here for shared memory. */
+    return("");
+}
+
+int Trick::MSSharedMemRing::process_sim_args() {
+    /** @par Detailed Design */
+    /** @li no shared memory arguments to search for, return 1 to enable slave */
+    return(1) ;
+}
+
+int Trick::MSSharedMemRing::accept() {
+
+    int ret ;
+    /** @par Detailed Design */
+    /** @li Call tsm_init to create shared memory for master. */
+    tsm_dev.size = sizeof(MSSharedMemRingData);
+    ret = tsm_init(&tsm_dev);
+    shm_addr = (MSSharedMemRingData*) tsm_dev.addr;
+    /** @li Save master process id so we can keep master and slave data seperate, and empty the rings. */
+    if (ret==TSM_SUCCESS) {
+        memset(shm_addr, 0, sizeof(MSSharedMemRingData)) ;
+        shm_addr->master_pid = getpid();
+    }
+    return(ret) ;
+}
+
+int Trick::MSSharedMemRing::connect() {
+    int ret ;
+    /** @par Detailed Design */
+    /** @li Call tsm_init to attach the slave to the shared memory, or tsm_reconnect if it was attached before. */
+    if (tsm_dev.size == 0) {
+        tsm_dev.size = sizeof(MSSharedMemRingData);
+        ret = tsm_init(&tsm_dev);
+        shm_addr = (MSSharedMemRingData*) tsm_dev.addr;
+    } else {
+        ret = tsm_reconnect(&tsm_dev);
+        shm_addr = (MSSharedMemRingData*) tsm_dev.addr;
+        /** @li On a reconnect, empty the rings the slave reads.  They may hold values the master wrote for the
+                slave that left, or be marked waiting by it. */
+        if (ret==TSM_SUCCESS) {
+            drain(&shm_addr->master_time) ;
+            drain(&shm_addr->master_command) ;
+            drain(&shm_addr->chkpnt_name_ready) ;
+        }
+    }
+    return(ret) ;
+}
+
+int Trick::MSSharedMemRing::disconnect() {
+    return(0) ;
+}
+
+bool Trick::MSSharedMemRing::is_master() {
+    return(getpid() == shm_addr->master_pid) ;
+}
+
+/**
+@details
+-# Only the writer changes head, so the value is stored in the slot before head is advanced past it.
+-# head is stored and reader_waiting loaded with sequential consistency, pairing with the reader's store of
+   reader_waiting and load of head, so that either the reader sees the new head or the writer sees the reader
+   waiting and wakes it.
+*/
+bool Trick::MSSharedMemRing::push(MSRing * ring, long long value) {
+
+    unsigned int head = ring->head ;
+
+    if ( head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) >= MS_RING_SIZE ) {
+        return false ;
+    }
+    ring->data[head % MS_RING_SIZE] = value ;
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_SEQ_CST) ;
+    if ( __atomic_load_n(&ring->reader_waiting, __ATOMIC_SEQ_CST) ) {
+        futex_wake(&ring->head) ;
+    }
+    return true ;
+}
+
+/**
+@details
+-# If the ring is empty, spin for at most spin_wait_limit.
+-# Then, until sync_wait_limit, mark the reader waiting and sleep on head while it still equals tail.  The futex
+   returns at once if head has already moved.
+-# Take the value and advance tail to free its slot.
+*/
+bool Trick::MSSharedMemRing::pop(MSRing * ring, long long * value) {
+
+    unsigned int tail = ring->tail ;
+    unsigned int head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) ;
+
+    if ( head == tail ) {
+        struct timespec start ;
+        double elapsed = 0.0 ;
+        clock_gettime(CLOCK_MONOTONIC, &start) ;
+        while ( head == tail && elapsed < spin_wait_limit && elapsed < sync_wait_limit ) {
+            cpu_relax() ;
+            head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) ;
+            elapsed = seconds_since(start) ;
+        }
+        while ( head == tail && elapsed < sync_wait_limit ) {
+            __atomic_store_n(&ring->reader_waiting, 1, __ATOMIC_SEQ_CST) ;
+            head = __atomic_load_n(&ring->head, __ATOMIC_SEQ_CST) ;
+            if ( head == tail ) {
+                futex_wait(&ring->head, tail, sync_wait_limit - elapsed) ;
+                head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) ;
+                elapsed = seconds_since(start) ;
+            }
+        }
+        __atomic_store_n(&ring->reader_waiting, 0, __ATOMIC_RELAXED) ;
+        if ( head == tail ) {
+            return false ;
+        }
+    }
+    *value = ring->data[tail % MS_RING_SIZE] ;
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE) ;
+    return true ;
+}
+
+/**
+@details
+-# Only the reader changes tail, so the reader empties the ring by moving tail up to head.
+*/
+void Trick::MSSharedMemRing::drain(MSRing * ring) {
+    __atomic_store_n(&ring->reader_waiting, 0, __ATOMIC_RELAXED) ;
+    __atomic_store_n(&ring->tail, __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE) ;
+}
+
+bool Trick::MSSharedMemRing::command_ready() {
+    MSRing * ring = is_master() ? &shm_addr->slave_command : &shm_addr->master_command ;
+    return(__atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) != ring->tail) ;
+}
+
+long long Trick::MSSharedMemRing::read_time() {
+    long long in_time ;
+    /** @par Detailed Design */
+    /** @li Get time from the master's time ring, or return the "error" time if none arrives in time */
+    if ( pop(&shm_addr->master_time, &in_time) ) {
+        return(in_time) ;
+    }
+    return(MS_ERROR_TIME) ;
+}
+
+MS_SIM_COMMAND Trick::MSSharedMemRing::read_command() {
+    long long command ;
+    /** @par Detailed Design */
+    /** @li The master reads the slave's command ring and the slave reads the master's.
+            Return "error" command if none arrives in time. */
+    MSRing * ring = is_master() ? &shm_addr->slave_command : &shm_addr->master_command ;
+    if ( pop(ring, &command) ) {
+        return((MS_SIM_COMMAND)command) ;
+    }
+    return(MS_ErrorCmd) ;
+}
+
+int Trick::MSSharedMemRing::read_port() {
+    long long in_port ;
+    /** @par Detailed Design */
+    /** @li Get port number from its ring, or return the "error" port if none arrives in time */
+    if ( pop(&shm_addr->slave_port, &in_port) ) {
+        return((int)in_port) ;
+    }
+    return(MS_ERROR_PORT) ;
+}
+
+char Trick::MSSharedMemRing::read_name(char * read_data, size_t size) {
+    long long ready ;
+    /** @par Detailed Design */
+    /** @li Wait for the writer to mark the name ready, then copy it out of shared memory.
+            Return the "error" name character if it is not ready in time. */
+    if ( size > sizeof(shm_addr->chkpnt_name) ) {
+        size = sizeof(shm_addr->chkpnt_name) ;
+    }
+    if ( pop(&shm_addr->chkpnt_name_ready, &ready) ) {
+        memcpy(read_data, shm_addr->chkpnt_name, size);
+        return(read_data[0]) ;
+    }
+    return(MS_ERROR_NAME) ;
+}
+
+int Trick::MSSharedMemRing::write_time(long long in_time) {
+    /** @par Detailed Design */
+    /** @li Write time to its ring and return the number of bytes written */
+    return( push(&shm_addr->master_time, in_time) ? sizeof(long long) : 0 ) ;
+}
+
+int Trick::MSSharedMemRing::write_command(MS_SIM_COMMAND command) {
+    /** @par Detailed Design */
+    /** @li Write command to the master's or the slave's ring and return the number of bytes written */
+    MSRing * ring = is_master() ? &shm_addr->master_command : &shm_addr->slave_command ;
+    return( push(ring, command) ? sizeof(MS_SIM_COMMAND) : 0 ) ;
+}
+
+int Trick::MSSharedMemRing::write_port(int in_port) {
+    /** @par Detailed Design */
+    /** @li Write port number to its ring and return the number of bytes written */
+    return( push(&shm_addr->slave_port, in_port) ? sizeof(int) : 0 ) ;
+}
+
+int Trick::MSSharedMemRing::write_name(char * in_data, size_t size) {
+    /** @par Detailed Design */
+    /** @li Copy the name to shared memory, then mark it ready; the ring publishes the copy to the reader */
+    if ( size > sizeof(shm_addr->chkpnt_name) ) {
+        size = sizeof(shm_addr->chkpnt_name) ;
+    }
+    memcpy(shm_addr->chkpnt_name, in_data, size);
+    return( push(&shm_addr->chkpnt_name_ready, 1) ? (int)size : 0 ) ;
+}
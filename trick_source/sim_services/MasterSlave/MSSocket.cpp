@@ -3,6 +3,7 @@
 #include <sstream>
 #include <string.h>
 #include <unistd.h>
+#include <poll.h>
 
 #include "trick/MSSocket.hh"
 #include "trick/Master.hh"
@@ -228,3 +229,20 @@ int Trick::MSSocket::write_name(char * in_data, size_t size) {
     /** @li Return the number of bytes written */
     return(size) ;
 }
+
+bool Trick::MSSocket::command_ready() {
+
+    struct pollfd pfd ;
+
+    /** @par Detailed Design */
+    /** @li Poll the socket without waiting.  A closed or failed socket counts as ready so that the
+            read reports the error. */
+    pfd.fd = tc_dev.socket ;
+    pfd.events = POLLIN ;
+    pfd.revents = 0 ;
+    return(poll(&pfd, 1, 0) != 0) ;
+}
+
+int Trick::MSSocket::get_poll_fd() {
+    return(tc_dev.socket) ;
+}
@@ -6,7 +6,11 @@
 #include <sstream>
 #include <string>
 #include <pwd.h>
+#include <math.h>
+#include <poll.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #include <sys/types.h>
@@ -24,9 +28,17 @@
 #include "trick/message_type.h"
 #include "trick/env_proto.h"
 #include "trick/CheckPointRestart_c_intf.hh" // for checkpoint_get_output_file
+#include "trick/release.h"
 
 Trick::Master * the_ms_master ;
 
+/* Seconds elapsed since start on the monotonic clock. */
+static double seconds_since(const struct timespec & start) {
+    struct timespec now ;
+    clock_gettime(CLOCK_MONOTONIC, &now) ;
+    return (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) / 1000000000.0 ;
+}
+
 Trick::SlaveInfo::SlaveInfo() {
 
     enabled = true ;
@@ -47,6 +59,11 @@ Trick::SlaveInfo::SlaveInfo() {
     reconnect_count = 0;
     chkpnt_dump_auto = true ;
     chkpnt_load_auto = true ;
+
+    connection = NULL ;
+    sync_latency = 0.0 ;
+    sync_latency_max = 0.0 ;
+    memset(sync_latency_hist, 0, sizeof(sync_latency_hist)) ;
 }
 
 int Trick::SlaveInfo::set_connection_type(Trick::MSConnect * in_connection) {
@@ -182,15 +199,22 @@ int Trick::SlaveInfo::start() {
 
 int Trick::SlaveInfo::read_slave_status() {
 
-    MS_SIM_COMMAND slave_command ;
+    /** @par Detailed Design: */
+    /** @li If the slave is an active synchronization partner (activated == true) */
+    if (activated == true) {
+        /** @li read the current slave exec_command and act on it */
+        return(process_slave_status(connection->read_command())) ;
+    }
+    return(0) ;
+}
+
+int Trick::SlaveInfo::process_slave_status(MS_SIM_COMMAND slave_command) {
+
     MS_SIM_COMMAND exec_command ;
 
     /** @par Detailed Design: */
-    /** @li If the slave is an active synchronization partner (activated == true) */
     if (activated == true) {
 
-        /** @li read the current slave exec_command */
-        slave_command = connection->read_command() ;
         //printf("DEBUG master read %d command from slave\n", slave_command);fflush(stdout);
 
         exec_command = (MS_SIM_COMMAND)exec_get_exec_command() ;
@@ -262,6 +286,23 @@ int Trick::SlaveInfo::read_slave_status() {
     return(0) ;
 }
 
+void Trick::SlaveInfo::record_sync_latency(double latency) {
+
+    double usec = latency * 1000000.0 ;
+    int bin = 0 ;
+
+    sync_latency = latency ;
+    if ( latency > sync_latency_max ) {
+        sync_latency_max = latency ;
+    }
+    /* Bin 0 is under 1 us, each bin after it doubles */
+    while ( bin < MS_SYNC_LATENCY_BINS - 1 && usec >= 1.0 ) {
+        usec /= 2.0 ;
+        bin++ ;
+    }
+    sync_latency_hist[bin]++ ;
+}
+
 int Trick::SlaveInfo::write_master_status() {
     /** @par Detailed Design: */
     /** @li If the slave is an active synchronization partner (activated == true) */
@@ -297,6 +338,7 @@ Trick::Master::Master() {
     enabled = false ;
     the_ms_master = this ;
     num_slaves = 0 ;
+    parallel_sync = false ;
 }
 
 int Trick::Master::enable() {
@@ -365,19 +407,130 @@ int Trick::Master::init() {
 
 /**
 @details
--# Read the status of all slaves
+-# Read the status of all slaves, in slave order or as it arrives if parallel_sync is set
+-# Record how long the master waited for each activated slave.  Read in slave order, that is the wait for that
+   slave's read alone, not including the reads of the slaves before it.
 */
 int Trick::Master::end_of_frame_status_from_slave() {
     unsigned int ii ;
+    struct timespec start ;
     if ( enabled ) {
+        if ( parallel_sync ) {
+            return(collect_slave_status()) ;
+        }
         for ( ii = 0 ; ii < slaves.size() ; ii++ ) {
-            slaves[ii]->read_slave_status() ;
+            if ( slaves[ii]->activated ) {
+                clock_gettime(CLOCK_MONOTONIC, &start) ;
+                slaves[ii]->read_slave_status() ;
+                slaves[ii]->record_sync_latency(seconds_since(start)) ;
+            }
         }
     }
 
     return(0) ;
 }
 
+/**
+@details
+-# Until every activated slave has been heard from or has run out its sync wait limit
+   -# Read and act on the status of each slave whose status has arrived
+   -# A slave whose sync wait limit has passed since the collection started has lost sync, as if its read had
+      timed out
+   -# Wait for the first socket to become readable or the nearest wait limit to pass.  Connections that have no
+      descriptor to poll, like shared memory, are checked again after yielding the processor.
+-# Record how long the master waited for each slave
+*/
+int Trick::Master::collect_slave_status() {
+
+    std::vector< Trick::SlaveInfo * > pending ;
+    std::vector< struct pollfd > fds ;
+    std::vector< Trick::SlaveInfo * >::iterator it ;
+    struct timespec start ;
+    unsigned int ii ;
+
+    clock_gettime(CLOCK_MONOTONIC, &start) ;
+    for ( ii = 0 ; ii < slaves.size() ; ii++ ) {
+        if ( slaves[ii]->activated ) {
+            pending.push_back(slaves[ii]) ;
+        }
+    }
+
+    while ( ! pending.empty() ) {
+        double elapsed = seconds_since(start) ;
+        double timeout = -1.0 ;
+        bool spin = false ;
+
+        fds.clear() ;
+        for ( it = pending.begin() ; it != pending.end() ; ) {
+            Trick::SlaveInfo * slave = *it ;
+            double limit = slave->connection->sync_wait_limit ;
+            if ( slave->connection->command_ready() ) {
+                slave->process_slave_status(slave->connection->read_command()) ;
+            } else if ( limit > 0.0 && elapsed >= limit ) {
+                slave->process_slave_status(MS_ErrorCmd) ;
+            } else {
+                if ( limit > 0.0 && (timeout < 0.0 || limit - elapsed < timeout) ) {
+                    timeout = limit - elapsed ;
+                }
+                struct pollfd pfd ;
+                pfd.fd = slave->connection->get_poll_fd() ;
+                pfd.events = POLLIN ;
+                pfd.revents = 0 ;
+                if ( pfd.fd >= 0 ) {
+                    fds.push_back(pfd) ;
+                } else {
+                    spin = true ;
+                }
+                ++it ;
+                continue ;
+            }
+            slave->record_sync_latency(seconds_since(start)) ;
+            it = pending.erase(it) ;
+        }
+
+        if ( ! pending.empty() ) {
+            if ( spin ) {
+                if ( ! fds.empty() ) {
+                    poll(&fds[0], fds.size(), 0) ;
+                }
+                RELEASE() ;
+            } else {
+                poll(&fds[0], fds.size(), (timeout < 0.0) ? -1 : (int)ceil(timeout * 1000.0)) ;
+            }
+        }
+    }
+
+    return(0) ;
+}
+
+int Trick::Master::print_sync_latency() {
+
+    unsigned int ii ;
+    int jj ;
+    std::stringstream ss ;
+
+    /** @par Detailed Design: */
+    /** @li For each slave print the last and longest waits and the non-empty histogram bins, labeled by
+            their upper bound */
+    for ( ii = 0 ; ii < slaves.size() ; ii++ ) {
+        ss.str("") ;
+        ss << "Slave " << ii << " (" << slaves[ii]->machine_name << ") sync latency: last "
+           << slaves[ii]->sync_latency << " s, max " << slaves[ii]->sync_latency_max << " s\n" ;
+        for ( jj = 0 ; jj < MS_SYNC_LATENCY_BINS ; jj++ ) {
+            if ( slaves[ii]->sync_latency_hist[jj] > 0 ) {
+                if ( jj == MS_SYNC_LATENCY_BINS - 1 ) {
+                    ss << "    >= " << (1u << (jj - 1)) << " us: " ;
+                } else {
+                    ss << "    < " << (1u << jj) << " us: " ;
+                }
+                ss << slaves[ii]->sync_latency_hist[jj] << "\n" ;
+            }
+        }
+        message_publish(MSG_INFO, "%s", ss.str().c_str()) ;
+    }
+    return(0) ;
+}
+
 /**
 @details
 -# Write the master status to all slaves
@@ -522,3 +675,22 @@ extern "C" int ms_master_disable(void) {
     the_ms_master->disable() ;
     return(0) ;
 }
+
+/**
+ * @relates Trick::Master
+ * C binded function to set whether the master reads the slaves' status as it arrives.
+ * @return always 0
+ */
+extern "C" int ms_master_set_parallel_sync(int on_off) {
+    the_ms_master->parallel_sync = (bool)on_off ;
+    return(0) ;
+}
+
+/**
+ * @relates Trick::Master
+ * @copydoc Trick::Master::print_sync_latency
+ */
+extern "C" int ms_master_print_sync_latency(void) {
+    the_ms_master->print_sync_latency() ;
+    return(0) ;
+}
@@ -0,0 +1,178 @@
+#define protected public
+
+#include <climits>
+#include <thread>
+#include <sys/shm.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+#include "trick/MSSharedMemRing.hh"
+
+namespace Trick {
+
+class MSSharedMemRingTest : public ::testing::Test {
+
+    protected:
+        Trick::MSSharedMemRing master ;
+        MSRing ring ;
+
+        MSSharedMemRingTest() {}
+        ~MSSharedMemRingTest() {}
+        virtual void SetUp() {
+            memset(&ring, 0, sizeof(ring)) ;
+            master.set_sync_wait_limit(5.0) ;
+        }
+        virtual void TearDown() {
+            if ( master.shm_addr != NULL ) {
+                shmctl(master.tsm_dev.shmid, IPC_RMID, NULL) ;
+            }
+        }
+
+        int connect_master() {
+            // The key only has to name a file that exists.
+            snprintf(master.tsm_dev.key_file, sizeof(master.tsm_dev.key_file), "%s", __FILE__) ;
+            return master.accept() ;
+        }
+} ;
+
+TEST_F(MSSharedMemRingTest , PushPopInOrder) {
+    long long value ;
+    int ii ;
+
+    for ( ii = 0 ; ii < MS_RING_SIZE ; ii++ ) {
+        EXPECT_TRUE(master.push(&ring, ii)) ;
+    }
+    // A full ring refuses the value rather than overwrite one not yet read.
+    EXPECT_FALSE(master.push(&ring, MS_RING_SIZE)) ;
+    for ( ii = 0 ; ii < MS_RING_SIZE ; ii++ ) {
+        EXPECT_TRUE(master.pop(&ring, &value)) ;
+        EXPECT_EQ(value, ii) ;
+    }
+    EXPECT_EQ(ring.head, ring.tail) ;
+}
+
+TEST_F(MSSharedMemRingTest , CountersWrap) {
+    long long value ;
+    int ii ;
+
+    // head and tail keep counting through the unsigned wrap.
+    ring.head = ring.tail = UINT_MAX - 2 ;
+    for ( ii = 0 ; ii < MS_RING_SIZE ; ii++ ) {
+        EXPECT_TRUE(master.push(&ring, 100 + ii)) ;
+    }
+    EXPECT_FALSE(master.push(&ring, 0)) ;
+    for ( ii = 0 ; ii < MS_RING_SIZE ; ii++ ) {
+        EXPECT_TRUE(master.pop(&ring, &value)) ;
+        EXPECT_EQ(value, 100 + ii) ;
+    }
+    EXPECT_EQ(ring.head, (unsigned int)(UINT_MAX - 2 + MS_RING_SIZE)) ;
+}
+
+TEST_F(MSSharedMemRingTest , EmptyPopTimesOut) {
+    struct timespec start , end ;
+    long long value ;
+
+    master.set_sync_wait_limit(0.02) ;
+    clock_gettime(CLOCK_MONOTONIC, &start) ;
+    EXPECT_FALSE(master.pop(&ring, &value)) ;
+    clock_gettime(CLOCK_MONOTONIC, &end) ;
+    EXPECT_GE((end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1000000000.0 , 0.02) ;
+    EXPECT_EQ(ring.reader_waiting, 0u) ;
+}
+
+TEST_F(MSSharedMemRingTest , Drain) {
+    long long value ;
+
+    master.push(&ring, 1) ;
+    master.push(&ring, 2) ;
+    ring.reader_waiting = 1 ;
+    master.drain(&ring) ;
+    EXPECT_EQ(ring.head, ring.tail) ;
+    EXPECT_EQ(ring.reader_waiting, 0u) ;
+    master.push(&ring, 3) ;
+    EXPECT_TRUE(master.pop(&ring, &value)) ;
+    EXPECT_EQ(value, 3) ;
+}
+
+TEST_F(MSSharedMemRingTest , TwoThreads) {
+    const long long count = 200000 ;
+    long long value ;
+    long long ii ;
+    long long errors = 0 ;
+
+    // The writer outruns the reader, so the ring fills, and the reader also sleeps on an empty ring.
+    std::thread writer([&]() {
+        for ( long long jj = 0 ; jj < count ; jj++ ) {
+            while ( ! master.push(&ring, jj) ) {
+                sched_yield() ;
+            }
+            if ( jj % 10000 == 0 ) {
+                usleep(1000) ;
+            }
+        }
+    }) ;
+    for ( ii = 0 ; ii < count ; ii++ ) {
+        if ( ! master.pop(&ring, &value) || value != ii ) {
+            errors++ ;
+            break ;
+        }
+    }
+    writer.join() ;
+    EXPECT_EQ(errors, 0) ;
+    EXPECT_EQ(ring.head, ring.tail) ;
+}
+
+TEST_F(MSSharedMemRingTest , TwoProcesses) {
+    const int frames = 10000 ;
+    char name[256] ;
+    int status ;
+    int ii ;
+
+    ASSERT_EQ(connect_master(), TSM_SUCCESS) ;
+    // Left behind for a slave that has gone; the reconnecting slave must not read it.
+    master.write_time(-5) ;
+    master.write_command(MS_FreezeCmd) ;
+
+    pid_t pid = fork() ;
+    ASSERT_NE(pid, -1) ;
+    if ( pid == 0 ) {
+        // The slave reconnects to the master's shared memory and echoes every frame's time and command.
+        Trick::MSSharedMemRing slave ;
+        slave.tsm_dev = master.tsm_dev ;
+        slave.set_sync_wait_limit(5.0) ;
+        if ( slave.connect() != TSM_SUCCESS || slave.is_master() ) {
+            _exit(1) ;
+        }
+        slave.write_port(0) ;
+        for ( ii = 1 ; ii <= frames ; ii++ ) {
+            if ( slave.read_time() != ii || slave.read_command() != MS_NoCmd ) {
+                _exit(2) ;
+            }
+            slave.write_port(ii) ;
+            slave.write_command(MS_NoCmd) ;
+        }
+        if ( slave.read_name(name, sizeof(name)) != 'c' || strcmp(name, "chkpnt_1.0") ) {
+            _exit(3) ;
+        }
+        _exit(0) ;
+    }
+
+    EXPECT_TRUE(master.is_master()) ;
+    EXPECT_EQ(master.read_port(), 0) ;
+    for ( ii = 1 ; ii <= frames ; ii++ ) {
+        master.write_time(ii) ;
+        master.write_command(MS_NoCmd) ;
+        EXPECT_EQ(master.read_port(), ii) ;
+        EXPECT_EQ(master.read_command(), MS_NoCmd) ;
+    }
+    strcpy(name, "chkpnt_1.0") ;
+    master.write_name(name, sizeof(name)) ;
+
+    ASSERT_EQ(waitpid(pid, &status, 0), pid) ;
+    EXPECT_TRUE(WIFEXITED(status)) ;
+    EXPECT_EQ(WEXITSTATUS(status), 0) ;
+}
+
+}
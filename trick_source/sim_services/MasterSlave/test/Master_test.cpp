@@ -0,0 +1,135 @@
+
+#include <time.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+#include "trick/Executive.hh"
+#include "trick/Master.hh"
+
+namespace Trick {
+
+/* A connection whose slave status arrives a fixed time after the master starts to wait for it. */
+class DelayedConnect : public Trick::MSConnect {
+    public:
+        DelayedConnect(double in_delay) : delay(in_delay) , reads(0) { sync_wait_limit = 0.0 ; }
+
+        virtual int set_sync_wait_limit(double in_limit) { sync_wait_limit = in_limit ; return 0 ; }
+        virtual std::string add_sim_args(std::string) { return "" ; }
+        virtual int process_sim_args() { return 0 ; }
+        virtual int accept() { return 0 ; }
+        virtual int connect() { return 0 ; }
+        virtual int disconnect() { return 0 ; }
+        virtual long long read_time() { return 0 ; }
+        virtual int read_port() { return 0 ; }
+        virtual char read_name(char *, size_t) { return 0 ; }
+        virtual int write_time(long long) { return 0 ; }
+        virtual int write_port(int) { return 0 ; }
+        virtual int write_name(char *, size_t) { return 0 ; }
+        virtual int write_command(MS_SIM_COMMAND) { return 0 ; }
+
+        /* Blocks until the status arrives, like a socket read. */
+        virtual MS_SIM_COMMAND read_command() {
+            if ( ! command_ready() ) {
+                usleep((useconds_t)(delay * 1000000.0)) ;
+            }
+            reads++ ;
+            return MS_NoCmd ;
+        }
+
+        /* The status arrives delay seconds after the first look at this frame. */
+        virtual bool command_ready() {
+            struct timespec now ;
+            clock_gettime(CLOCK_MONOTONIC, &now) ;
+            if ( ! started ) {
+                start = now ;
+                started = true ;
+            }
+            return (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) / 1000000000.0 >= delay ;
+        }
+
+        double delay ;
+        int reads ;
+        bool started = false ;
+        struct timespec start ;
+} ;
+
+class MasterTest : public ::testing::Test {
+
+    protected:
+        Trick::Executive exec ;
+        Trick::Master master ;
+        Trick::SlaveInfo slave_1 ;
+        Trick::SlaveInfo slave_2 ;
+        DelayedConnect connect_1 ;
+        DelayedConnect connect_2 ;
+
+        MasterTest() : connect_1(0.02) , connect_2(0.02) {}
+        ~MasterTest() {}
+        virtual void SetUp() {
+            slave_1.set_connection_type(&connect_1) ;
+            slave_2.set_connection_type(&connect_2) ;
+            slave_1.activated = true ;
+            slave_2.activated = true ;
+            master.add_slave(&slave_1) ;
+            master.add_slave(&slave_2) ;
+            master.enable() ;
+        }
+        virtual void TearDown() {}
+} ;
+
+TEST_F(MasterTest , RecordSyncLatency) {
+    // Bin 0 is under 1 us, bin i is [2^(i-1), 2^i) us, the last bin holds the rest.
+    slave_1.record_sync_latency(0.0000005) ;
+    slave_1.record_sync_latency(0.0000015) ;
+    slave_1.record_sync_latency(0.000003) ;
+    slave_1.record_sync_latency(0.001) ;
+    slave_1.record_sync_latency(100.0) ;
+    slave_1.record_sync_latency(0.0005) ;
+    EXPECT_EQ(slave_1.sync_latency_hist[0] , 1u) ;
+    EXPECT_EQ(slave_1.sync_latency_hist[1] , 1u) ;
+    EXPECT_EQ(slave_1.sync_latency_hist[2] , 1u) ;
+    EXPECT_EQ(slave_1.sync_latency_hist[9] , 1u) ;
+    EXPECT_EQ(slave_1.sync_latency_hist[10] , 1u) ;
+    EXPECT_EQ(slave_1.sync_latency_hist[MS_SYNC_LATENCY_BINS - 1] , 1u) ;
+    EXPECT_DOUBLE_EQ(slave_1.sync_latency , 0.0005) ;
+    EXPECT_DOUBLE_EQ(slave_1.sync_latency_max , 100.0) ;
+}
+
+TEST_F(MasterTest , SerialSyncLatencyPerSlave) {
+    // Read in slave order, the second slave's latency does not include the wait for the first.
+    master.end_of_frame_status_from_slave() ;
+    EXPECT_EQ(connect_1.reads , 1) ;
+    EXPECT_EQ(connect_2.reads , 1) ;
+    EXPECT_GE(slave_1.sync_latency , 0.015) ;
+    EXPECT_GE(slave_2.sync_latency , 0.015) ;
+    EXPECT_LT(slave_2.sync_latency , 0.035) ;
+}
+
+TEST_F(MasterTest , ParallelSyncLatency) {
+    // Collected together, each latency is the time until that slave's status arrived.
+    master.parallel_sync = true ;
+    connect_1.delay = 0.01 ;
+    connect_2.delay = 0.03 ;
+    master.end_of_frame_status_from_slave() ;
+    EXPECT_EQ(connect_1.reads , 1) ;
+    EXPECT_EQ(connect_2.reads , 1) ;
+    EXPECT_GE(slave_1.sync_latency , 0.01) ;
+    EXPECT_LT(slave_1.sync_latency , 0.025) ;
+    EXPECT_GE(slave_2.sync_latency , 0.03) ;
+    EXPECT_LT(slave_2.sync_latency , 0.045) ;
+}
+
+TEST_F(MasterTest , ParallelSyncWaitLimit) {
+    // A slave that does not answer within its sync wait limit is deactivated, the other is still read.
+    master.parallel_sync = true ;
+    connect_2.delay = 10.0 ;
+    connect_2.sync_wait_limit = 0.05 ;
+    master.end_of_frame_status_from_slave() ;
+    EXPECT_EQ(connect_1.reads , 1) ;
+    EXPECT_EQ(connect_2.reads , 0) ;
+    EXPECT_TRUE(slave_1.activated) ;
+    EXPECT_FALSE(slave_2.activated) ;
+    EXPECT_GE(slave_2.sync_latency , 0.05) ;
+}
+
+}
@@ -0,0 +1,167 @@
+/*
+   PURPOSE: (Lazily built name and offset lookup indexes over ATTRIBUTES arrays.)
+*/
+
+#include <algorithm>
+#include <pthread.h>
+#include <string.h>
+
+#include "trick/AttributesIndex.hh"
+
+typedef std::unordered_map< ATTRIBUTES * , Trick::AttributesIndex * > ATTRIBUTES_INDEX_MAP ;
+
+static ATTRIBUTES_INDEX_MAP attributes_index_map ;
+static pthread_rwlock_t attributes_index_lock = PTHREAD_RWLOCK_INITIALIZER ;
+// Indexes replaced because their array changed, or removed. Another thread may still be reading one, so they are kept.
+static std::vector< Trick::AttributesIndex * > retired_indexes ;
+
+Trick::AttributesIndex * Trick::AttributesIndex::get_index( ATTRIBUTES * attr_list ) {
+
+    if ( attr_list == NULL ) {
+        return NULL ;
+    }
+
+    AttributesIndex * index = NULL ;
+    pthread_rwlock_rdlock(&attributes_index_lock) ;
+    ATTRIBUTES_INDEX_MAP::iterator it = attributes_index_map.find(attr_list) ;
+    if ( it != attributes_index_map.end() and it->second->matches(attr_list) ) {
+        index = it->second ;
+    }
+    pthread_rwlock_unlock(&attributes_index_lock) ;
+    if ( index != NULL ) {
+        return index ;
+    }
+
+    pthread_rwlock_wrlock(&attributes_index_lock) ;
+    it = attributes_index_map.find(attr_list) ;
+    if ( it != attributes_index_map.end() and it->second->matches(attr_list) ) {
+        // Another thread built it first.
+        index = it->second ;
+    } else {
+        if ( it != attributes_index_map.end() ) {
+            // The array at this address is not the one indexed, which was freed or unloaded.
+            retired_indexes.push_back(it->second) ;
+        }
+        index = new AttributesIndex(attr_list) ;
+        attributes_index_map[attr_list] = index ;
+    }
+    pthread_rwlock_unlock(&attributes_index_lock) ;
+    return index ;
+}
+
+void Trick::AttributesIndex::remove_index( ATTRIBUTES * attr_list ) {
+
+    pthread_rwlock_wrlock(&attributes_index_lock) ;
+    ATTRIBUTES_INDEX_MAP::iterator it = attributes_index_map.find(attr_list) ;
+    if ( it != attributes_index_map.end() ) {
+        // A reader may still hold the index without the lock, as with a replaced one.
+        retired_indexes.push_back(it->second) ;
+        attributes_index_map.erase(it) ;
+    }
+    pthread_rwlock_unlock(&attributes_index_lock) ;
+}
+
+bool Trick::AttributesIndex::matches( ATTRIBUTES * in_attr_list ) const {
+    return in_attr_list[0].name == first_name and in_attr_list[0].type_name == first_type_name ;
+}
+
+int Trick::AttributesIndex::member_size( ATTRIBUTES * attr ) {
+
+    int size ;
+    // if mod bit 0 is set, attr is a reference. Width of reference is stored
+    // in mod bits 3-8. We could use sizeof(void*), but that is implementation
+    // specific and not required by C++ standard.
+    if ((attr->mods & 1) == 1) {
+        size = ((attr->mods >> 3) & 0x3F);
+    } else if (attr->num_index != 0) {
+        // if size of last valid index is 0, then we are looking at a pointer
+        if (attr->index[attr->num_index - 1].size == 0) {
+            size = sizeof(void*);
+        } else {
+            size = attr->size;
+        }
+        for (int jj = 0; jj < attr->num_index; jj++) {
+            if (attr->index[jj].size != 0) {
+                size *= attr->index[jj].size;
+            } else {
+                break;
+            }
+        }
+    } else {
+        size = attr->size;
+    }
+    return size ;
+}
+
+Trick::AttributesIndex::AttributesIndex( ATTRIBUTES * in_attr_list ) :
+ attr_list(in_attr_list) ,
+ first_name(in_attr_list[0].name) ,
+ first_type_name(in_attr_list[0].type_name) ,
+ overlapping(false) {
+
+    int ii ;
+    for ( ii = 0 ; attr_list[ii].name[0] != '\0' ; ii++ ) {
+        // emplace keeps the first declaration of a duplicated name, same as a linear search.
+        name_map.emplace(attr_list[ii].name, &attr_list[ii]) ;
+
+        int size = member_size(&attr_list[ii]) ;
+        if ( size > 0 ) {
+            OffsetEntry entry ;
+            entry.start = attr_list[ii].offset ;
+            entry.end = attr_list[ii].offset + size ;
+            entry.index = ii ;
+            offset_table.push_back(entry) ;
+        }
+    }
+    terminator = &attr_list[ii] ;
+
+    std::sort(offset_table.begin(), offset_table.end(),
+     [](const OffsetEntry & a, const OffsetEntry & b) {
+        return (a.start != b.start) ? (a.start < b.start) : (a.index < b.index) ;
+     }) ;
+    for ( size_t jj = 1 ; jj < offset_table.size() ; jj++ ) {
+        if ( offset_table[jj].start < offset_table[jj-1].end ) {
+            overlapping = true ;
+            break ;
+        }
+    }
+}
+
+ATTRIBUTES * Trick::AttributesIndex::find_name( const char * name ) const {
+
+    std::unordered_map< std::string , ATTRIBUTES * >::const_iterator it = name_map.find(name) ;
+    if ( it != name_map.end() ) {
+        return it->second ;
+    }
+    return NULL ;
+}
+
+ATTRIBUTES * Trick::AttributesIndex::find_offset( long offset ) const {
+
+    if ( overlapping ) {
+        // Members share storage; the first member in declaration order that contains the offset wins.
+        for ( int ii = 0 ; attr_list[ii].name[0] != '\0' ; ii++ ) {
+            long start = attr_list[ii].offset ;
+            if ( offset >= start and offset < start + member_size(&attr_list[ii]) ) {
+                return &attr_list[ii] ;
+            }
+        }
+        return terminator ;
+    }
+
+    // Find the last member that starts at or before offset.
+    size_t lo = 0 ;
+    size_t hi = offset_table.size() ;
+    while ( lo < hi ) {
+        size_t mid = lo + (hi - lo) / 2 ;
+        if ( offset_table[mid].start <= offset ) {
+            lo = mid + 1 ;
+        } else {
+            hi = mid ;
+        }
+    }
+    if ( lo > 0 and offset < offset_table[lo-1].end ) {
+        return &attr_list[offset_table[lo-1].index] ;
+    }
+    return terminator ;
+}
@@ -0,0 +1,33 @@
+/*
+   PURPOSE: (Map of mangled type names to the functions and attributes generated by ICG.)
+*/
+
+#include "trick/IOSrcTypeRegistry.hh"
+
+Trick::IOSrcTypeRegistry * Trick::IOSrcTypeRegistry::pInstance = NULL ;
+
+void Trick::IOSrcTypeRegistry::add_class( std::string type , size_t (*sizeof_func)(void) , ATTRIBUTES * attr ,
+ void (*init_attr_func)(void) , void * (*allocate_func)(int) ,
+ void (*destruct_func)(void *, int) , void (*delete_func)(void *) ) {
+
+    IO_SRC_TYPE_INFO & info = type_map[type] ;
+    info.sizeof_func = sizeof_func ;
+    info.attr = attr ;
+    info.init_attr_func = init_attr_func ;
+    info.allocate_func = allocate_func ;
+    info.destruct_func = destruct_func ;
+    info.delete_func = delete_func ;
+    info.enum_attr = NULL ;
+}
+
+void Trick::IOSrcTypeRegistry::add_enum( std::string type , size_t (*sizeof_func)(void) , ENUM_ATTR * enum_attr ) {
+
+    IO_SRC_TYPE_INFO & info = type_map[type] ;
+    info.sizeof_func = sizeof_func ;
+    info.attr = NULL ;
+    info.init_attr_func = NULL ;
+    info.allocate_func = NULL ;
+    info.destruct_func = NULL ;
+    info.delete_func = NULL ;
+    info.enum_attr = enum_attr ;
+}
@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include "trick/MemoryManager.hh"
 #include "trick/ClassicCheckPointAgent.hh"
+#include "trick/RefCache.hh"
+#include "trick/MemoryPool.hh"
 // Global pointer to the (singleton) MemoryManager for the C language interface.
 Trick::MemoryManager * trick_MM = NULL;
 
@@ -30,6 +32,10 @@ Trick::MemoryManager::MemoryManager()
     // start counter at 0.  This forces extern vars to appear in front of actual allocations in checkpoint.
     extern_alloc_info_map_counter = 0 ;
     pthread_mutex_init(&mm_mutex, NULL);
+    ref_cache = new RefCache(16384);
+    alloc_pool = new MemoryPool();
+    use_alloc_pool = false;
+    alloc_pool_used = false;
 
     defaultCheckPointAgent = new ClassicCheckPointAgent( this);
     defaultCheckPointAgent->set_reduced_checkpoint( reduced_checkpoint);
@@ -84,16 +90,18 @@ Trick::MemoryManager::~MemoryManager() {
         ALLOC_INFO * ai_ptr = (*ait).second ;
         if (ai_ptr->stcl == TRICK_LOCAL) {
             if ( ai_ptr->alloc_type == TRICK_ALLOC_MALLOC ) {
-                free((char *)ai_ptr->start - ai_ptr->sentinel_bytes) ;
+                free_memory((char *)ai_ptr->start - ai_ptr->sentinel_bytes) ;
             } else if ( ai_ptr->alloc_type == TRICK_ALLOC_NEW ) {
                 io_src_delete_class( ai_ptr );
             }
         }
         if (ai_ptr->name) { free(ai_ptr->name); }
         if (ai_ptr->user_type_name) { free(ai_ptr->user_type_name); }
-        free(ai_ptr) ;
+        free_alloc_info(ai_ptr) ;
     }
     alloc_info_map.clear() ;
+    delete ref_cache ;
+    delete alloc_pool ;
 }
 
 #include <sstream>
@@ -9,6 +9,7 @@
 
 #include "trick/SimObject.hh"
 #include "trick/MemoryManager.hh"
+#include "trick/IOSrcTypeRegistry.hh"
 
 /**
  *
@@ -27,6 +28,7 @@ int Trick::MemoryManager::add_attr_info( const std::string & user_type_string ,
     size_t (*size_func)(void) = NULL ;
     unsigned int ii ;
     std::set<std::string>::iterator it ;
+    const IO_SRC_TYPE_INFO * type_info ;
 
     /** @par Design Details: */
 
@@ -62,6 +64,18 @@ int Trick::MemoryManager::add_attr_info( const std::string & user_type_string ,
     // remove spaces
     user_type_name.erase(std::remove_if(user_type_name.begin(), user_type_name.end(), (int(*)(int))std::isspace), user_type_name.end()) ;
 
+    // Types listed in the ICG generated class_map are found without dlsym.
+    type_info = IOSrcTypeRegistry::registry()->get_type(user_type_name) ;
+    if ( type_info != NULL ) {
+        size_func = type_info->sizeof_func ;
+        sub_attr = type_info->attr ;
+        init_sub_attr = type_info->init_attr_func ;
+        enum_attr = type_info->enum_attr ;
+        if ( size_func != NULL ) {
+            attr->size = (*size_func)() ;
+        }
+    }
+
     // Attempt to find an io_src_sizeof function for the named user type.
     size_func_name = "io_src_sizeof_" + user_type_name ;
     for ( ii = 0 ; ii < dlhandles.size() && size_func == NULL ; ii++ ) {
@@ -81,7 +95,7 @@ int Trick::MemoryManager::add_attr_info( const std::string & user_type_string ,
 
     // Attempt to find an attributes list for the named user type.
     sub_attr_name = "attr" + user_type_name ;
-    for ( ii = 0 ; ii < dlhandles.size() && sub_attr == NULL ; ii++ ) {
+    for ( ii = 0 ; ii < dlhandles.size() && sub_attr == NULL && enum_attr == NULL ; ii++ ) {
         sub_attr      = (ATTRIBUTES *)dlsym( dlhandles[ii] , sub_attr_name.c_str()) ;
     }
 
@@ -1,4 +1,5 @@
 #include "trick/MemoryManager.hh"
+#include "trick/RefCache.hh"
 #include <sstream>
 #include <string.h>
 
@@ -43,6 +44,7 @@ int Trick::MemoryManager::set_name_at( void* addr , const char * name ) {
             ret = -1 ;
         } else {
             variable_map[name] = pos->second ;
+            ref_cache->invalidate();
         }
         pthread_mutex_unlock(&mm_mutex);
     } else {
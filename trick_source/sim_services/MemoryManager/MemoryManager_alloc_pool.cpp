@@ -0,0 +1,43 @@
+#include <stdlib.h>
+#include "trick/MemoryManager.hh"
+#include "trick/MemoryPool.hh"
+
+void Trick::MemoryManager::set_pool_allocation( bool on_off ) {
+    use_alloc_pool = on_off ;
+    if ( on_off ) {
+        alloc_pool_used = true ;
+    }
+}
+
+bool Trick::MemoryManager::get_pool_allocation() {
+    return use_alloc_pool ;
+}
+
+void* Trick::MemoryManager::allocate_memory( size_t n_elems, size_t size) {
+
+    void* address = NULL ;
+
+    if ( use_alloc_pool ) {
+        address = alloc_pool->allocate( n_elems * size ) ;
+    }
+    if ( address == NULL ) {
+        address = calloc( n_elems, size ) ;
+    }
+    return address ;
+}
+
+void Trick::MemoryManager::free_memory( void* address) {
+
+    // Memory can only be in the pool if the pool was ever turned on, skip the pool lock and search otherwise.
+    if ( ! alloc_pool_used or ! alloc_pool->deallocate( address ) ) {
+        free( address ) ;
+    }
+}
+
+ALLOC_INFO* Trick::MemoryManager::allocate_alloc_info() {
+    return (ALLOC_INFO*)allocate_memory( 1, sizeof(ALLOC_INFO) ) ;
+}
+
+void Trick::MemoryManager::free_alloc_info( ALLOC_INFO* alloc_info) {
+    free_memory( alloc_info ) ;
+}
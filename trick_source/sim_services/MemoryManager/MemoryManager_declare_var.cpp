@@ -5,6 +5,7 @@
 #include <dlfcn.h>
 #include <string.h>
 #include "trick/MemoryManager.hh"
+#include "trick/RefCache.hh"
 #include "trick/ADefParseContext.hh"
 
 /**
@@ -46,7 +47,7 @@ void* Trick::MemoryManager::declare_var( TRICK_TYPE type,
     char* allocation_name;
     int n_elems;
     Language language;
-    TRICK_ALLOC_TYPE allocation_type;
+    TRICK_ALLOC_TYPE allocation_type = TRICK_ALLOC_MALLOC;
     void* address;
     ATTRIBUTES* sub_attr;
     ALLOC_INFO *new_alloc;
@@ -143,7 +144,7 @@ void* Trick::MemoryManager::declare_var( TRICK_TYPE type,
         }
         language = Language_CPP;
     } else {
-        if ( (address = calloc( (size_t)n_elems, (size_t)size ) ) == NULL) {
+        if ( (address = allocate_memory( (size_t)n_elems, (size_t)size ) ) == NULL) {
             emitError("Out of memory.") ;
             return ((void*)NULL);
         }
@@ -151,7 +152,7 @@ void* Trick::MemoryManager::declare_var( TRICK_TYPE type,
     }
 
     /** @li Allocate and populate an ALLOC_INFO record for the allocation. */
-    if ((new_alloc = (ALLOC_INFO*)calloc(1, sizeof(ALLOC_INFO))) != NULL) {
+    if ((new_alloc = allocate_alloc_info()) != NULL) {
 
         new_alloc->start = address;
         new_alloc->end = ( (char*)new_alloc->start) + (n_elems * size) - 1;
@@ -191,6 +192,7 @@ void* Trick::MemoryManager::declare_var( TRICK_TYPE type,
             key-value pair into the variable map.*/
         if (new_alloc->name) {
             variable_map[new_alloc->name] = new_alloc;
+            ref_cache->invalidate();
         }
         pthread_mutex_unlock(&mm_mutex);
     } else {
@@ -341,7 +343,7 @@ void* Trick::MemoryManager::declare_operatornew_var( std::string user_type_name,
     aligned = alloc_size % element_size ;
 
     /** @li Allocate and populate an ALLOC_INFO record for the allocation. */
-    if ((new_alloc = (ALLOC_INFO*)calloc(1, sizeof(ALLOC_INFO))) != NULL) {
+    if ((new_alloc = allocate_alloc_info()) != NULL) {
 
         new_alloc->start = (char *)address + aligned ;
         new_alloc->end = ( (char*)new_alloc->start) + alloc_size - 1 - aligned ;
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <dlfcn.h>
 #include "trick/MemoryManager.hh"
+#include "trick/RefCache.hh"
 
 // MEMBER FUNCTION
 int Trick::MemoryManager::delete_var(void* address ) {
@@ -50,7 +51,7 @@ int Trick::MemoryManager::delete_var(void* address ) {
 		// delete that same address.
 		deleted_addr_list.push_back(address);
 
-                free( address);
+                free_memory( address);
             } else if ( alloc_info->alloc_type == TRICK_ALLOC_NEW ) {
                 io_src_delete_class( alloc_info );
             }
@@ -64,6 +65,7 @@ int Trick::MemoryManager::delete_var(void* address ) {
         if (alloc_info->name ) {
             pthread_mutex_lock(&mm_mutex);
             variable_map.erase( alloc_info->name);
+            ref_cache->invalidate();
             pthread_mutex_unlock(&mm_mutex);
             free(alloc_info->name);
         }
@@ -73,7 +75,7 @@ int Trick::MemoryManager::delete_var(void* address ) {
         }
 
         // Delete the alloc_info record.
-        free(alloc_info);
+        free_alloc_info(alloc_info);
 
     } else {
 
@@ -5,6 +5,7 @@
 // Provides dlsym().
 #include <string.h>
 #include "trick/MemoryManager.hh"
+#include "trick/IOSrcTypeRegistry.hh"
 
 // MEMBER FUNCTION: void* Trick::MemoryManager::io_src_allocate_class(const char* class_name, int num);
 
@@ -18,7 +19,7 @@
  * - This requires that the io_src code be linked into the executable.
  * - Then given the name of the class, we can prepend the string "io_src_allocate_"
  * to form the name of the function.
- * - Then we look up the address of the function by name, using dlsym().
+ * - Then we look up the address of the function in the IOSrcTypeRegistry, or failing that by name, using dlsym().
  * - If we find it, then we call it and return the address of the allocation.
  * - Otherwise we whine that we couldn't find it and return NULL.
  */
@@ -39,6 +40,11 @@ void* Trick::MemoryManager::io_src_allocate_class(const char* class_name, int nu
         }
     }
 
+    const IO_SRC_TYPE_INFO * type_info = IOSrcTypeRegistry::registry()->get_type(&alloc_fn_name[sizeof("io_src_allocate_") - 1]) ;
+    if ( type_info != NULL ) {
+        construct = type_info->allocate_func ;
+    }
+
     for ( ii = 0 ; ii < dlhandles.size() && construct == NULL ; ii++ ) {
         construct = (void*(*)(int)) dlsym( dlhandles[ii], alloc_fn_name);
     }
@@ -59,7 +65,7 @@ void* Trick::MemoryManager::io_src_allocate_class(const char* class_name, int nu
 void Trick::MemoryManager::io_src_destruct_class(ALLOC_INFO * alloc_info) {
 
     char destruct_fn_name[512];
-    void* (*destruct)(void*, int) = NULL ;
+    void (*destruct)(void*, int) = NULL ;
 
     if ( (alloc_info->type == TRICK_STRUCTURED) &&
         (alloc_info->language == Language_CPP) &&
@@ -75,8 +81,13 @@ void Trick::MemoryManager::io_src_destruct_class(ALLOC_INFO * alloc_info) {
             }
         }
 
+        const IO_SRC_TYPE_INFO * type_info = IOSrcTypeRegistry::registry()->get_type(&destruct_fn_name[sizeof("io_src_destruct_") - 1]) ;
+        if ( type_info != NULL ) {
+            destruct = type_info->destruct_func ;
+        }
+
         for (size_t  ii = 0 ; ii < dlhandles.size() && destruct == NULL ; ii++ ) {
-            destruct = (void*(*)(void*,int)) dlsym( dlhandles[ii], destruct_fn_name);
+            destruct = (void(*)(void*,int)) dlsym( dlhandles[ii], destruct_fn_name);
         }
         if ( destruct != NULL) {
             (*destruct)(alloc_info->start, alloc_info->num) ;
@@ -93,7 +104,7 @@ void Trick::MemoryManager::io_src_destruct_class(ALLOC_INFO * alloc_info) {
 // MEMBER FUNCTION: void Trick::MemoryManager::io_src_delete_class(ALLOC_INFO * alloc_info);
 void Trick::MemoryManager::io_src_delete_class(ALLOC_INFO * alloc_info) {
     char delete_fn_name[512];
-    void* (*delete_fn)(void*) = NULL ;
+    void (*delete_fn)(void*) = NULL ;
 
     if ( (alloc_info->type == TRICK_STRUCTURED) &&
         (alloc_info->language == Language_CPP) &&
@@ -109,8 +120,13 @@ void Trick::MemoryManager::io_src_delete_class(ALLOC_INFO * alloc_info) {
             }
         }
 
+        const IO_SRC_TYPE_INFO * type_info = IOSrcTypeRegistry::registry()->get_type(&delete_fn_name[sizeof("io_src_delete_") - 1]) ;
+        if ( type_info != NULL ) {
+            delete_fn = type_info->delete_func ;
+        }
+
         for (size_t  ii = 0 ; ii < dlhandles.size() && delete_fn == NULL ; ii++ ) {
-            delete_fn = (void*(*)(void*)) dlsym( dlhandles[ii], delete_fn_name);
+            delete_fn = (void(*)(void*)) dlsym( dlhandles[ii], delete_fn_name);
         }
         if ( delete_fn != NULL) {
             (*delete_fn)(alloc_info->start) ;
@@ -148,6 +164,11 @@ size_t Trick::MemoryManager::io_src_sizeof_user_type( const char* user_type_name
         }
     }
 
+    const IO_SRC_TYPE_INFO * type_info = IOSrcTypeRegistry::registry()->get_type(&size_fn_name[sizeof("io_src_sizeof_") - 1]) ;
+    if ( type_info != NULL ) {
+        size_fn = type_info->sizeof_func ;
+    }
+
     for ( ii = 0 ; ii < dlhandles.size() && size_fn == NULL ; ii++ ) {
         size_fn = (size_t (*)(void)) dlsym( dlhandles[ii], size_fn_name);
     }
@@ -3,6 +3,7 @@
 #include <string.h>
 
 #include "trick/MemoryManager.hh"
+#include "trick/RefCache.hh"
 #include "trick/ADefParseContext.hh"
 
 /**
@@ -84,7 +85,7 @@ void* Trick::MemoryManager::
     /** @li Allocate and populate an ALLOC_INFO record for the external allocation
         (the thingy pointed to by @b address).
      */
-    if ((new_alloc = (ALLOC_INFO*)calloc(1, sizeof(ALLOC_INFO))) != NULL) {
+    if ((new_alloc = allocate_alloc_info()) != NULL) {
 
         new_alloc->start = (void *) address;
         new_alloc->end = ((char*)new_alloc->start) + (n_elems * size) - 1;
@@ -127,6 +128,7 @@ void* Trick::MemoryManager::
         /** @li Insert the <variable-name, ALLOC_INFO> key-value pair into the variable map. */
         if (new_alloc->name) {
             variable_map[new_alloc->name] = new_alloc;
+            ref_cache->invalidate();
         }
         pthread_mutex_unlock(&mm_mutex);
     } else {
@@ -1,4 +1,5 @@
 #include "trick/MemoryManager.hh"
+#include "trick/RefCache.hh"
 #include <dlfcn.h>
 #include <stdlib.h>
 #include <sstream>
@@ -145,7 +146,7 @@ void* Trick::MemoryManager::resize_array( void *address, int n_cdims, int *cdims
             return ((void*)NULL);
         }
     } else {
-        if ( (new_address = calloc( (size_t)new_n_elems, (size_t)alloc_info->size ) ) == NULL) {
+        if ( (new_address = allocate_memory( (size_t)new_n_elems, (size_t)alloc_info->size ) ) == NULL) {
             emitError("Out of memory.") ;
             pthread_mutex_unlock(&mm_mutex);
             return ((void*)NULL);
@@ -161,7 +162,7 @@ void* Trick::MemoryManager::resize_array( void *address, int n_cdims, int *cdims
                 n_cdims);
 
     /** @li Delete the previous memory allocation. */
-    free( address);
+    free_memory( address);
 
     // Remove the old <address, ALLOC_INFO*> key-value pair from the alloc_info_map.
     alloc_info_map.erase( address);
@@ -177,6 +178,9 @@ void* Trick::MemoryManager::resize_array( void *address, int n_cdims, int *cdims
 
     /** @li Insert the new <address, ALLOC_INFO> key-value pair into the alloc_info_map.*/
     alloc_info_map[alloc_info->start] = alloc_info;
+
+    /** @li Cached references into the previous array are no longer valid. */
+    ref_cache->invalidate();
     pthread_mutex_unlock(&mm_mutex);
 
     /** @li If debug is enabled, show what happened.*/
@@ -1,13 +1,166 @@
-
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <ctype.h>
 #include <sstream>
+#include <vector>
 #include "trick/MemoryManager.hh"
 #include "trick/RefParseContext.hh"
+#include "trick/RefCache.hh"
+#include "trick/memorymanager_c_intf.h"
 
 extern int REF_debug;
 
+namespace {
+
+    /* One "name", ".name" or "[index]" element of a simple reference. */
+    struct RefStep {
+        bool is_index ;
+        std::string name ;
+        int index ;
+        size_t end ;      /* length of the reference prefix ending with this step */
+    } ;
+
+    /* Splits name into steps. Returns false if name uses syntax that only the reference parser handles. */
+    bool split_simple_reference( const char * name , std::vector<RefStep> & steps ) {
+
+        const char * p = name ;
+        bool expect_name = true ;
+
+        while ( true ) {
+            RefStep step ;
+            if ( expect_name ) {
+                if ( ! (isalpha(*p) or *p == '_') ) {
+                    return false ;
+                }
+                const char * start = p ;
+                while ( isalnum(*p) or *p == '_' or *p == ':' ) {
+                    p++ ;
+                }
+                step.is_index = false ;
+                step.name.assign(start, p - start) ;
+                step.index = 0 ;
+                expect_name = false ;
+            } else if ( *p == '[' ) {
+                p++ ;
+                const char * start = p ;
+                while ( isdigit(*p) ) {
+                    p++ ;
+                }
+                // Hexadecimal, negative and overly long indexes go to the parser.
+                if ( p == start or (p - start) > 9 or *p != ']' ) {
+                    return false ;
+                }
+                step.is_index = true ;
+                step.index = atoi(start) ;
+                p++ ;
+            } else {
+                return false ;
+            }
+            step.end = p - name ;
+            steps.push_back(step) ;
+
+            if ( *p == '\0' ) {
+                return true ;
+            } else if ( *p == '.' ) {
+                p++ ;
+                expect_name = true ;
+            }
+        }
+    }
+
+    void free_partial_ref( REF2 * R ) {
+        ref_free(R) ;
+        if ( R->ref_attr ) {
+            free(R->ref_attr) ;
+        }
+    }
+}
+
+bool Trick::MemoryManager::simple_ref_attributes(const char* name, REF2** result) {
+
+    std::vector<RefStep> steps ;
+    REF2 ref ;
+    size_t ii , first_step = 0 ;
+    int ret ;
+
+    *result = NULL ;
+    if ( ! split_simple_reference(name, steps) ) {
+        return false ;
+    }
+
+    unsigned int generation = ref_cache->get_generation() ;
+    std::string full_name(name) ;
+
+    /* Start from the longest cached prefix of the reference. */
+    for ( ii = steps.size() ; ii > 0 ; ii-- ) {
+        if ( ref_cache->get(full_name.substr(0, steps[ii-1].end), &ref) ) {
+            first_step = ii ;
+            break ;
+        }
+    }
+
+    /* The reference string used in error messages omits indexes, as in the reference parser. */
+    std::string ref_string ;
+    for ( ii = 0 ; ii < first_step ; ii++ ) {
+        if ( ! steps[ii].is_index ) {
+            ref_string += (ii == 0) ? steps[ii].name : "." + steps[ii].name ;
+        }
+    }
+
+    if ( first_step == 0 ) {
+        memset(&ref, 0, sizeof(REF2)) ;
+        ref.ref_type = REF_ADDRESS ;
+        ref.create_add_path = 1 ;
+        ref.address_path = DLL_Create() ;
+
+        if ( ref_var(&ref, const_cast<char *>(steps[0].name.c_str())) != MM_OK ) {
+            free_partial_ref(&ref) ;
+            return true ;
+        }
+        ref.num_index_left = ref.attr->num_index ;
+        ref_string = steps[0].name ;
+        ref_cache->put(full_name.substr(0, steps[0].end), &ref, generation) ;
+        first_step = 1 ;
+    }
+    ref.reference = strdup(ref_string.c_str()) ;
+
+    for ( ii = first_step ; ii < steps.size() ; ii++ ) {
+        if ( steps[ii].is_index ) {
+            V_DATA v_data ;
+            v_data.type = TRICK_INTEGER ;
+            v_data.value.i = steps[ii].index ;
+            ret = ref_dim(&ref, &v_data) ;
+        } else {
+            /* Check to see if previous parameter specified enough dimensions. */
+            if (ref.num_index != ref.attr->num_index) {
+                emitError("Dimension mismatch.");
+                ret = MM_PARAMETER_ARRAY_DIM ;
+            } else {
+                ref.num_index = 0;
+                ret = ref_name(&ref, const_cast<char *>(steps[ii].name.c_str())) ;
+                if ( ret == MM_OK ) {
+                    ref.num_index_left = ref.attr->num_index;
+                    ref_string += "." + steps[ii].name ;
+                    free(ref.reference) ;
+                    ref.reference = strdup(ref_string.c_str()) ;
+                }
+            }
+        }
+        if ( ret != MM_OK ) {
+            free_partial_ref(&ref) ;
+            return true ;
+        }
+        ref_cache->put(full_name.substr(0, steps[ii].end), &ref, generation) ;
+    }
+
+    free(ref.reference) ;
+    ref.reference = strdup(name) ;
+    *result = (REF2 *)malloc(sizeof(REF2)) ;
+    memcpy(*result, &ref, sizeof(REF2)) ;
+    return true ;
+}
+
 REF2 *Trick::MemoryManager::ref_attributes(const char* name) {
 
     std::stringstream reference_sstream;
@@ -15,11 +168,16 @@ REF2 *Trick::MemoryManager::ref_attributes(const char* name) {
     RefParseContext* context = NULL;
 
     /** @par Design Details: */
+    /** @li Resolve simple dotted/indexed names directly, using the reference cache. */
+    if ( simple_ref_attributes(name, &result) ) {
+        return ( result);
+    }
+
     reference_sstream << name;
 
     REF_debug = 0;
 
-    /** @li Create a parse context. */
+    /** @li Otherwise, create a parse context. */
     context = new RefParseContext(this, &reference_sstream);
 
     /** @li Call REF_parse to parse the variable reference. */
@@ -41,3 +199,6 @@ REF2 *Trick::MemoryManager::ref_attributes(const char* name) {
     return ( result);
 }
 
+void Trick::MemoryManager::set_ref_cache_size( unsigned int num_entries ) {
+    ref_cache->set_capacity(num_entries) ;
+}
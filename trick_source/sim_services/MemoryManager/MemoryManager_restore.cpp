@@ -5,6 +5,7 @@
 #include <fstream>
 
 #include "trick/MemoryManager.hh"
+#include "trick/RefCache.hh"
 #include "trick/ClassicCheckPointAgent.hh"
 
 int Trick::MemoryManager::set_restore_stls_default (bool on_off) {
@@ -52,6 +53,7 @@ int Trick::MemoryManager::read_checkpoint( std::istream *is, bool do_restore_stl
 
                 // 1) Unregister the associated variable.
                 variable_map.erase( name);
+                ref_cache->invalidate();
 
                 // 2) free the name
                 free( alloc_info->name);
@@ -0,0 +1,126 @@
+/*
+   PURPOSE: (Size class arenas for small MemoryManager allocations.)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <functional>
+
+#include "trick/MemoryPool.hh"
+
+Trick::MemoryPool::MemoryPool() {
+    for ( unsigned int ii = 0 ; ii < num_size_classes ; ii++ ) {
+        free_lists[ii] = NULL ;
+        next_block[ii] = NULL ;
+        chunk_end[ii] = NULL ;
+    }
+    pthread_mutex_init(&mutex, NULL) ;
+}
+
+Trick::MemoryPool::~MemoryPool() {
+    for ( size_t ii = 0 ; ii < chunks.size() ; ii++ ) {
+        free(chunks[ii].start) ;
+    }
+    pthread_mutex_destroy(&mutex) ;
+}
+
+size_t Trick::MemoryPool::get_max_block_size() const {
+    return min_block_size << (num_size_classes - 1) ;
+}
+
+size_t Trick::MemoryPool::get_reserved_bytes() {
+    pthread_mutex_lock(&mutex) ;
+    size_t ret = chunks.size() * chunk_size ;
+    pthread_mutex_unlock(&mutex) ;
+    return ret ;
+}
+
+long Trick::MemoryPool::find_chunk( void * address ) {
+    std::less<void *> below ;
+    long low = 0 ;
+    long high = (long)chunks.size() - 1 ;
+    while ( low <= high ) {
+        long mid = (low + high) / 2 ;
+        if ( below(address, chunks[mid].start) ) {
+            high = mid - 1 ;
+        } else if ( below(address, chunks[mid].end) ) {
+            return mid ;
+        } else {
+            low = mid + 1 ;
+        }
+    }
+    return -1 ;
+}
+
+bool Trick::MemoryPool::add_chunk( unsigned int size_class ) {
+    Chunk chunk ;
+    if ( (chunk.start = (char *)malloc(chunk_size)) == NULL ) {
+        return false ;
+    }
+    chunk.end = chunk.start + chunk_size ;
+    chunk.size_class = size_class ;
+
+    std::vector< Chunk >::iterator it = chunks.begin() ;
+    while ( it != chunks.end() and std::less<void *>()(it->start, chunk.start) ) {
+        ++it ;
+    }
+    chunks.insert(it, chunk) ;
+
+    next_block[size_class] = chunk.start ;
+    chunk_end[size_class] = chunk.end ;
+    return true ;
+}
+
+void * Trick::MemoryPool::allocate( size_t bytes ) {
+
+    if ( bytes == 0 or bytes > get_max_block_size() ) {
+        return NULL ;
+    }
+
+    unsigned int size_class = 0 ;
+    size_t block_size = min_block_size ;
+    while ( block_size < bytes ) {
+        block_size <<= 1 ;
+        size_class++ ;
+    }
+
+    void * block = NULL ;
+    pthread_mutex_lock(&mutex) ;
+    if ( free_lists[size_class] != NULL ) {
+        block = free_lists[size_class] ;
+        free_lists[size_class] = free_lists[size_class]->next ;
+    } else {
+        if ( next_block[size_class] == chunk_end[size_class] and ! add_chunk(size_class) ) {
+            pthread_mutex_unlock(&mutex) ;
+            return NULL ;
+        }
+        block = next_block[size_class] ;
+        next_block[size_class] += block_size ;
+    }
+    pthread_mutex_unlock(&mutex) ;
+
+    memset(block, 0, block_size) ;
+    return block ;
+}
+
+bool Trick::MemoryPool::deallocate( void * address ) {
+
+    pthread_mutex_lock(&mutex) ;
+    long index = find_chunk(address) ;
+    if ( index < 0 ) {
+        pthread_mutex_unlock(&mutex) ;
+        return false ;
+    }
+    FreeBlock * block = (FreeBlock *)address ;
+    block->next = free_lists[chunks[index].size_class] ;
+    free_lists[chunks[index].size_class] = block ;
+    pthread_mutex_unlock(&mutex) ;
+    return true ;
+}
+
+bool Trick::MemoryPool::owns( void * address ) {
+    pthread_mutex_lock(&mutex) ;
+    bool ret = (find_chunk(address) >= 0) ;
+    pthread_mutex_unlock(&mutex) ;
+    return ret ;
+}
@@ -0,0 +1,142 @@
+/*
+   PURPOSE: (Least recently used cache of resolved variable references.)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "trick/RefCache.hh"
+#include "trick/dllist.h"
+#include "trick/memorymanager_c_intf.h"
+
+Trick::RefCache::RefCache( unsigned int in_capacity ) : capacity(in_capacity) , generation(0) {
+    pthread_mutex_init(&mutex, NULL) ;
+}
+
+Trick::RefCache::~RefCache() {
+    pthread_mutex_destroy(&mutex) ;
+}
+
+void Trick::RefCache::set_capacity( unsigned int in_capacity ) {
+    pthread_mutex_lock(&mutex) ;
+    capacity = in_capacity ;
+    evict() ;
+    pthread_mutex_unlock(&mutex) ;
+}
+
+unsigned int Trick::RefCache::get_capacity() {
+    return capacity ;
+}
+
+unsigned int Trick::RefCache::get_size() {
+    pthread_mutex_lock(&mutex) ;
+    unsigned int size = entry_map.size() ;
+    pthread_mutex_unlock(&mutex) ;
+    return size ;
+}
+
+void Trick::RefCache::invalidate() {
+    pthread_mutex_lock(&mutex) ;
+    generation++ ;
+    entries.clear() ;
+    entry_map.clear() ;
+    pthread_mutex_unlock(&mutex) ;
+}
+
+unsigned int Trick::RefCache::get_generation() {
+    pthread_mutex_lock(&mutex) ;
+    unsigned int ret = generation ;
+    pthread_mutex_unlock(&mutex) ;
+    return ret ;
+}
+
+void Trick::RefCache::evict() {
+    while ( entries.size() > capacity ) {
+        entry_map.erase(entries.back().key) ;
+        entries.pop_back() ;
+    }
+}
+
+bool Trick::RefCache::get( const std::string & key , REF2 * R ) {
+
+    if ( capacity == 0 ) {
+        return false ;
+    }
+
+    pthread_mutex_lock(&mutex) ;
+    std::unordered_map< std::string , ENTRY_LIST::iterator >::iterator mit = entry_map.find(key) ;
+    if ( mit == entry_map.end() ) {
+        pthread_mutex_unlock(&mutex) ;
+        return false ;
+    }
+    // Move the entry to the front of the list, marking it most recently used.
+    entries.splice(entries.begin(), entries, mit->second) ;
+    const Entry & entry = *(mit->second) ;
+
+    memset(R, 0, sizeof(REF2)) ;
+    R->ref_type = REF_ADDRESS ;
+    R->num_index = entry.num_index ;
+    R->num_index_left = entry.num_index_left ;
+    R->pointer_present = entry.pointer_present ;
+    R->create_add_path = 1 ;
+    R->address_path = DLL_Create() ;
+    for ( size_t ii = 0 ; ii < entry.address_path.size() ; ii++ ) {
+        ADDRESS_NODE * address_node = new ADDRESS_NODE ;
+        *address_node = entry.address_path[ii] ;
+        DLL_AddTail(address_node , R->address_path) ;
+    }
+    if ( entry.attr_is_ref_attr ) {
+        R->ref_attr = (ATTRIBUTES *)malloc(sizeof(ATTRIBUTES)) ;
+        *(R->ref_attr) = entry.ref_attr ;
+        R->attr = R->ref_attr ;
+    } else {
+        R->attr = entry.attr ;
+    }
+    pthread_mutex_unlock(&mutex) ;
+
+    // Pointers along the path may have changed since the entry was stored.
+    R->address = follow_address_path(R) ;
+    if ( R->address == NULL ) {
+        ref_free(R) ;
+        if ( R->ref_attr ) {
+            free(R->ref_attr) ;
+        }
+        memset(R, 0, sizeof(REF2)) ;
+        return false ;
+    }
+    return true ;
+}
+
+void Trick::RefCache::put( const std::string & key , REF2 * R , unsigned int in_generation ) {
+
+    if ( capacity == 0 or R->address_path == NULL ) {
+        return ;
+    }
+
+    Entry entry ;
+    entry.key = key ;
+    entry.attr_is_ref_attr = (R->attr == R->ref_attr) ;
+    if ( entry.attr_is_ref_attr ) {
+        entry.attr = NULL ;
+        entry.ref_attr = *(R->ref_attr) ;
+    } else {
+        entry.attr = R->attr ;
+        memset(&entry.ref_attr, 0, sizeof(ATTRIBUTES)) ;
+    }
+    entry.num_index = R->num_index ;
+    entry.num_index_left = R->num_index_left ;
+    entry.pointer_present = R->pointer_present ;
+
+    DLLPOS list_pos = DLL_GetHeadPosition(R->address_path) ;
+    while ( list_pos != NULL ) {
+        entry.address_path.push_back(*(ADDRESS_NODE *)DLL_GetNext(&list_pos, R->address_path)) ;
+    }
+
+    pthread_mutex_lock(&mutex) ;
+    if ( in_generation == generation and entry_map.find(key) == entry_map.end() ) {
+        entries.push_front(entry) ;
+        entry_map[key] = entries.begin() ;
+        evict() ;
+    }
+    pthread_mutex_unlock(&mutex) ;
+}
@@ -0,0 +1,181 @@
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <map>
+#include <vector>
+#include <functional>
+#include "trick/AllocInfoMap.hh"
+#include "trick/MemoryPool.hh"
+
+/*
+ Test Fixture.
+ */
+class MM_alloc_pool : public ::testing::Test {
+    protected:
+        ALLOC_INFO records[4096];
+        char data[4096 * 16];
+        MM_alloc_pool() {}
+        ~MM_alloc_pool() {}
+        void SetUp() {
+            memset(records, 0, sizeof(records));
+            for (int ii = 0 ; ii < 4096 ; ii++) {
+                records[ii].start = &data[ii * 16];
+                records[ii].end = &data[ii * 16 + 15];
+            }
+        }
+        void TearDown() {}
+};
+
+/*
+ Compares every lookup of an AllocInfoMap to the std::map it replaces.
+ */
+static void expect_same( Trick::AllocInfoMap & aim, std::map<void*, ALLOC_INFO*, std::greater<void*> > & ref, char * data, int num_bytes ) {
+
+    ASSERT_EQ(ref.size(), aim.size());
+
+    std::map<void*, ALLOC_INFO*, std::greater<void*> >::iterator rit = ref.begin();
+    Trick::AllocInfoMap::iterator ait = aim.begin();
+    for ( ; rit != ref.end() ; ++rit, ++ait) {
+        ASSERT_TRUE(ait != aim.end());
+        EXPECT_EQ(rit->first, ait->first);
+        EXPECT_EQ(rit->second, ait->second);
+    }
+    EXPECT_TRUE(ait == aim.end());
+
+    for (int ii = 0 ; ii < num_bytes ; ii += 5) {
+        void * addr = &data[ii];
+        rit = ref.lower_bound(addr);
+        ait = aim.lower_bound(addr);
+        if ( rit == ref.end() ) {
+            EXPECT_TRUE(ait == aim.end());
+        } else {
+            ASSERT_TRUE(ait != aim.end());
+            EXPECT_EQ(rit->second, ait->second);
+        }
+        EXPECT_EQ(ref.find(addr) == ref.end(), aim.find(addr) == aim.end());
+    }
+}
+
+TEST_F(MM_alloc_pool, MapSemantics) {
+
+    Trick::AllocInfoMap aim;
+    std::map<void*, ALLOC_INFO*, std::greater<void*> > ref;
+
+    EXPECT_TRUE(aim.begin() == aim.end());
+    EXPECT_TRUE(aim.lower_bound(data) == aim.end());
+
+    // Insert out of order, erase, and insert again.
+    for (int ii = 0 ; ii < 4096 ; ii += 2) {
+        aim[records[ii].start] = &records[ii];
+        ref[records[ii].start] = &records[ii];
+    }
+    for (int ii = 4095 ; ii > 0 ; ii -= 2) {
+        aim[records[ii].start] = &records[ii];
+        ref[records[ii].start] = &records[ii];
+    }
+    expect_same(aim, ref, data, sizeof(data));
+
+    for (int ii = 0 ; ii < 4096 ; ii += 3) {
+        EXPECT_EQ((size_t)1, aim.erase(records[ii].start));
+        ref.erase(records[ii].start);
+    }
+    EXPECT_EQ((size_t)0, aim.erase(records[0].start));
+    expect_same(aim, ref, data, sizeof(data));
+
+    for (int ii = 0 ; ii < 4096 ; ii += 6) {
+        aim[records[ii].start] = &records[ii];
+        ref[records[ii].start] = &records[ii];
+    }
+    expect_same(aim, ref, data, sizeof(data));
+
+    // Erase almost everything.
+    for (int ii = 0 ; ii < 4000 ; ii++) {
+        aim.erase(records[ii].start);
+        ref.erase(records[ii].start);
+    }
+    expect_same(aim, ref, data, sizeof(data));
+
+    aim.clear();
+    EXPECT_EQ((size_t)0, aim.size());
+    EXPECT_TRUE(aim.begin() == aim.end());
+}
+
+TEST_F(MM_alloc_pool, InsertBelowExisting) {
+
+    Trick::AllocInfoMap aim;
+    std::map<void*, ALLOC_INFO*, std::greater<void*> > ref;
+
+    // Insert every allocation below all of the others.
+    for (int ii = 4095 ; ii >= 0 ; ii--) {
+        aim[records[ii].start] = &records[ii];
+        ref[records[ii].start] = &records[ii];
+    }
+    expect_same(aim, ref, data, sizeof(data));
+}
+
+TEST_F(MM_alloc_pool, IteratorsSurviveChanges) {
+
+    Trick::AllocInfoMap aim;
+
+    for (int ii = 0 ; ii < 4096 ; ii += 2) {
+        aim[records[ii].start] = &records[ii];
+    }
+
+    // Erase each entry while iterating over it, as destructors calling delete_var may do,
+    // and insert entries below the iterator.
+    std::vector<void *> visited;
+    Trick::AllocInfoMap::iterator it = aim.begin();
+    while ( it != aim.end() ) {
+        void * addr = it->first;
+        visited.push_back(addr);
+        ++it;
+        aim.erase(addr);
+        if ( visited.size() == 100 ) {
+            aim[records[1].start] = &records[1];
+        }
+    }
+    ASSERT_EQ((size_t)2049, visited.size());
+    for (size_t ii = 1 ; ii < visited.size() ; ii++) {
+        EXPECT_TRUE(std::greater<void *>()(visited[ii - 1], visited[ii]));
+    }
+    EXPECT_EQ((size_t)0, aim.size());
+}
+
+TEST_F(MM_alloc_pool, PoolBlocks) {
+
+    Trick::MemoryPool pool;
+
+    EXPECT_TRUE(pool.allocate(0) == NULL);
+    EXPECT_TRUE(pool.allocate(pool.get_max_block_size() + 1) == NULL);
+    EXPECT_FALSE(pool.deallocate(data));
+    EXPECT_FALSE(pool.owns(data));
+
+    std::vector<char *> blocks;
+    for (int ii = 0 ; ii < 5000 ; ii++) {
+        char * block = (char *)pool.allocate(24);
+        ASSERT_TRUE(block != NULL);
+        EXPECT_EQ((size_t)0, (size_t)block % 16);
+        EXPECT_TRUE(pool.owns(block));
+        for (int jj = 0 ; jj < 24 ; jj++) {
+            EXPECT_EQ(0, block[jj]);
+        }
+        memset(block, 0xff, 24);
+        blocks.push_back(block);
+    }
+    EXPECT_GE(pool.get_reserved_bytes(), (size_t)5000 * 32);
+
+    // Freed blocks are reused and zeroed again.
+    EXPECT_TRUE(pool.deallocate(blocks[10]));
+    char * block = (char *)pool.allocate(17);
+    EXPECT_EQ(blocks[10], block);
+    for (int jj = 0 ; jj < 24 ; jj++) {
+        EXPECT_EQ(0, block[jj]);
+    }
+
+    char * big = (char *)pool.allocate(pool.get_max_block_size());
+    ASSERT_TRUE(big != NULL);
+    EXPECT_TRUE(pool.deallocate(big));
+    for (size_t ii = 0 ; ii < blocks.size() ; ii++) {
+        EXPECT_TRUE(pool.deallocate(blocks[ii]));
+    }
+}
@@ -0,0 +1,129 @@
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <pthread.h>
+#include "trick/AttributesIndex.hh"
+
+/*
+ Test Fixture.
+ */
+class MM_attributes_index : public ::testing::Test {
+    protected:
+        ATTRIBUTES attr[5];
+        ATTRIBUTES union_attr[3];
+        MM_attributes_index() {}
+        ~MM_attributes_index() {}
+        void SetUp() {
+            memset(attr, 0, sizeof(attr));
+            // double x ; int arr[4] ; double * ptr ; int x (shadowing) ;
+            set_member(attr[0], "x", 8, 0);
+            set_member(attr[1], "arr", 4, 8);
+            attr[1].num_index = 1;
+            attr[1].index[0].size = 4;
+            set_member(attr[2], "ptr", 8, 24);
+            attr[2].num_index = 1;
+            attr[2].index[0].size = 0;
+            set_member(attr[3], "x", 4, 32);
+            set_member(attr[4], "", 0, 0);
+
+            memset(union_attr, 0, sizeof(union_attr));
+            set_member(union_attr[0], "d", 8, 0);
+            set_member(union_attr[1], "i", 4, 0);
+            set_member(union_attr[2], "", 0, 0);
+        }
+        void TearDown() {
+            Trick::AttributesIndex::remove_index(attr);
+            Trick::AttributesIndex::remove_index(union_attr);
+        }
+        void set_member(ATTRIBUTES & a, const char * name, int size, long offset) {
+            a.name = name;
+            a.size = size;
+            a.offset = offset;
+        }
+};
+
+/* ================================================================================
+                                      Test Cases
+   ================================================================================
+*/
+
+TEST_F(MM_attributes_index, find_name) {
+    Trick::AttributesIndex * index = Trick::AttributesIndex::get_index(attr);
+    ASSERT_TRUE(index != NULL);
+    EXPECT_EQ(&attr[1], index->find_name("arr"));
+    EXPECT_EQ(&attr[2], index->find_name("ptr"));
+    // The first declaration of a duplicated name is found, same as a linear search.
+    EXPECT_EQ(&attr[0], index->find_name("x"));
+    EXPECT_TRUE(index->find_name("not_a_member") == NULL);
+}
+
+TEST_F(MM_attributes_index, same_index_returned) {
+    EXPECT_EQ(Trick::AttributesIndex::get_index(attr), Trick::AttributesIndex::get_index(attr));
+    EXPECT_TRUE(Trick::AttributesIndex::get_index(NULL) == NULL);
+}
+
+TEST_F(MM_attributes_index, find_offset) {
+    Trick::AttributesIndex * index = Trick::AttributesIndex::get_index(attr);
+    EXPECT_EQ(&attr[0], index->find_offset(0));
+    EXPECT_EQ(&attr[0], index->find_offset(7));
+    EXPECT_EQ(&attr[1], index->find_offset(8));
+    EXPECT_EQ(&attr[1], index->find_offset(23));
+    EXPECT_EQ(&attr[2], index->find_offset(24));
+    EXPECT_EQ(&attr[3], index->find_offset(35));
+    // Offsets not covered by any member return the terminating entry.
+    EXPECT_EQ(&attr[4], index->find_offset(36));
+    EXPECT_EQ(&attr[4], index->find_offset(-1));
+}
+
+TEST_F(MM_attributes_index, find_offset_overlapping) {
+    Trick::AttributesIndex * index = Trick::AttributesIndex::get_index(union_attr);
+    EXPECT_EQ(&union_attr[0], index->find_offset(0));
+    EXPECT_EQ(&union_attr[0], index->find_offset(6));
+    EXPECT_EQ(&union_attr[2], index->find_offset(8));
+}
+
+TEST_F(MM_attributes_index, member_size) {
+    EXPECT_EQ(8, Trick::AttributesIndex::member_size(&attr[0]));
+    EXPECT_EQ(16, Trick::AttributesIndex::member_size(&attr[1]));
+    EXPECT_EQ((int)sizeof(void*), Trick::AttributesIndex::member_size(&attr[2]));
+}
+
+TEST_F(MM_attributes_index, array_replaced_at_same_address) {
+    Trick::AttributesIndex * index = Trick::AttributesIndex::get_index(attr);
+    EXPECT_EQ(&attr[1], index->find_name("arr"));
+    // A different array is placed where the indexed one was, as when an array is freed and its memory reused.
+    set_member(attr[0], "y", 8, 0);
+    set_member(attr[1], "vec", 4, 8);
+    index = Trick::AttributesIndex::get_index(attr);
+    EXPECT_EQ(&attr[0], index->find_name("y"));
+    EXPECT_EQ(&attr[1], index->find_name("vec"));
+    EXPECT_TRUE(index->find_name("arr") == NULL);
+}
+
+TEST_F(MM_attributes_index, removed_index_still_readable) {
+    Trick::AttributesIndex * index = Trick::AttributesIndex::get_index(attr);
+    Trick::AttributesIndex::remove_index(attr);
+    // A reader that got the index before it was removed can still use it.
+    EXPECT_EQ(&attr[1], index->find_name("arr"));
+    EXPECT_EQ(&attr[2], index->find_offset(24));
+    // The next lookup builds a new index.
+    EXPECT_EQ(&attr[1], Trick::AttributesIndex::get_index(attr)->find_name("arr"));
+}
+
+static void * get_index_thread( void * arg ) {
+    return Trick::AttributesIndex::get_index((ATTRIBUTES *)arg);
+}
+
+TEST_F(MM_attributes_index, concurrent_get_index) {
+    pthread_t threads[8];
+    void * indexes[8];
+    for ( int ii = 0 ; ii < 8 ; ii++ ) {
+        pthread_create(&threads[ii], NULL, get_index_thread, attr);
+    }
+    for ( int ii = 0 ; ii < 8 ; ii++ ) {
+        pthread_join(threads[ii], &indexes[ii]);
+    }
+    for ( int ii = 0 ; ii < 8 ; ii++ ) {
+        EXPECT_EQ(Trick::AttributesIndex::get_index(attr), indexes[ii]);
+    }
+}
@@ -298,3 +298,27 @@ TEST_F(MM_declare_var, UserDefinedTwoDimArray) {
         int extents[8] = {3,4,0,0,0,0,0,0};
         validate_alloc_info_local(memmgr, test_var, TRICK_STRUCTURED, "UDT1", NULL, 12, 2, extents);
 }
+
+// Pooled allocation
+
+TEST_F(MM_declare_var, PooledAllocation) {
+        memmgr->set_pool_allocation(true);
+        EXPECT_TRUE(memmgr->get_pool_allocation());
+
+        double *test_var = (double *)memmgr->declare_var("double pooled_dbl[3]");
+        int extents[8] = {3,0,0,0,0,0,0,0};
+        validate_alloc_info_local(memmgr, test_var, TRICK_DOUBLE, NULL, "pooled_dbl", 3, 1, extents);
+        EXPECT_EQ(memmgr->get_alloc_info_of(&test_var[2]), memmgr->get_alloc_info_at(test_var));
+
+        // Resizing and deleting work the same whether the memory came from the pool or not.
+        test_var = (double *)memmgr->resize_array(test_var, 100000);
+        extents[0] = 100000;
+        validate_alloc_info_local(memmgr, test_var, TRICK_DOUBLE, NULL, "pooled_dbl", 100000, 1, extents);
+        EXPECT_EQ(0, memmgr->delete_var(test_var));
+        EXPECT_TRUE(memmgr->get_alloc_info_of(test_var) == NULL);
+
+        memmgr->set_pool_allocation(false);
+        int *int_var = (int *)memmgr->declare_var("int[4]");
+        extents[0] = 4;
+        validate_alloc_info_local(memmgr, int_var, TRICK_INTEGER, NULL, NULL, 4, 1, extents);
+}
@@ -0,0 +1,106 @@
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include "trick/MemoryManager.hh"
+#include "trick/IOSrcTypeRegistry.hh"
+
+/*
+ Hand written io_src code for two types. RegType is only in the registry, DlsymType is only
+ found with dlsym, as a type from a library loaded at runtime would be.
+ */
+static int reg_init_calls = 0 ;
+static ATTRIBUTES attrRegType[2] ;
+static size_t reg_sizeof() { return 24 ; }
+static void reg_init_attr() { reg_init_calls++ ; }
+
+static ENUM_ATTR enumRegEnum[] = { { "RED", 0, 0x0 }, { "", 0, 0x0 } } ;
+static size_t reg_enum_sizeof() { return sizeof(int) ; }
+
+extern "C" {
+    int dlsym_init_calls = 0 ;
+    ATTRIBUTES attrDlsymType[2] ;
+    size_t io_src_sizeof_DlsymType() { return 40 ; }
+    void init_attrDlsymType_c_intf() { dlsym_init_calls++ ; }
+}
+
+class MM_io_src_type_registry : public ::testing::Test {
+    protected:
+        Trick::MemoryManager * memmgr ;
+        MM_io_src_type_registry() {
+            try {
+                memmgr = new Trick::MemoryManager ;
+            } catch (std::logic_error e) {
+                memmgr = NULL ;
+            }
+        }
+        ~MM_io_src_type_registry() {
+            delete memmgr ;
+        }
+        void SetUp() {
+            memset(attrRegType, 0, sizeof(attrRegType)) ;
+            attrRegType[0].name = "" ;
+            memset(attrDlsymType, 0, sizeof(attrDlsymType)) ;
+            attrDlsymType[0].name = "" ;
+            reg_init_calls = 0 ;
+            dlsym_init_calls = 0 ;
+            Trick::IOSrcTypeRegistry::registry()->add_class("RegType", reg_sizeof, attrRegType, reg_init_attr,
+             NULL, NULL, NULL) ;
+            Trick::IOSrcTypeRegistry::registry()->add_enum("RegEnum", reg_enum_sizeof, enumRegEnum) ;
+        }
+        void TearDown() {}
+} ;
+
+/* ================================================================================
+                                      Test Cases
+   ================================================================================
+*/
+
+TEST_F(MM_io_src_type_registry, get_type) {
+    const Trick::IO_SRC_TYPE_INFO * info = Trick::IOSrcTypeRegistry::registry()->get_type("RegType") ;
+    ASSERT_TRUE(info != NULL) ;
+    EXPECT_EQ(attrRegType, info->attr) ;
+    EXPECT_EQ(24u, info->sizeof_func()) ;
+    EXPECT_TRUE(info->enum_attr == NULL) ;
+
+    info = Trick::IOSrcTypeRegistry::registry()->get_type("RegEnum") ;
+    ASSERT_TRUE(info != NULL) ;
+    EXPECT_EQ(enumRegEnum, info->enum_attr) ;
+    EXPECT_TRUE(info->attr == NULL) ;
+
+    EXPECT_TRUE(Trick::IOSrcTypeRegistry::registry()->get_type("DlsymType") == NULL) ;
+}
+
+TEST_F(MM_io_src_type_registry, add_attr_info_from_registry) {
+    ATTRIBUTES attr ;
+    memset(&attr, 0, sizeof(attr)) ;
+    EXPECT_EQ(0, memmgr->add_attr_info("RegType", &attr)) ;
+    EXPECT_EQ(TRICK_STRUCTURED, attr.type) ;
+    EXPECT_EQ(attrRegType, attr.attr) ;
+    EXPECT_EQ(24, attr.size) ;
+    EXPECT_EQ(1, reg_init_calls) ;
+}
+
+TEST_F(MM_io_src_type_registry, add_attr_info_enum_from_registry) {
+    ATTRIBUTES attr ;
+    memset(&attr, 0, sizeof(attr)) ;
+    EXPECT_EQ(0, memmgr->add_attr_info("RegEnum", &attr)) ;
+    EXPECT_EQ(TRICK_ENUMERATED, attr.type) ;
+    EXPECT_EQ(enumRegEnum, attr.attr) ;
+    EXPECT_EQ((int)sizeof(int), attr.size) ;
+}
+
+TEST_F(MM_io_src_type_registry, add_attr_info_falls_back_to_dlsym) {
+    ATTRIBUTES attr ;
+    memset(&attr, 0, sizeof(attr)) ;
+    EXPECT_EQ(0, memmgr->add_attr_info("DlsymType", &attr)) ;
+    EXPECT_EQ(TRICK_STRUCTURED, attr.type) ;
+    EXPECT_EQ(attrDlsymType, attr.attr) ;
+    EXPECT_EQ(40, attr.size) ;
+    EXPECT_EQ(1, dlsym_init_calls) ;
+    EXPECT_EQ(0, reg_init_calls) ;
+}
+
+TEST_F(MM_io_src_type_registry, io_src_sizeof_user_type) {
+    EXPECT_EQ(24u, memmgr->io_src_sizeof_user_type("RegType")) ;
+    EXPECT_EQ(40u, memmgr->io_src_sizeof_user_type("DlsymType")) ;
+}
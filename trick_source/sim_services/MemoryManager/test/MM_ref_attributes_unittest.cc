@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 #include "MM_test.hh"
 #include "MM_user_defined_types.hh"
+#include "trick/memorymanager_c_intf.h"
 
 
 /*
@@ -188,3 +189,63 @@ TEST_F(MM_ref_attributes, FailureCases) {
 
 
 }
+
+TEST_F(MM_ref_attributes, CachedReferences) {
+    REF2 *ref;
+    UDT1  udt1, other_udt1;
+    UDT3  udt3, other_udt3;
+
+    udt3.udt1_p = &udt1;
+
+    UDT3* udt3_p = (UDT3*)memmgr->declare_extern_var(&udt3, "UDT3 udt3");
+    ASSERT_TRUE(udt3_p != NULL);
+
+    // The second lookup of each name is served by the reference cache.
+    for (int ii = 0 ; ii < 2 ; ii++) {
+        ref = memmgr->ref_attributes("udt3.NA[1].udt1.x");
+        ASSERT_TRUE(ref != NULL);
+        EXPECT_EQ( &udt3.NA[1].udt1.x, ref->address);
+        EXPECT_STREQ( "udt3.NA[1].udt1.x", ref->reference);
+        ref_free(ref);
+        free( ref);
+    }
+
+    // A reference that shares a cached prefix.
+    ref = memmgr->ref_attributes("udt3.NA[1].udt1.y");
+    ASSERT_TRUE(ref != NULL);
+    EXPECT_EQ( &udt3.NA[1].udt1.y, ref->address);
+    ref_free(ref);
+    free( ref);
+
+    // Pointers along a cached path are followed on every lookup.
+    ref = memmgr->ref_attributes("udt3.udt1_p[0].y");
+    ASSERT_TRUE(ref != NULL);
+    EXPECT_EQ( &udt1.y, ref->address);
+    ref_free(ref);
+    free( ref);
+
+    udt3.udt1_p = &other_udt1;
+    ref = memmgr->ref_attributes("udt3.udt1_p[0].y");
+    ASSERT_TRUE(ref != NULL);
+    EXPECT_EQ( &other_udt1.y, ref->address);
+    ref_free(ref);
+    free( ref);
+
+    // Deleting and redeclaring a variable invalidates the cache.
+    memmgr->delete_extern_var("udt3");
+    udt3_p = (UDT3*)memmgr->declare_extern_var(&other_udt3, "UDT3 udt3");
+    ASSERT_TRUE(udt3_p != NULL);
+    ref = memmgr->ref_attributes("udt3.NA[1].udt1.x");
+    ASSERT_TRUE(ref != NULL);
+    EXPECT_EQ( &other_udt3.NA[1].udt1.x, ref->address);
+    ref_free(ref);
+    free( ref);
+
+    // Lookups still work with the cache disabled.
+    memmgr->set_ref_cache_size(0);
+    ref = memmgr->ref_attributes("udt3.M2[2][3]");
+    ASSERT_TRUE(ref != NULL);
+    EXPECT_EQ( &other_udt3.M2[2][3], ref->address);
+    ref_free(ref);
+    free( ref);
+}
@@ -48,7 +48,14 @@ void Trick::MessageCout::update( unsigned int level , std::string header , std::
         } else {
             oss << header << message ;
         }
-        std::cout << oss.str() << std::flush;
+        std::cout << oss.str() ;
+        if ( ! batch_flush ) {
+            std::cout << std::flush ;
+        }
     }
 }
 
+void Trick::MessageCout::flush() {
+    std::cout << std::flush ;
+}
+
@@ -20,12 +20,14 @@ Trick::MessageCustomFile::MessageCustomFile() : _this_level(level_counter++) {
 @details
 -# If enabled and level is this file's level
     -# Write the header and message to the file stream
--# Flush the stream
+-# Flush the stream, unless the publisher is delivering a batch
 */
 void Trick::MessageCustomFile::update( unsigned int level , std::string header, std::string message ) {
     if ( enabled && level == _this_level ) {
         out_stream << header << message ;
-        out_stream.flush() ;
+        if ( ! batch_flush ) {
+            out_stream.flush() ;
+        }
     }
 }
 
@@ -46,10 +46,17 @@ int Trick::MessageCustomManager::open_custom_message_file(std::string file_name,
     */
 void Trick::MessageCustomManager::update( unsigned int level , std::string header , std::string message ) {
     for (auto message_file : _custom_message_files) {
+        message_file->batch_flush = batch_flush;
         message_file->update(level, header, message);
     }
 }
 
+void Trick::MessageCustomManager::flush( ) {
+    for (auto message_file : _custom_message_files) {
+        message_file->flush();
+    }
+}
+
 int Trick::MessageCustomManager::restart( ) {
     for (auto message_file : _custom_message_files) {
         message_file->restart();
@@ -34,17 +34,23 @@ int Trick::MessageFile::set_file_name(std::string in_name) {
 @details
 -# If enabled and level < 100
     -# Write the header and message to the file stream
-    -# Flush the stream
+    -# Flush the stream, unless the publisher is delivering a batch
 */
 void Trick::MessageFile::update( unsigned int level , std::string header, std::string message ) {
 
     if ( enabled && level < 100 ) {
         out_stream << header << message ;
-        out_stream.flush() ;
+        if ( ! batch_flush ) {
+            out_stream.flush() ;
+        }
     }
 
 }
 
+void Trick::MessageFile::flush() {
+    out_stream.flush() ;
+}
+
 /**
 @details
 -# Deletes the current output file
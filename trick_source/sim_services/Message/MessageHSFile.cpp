@@ -18,13 +18,15 @@ Trick::MessageHSFile::MessageHSFile() {
 @details
 -# If enabled and level < 100
     -# Write the header and message to the file stream
-    -# Flush the stream
+    -# Flush the stream, unless the publisher is delivering a batch
 */
 void Trick::MessageHSFile::update( unsigned int level , std::string header, std::string message ) {
 
     if ( enabled && level < 100 ) {
         out_stream << header << message ;
-        out_stream.flush() ;
+        if ( ! batch_flush ) {
+            out_stream.flush() ;
+        }
     }
 
 }
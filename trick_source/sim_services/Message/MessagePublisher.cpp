@@ -6,16 +6,142 @@
 #include <time.h>
 #include <math.h>
 #include <unistd.h>
+#include <string.h>
+#include <ctype.h>
+#include <algorithm>
 
 #include "trick/MessagePublisher.hh"
+#include "trick/MessageAsyncWriter.hh"
 #include "trick/message_proto.h"
+#include "trick/message_type.h"
 #include "trick/exec_proto.h"
 
 #define MAX_MSG_HEADER_SIZE 256
 
+/* length of a MessageRecord that only pads the ring to its end */
+#define MESSAGE_RECORD_PAD 0xffffffff
+
+/* Number of message groups counted at once, a power of 2, and how many slots are searched for a group. */
+#define MESSAGE_LIMIT_SLOTS 256
+#define MESSAGE_LIMIT_PROBES 8
+
+/* Characters of the last suppressed message kept for its report */
+#define MESSAGE_LIMIT_TEXT 160
+
+namespace Trick {
+
+    /** Header of one queued message.  The text follows, and the record is padded to a multiple of 8 bytes. */
+    struct MessageRecord {
+        unsigned long long seq ;
+        long long tics ;
+        long long date ;
+        int level ;
+        unsigned int length ;
+    } ;
+
+    /** A single writer, single reader ring of one thread's messages.  head counts the bytes written and tail
+        the bytes delivered; each is changed only by its own side.  retired is set when the thread exits, after
+        its last message. */
+    struct MessageRing {
+        char * data ;
+        unsigned int mask ;
+        unsigned int head ;
+        unsigned int tail ;
+        bool retired ;
+    } ;
+
+    /** The counts of one message group, the messages of one level and format, in the current rate window. */
+    struct MessageLimitEntry {
+        unsigned long long key ;
+        int level ;
+        long long window_start ;
+        unsigned int published ;
+        unsigned int repeated ;
+        unsigned int limited ;
+        unsigned long long last_hash ;
+        char last_text[MESSAGE_LIMIT_TEXT] ;
+    } ;
+
+}
+
 Trick::MessagePublisher * the_message_publisher ;
 
-Trick::MessagePublisher::MessagePublisher() {
+/* The calling thread's ring, once it has published asynchronously. */
+static __thread Trick::MessageRing * thread_ring = NULL ;
+
+/* Also holds the calling thread's ring, so that the ring is retired when the thread exits. */
+static pthread_key_t ring_key ;
+static pthread_once_t ring_key_once = PTHREAD_ONCE_INIT ;
+
+/* Called when a thread that published asynchronously exits.  Forget its ring, so a message it publishes later
+   gets a new one, and mark the ring retired after the thread's last message.  flush() frees it once it is
+   delivered. */
+static void retire_ring( void * ring ) {
+    thread_ring = NULL ;
+    __atomic_store_n(&((Trick::MessageRing *)ring)->retired, true, __ATOMIC_RELEASE) ;
+}
+
+static void create_ring_key() {
+    pthread_key_create(&ring_key, retire_ring) ;
+}
+
+/* Order in which messages were queued, across all threads. */
+static unsigned long long message_seq = 0 ;
+
+static unsigned int record_size( unsigned int length ) {
+    return (sizeof(Trick::MessageRecord) + length + 7) & ~7u ;
+}
+
+/* FNV-1a hash of length bytes, continued from hash. */
+static unsigned long long hash_bytes( unsigned long long hash , const char * bytes , size_t length ) {
+    size_t ii ;
+    for ( ii = 0 ; ii < length ; ii++ ) {
+        hash = (hash ^ (unsigned char)bytes[ii]) * 1099511628211ULL ;
+    }
+    return hash ;
+}
+
+/* True if the format has text besides its conversions and white space.  A format without, such as "%s\n", says
+   nothing about which message it publishes. */
+static bool format_has_text( const char * format ) {
+    for ( ; *format != '\0' ; format++ ) {
+        if ( *format == '%' ) {
+            if ( format[1] == '%' ) {
+                return true ;
+            }
+            // skip the flags, width, precision and length up to the conversion
+            while ( format[1] != '\0' and strchr("-+ #0123456789.*'hlqLjzt", format[1]) != NULL ) {
+                format++ ;
+            }
+            if ( format[1] != '\0' ) {
+                format++ ;
+            }
+        } else if ( ! isspace((unsigned char)*format) ) {
+            return true ;
+        }
+    }
+    return false ;
+}
+
+static long long monotonic_ns() {
+    struct timespec tp ;
+    clock_gettime(CLOCK_MONOTONIC, &tp) ;
+    return (long long)tp.tv_sec * 1000000000LL + tp.tv_nsec ;
+}
+
+Trick::MessagePublisher::MessagePublisher() :
+ async_writer(NULL) ,
+ last_async_dropped(0) ,
+ level_limits_set(false) ,
+ last_limit_sweep(0) ,
+ async(false) ,
+ async_buffer_size(65536) ,
+ async_period(0.01) ,
+ async_dropped(0) ,
+ rate_limit(0) ,
+ suppress_duplicates(false) ,
+ rate_window(1.0) ,
+ rate_suppressed(0) {
 
     sim_name = " " ;
     the_message_publisher = this ;
@@ -23,10 +149,23 @@ Trick::MessagePublisher::MessagePublisher() {
     tics_per_sec = 1000000 ;
     set_print_format() ;
 
+    // recursive, so a subscriber may publish while a message is delivered to it
+    pthread_mutexattr_t attr ;
+    pthread_mutexattr_init(&attr) ;
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE) ;
+    pthread_mutex_init(&subscribers_mutex, &attr) ;
+    pthread_mutexattr_destroy(&attr) ;
+    pthread_mutex_init(&rings_mutex, NULL) ;
+    pthread_once(&ring_key_once, create_ring_key) ;
+    pthread_mutex_init(&limit_mutex, NULL) ;
+    limit_entries = new Trick::MessageLimitEntry[MESSAGE_LIMIT_SLOTS]() ;
+    (void) gethostname(hostname, (size_t) 48);
+    hostname[48] = '\0' ;
 }
 
 Trick::MessagePublisher::~MessagePublisher() {
     the_message_publisher = NULL;
+    delete[] limit_entries ;
 }
 
 void Trick::MessagePublisher::set_print_format() {
@@ -37,25 +176,54 @@ void Trick::MessagePublisher::set_print_format() {
 int Trick::MessagePublisher::init() {
     tics_per_sec = exec_get_time_tic_value() ;
     set_print_format() ;
+    // async may have been set directly instead of through set_async()
+    if ( async ) {
+        set_async(true) ;
+    }
     return 0 ;
 }
 
+void Trick::MessagePublisher::subscribe(MessageSubscriber *in_ms) {
+    pthread_mutex_lock(&subscribers_mutex) ;
+    subscribers.push_back(in_ms) ;
+    pthread_mutex_unlock(&subscribers_mutex) ;
+}
+
+void Trick::MessagePublisher::unsubscribe(MessageSubscriber *in_ms) {
+    pthread_mutex_lock(&subscribers_mutex) ;
+    subscribers.remove(in_ms) ;
+    pthread_mutex_unlock(&subscribers_mutex) ;
+}
+
 int Trick::MessagePublisher::publish(int level , std::string message) {
 
+    /** @par Design Details: */
+    /** @li In asynchronous mode, queue the message for the background thread. */
+    if ( async ) {
+        enqueue(level, message.c_str(), message.length()) ;
+        return(0) ;
+    }
+
+    /** @li Else deliver it now with the current simulation time and date, holding subscribers_mutex so the
+            subscribers are not changed or flushed by another thread meanwhile. */
+    pthread_mutex_lock(&subscribers_mutex) ;
+    deliver(level, exec_get_time_tics(), time(NULL), message) ;
+    pthread_mutex_unlock(&subscribers_mutex) ;
+    return(0) ;
+}
+
+void Trick::MessagePublisher::deliver(int level, long long tics, time_t date, const std::string & message) {
+
     /** @par Design Details: */
     std::list<Trick::MessageSubscriber *>::iterator p ;
 
     char date_buf[MAX_MSG_HEADER_SIZE];
     char header_buf[MAX_MSG_HEADER_SIZE];
-    char hostname[64];
-    time_t date ;
+    struct tm date_tm ;
     std::string header ;
-    long long tics = exec_get_time_tics() ;
 
     /** @li Create message header with level, date, host, sim name, process id, sim time. */
-    date = time(NULL) ;
-    strftime(date_buf, (size_t) 20, "%Y/%m/%d,%H:%M:%S", localtime(&date));
-    (void) gethostname(hostname, (size_t) 48);
+    strftime(date_buf, (size_t) 20, "%Y/%m/%d,%H:%M:%S", localtime_r(&date, &date_tm));
     snprintf(header_buf, sizeof(header_buf), print_format , level, date_buf, hostname,
             sim_name.c_str(), exec_get_process_id(), tics/tics_per_sec ,
             (long long)((double)(tics % tics_per_sec) * (double)(pow(10 , num_digits)/tics_per_sec)) ) ;
@@ -75,16 +243,490 @@ int Trick::MessagePublisher::publish(int level , std::string message) {
         // multithreaded sims from interleaving header and message elements.
         std::ostringstream oss;
         oss << header << message ;
-        std::cout << oss.str() << std::flush ; } return(0) ;
+        std::cout << oss.str() << std::flush ;
+    }
+}
+
+/**
+@details
+-# The first time a thread publishes asynchronously, allocate its ring and add it to rings.  This is the only lock
+   taken on the publishing side.  The ring is also set in ring_key, whose destructor retires it when the thread
+   exits.
+-# Truncate a message longer than half the ring.
+-# If the record does not fit before the end of the ring, it starts at the beginning, and the space left at the
+   end is skipped.
+-# If the ring does not have room, count the message as dropped.
+-# Otherwise fill in the record, take the next sequence number, and publish the record by advancing head.
+*/
+int Trick::MessagePublisher::enqueue(int level, const char * message, size_t length) {
+
+    Trick::MessageRing * ring = thread_ring ;
+    unsigned int size , need , head , pos , pad ;
+    Trick::MessageRecord * record ;
+
+    if ( ring == NULL ) {
+        size = 1024 ;
+        while ( size < async_buffer_size ) {
+            size <<= 1 ;
+        }
+        ring = new Trick::MessageRing() ;
+        ring->data = new char[size] ;
+        ring->mask = size - 1 ;
+        ring->head = 0 ;
+        ring->tail = 0 ;
+        ring->retired = false ;
+        pthread_mutex_lock(&rings_mutex) ;
+        rings.push_back(ring) ;
+        pthread_mutex_unlock(&rings_mutex) ;
+        pthread_setspecific(ring_key, ring) ;
+        thread_ring = ring ;
+    }
+
+    size = ring->mask + 1 ;
+    if ( length > size / 2 ) {
+        length = size / 2 ;
+    }
+    need = record_size(length) ;
+    head = ring->head ;
+    pos = head & ring->mask ;
+    pad = ( size - pos < need ) ? size - pos : 0 ;
+
+    if ( head + pad + need - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) > size ) {
+        __atomic_fetch_add(&async_dropped, 1, __ATOMIC_RELAXED) ;
+        return(-1) ;
+    }
+    if ( pad >= sizeof(Trick::MessageRecord) ) {
+        ((Trick::MessageRecord *)(ring->data + pos))->length = MESSAGE_RECORD_PAD ;
+    }
+    head += pad ;
+
+    record = (Trick::MessageRecord *)(ring->data + (head & ring->mask)) ;
+    record->tics = exec_get_time_tics() ;
+    record->date = (long long)time(NULL) ;
+    record->level = level ;
+    record->length = (unsigned int)length ;
+    memcpy(record + 1, message, length) ;
+    record->seq = __atomic_fetch_add(&message_seq, 1, __ATOMIC_RELAXED) ;
+    __atomic_store_n(&ring->head, head + need, __ATOMIC_RELEASE) ;
+
+    return(0) ;
+}
+
+/* Skips the padding at the end of a ring.  Returns the record at tail, or NULL if the ring is empty. */
+static Trick::MessageRecord * next_record( Trick::MessageRing * ring , unsigned int & tail , unsigned int head ) {
+    while ( tail != head ) {
+        unsigned int pos = tail & ring->mask ;
+        unsigned int to_end = ring->mask + 1 - pos ;
+        Trick::MessageRecord * record = (Trick::MessageRecord *)(ring->data + pos) ;
+        if ( to_end < sizeof(Trick::MessageRecord) or record->length == MESSAGE_RECORD_PAD ) {
+            tail += to_end ;
+        } else {
+            return record ;
+        }
+    }
+    return NULL ;
+}
+
+/**
+@details
+-# Hold subscribers_mutex, so subscribers are not added or removed during the batch and only one thread
+   flushes at a time.
+-# Copy the list of rings, so threads may add theirs while the messages are delivered.
+-# Repeatedly deliver the queued message with the lowest sequence number among the rings, so messages from
+   different threads keep the order they were published in.  Subscribers are told not to flush each message.
+   Each message's space is given back to its ring as soon as it is delivered.
+-# A ring seen retired before its head was read holds no more messages once delivered.  Remove it from rings and
+   free it.
+-# If messages were dropped since the last flush, deliver a warning saying how many.
+-# Flush each enabled subscriber once.
+-# Before all that, queue the reports of message groups whose rate window has ended, so they are delivered even
+   if the group publishes nothing more.
+*/
+int Trick::MessagePublisher::flush() {
+
+    struct Pending {
+        Trick::MessageRing * ring ;
+        unsigned int tail ;
+        unsigned int head ;
+        Trick::MessageRecord * record ;
+    } ;
+    std::vector< Trick::MessageRing * > curr_rings ;
+    std::vector< bool > retired ;
+    std::vector< Pending > pending ;
+    std::list<Trick::MessageSubscriber *>::iterator p ;
+    unsigned int ii ;
+    unsigned long long curr_dropped ;
+
+    report_ended_windows() ;
+
+    pthread_mutex_lock(&subscribers_mutex) ;
+
+    pthread_mutex_lock(&rings_mutex) ;
+    curr_rings = rings ;
+    pthread_mutex_unlock(&rings_mutex) ;
+
+    for ( ii = 0 ; ii < curr_rings.size() ; ii++ ) {
+        Pending curr ;
+        retired.push_back(__atomic_load_n(&curr_rings[ii]->retired, __ATOMIC_ACQUIRE)) ;
+        curr.ring = curr_rings[ii] ;
+        curr.tail = curr.ring->tail ;
+        curr.head = __atomic_load_n(&curr.ring->head, __ATOMIC_ACQUIRE) ;
+        curr.record = next_record(curr.ring, curr.tail, curr.head) ;
+        if ( curr.record != NULL ) {
+            pending.push_back(curr) ;
+        }
+    }
+
+    for ( p = subscribers.begin() ; p != subscribers.end() ; ++p ) {
+        (*p)->batch_flush = true ;
+    }
+
+    while ( ! pending.empty() ) {
+        unsigned int first = 0 ;
+        for ( ii = 1 ; ii < pending.size() ; ii++ ) {
+            if ( pending[ii].record->seq < pending[first].record->seq ) {
+                first = ii ;
+            }
+        }
+        Pending & curr = pending[first] ;
+        Trick::MessageRecord * record = curr.record ;
+        deliver(record->level, record->tics, (time_t)record->date,
+         std::string((const char *)(record + 1), record->length)) ;
+        curr.tail += record_size(record->length) ;
+        __atomic_store_n(&curr.ring->tail, curr.tail, __ATOMIC_RELEASE) ;
+        curr.record = next_record(curr.ring, curr.tail, curr.head) ;
+        if ( curr.record == NULL ) {
+            __atomic_store_n(&curr.ring->tail, curr.tail, __ATOMIC_RELEASE) ;
+            pending.erase(pending.begin() + first) ;
+        }
+    }
+
+    for ( ii = 0 ; ii < curr_rings.size() ; ii++ ) {
+        if ( retired[ii] ) {
+            pthread_mutex_lock(&rings_mutex) ;
+            rings.erase(std::find(rings.begin(), rings.end(), curr_rings[ii])) ;
+            pthread_mutex_unlock(&rings_mutex) ;
+            delete [] curr_rings[ii]->data ;
+            delete curr_rings[ii] ;
+        }
+    }
+
+    curr_dropped = __atomic_load_n(&async_dropped, __ATOMIC_RELAXED) ;
+    if ( curr_dropped != last_async_dropped ) {
+        char message[256] ;
+        snprintf(message, sizeof(message), "%llu messages were dropped because a message buffer was full.  "
+         "Increase async_buffer_size or decrease async_period.\n", curr_dropped - last_async_dropped) ;
+        last_async_dropped = curr_dropped ;
+        deliver(MSG_WARNING, exec_get_time_tics(), time(NULL), message) ;
+    }
+
+    for ( p = subscribers.begin() ; p != subscribers.end() ; ++p ) {
+        (*p)->batch_flush = false ;
+        if ( (*p)->enabled ) {
+            (*p)->flush() ;
+        }
+    }
+
+    pthread_mutex_unlock(&subscribers_mutex) ;
+    return(0) ;
+}
 
+/**
+@details
+-# Turning asynchronous mode on creates the background thread the first time.
+-# Turning it off delivers the messages already queued.  A message another thread is queueing at that moment is
+   delivered by the next flush().
+*/
+int Trick::MessagePublisher::set_async(bool yes_no) {
+    if ( yes_no ) {
+        if ( async_writer == NULL ) {
+            async_writer = new Trick::MessageAsyncWriter(*this) ;
+            async_writer->create_thread() ;
+        }
+        async = true ;
+    } else if ( async ) {
+        async = false ;
+        flush() ;
+    }
+    return(0) ;
+}
+
+/**
+@details
+-# Look up the rate limit and duplicate suppression of the level.  If neither applies, the message is published.
+   When no limits are set this returns without taking a lock.
+-# Once per rate_window, end the windows of all groups whose window has passed, so a group that stopped
+   publishing still has its suppressed messages reported.
+-# Find the group of the message by the hash of its level and format string.  A format without text of its own
+   is shared by unrelated messages, so the caller is added to the hash, or the text if the caller is not known.  A new group takes a free slot, or
+   if the slots searched are all taken by other groups, the one with the oldest window is ended and its slot reused.
+-# If the window of the group has passed, end it and start a new one.
+-# Suppress the message if duplicates are suppressed and it is identical to the last message of the group, or if
+   the group has published rate_limit messages in this window.  Keep the text of the last suppressed message for
+   the report.
+-# Publish the reports of ended windows after releasing the lock.
+*/
+bool Trick::MessagePublisher::limit(int level, const char * format, const char * message, size_t length,
+ const void * caller) {
+
+    unsigned int max_count = rate_limit ;
+    bool no_duplicates = suppress_duplicates ;
+    std::map< int , unsigned int >::iterator rit ;
+    std::map< int , bool >::iterator dit ;
+    std::vector< std::pair< int , std::string > > reports ;
+    unsigned long long key , text_hash ;
+    unsigned int ii , slot ;
+    long long now , window_ns ;
+    Trick::MessageLimitEntry * entry = NULL ;
+    bool suppress = false ;
+
+    if ( ! level_limits_set and max_count == 0 and ! no_duplicates ) {
+        return false ;
+    }
+
+    now = monotonic_ns() ;
+    window_ns = (long long)(rate_window * 1000000000.0) ;
+
+    pthread_mutex_lock(&limit_mutex) ;
+
+    if ( level_limits_set ) {
+        if ( (rit = level_rate_limit.find(level)) != level_rate_limit.end() ) {
+            max_count = rit->second ;
+        }
+        if ( (dit = level_suppress_duplicates.find(level)) != level_suppress_duplicates.end() ) {
+            no_duplicates = dit->second ;
+        }
+    }
+
+    sweep_limit_windows(now, window_ns, reports) ;
+
+    if ( max_count != 0 or no_duplicates ) {
+        key = hash_bytes(14695981039346656037ULL, (const char *)&level, sizeof(level)) ;
+        if ( format != NULL ) {
+            key = hash_bytes(key, format, strlen(format)) ;
+        }
+        if ( format == NULL or ! format_has_text(format) ) {
+            if ( caller != NULL ) {
+                key = hash_bytes(key, (const char *)&caller, sizeof(caller)) ;
+            } else {
+                key = hash_bytes(key, message, length) ;
+            }
+        }
+        key |= 1 ;
+        for ( ii = 0 ; ii < MESSAGE_LIMIT_PROBES ; ii++ ) {
+            slot = (unsigned int)(key + ii) & (MESSAGE_LIMIT_SLOTS - 1) ;
+            if ( limit_entries[slot].key == key ) {
+                entry = &limit_entries[slot] ;
+                break ;
+            }
+            if ( entry == NULL or ( entry->key != 0 and ( limit_entries[slot].key == 0 or
+                 limit_entries[slot].window_start < entry->window_start ) ) ) {
+                entry = &limit_entries[slot] ;
+            }
+        }
+        if ( entry->key != key ) {
+            if ( entry->key != 0 ) {
+                end_limit_window(*entry, now, reports) ;
+            }
+            entry->key = key ;
+            entry->level = level ;
+            entry->window_start = now ;
+            entry->published = 0 ;
+            entry->repeated = 0 ;
+            entry->limited = 0 ;
+        } else if ( now - entry->window_start >= window_ns ) {
+            end_limit_window(*entry, now, reports) ;
+        }
+
+        text_hash = hash_bytes(14695981039346656037ULL, message, length) ;
+        if ( no_duplicates and entry->published != 0 and text_hash == entry->last_hash ) {
+            entry->repeated++ ;
+            suppress = true ;
+        } else if ( max_count != 0 and entry->published >= max_count ) {
+            entry->limited++ ;
+            suppress = true ;
+        } else {
+            entry->published++ ;
+            entry->last_hash = text_hash ;
+        }
+
+        if ( suppress ) {
+            rate_suppressed++ ;
+            while ( length > 0 and message[length - 1] == '\n' ) {
+                length-- ;
+            }
+            if ( length > MESSAGE_LIMIT_TEXT - 1 ) {
+                length = MESSAGE_LIMIT_TEXT - 1 ;
+            }
+            memcpy(entry->last_text, message, length) ;
+            entry->last_text[length] = '\0' ;
+        }
+    }
+
+    pthread_mutex_unlock(&limit_mutex) ;
+
+    for ( ii = 0 ; ii < reports.size() ; ii++ ) {
+        publish_report(reports[ii].first, reports[ii].second) ;
+    }
+    return suppress ;
+}
+
+void Trick::MessagePublisher::sweep_limit_windows(long long now, long long window_ns,
+ std::vector< std::pair< int , std::string > > & reports) {
+
+    unsigned int ii ;
+
+    if ( now - last_limit_sweep >= window_ns ) {
+        last_limit_sweep = now ;
+        for ( ii = 0 ; ii < MESSAGE_LIMIT_SLOTS ; ii++ ) {
+            if ( limit_entries[ii].key != 0 and now - limit_entries[ii].window_start >= window_ns ) {
+                end_limit_window(limit_entries[ii], now, reports) ;
+                limit_entries[ii].key = 0 ;
+            }
+        }
+    }
+}
+
+/**
+@details
+-# When no limits are set, return without taking a lock.
+-# Sweep the ended windows and publish their reports after releasing the lock.
+*/
+void Trick::MessagePublisher::report_ended_windows() {
+
+    std::vector< std::pair< int , std::string > > reports ;
+    unsigned int ii ;
+
+    if ( ! level_limits_set and rate_limit == 0 and ! suppress_duplicates ) {
+        return ;
+    }
+
+    pthread_mutex_lock(&limit_mutex) ;
+    sweep_limit_windows(monotonic_ns(), (long long)(rate_window * 1000000000.0), reports) ;
+    pthread_mutex_unlock(&limit_mutex) ;
+
+    for ( ii = 0 ; ii < reports.size() ; ii++ ) {
+        publish_report(reports[ii].first, reports[ii].second) ;
+    }
+}
+
+/**
+@details
+-# If messages of the group were suppressed in the window, add a report to reports.  If all of them repeated the
+   last published message, it says how many times it was repeated.  Otherwise it says how many messages were
+   suppressed and shows the last one.
+-# Start a new window at now.
+*/
+void Trick::MessagePublisher::end_limit_window(Trick::MessageLimitEntry & entry, long long now,
+ std::vector< std::pair< int , std::string > > & reports) {
+
+    char report[MESSAGE_LIMIT_TEXT + 128] ;
+    double window = (now - entry.window_start) / 1000000000.0 ;
+
+    if ( entry.limited != 0 ) {
+        snprintf(report, sizeof(report), "%u messages suppressed in last %.3gs, the last was: %s\n",
+         entry.repeated + entry.limited, window, entry.last_text) ;
+        reports.push_back(std::make_pair(entry.level, std::string(report))) ;
+    } else if ( entry.repeated != 0 ) {
+        snprintf(report, sizeof(report), "message repeated %u times in last %.3gs: %s\n",
+         entry.repeated, window, entry.last_text) ;
+        reports.push_back(std::make_pair(entry.level, std::string(report))) ;
+    }
+    entry.window_start = now ;
+    entry.published = 0 ;
+    entry.repeated = 0 ;
+    entry.limited = 0 ;
+}
+
+void Trick::MessagePublisher::publish_report(int level, const std::string & message) {
+    if ( async ) {
+        enqueue(level, message.c_str(), message.length()) ;
+    } else {
+        publish(level, message) ;
+    }
+}
+
+int Trick::MessagePublisher::set_rate_limit(int level, unsigned int max_count) {
+    pthread_mutex_lock(&limit_mutex) ;
+    if ( level < 0 ) {
+        rate_limit = max_count ;
+    } else {
+        level_rate_limit[level] = max_count ;
+        level_limits_set = true ;
+    }
+    pthread_mutex_unlock(&limit_mutex) ;
+    return(0) ;
+}
+
+int Trick::MessagePublisher::set_suppress_duplicates(int level, bool yes_no) {
+    pthread_mutex_lock(&limit_mutex) ;
+    if ( level < 0 ) {
+        suppress_duplicates = yes_no ;
+    } else {
+        level_suppress_duplicates[level] = yes_no ;
+        level_limits_set = true ;
+    }
+    pthread_mutex_unlock(&limit_mutex) ;
+    return(0) ;
+}
+
+int Trick::MessagePublisher::report_suppressed() {
+    std::vector< std::pair< int , std::string > > reports ;
+    long long now = monotonic_ns() ;
+    unsigned int ii ;
+
+    pthread_mutex_lock(&limit_mutex) ;
+    for ( ii = 0 ; ii < MESSAGE_LIMIT_SLOTS ; ii++ ) {
+        if ( limit_entries[ii].key != 0 ) {
+            end_limit_window(limit_entries[ii], now, reports) ;
+        }
+    }
+    pthread_mutex_unlock(&limit_mutex) ;
+
+    for ( ii = 0 ; ii < reports.size() ; ii++ ) {
+        publish_report(reports[ii].first, reports[ii].second) ;
+    }
+    return(0) ;
+}
+
+int Trick::MessagePublisher::shutdown() {
+    report_suppressed() ;
+    set_async(false) ;
+    return(0) ;
+}
+
+Trick::MessageAsyncWriter::MessageAsyncWriter( Trick::MessagePublisher & in_publisher ) :
+ Trick::SysThread("MessageAsync") ,
+ publisher(in_publisher) {}
+
+/**
+@details
+-# Sleep async_period, then deliver the queued messages.  Cancellation is disabled while delivering, so the
+   thread is only cancelled in its sleep and never while holding the subscribers or a subscriber's stream.
+*/
+void * Trick::MessageAsyncWriter::thread_body() {
+    int old_state ;
+    while ( true ) {
+        usleep((useconds_t)(publisher.async_period * 1000000.0)) ;
+        if ( publisher.async ) {
+            pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &old_state) ;
+            publisher.flush() ;
+            pthread_setcancelstate(old_state, NULL) ;
+        }
+    }
+    return NULL ;
 }
 
 Trick::MessageSubscriber * Trick::MessagePublisher::getSubscriber( std::string sub_name ) {
     std::list<Trick::MessageSubscriber *>::iterator lit ;
+    Trick::MessageSubscriber * ret = NULL ;
+    pthread_mutex_lock(&subscribers_mutex) ;
     for ( lit = subscribers.begin() ; lit != subscribers.end() ; ++lit ) {
         if ( ! (*lit)->name.compare(sub_name) ) {
-            return *lit ;
+            ret = *lit ;
+            break ;
         }
     }
-    return NULL ;
+    pthread_mutex_unlock(&subscribers_mutex) ;
+    return ret ;
 }
@@ -3,7 +3,8 @@
 
 Trick::MessageSubscriber::MessageSubscriber() :
  enabled(true) ,
- color(1) {}
+ color(1) ,
+ batch_flush(false) {}
 
 int Trick::MessageSubscriber::set_enabled(bool yes_no) {
     enabled = yes_no ;
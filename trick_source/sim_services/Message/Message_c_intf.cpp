@@ -61,12 +61,91 @@ extern "C" void * message_get_subscriber( const char * sub_name ) {
     return (void *)the_message_publisher->getSubscriber(sub_name) ;
 }
 
+/* The length of the text vsnprintf wrote into a MAX_MSG_SIZE buffer, given its return value. */
+static size_t msg_length( int length ) {
+    if ( length < 0 ) {
+        return 0 ;
+    }
+    return ( length < MAX_MSG_SIZE ) ? length : MAX_MSG_SIZE - 1 ;
+}
+
+/**
+ @relates Trick::MessagePublisher
+ @copydoc Trick::MessagePublisher::set_async
+ */
+extern "C" int message_set_async( int yes_no ) {
+    if (the_message_publisher != NULL) {
+        return the_message_publisher->set_async(yes_no != 0) ;
+    }
+    return(0) ;
+}
+
+/**
+ @relates Trick::MessagePublisher
+ @copydoc Trick::MessagePublisher::flush
+ */
+extern "C" int message_flush( void ) {
+    if (the_message_publisher != NULL) {
+        return the_message_publisher->flush() ;
+    }
+    return(0) ;
+}
+
+/**
+ @relates Trick::MessagePublisher
+ @copydoc Trick::MessagePublisher::set_rate_limit
+ */
+extern "C" int message_set_rate_limit( int level , unsigned int max_count ) {
+    if (the_message_publisher != NULL) {
+        return the_message_publisher->set_rate_limit(level, max_count) ;
+    }
+    return(0) ;
+}
+
+/**
+ @relates Trick::MessagePublisher
+ @copydoc Trick::MessagePublisher::set_suppress_duplicates
+ */
+extern "C" int message_set_suppress_duplicates( int level , int yes_no ) {
+    if (the_message_publisher != NULL) {
+        return the_message_publisher->set_suppress_duplicates(level, yes_no != 0) ;
+    }
+    return(0) ;
+}
+
+/* Formats and publishes a message unless it is limited.  caller is the code that published it, which groups the
+   messages of a format without text of its own. */
+static int publish_message(int level, const char * format_msg, va_list args, const void * caller) {
+
+    char msg_buf[MAX_MSG_SIZE];
+    int length ;
+
+    length = vsnprintf(msg_buf, MAX_MSG_SIZE, format_msg, args);
+
+    if (the_message_publisher != NULL) {
+        if (the_message_publisher->limit(level, format_msg, msg_buf, msg_length(length), caller)) {
+            return (0);
+        }
+        if (the_message_publisher->async) {
+            // queue the text as formatted, without copying it into a std::string
+            the_message_publisher->enqueue(level, msg_buf, msg_length(length)) ;
+        } else {
+            the_message_publisher->publish(level, msg_buf) ;
+        }
+    } else {
+        // if we don't have a message publisher, simply print message to terminal
+        message_publish_standalone(level, msg_buf) ;
+    }
+
+    return (0);
+}
+
 /**
  @relates Trick::MessagePublisher
  @userdesc Command to publish a message, which sends the message to all subscribers.
  Creates a header that is prepended to the message, so that the output looks like this:
  @code |L <level>|<date>|<hostname>|<Trick::MessagePublisher::sim_name>|T <process id>|<sim time>| <format_msg> @endcode
- Calls Trick::MessagePublisher::publish.
+ Calls Trick::MessagePublisher::publish unless Trick::MessagePublisher::limit suppresses the message.
  @par Python Usage:
  @code trick.message_publish(<level>, "<format_msg>") @endcode
  @param level - the published message level
@@ -75,38 +154,19 @@ extern "C" void * message_get_subscriber( const char * sub_name ) {
  */
 extern "C" int message_publish(int level, const char * format_msg, ...) {
 
-    char msg_buf[MAX_MSG_SIZE];
     va_list args;
 
     va_start(args, format_msg);
-    (void) vsnprintf(msg_buf, MAX_MSG_SIZE, format_msg, args);
+    publish_message(level, format_msg, args, __builtin_return_address(0)) ;
     va_end(args);
 
-    if (the_message_publisher != NULL) {
-        the_message_publisher->publish(level, msg_buf) ;
-    } else {
-        // if we don't have a message publisher, simply print message to terminal
-        message_publish_standalone(level, msg_buf) ;
-    }
-
     return (0);
 }
 
 extern "C" int vmessage_publish(int level, const char * format_msg, va_list args) {
-
-    char msg_buf[MAX_MSG_SIZE];
-
-    (void) vsnprintf(msg_buf, MAX_MSG_SIZE, format_msg, args);
-
-    if (the_message_publisher != NULL) {
-        the_message_publisher->publish(level, msg_buf) ;
-    } else {
-        // if we don't have a message publisher, simply print message to terminal
-        message_publish_standalone(level, msg_buf) ;
-    }
-
-    return (0);
+    return publish_message(level, format_msg, args, __builtin_return_address(0)) ;
 }
+
 /**
  @relates Trick::MessagePublisher
  @userdesc A send health & status routine provided for backwards compatibility; simply calls message_publish with level 0.
@@ -118,21 +178,19 @@ extern "C" int vmessage_publish(int level, const char * format_msg, va_list args
  */
 extern "C" int send_hs(FILE * fp __attribute__ ((unused)), const char * format_msg, ...) {
 
-    char msg_buf[MAX_MSG_SIZE];
     va_list args;
 
+    // pass the format on, so the message is rate limited with the other messages of its format
     va_start(args, format_msg);
-    (void) vsnprintf(msg_buf, MAX_MSG_SIZE, format_msg, args);
+    publish_message(0, format_msg, args, __builtin_return_address(0)) ;
     va_end(args);
 
-    message_publish(0, msg_buf) ;
-
     return (0);
 }
 
 extern "C" int vsend_hs(FILE * fp __attribute__ ((unused)), const char * format_msg, va_list args) {
 
-    vmessage_publish(0, format_msg, args) ;
+    publish_message(0, format_msg, args, __builtin_return_address(0)) ;
     return (0);
 }
 
@@ -14,7 +14,9 @@ void Trick::PlaybackFile::update( unsigned int level , std::string header __attr
 
     if ( enabled && level == MSG_PLAYBACK ) {
         out_stream << message ;
-        out_stream.flush() ;
+        if ( ! batch_flush ) {
+            out_stream.flush() ;
+        }
     }
 
 }
@@ -0,0 +1,322 @@
+#include <pthread.h>
+#include <unistd.h>
+#include <functional>
+#include <list>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#define private public
+#include "trick/MessagePublisher.hh"
+#include "trick/MessageSubscriber.hh"
+#include "trick/message_type.h"
+
+namespace Trick {
+
+/* A subscriber that keeps every message it is sent. */
+class LogSubscriber : public Trick::MessageSubscriber {
+    public:
+        LogSubscriber() : flushes(0) {}
+        virtual void update( unsigned int level , std::string , std::string message ) {
+            levels.push_back(level) ;
+            messages.push_back(message) ;
+        }
+        virtual void flush() { flushes++ ; }
+
+        std::vector<unsigned int> levels ;
+        std::vector<std::string> messages ;
+        int flushes ;
+} ;
+
+class MessagePublisherTest : public ::testing::Test {
+
+    protected:
+        Trick::MessagePublisher mp ;
+        LogSubscriber log ;
+
+        MessagePublisherTest() {}
+        ~MessagePublisherTest() {}
+
+        virtual void SetUp() {
+            mp.subscribe(&log) ;
+            // the smallest ring, 1024 bytes
+            mp.async_buffer_size = 0 ;
+        }
+
+        /* Runs body on a new thread.  A thread keeps its ring for the publisher it first queued a message for,
+           so each test queues from its own threads. */
+        void run_on_thread( std::function<void()> body ) {
+            std::thread thread(body) ;
+            thread.join() ;
+        }
+
+        /* Publishes a message the way message_publish() does, unless it is limited. */
+        void publish_limited( int level , const char * format , const std::string & text , const void * caller = NULL ) {
+            if ( ! mp.limit(level, format, text.c_str(), text.length(), caller) ) {
+                mp.publish(level, text) ;
+            }
+        }
+
+        /* A message of length characters, ending in a newline, that starts with its number. */
+        std::string make_message( int num , size_t length ) {
+            std::string message = std::to_string(num) + ":" ;
+            message.resize(length - 1, 'x') ;
+            return message + "\n" ;
+        }
+} ;
+
+TEST_F(MessagePublisherTest , WrapsAndPads) {
+    run_on_thread([this]() {
+        std::vector<std::string> sent ;
+        // 4 records of 232 bytes fill the ring to 928.
+        for ( int ii = 0 ; ii < 4 ; ii++ ) {
+            sent.push_back(make_message(ii, 200)) ;
+            EXPECT_EQ(mp.enqueue(MSG_NORMAL, sent.back().c_str(), sent.back().length()), 0) ;
+        }
+        // The next record does not fit before the end, and there is no room at the beginning yet.
+        std::string message = make_message(4, 200) ;
+        EXPECT_EQ(mp.enqueue(MSG_NORMAL, message.c_str(), message.length()), -1) ;
+        mp.flush() ;
+
+        // After a delivery it starts over at the beginning, past a padding record.
+        sent.push_back(message) ;
+        EXPECT_EQ(mp.enqueue(MSG_NORMAL, message.c_str(), message.length()), 0) ;
+        mp.flush() ;
+        // Two records of 384 bytes end 24 bytes before the end, too few for a padding record, so the next record
+        // starts over at the beginning again.
+        for ( int ii = 5 ; ii < 7 ; ii++ ) {
+            sent.push_back(make_message(ii, 352)) ;
+            EXPECT_EQ(mp.enqueue(MSG_NORMAL, sent.back().c_str(), sent.back().length()), 0) ;
+        }
+        mp.flush() ;
+        sent.push_back(make_message(7, 10)) ;
+        EXPECT_EQ(mp.enqueue(MSG_WARNING, sent.back().c_str(), sent.back().length()), 0) ;
+        mp.flush() ;
+
+        EXPECT_EQ(mp.async_dropped, 1u) ;
+        // The messages in order, with the dropped messages warning after the first batch.
+        ASSERT_EQ(log.messages.size(), sent.size() + 1) ;
+        for ( unsigned int ii = 0 ; ii < 4 ; ii++ ) {
+            EXPECT_EQ(log.messages[ii], sent[ii]) ;
+        }
+        EXPECT_EQ(log.levels[4], (unsigned int)MSG_WARNING) ;
+        EXPECT_EQ(log.messages[4].find("1 messages were dropped"), 0u) ;
+        for ( unsigned int ii = 4 ; ii < sent.size() ; ii++ ) {
+            EXPECT_EQ(log.messages[ii + 1], sent[ii]) ;
+        }
+        EXPECT_EQ(log.levels.back(), (unsigned int)MSG_WARNING) ;
+        EXPECT_EQ(log.flushes, 4) ;
+    }) ;
+}
+
+TEST_F(MessagePublisherTest , TruncatesLongMessages) {
+    run_on_thread([this]() {
+        std::string message = make_message(0, 800) ;
+        EXPECT_EQ(mp.enqueue(MSG_NORMAL, message.c_str(), message.length()), 0) ;
+        mp.flush() ;
+        ASSERT_EQ(log.messages.size(), 1u) ;
+        EXPECT_EQ(log.messages[0], message.substr(0, 512)) ;
+    }) ;
+}
+
+TEST_F(MessagePublisherTest , DropsWhenFull) {
+    run_on_thread([this]() {
+        std::string message = make_message(0, 90) ;
+        int queued = 0 ;
+        // Records of 128 bytes, 8 fit.
+        for ( int ii = 0 ; ii < 20 ; ii++ ) {
+            if ( mp.enqueue(MSG_NORMAL, message.c_str(), message.length()) == 0 ) {
+                queued++ ;
+            }
+        }
+        EXPECT_EQ(queued, 8) ;
+        EXPECT_EQ(mp.async_dropped, 12u) ;
+        mp.flush() ;
+        ASSERT_EQ(log.messages.size(), 9u) ;
+        EXPECT_EQ(log.messages[8].find("12 messages were dropped"), 0u) ;
+
+        // The warning is given once for each batch of drops.
+        EXPECT_EQ(mp.enqueue(MSG_NORMAL, message.c_str(), message.length()), 0) ;
+        mp.flush() ;
+        EXPECT_EQ(log.messages.size(), 10u) ;
+    }) ;
+}
+
+TEST_F(MessagePublisherTest , OrdersThreads) {
+    pthread_barrier_t turn ;
+    pthread_barrier_init(&turn, NULL, 2) ;
+    // Two threads take turns queueing, each in its own ring.
+    std::thread other([this, &turn]() {
+        for ( int ii = 1 ; ii < 10 ; ii += 2 ) {
+            pthread_barrier_wait(&turn) ;
+            std::string message = make_message(ii, 20) ;
+            mp.enqueue(MSG_NORMAL, message.c_str(), message.length()) ;
+            pthread_barrier_wait(&turn) ;
+        }
+        pthread_barrier_wait(&turn) ;
+    }) ;
+    run_on_thread([this, &turn]() {
+        for ( int ii = 0 ; ii < 10 ; ii += 2 ) {
+            std::string message = make_message(ii, 20) ;
+            mp.enqueue(MSG_NORMAL, message.c_str(), message.length()) ;
+            pthread_barrier_wait(&turn) ;
+            pthread_barrier_wait(&turn) ;
+        }
+        EXPECT_EQ(mp.rings.size(), 2u) ;
+        mp.flush() ;
+        pthread_barrier_wait(&turn) ;
+    }) ;
+    other.join() ;
+    pthread_barrier_destroy(&turn) ;
+
+    ASSERT_EQ(log.messages.size(), 10u) ;
+    for ( int ii = 0 ; ii < 10 ; ii++ ) {
+        EXPECT_EQ(log.messages[ii], make_message(ii, 20)) ;
+    }
+}
+
+TEST_F(MessagePublisherTest , FreesRingOfExitedThread) {
+    pthread_barrier_t queued ;
+    pthread_barrier_init(&queued, NULL, 2) ;
+    std::thread running([this, &queued]() {
+        std::string message = make_message(0, 20) ;
+        mp.enqueue(MSG_NORMAL, message.c_str(), message.length()) ;
+        pthread_barrier_wait(&queued) ;
+        pthread_barrier_wait(&queued) ;
+    }) ;
+    pthread_barrier_wait(&queued) ;
+    run_on_thread([this]() {
+        std::string message = make_message(1, 20) ;
+        mp.enqueue(MSG_NORMAL, message.c_str(), message.length()) ;
+    }) ;
+    EXPECT_EQ(mp.rings.size(), 2u) ;
+
+    // The exited thread's ring is delivered, then freed.  The ring of the running thread is kept.
+    mp.flush() ;
+    EXPECT_EQ(log.messages.size(), 2u) ;
+    EXPECT_EQ(mp.rings.size(), 1u) ;
+    pthread_barrier_wait(&queued) ;
+    running.join() ;
+    pthread_barrier_destroy(&queued) ;
+    mp.flush() ;
+    EXPECT_EQ(mp.rings.size(), 0u) ;
+}
+
+TEST_F(MessagePublisherTest , PublishesNow) {
+    mp.publish(MSG_ERROR, "now\n") ;
+    ASSERT_EQ(log.messages.size(), 1u) ;
+    EXPECT_EQ(log.levels[0], (unsigned int)MSG_ERROR) ;
+    EXPECT_EQ(log.messages[0], "now\n") ;
+    EXPECT_TRUE(mp.rings.empty()) ;
+}
+
+TEST_F(MessagePublisherTest , NoLimitsByDefault) {
+    for ( int ii = 0 ; ii < 5 ; ii++ ) {
+        publish_limited(MSG_NORMAL, "same\n", "same\n") ;
+    }
+    EXPECT_EQ(log.messages.size(), 5u) ;
+    EXPECT_EQ(mp.rate_suppressed, 0u) ;
+}
+
+TEST_F(MessagePublisherTest , RateLimit) {
+    mp.set_rate_limit(-1, 3) ;
+    for ( int ii = 0 ; ii < 10 ; ii++ ) {
+        publish_limited(MSG_WARNING, "value %d\n", "value " + std::to_string(ii) + "\n") ;
+    }
+    // Another format is another group.
+    publish_limited(MSG_WARNING, "other\n", "other\n") ;
+    ASSERT_EQ(log.messages.size(), 4u) ;
+    EXPECT_EQ(log.messages[2], "value 2\n") ;
+    EXPECT_EQ(log.messages[3], "other\n") ;
+    EXPECT_EQ(mp.rate_suppressed, 7u) ;
+
+    mp.report_suppressed() ;
+    ASSERT_EQ(log.messages.size(), 5u) ;
+    EXPECT_EQ(log.levels[4], (unsigned int)MSG_WARNING) ;
+    EXPECT_EQ(log.messages[4].find("7 messages suppressed in last "), 0u) << log.messages[4] ;
+    EXPECT_NE(log.messages[4].find("the last was: value 9\n"), std::string::npos) << log.messages[4] ;
+
+    // The report starts a new window.
+    publish_limited(MSG_WARNING, "value %d\n", "value 10\n") ;
+    EXPECT_EQ(log.messages.size(), 6u) ;
+}
+
+TEST_F(MessagePublisherTest , LevelLimits) {
+    mp.set_rate_limit(-1, 1) ;
+    mp.set_rate_limit(MSG_ERROR, 0) ;
+    for ( int ii = 0 ; ii < 5 ; ii++ ) {
+        publish_limited(MSG_ERROR, "failed\n", "failed\n") ;
+        publish_limited(MSG_NORMAL, "failed\n", "failed\n") ;
+    }
+    EXPECT_EQ(log.messages.size(), 6u) ;
+    EXPECT_EQ(mp.rate_suppressed, 4u) ;
+}
+
+TEST_F(MessagePublisherTest , SuppressesDuplicates) {
+    mp.set_suppress_duplicates(-1, true) ;
+    for ( int ii = 0 ; ii < 5 ; ii++ ) {
+        publish_limited(MSG_NORMAL, "pressure %d\n", "pressure 1\n") ;
+    }
+    publish_limited(MSG_NORMAL, "pressure %d\n", "pressure 2\n") ;
+    publish_limited(MSG_NORMAL, "pressure %d\n", "pressure 2\n") ;
+    ASSERT_EQ(log.messages.size(), 2u) ;
+    EXPECT_EQ(log.messages[1], "pressure 2\n") ;
+
+    mp.report_suppressed() ;
+    ASSERT_EQ(log.messages.size(), 3u) ;
+    EXPECT_EQ(log.messages[2].find("message repeated 5 times in last "), 0u) << log.messages[2] ;
+    EXPECT_NE(log.messages[2].find(": pressure 2\n"), std::string::npos) << log.messages[2] ;
+
+    // Nothing suppressed, nothing reported.
+    mp.report_suppressed() ;
+    EXPECT_EQ(log.messages.size(), 3u) ;
+}
+
+TEST_F(MessagePublisherTest , GroupsFormatsWithoutText) {
+    int first_caller , second_caller ;
+    mp.set_rate_limit(-1, 1) ;
+
+    // The messages of a format without text are grouped by caller.
+    publish_limited(MSG_INFO, "%s\n", "a\n", &first_caller) ;
+    publish_limited(MSG_INFO, "%s\n", "b\n", &second_caller) ;
+    publish_limited(MSG_INFO, "%s\n", "c\n", &first_caller) ;
+    ASSERT_EQ(log.messages.size(), 2u) ;
+    EXPECT_EQ(log.messages[1], "b\n") ;
+
+    // Or by their text if the caller is not known.
+    publish_limited(MSG_INFO, " %-8.3s\t%lld ", "x", NULL) ;
+    publish_limited(MSG_INFO, " %-8.3s\t%lld ", "y", NULL) ;
+    publish_limited(MSG_INFO, " %-8.3s\t%lld ", "x", NULL) ;
+    EXPECT_EQ(log.messages.size(), 4u) ;
+
+    // A format with text is one group for all callers.
+    publish_limited(MSG_INFO, "done %s\n", "done a\n", &first_caller) ;
+    publish_limited(MSG_INFO, "done %s\n", "done b\n", &second_caller) ;
+    publish_limited(MSG_INFO, "100%%\n", "100%\n", &first_caller) ;
+    publish_limited(MSG_INFO, "100%%\n", "100%\n", &second_caller) ;
+    EXPECT_EQ(log.messages.size(), 6u) ;
+    EXPECT_EQ(mp.rate_suppressed, 4u) ;
+}
+
+TEST_F(MessagePublisherTest , FlushReportsEndedWindows) {
+    mp.rate_window = 0.02 ;
+    mp.set_rate_limit(-1, 1) ;
+    for ( int ii = 0 ; ii < 3 ; ii++ ) {
+        publish_limited(MSG_NORMAL, "step %d\n", "step " + std::to_string(ii) + "\n") ;
+    }
+    mp.flush() ;
+    EXPECT_EQ(log.messages.size(), 1u) ;
+
+    // The group publishes nothing more, the background thread's flush reports it once its window ends.
+    usleep(30000) ;
+    mp.flush() ;
+    ASSERT_EQ(log.messages.size(), 2u) ;
+    EXPECT_EQ(log.messages[1].find("2 messages suppressed in last "), 0u) << log.messages[1] ;
+    mp.flush() ;
+    EXPECT_EQ(log.messages.size(), 2u) ;
+}
+
+}
@@ -10,11 +10,17 @@ Trick::MonteCarlo::MonteCarlo() :
     custom_slave_dispatch(false),
     timeout(120),
     max_tries(2),
+    dispatch_ahead(true),
+    slave_init_once(false),
+    local_workers(0),
     verbosity(MC_INFORMATIONAL),
+    run_data_offset(0),
     num_runs(0),
     actual_num_runs(0),
     num_results(0),
     slave_id(0),
+    pipe_fd(-1),
+    pending_command(-1),
     except_return(0)
 {
     the_mc = this;
@@ -91,6 +91,45 @@ extern "C" unsigned int mc_get_max_tries(void) {
     return 0 ;
 }
 
+extern "C" void mc_set_dispatch_ahead(int dispatch_ahead) {
+    if ( the_mc != NULL ) {
+        the_mc->set_dispatch_ahead((bool)dispatch_ahead);
+    }
+}
+
+extern "C" int mc_get_dispatch_ahead(void) {
+    if ( the_mc != NULL ) {
+        return the_mc->get_dispatch_ahead();
+    }
+    return 0 ;
+}
+
+extern "C" void mc_set_slave_init_once(int slave_init_once) {
+    if ( the_mc != NULL ) {
+        the_mc->set_slave_init_once((bool)slave_init_once);
+    }
+}
+
+extern "C" int mc_get_slave_init_once(void) {
+    if ( the_mc != NULL ) {
+        return the_mc->get_slave_init_once();
+    }
+    return 0 ;
+}
+
+extern "C" void mc_set_local_workers(int local_workers) {
+    if ( the_mc != NULL ) {
+        the_mc->set_local_workers(local_workers);
+    }
+}
+
+extern "C" int mc_get_local_workers(void) {
+    if ( the_mc != NULL ) {
+        return the_mc->get_local_workers();
+    }
+    return 0 ;
+}
+
 extern "C" void mc_set_user_cmd_string(const char *user_cmd_string) {
     if ( the_mc != NULL ) {
         the_mc->set_user_cmd_string(std::string(user_cmd_string ? user_cmd_string : ""));
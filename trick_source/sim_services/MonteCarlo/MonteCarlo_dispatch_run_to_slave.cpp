@@ -1,4 +1,3 @@
-
 #include <iomanip>
 #include <sstream>
 #include <sys/time.h>
@@ -8,57 +7,66 @@
 #include "trick/message_proto.h"
 #include "trick/message_type.h"
 
+/**
+ * @par Detailed Design:
+ * The run is written to the slave's connection in a single message of the MonteSlave::MC_PROCESS_RUN command, the run
+ * id, and the length and text of the input. A slave that is processing a run will start the new one when its current
+ * run finishes.
+ */
 void Trick::MonteCarlo::dispatch_run_to_slave(MonteRun *run, MonteSlave *slave) {
     if (slave && run) {
         current_run = run->id;
         if (prepare_run(run) == -1) {
             return;
         }
-        slave->state = MonteSlave::MC_RUNNING;
-        connection_device.hostname = (char*)slave->machine_name.c_str();
-        connection_device.port = slave->port;
-        if (tc_connect(&connection_device) == TC_SUCCESS) {
-            std::stringstream buffer_stream;
-            buffer_stream << slave_output_directory << "/RUN_" << std::setw(5) << std::setfill('0') << run->id;
-            std::string buffer = "";
-            for (std::vector<std::string>::size_type j = 0; j < run->variables.size(); ++j) {
-                buffer += run->variables[j] + "\n";
-            }
-            buffer += std::string("trick.set_output_dir(\"") + buffer_stream.str() + std::string("\")\n");
-            buffer_stream.str("");
-            buffer_stream << run->id ;
-            buffer += std::string("trick.mc_set_current_run(") + buffer_stream.str() + std::string(")\n");
-
-            if (verbosity >= MC_INFORMATIONAL) {
-                message_publish(MSG_INFO, "Monte [Master] Dispatching run %d to %s:%d.\n",
-		     run->id, slave->machine_name.c_str(), slave->id) ;
-            }
+        std::stringstream buffer_stream;
+        buffer_stream << slave_output_directory << "/RUN_" << std::setw(5) << std::setfill('0') << run->id;
+        std::string buffer = "";
+        for (std::vector<std::string>::size_type j = 0; j < run->variables.size(); ++j) {
+            buffer += run->variables[j] + "\n";
+        }
+        buffer += std::string("trick.set_output_dir(\"") + buffer_stream.str() + std::string("\")\n");
+        buffer_stream.str("");
+        buffer_stream << run->id ;
+        buffer += std::string("trick.mc_set_current_run(") + buffer_stream.str() + std::string(")\n");
 
-            int command = htonl(MonteSlave::MC_PROCESS_RUN);
-            tc_write(&connection_device, (char *)&command, (int)sizeof(command));
-            int num_bytes = htonl(buffer.length());
-            tc_write(&connection_device, (char*)&num_bytes, (int)sizeof(num_bytes));
-            tc_write(&connection_device, (char*)buffer.c_str(), (int)buffer.length());
+        if (verbosity >= MC_INFORMATIONAL) {
+            message_publish(MSG_INFO, "Monte [Master] Dispatching run %d to %s:%d.\n",
+                 run->id, slave->machine_name.c_str(), slave->id) ;
+        }
 
-            if (verbosity >= MC_ALL) {
-                message_publish(MSG_INFO, "Parameterization of run %d :\n%s\n", run->id, buffer.c_str()) ;
+        int header[3];
+        header[0] = htonl(MonteSlave::MC_PROCESS_RUN);
+        header[1] = htonl(run->id);
+        header[2] = htonl(buffer.length());
+        buffer.insert(0, (char *)header, sizeof(header));
+        ++run->num_tries;
+        if (write_to_slave(*slave, (char *)buffer.c_str(), (int)buffer.length()) != (int)buffer.length()) {
+            if (verbosity >= MC_ERROR) {
+                message_publish(MSG_ERROR, "Monte [Master] Failed to dispatch run %d to %s:%d.\n",
+                                run->id, slave->machine_name.c_str(), slave->id) ;
             }
+            /* Back to the head of the queue. The run keeps its values since it counts as tried. */
+            runs.push_front(run);
+            set_disconnected_state(*slave);
+            return;
+        }
 
-            tc_disconnect(&connection_device);
+        if (verbosity >= MC_ALL) {
+            message_publish(MSG_INFO, "Parameterization of run %d :\n%s\n", run->id, buffer.c_str() + sizeof(header)) ;
+        }
 
-            ++slave->num_dispatches;
-            slave->current_run = run;
+        ++slave->num_dispatches;
 
+        /** <ul><li> A ready slave starts the run now, a busy slave after its current run. </ul> */
+        if (slave->state == MonteSlave::MC_READY) {
+            slave->state = MonteSlave::MC_RUNNING;
+            slave->current_run = run;
             struct timeval time_val;
             gettimeofday(&time_val, NULL);
             run->start_time = time_val.tv_sec + (double)time_val.tv_usec / 1000000;
-            ++run->num_tries;
         } else {
-            slave->state = Trick::MonteSlave::MC_DISCONNECTED;
-            if (verbosity >= MC_ERROR) {
-                message_publish(MSG_ERROR, "Monte [Master] Failed to connect to %s:%d to dispatch run.\n",
-                                slave->machine_name.c_str(), slave->id) ;
-            }
+            slave->next_run = run;
         }
     }
 }
@@ -15,10 +15,25 @@ int Trick::MonteCarlo::execute_monte() {
                 exit(0);
             }
             master();
-        } else {
+        } else if (!slave_init_once) {
             slave_init();
             execute_as_slave();
         }
     }
     return(0);
 }
+
+/**
+ * @par Detailed Design:
+ * The slave connects to the master only now, so that the master's timeouts do not count the time spent initializing.
+ * Each run is forked from here. Jobs later in the initialization, such as starting data recording and the realtime
+ * clock, run in each run.
+ */
+int Trick::MonteCarlo::execute_monte_post_init() {
+
+    if (enabled && is_slave() && slave_init_once) {
+        slave_init();
+        execute_as_slave();
+    }
+    return(0);
+}
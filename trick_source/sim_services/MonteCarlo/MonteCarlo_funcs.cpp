@@ -73,6 +73,30 @@ unsigned int Trick::MonteCarlo::get_max_tries() {
     return max_tries;
 }
 
+void Trick::MonteCarlo::set_dispatch_ahead(bool in_dispatch_ahead) {
+    this->dispatch_ahead = in_dispatch_ahead;
+}
+
+bool Trick::MonteCarlo::get_dispatch_ahead() {
+    return dispatch_ahead;
+}
+
+void Trick::MonteCarlo::set_slave_init_once(bool in_slave_init_once) {
+    this->slave_init_once = in_slave_init_once;
+}
+
+bool Trick::MonteCarlo::get_slave_init_once() {
+    return slave_init_once;
+}
+
+void Trick::MonteCarlo::set_local_workers(int in_local_workers) {
+    this->local_workers = in_local_workers;
+}
+
+int Trick::MonteCarlo::get_local_workers() {
+    return local_workers;
+}
+
 void Trick::MonteCarlo::set_user_cmd_string(std::string in_user_cmd_string) {
     this->user_cmd_string = in_user_cmd_string;
 }
@@ -284,6 +308,13 @@ int Trick::MonteCarlo::process_sim_args() {
                 sscanf(argv[++i], "%d", &master_port);
             } else if (!strncmp("--monte_client_id", argv[i], 12)) {
                 sscanf(argv[++i], "%d", &slave_id);
+            } else if (!strncmp("--monte_pipes", argv[i], 13)) {
+                /* A local worker's pipes from and to the master. */
+                int read_fd, write_fd;
+                if (sscanf(argv[++i], "%d,%d", &read_fd, &write_fd) == 2) {
+                    connection_device.socket = read_fd;
+                    pipe_fd = write_fd;
+                }
             }
         }
     }
@@ -292,26 +323,30 @@ int Trick::MonteCarlo::process_sim_args() {
 
 /** @par Detailed Design: */
 int Trick::MonteCarlo::shutdown() {
-    /** <ul><li> If this is a slave, run the shutdown jobs. */
+    /** <ul><li> If this is a slave, run the post run jobs and send the results to the master. */
     if (enabled && is_slave()) {
-        connection_device.port = master_port;
-        if (tc_connect(&connection_device) == TC_SUCCESS) {
-            int exit_status = the_exec->get_except_return() ? MonteRun::MC_RUN_FAILED : MonteRun::MC_RUN_COMPLETE;
-            if (verbosity >= MC_ALL) {
-                message_publish(MSG_INFO, "Monte [%s:%d] Sending run exit status to master: %d\n",
-                                machine_name.c_str(), slave_id, exit_status) ;
-            }
-            int id = htonl(slave_id);
-            tc_write(&connection_device, (char*)&id, (int)sizeof(id));
-            exit_status = htonl(exit_status);
-            tc_write(&connection_device, (char*)&exit_status, (int)sizeof(exit_status));
-            run_queue(&slave_post_queue, "in slave_post queue");
-            tc_disconnect(&connection_device);
-        } else {
+        int exit_status = the_exec->get_except_return() ? MonteRun::MC_RUN_FAILED : MonteRun::MC_RUN_COMPLETE;
+        run_data.clear();
+        run_queue(&slave_post_queue, "in slave_post queue");
+        if (verbosity >= MC_ALL) {
+            message_publish(MSG_INFO, "Monte [%s:%d] Sending run exit status to master: %d\n",
+                            machine_name.c_str(), slave_id, exit_status) ;
+        }
+        /**
+         * <li> The connection was inherited from the slave process, which still uses it. Leave it open rather
+         * than disconnecting, which would shut it down for the slave too. </ul>
+         */
+        int header[4];
+        header[0] = htonl(slave_id);
+        header[1] = htonl(current_run);
+        header[2] = htonl(exit_status);
+        header[3] = htonl(run_data.size());
+        run_data.insert(0, (char*)header, sizeof(header));
+        if (write_to_master((char*)run_data.c_str(), (int)run_data.size()) != (int)run_data.size()) {
             if (verbosity >= MC_ERROR)
                 message_publish(
                   MSG_ERROR,
-                  "Monte [%s:%d] Failed to connect to master.\n",
+                  "Monte [%s:%d] Failed to send results to master.\n",
                   machine_name.c_str(), slave_id);
         }
     }
@@ -383,6 +418,11 @@ void Trick::MonteCarlo::check_timeouts() {
             /** </ul><li> Update the slave's state. */
             slaves[i]->state = slaves[i]->state == MonteSlave::MC_RUNNING ?
                MonteSlave::MC_UNRESPONSIVE_RUNNING : MonteSlave::MC_UNRESPONSIVE_STOPPING;
+            /**
+             * <li> Cancel any run dispatched ahead to the slave and requeue it, since the slave may never get to it.
+             * </ul></ul>
+             */
+            cancel_next_run(*slaves[i]);
         }
     }
 }
@@ -396,6 +436,70 @@ Trick::MonteSlave * Trick::MonteCarlo::get_ready_slave() {
     return NULL;
 }
 
+/**
+ * @par Detailed Design:
+ * Only a running slave that has responded within the timeout and has no run waiting qualifies.
+ */
+Trick::MonteSlave * Trick::MonteCarlo::get_dispatch_ahead_slave() {
+    if (!dispatch_ahead) {
+        return NULL;
+    }
+    for (std::vector<Trick::MonteSlave>::size_type i = 0; i < slaves.size(); ++i) {
+        if (slaves[i]->state == Trick::MonteSlave::MC_RUNNING && slaves[i]->next_run == NULL) {
+            return slaves[i];
+        }
+    }
+    return NULL;
+}
+
+/** @par Detailed Design: */
+void Trick::MonteCarlo::start_next_run(MonteSlave& slave, bool requeue) {
+    if (slave.next_run == NULL) {
+        return;
+    }
+    /** <ul><li> Put a requeued run at the head of the queue so that it is dispatched next. */
+    if (requeue) {
+        if (verbosity >= MC_ALL) {
+            message_publish(MSG_INFO, "Monte [Master] Requeueing run %d dispatched ahead to %s:%d.\n",
+                            slave.next_run->id, slave.machine_name.c_str(), slave.id) ;
+        }
+        runs.push_front(slave.next_run);
+    /** <li> Otherwise the slave has already started it, so start its clock. </ul> */
+    } else {
+        slave.current_run = slave.next_run;
+        struct timeval time_val;
+        gettimeofday(&time_val, NULL);
+        slave.current_run->start_time = time_val.tv_sec + (double)time_val.tv_usec / 1000000;
+        if (slave.state == MonteSlave::MC_READY) {
+            slave.state = MonteSlave::MC_RUNNING;
+        } else if (slave.state == MonteSlave::MC_STOPPED) {
+            slave.state = MonteSlave::MC_STOPPING;
+        }
+    }
+    slave.next_run = NULL;
+}
+
+/**
+ * @par Detailed Design:
+ * The run has already been written to the slave's connection. The slave reads the MonteSlave::MC_CANCEL_RUN and the
+ * run id after it, and skips the run if it has not started it yet. Results for a run the slave started anyway are
+ * discarded by #handle_run_data.
+ */
+void Trick::MonteCarlo::cancel_next_run(MonteSlave& slave) {
+    if (slave.next_run == NULL) {
+        return;
+    }
+    int header[2];
+    header[0] = htonl(MonteSlave::MC_CANCEL_RUN);
+    header[1] = htonl(slave.next_run->id);
+    if (write_to_slave(slave, (char *)header, (int)sizeof(header)) != (int)sizeof(header)) {
+        /* Disconnecting the slave requeues the run. */
+        set_disconnected_state(slave);
+        return;
+    }
+    start_next_run(slave, true);
+}
+
 Trick::MonteSlave* Trick::MonteCarlo::get_slave(unsigned int id) {
     int i = get_slave_index(id);
     if (i > -1) {
@@ -503,11 +607,14 @@ void Trick::MonteCarlo::update_actual_num_runs() {
             ++actual_num_runs;
         }
     }
-    /** <li> Add one for every currently dispatched run. */
+    /** <li> Add one for every currently dispatched run, and every run dispatched ahead. */
     for (std::vector<MonteSlave *>::size_type i = 0; i < slaves.size(); ++i) {
         if (slaves[i]->state == MonteSlave::MC_RUNNING || slaves[i]->state == MonteSlave::MC_STOPPING) {
             ++actual_num_runs;
         }
+        if (slaves[i]->next_run != NULL) {
+            ++actual_num_runs;
+        }
     }
 }
 
@@ -621,10 +728,30 @@ int Trick::MonteCarlo::write_s_job_execution(FILE *fp) {
     return 0;
 }
 
+/**
+ * @par Detailed Design:
+ * A slave collects the data in #run_data. MonteCarlo::shutdown sends it with the run's exit status.
+ */
 int Trick::MonteCarlo::write(char* data, int size) {
+    if (is_slave()) {
+        run_data.append(data, size);
+        return size;
+    }
     return tc_write(&connection_device, data, size);
 }
 
+/**
+ * @par Detailed Design:
+ * The master reads from the #run_data returned with the run being resolved, up to its end.
+ */
 int Trick::MonteCarlo::read(char* data, int size) {
+    if (is_master()) {
+        if (size > (int)(run_data.size() - run_data_offset)) {
+            size = (int)(run_data.size() - run_data_offset);
+        }
+        run_data.copy(data, size, run_data_offset);
+        run_data_offset += size;
+        return size;
+    }
     return tc_read(&connection_device, data, size);
 }
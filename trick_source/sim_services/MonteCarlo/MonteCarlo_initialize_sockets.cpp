@@ -14,15 +14,8 @@ int Trick::MonteCarlo::initialize_sockets() {
     tc_error(&listen_device, 0);
     tc_error(&connection_device, 0);
 
-    /** <ul><li> Initialize the sockets for communication with slaves. */
-    int return_value = tc_init(&listen_device);
-    if (return_value != TC_SUCCESS) {
-        if (verbosity >= MC_ERROR) {
-            message_publish(MSG_ERROR, "Monte [Master] Failed to initialize status communication socket.\n") ;
-        }
-        return return_value;
-    }
-    tc_blockio(&listen_device, TC_COMM_NOBLOCKIO);
+    /** <ul><li> Add the local workers. */
+    add_local_workers();
 
     /** <li> If no slaves were specified, add one on localhost. */
     if (slaves.empty()) {
@@ -31,5 +24,26 @@ int Trick::MonteCarlo::initialize_sockets() {
         }
         add_slave(new MonteSlave());
     }
+
+    /** <li> Local workers talk to the master over pipes. If every slave is one, there is nothing to listen for. */
+    bool all_local = true;
+    for (std::vector<MonteSlave *>::size_type i = 0; i < slaves.size(); ++i) {
+        all_local = all_local && slaves[i]->local_worker;
+    }
+    if (all_local) {
+        listen_device.socket = TRICKCOMM_INVALID_SOCKET;
+        connection_device.socket = TRICKCOMM_INVALID_SOCKET;
+        return TC_SUCCESS;
+    }
+
+    /** <li> Initialize the sockets for communication with slaves. </ul> */
+    int return_value = tc_init(&listen_device);
+    if (return_value != TC_SUCCESS) {
+        if (verbosity >= MC_ERROR) {
+            message_publish(MSG_ERROR, "Monte [Master] Failed to initialize status communication socket.\n") ;
+        }
+        return return_value;
+    }
+    tc_blockio(&listen_device, TC_COMM_NOBLOCKIO);
     return TC_SUCCESS ;
 }
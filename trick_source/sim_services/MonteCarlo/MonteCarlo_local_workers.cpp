@@ -0,0 +1,242 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <glob.h>
+#include <signal.h>
+#include <sstream>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#include "trick/MonteCarlo.hh"
+#include "trick/command_line_protos.h"
+#include "trick/message_proto.h"
+#include "trick/message_type.h"
+#include "trick/tc_proto.h"
+
+/* Reads until size bytes are read, the other end closes, or an error other than an interruption occurs. */
+static int read_fully(int fd, char *data, int size) {
+    int num_read = 0;
+    while (num_read < size) {
+        ssize_t result = ::read(fd, data + num_read, size - num_read);
+        if (result > 0) {
+            num_read += result;
+        } else if (result == 0 || errno != EINTR) {
+            break;
+        }
+    }
+    return num_read;
+}
+
+/*
+ * Writes until size bytes are written or an error other than an interruption occurs. A write to a closed connection
+ * fails rather than raising SIGPIPE.
+ */
+static int write_fully(int fd, const char *data, int size) {
+    int num_written = 0;
+    while (num_written < size) {
+        ssize_t result = ::send(fd, data + num_written, size - num_written, TC_NOSIGNAL);
+        if (result >= 0) {
+            num_written += result;
+        } else if (errno != EINTR) {
+            break;
+        }
+    }
+    return num_written;
+}
+
+/**
+ * @par Detailed Design:
+ * Local workers are added once, as localhost slaves. A negative #local_workers adds one per online processor.
+ */
+void Trick::MonteCarlo::add_local_workers() {
+    int num_workers = local_workers;
+    if (num_workers < 0) {
+        long num_processors = sysconf(_SC_NPROCESSORS_ONLN);
+        num_workers = num_processors > 0 ? (int)num_processors : 1;
+    }
+    for (int i = 0; i < num_workers; ++i) {
+        MonteSlave *slave = new MonteSlave("localhost");
+        slave->local_worker = true;
+        add_slave(slave);
+    }
+}
+
+/**
+ * @par Detailed Design:
+ * The worker runs the slave's S_main executable from the slave's sim path with the same arguments a remote shell would
+ * give it, except that --monte_pipes names the pipes over which it talks to the master in place of a host and port.
+ */
+void Trick::MonteCarlo::spawn_local_worker(MonteSlave* slave) {
+    /** <ul><li> Find the S_main executable as the shell would. */
+    if (slave->S_main_name.empty()) {
+        slave->S_main_name = "./S_main_*.exe";
+    }
+    std::string sim_path = slave->sim_path.empty() ? std::string(command_line_args_get_default_dir()) : slave->sim_path;
+    std::string pattern = slave->S_main_name[0] == '/' ? slave->S_main_name : sim_path + "/" + slave->S_main_name;
+    std::string executable;
+    glob_t matches;
+    if (glob(pattern.c_str(), 0, NULL, &matches) == 0 && matches.gl_pathc > 0) {
+        if (char *path = realpath(matches.gl_pathv[0], NULL)) {
+            executable = path;
+            free(path);
+        }
+    }
+    globfree(&matches);
+    if (executable.empty()) {
+        if (verbosity >= MC_ERROR) {
+            message_publish(MSG_ERROR, "Monte [Master] No executable matches %s for %s:%d.\n",
+                            pattern.c_str(), slave->machine_name.c_str(), slave->id) ;
+        }
+        slave->state = MonteSlave::MC_DISCONNECTED;
+        return;
+    }
+
+    /**
+     * <li> Create a pipe in each direction, as a local socket pair so that writes can be sent without SIGPIPE. The
+     * master's ends are closed on exec so that workers spawned later do not hold them open.
+     */
+    int to_worker[2], from_worker[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, to_worker) == -1) {
+        to_worker[0] = to_worker[1] = -1;
+    }
+    if (to_worker[0] == -1 || socketpair(AF_UNIX, SOCK_STREAM, 0, from_worker) == -1) {
+        if (verbosity >= MC_ERROR) {
+            message_publish(MSG_ERROR, "Monte [Master] Unable to create pipes for %s:%d: %s\n",
+                            slave->machine_name.c_str(), slave->id, strerror(errno)) ;
+        }
+        if (to_worker[0] != -1) {
+            close(to_worker[0]);
+            close(to_worker[1]);
+        }
+        slave->state = MonteSlave::MC_DISCONNECTED;
+        return;
+    }
+    fcntl(to_worker[1], F_SETFD, FD_CLOEXEC);
+    fcntl(from_worker[0], F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+    int on = 1;
+    setsockopt(to_worker[0], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+    setsockopt(to_worker[1], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+    setsockopt(from_worker[0], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+    setsockopt(from_worker[1], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+
+    /** <li> Build the arguments, splitting the user sim options on white space. */
+    std::stringstream ss;
+    ss << slave->id;
+    std::string id = ss.str();
+    ss.str("");
+    ss << to_worker[0] << "," << from_worker[1];
+    std::string pipes = ss.str();
+
+    std::vector<std::string> args;
+    args.push_back(executable);
+    args.push_back(command_line_args_get_input_file());
+    args.push_back("--monte_client_id");
+    args.push_back(id);
+    args.push_back("--monte_pipes");
+    args.push_back(pipes);
+    args.push_back("-O");
+    args.push_back(slave_output_directory);
+    std::istringstream options(slave_sim_options);
+    std::string option;
+    while (options >> option) {
+        args.push_back(option);
+    }
+    std::vector<char *> argv;
+    for (std::vector<std::string>::size_type i = 0; i < args.size(); ++i) {
+        argv.push_back((char *)args[i].c_str());
+    }
+    argv.push_back(NULL);
+
+    if (verbosity >= MC_INFORMATIONAL) {
+        message_publish(MSG_INFO, "Monte: Spawning local worker %d : %s %s --monte_client_id %s -O %s\n",
+                        slave->id, executable.c_str(), command_line_args_get_input_file(), id.c_str(),
+                        slave_output_directory.c_str()) ;
+    }
+
+    /** <li> Fork and execute the worker. */
+    pid_t pid = fork();
+    if (pid == 0) {
+        if (chdir(sim_path.c_str()) == 0) {
+            execv(argv[0], &argv[0]);
+        }
+        _exit(127);
+    }
+    close(to_worker[0]);
+    close(from_worker[1]);
+    if (pid == -1) {
+        if (verbosity >= MC_ERROR) {
+            message_publish(MSG_ERROR, "Monte [Master] Unable to fork local worker %d: %s\n", slave->id, strerror(errno)) ;
+        }
+        close(to_worker[1]);
+        close(from_worker[0]);
+        slave->state = MonteSlave::MC_DISCONNECTED;
+        return;
+    }
+
+    /** <li> The worker is initializing until it writes its initialization information over its pipe. </ul> */
+    slave->pid = pid;
+    slave->connection.socket = from_worker[0];
+    slave->pipe_fd = to_worker[1];
+    slave->state = MonteSlave::MC_INITIALIZING;
+}
+
+int Trick::MonteCarlo::read_from_slave(MonteSlave& slave, TCDevice& device, char* data, int size) {
+    if (slave.local_worker) {
+        return read_fully(device.socket, data, size);
+    }
+    return tc_read(&device, data, size);
+}
+
+int Trick::MonteCarlo::write_to_slave(MonteSlave& slave, char* data, int size) {
+    if (slave.local_worker) {
+        return write_fully(slave.pipe_fd, data, size);
+    }
+    return tc_write(&slave.connection, data, size);
+}
+
+/**
+ * @par Detailed Design:
+ * A local worker's pipes are closed and the worker is reaped. A worker shut down by the master exits once it reads
+ * the shutdown command or the closed pipe. A worker the master lost is killed first, since its run has been retried
+ * elsewhere and it may never read its pipe again.
+ */
+void Trick::MonteCarlo::disconnect_slave(MonteSlave& slave) {
+    if (slave.local_worker) {
+        if (slave.connection.socket != TRICKCOMM_INVALID_SOCKET) {
+            close(slave.connection.socket);
+            slave.connection.socket = TRICKCOMM_INVALID_SOCKET;
+        }
+        if (slave.pipe_fd != -1) {
+            close(slave.pipe_fd);
+            slave.pipe_fd = -1;
+        }
+        if (slave.pid > 0) {
+            if (slave.state == MonteSlave::MC_DISCONNECTED) {
+                kill(slave.pid, SIGKILL);
+            }
+            while (waitpid(slave.pid, NULL, 0) == -1 && errno == EINTR) {
+            }
+            slave.pid = 0;
+        }
+    } else if (slave.connection.socket != TRICKCOMM_INVALID_SOCKET) {
+        tc_disconnect(&slave.connection);
+    }
+}
+
+int Trick::MonteCarlo::read_from_master(char* data, int size) {
+    if (pipe_fd != -1) {
+        return read_fully(connection_device.socket, data, size);
+    }
+    return tc_read(&connection_device, data, size);
+}
+
+int Trick::MonteCarlo::write_to_master(char* data, int size) {
+    if (pipe_fd != -1) {
+        return write_fully(pipe_fd, data, size);
+    }
+    return tc_write(&connection_device, data, size);
+}
@@ -25,14 +25,22 @@ int Trick::MonteCarlo::master() {
              */
             spawn_slaves();
 
-            /** <li> Receive any finished runs. */
+            /** <li> Wait for and receive any finished runs. */
             receive_results();
 
             /** <li> Check to see if any dispatched units have timed out. */
             check_timeouts();
 
-            /** <li> Dispatch the next run to a ready slave. </ul> */
-            dispatch_run_to_slave(get_next_dispatch(), get_ready_slave());
+            /**
+             * <li> Dispatch runs to ready slaves, then ahead to busy slaves, until one or the other runs out.
+             * </ul>
+             */
+            MonteRun *run;
+            MonteSlave *slave;
+            while ((run = get_next_dispatch()) != NULL &&
+              ((slave = get_ready_slave()) != NULL || (slave = get_dispatch_ahead_slave()) != NULL)) {
+                dispatch_run_to_slave(run, slave);
+            }
         }
     } catch (Trick::ExecutiveException & ex ) {
 
@@ -55,11 +55,10 @@ void Trick::MonteCarlo::shutdown_slaves() {
 
     for (std::vector<MonteSlave *>::size_type i = 0; i < slaves.size() ; ++i) {
         slaves[i]->state = MonteSlave::MC_FINISHED;
-        connection_device.hostname = (char*)slaves[i]->machine_name.c_str();
-        connection_device.port = slaves[i]->port;
-        if (tc_connect(&connection_device) == TC_SUCCESS) {
+        if (slaves[i]->connection.socket != TRICKCOMM_INVALID_SOCKET) {
             int command = htonl(MonteSlave::MC_SHUTDOWN);
-            tc_write(&connection_device, (char*)&command, sizeof(command));
+            write_to_slave(*slaves[i], (char*)&command, sizeof(command));
+            disconnect_slave(*slaves[i]);
         }
     }
 }
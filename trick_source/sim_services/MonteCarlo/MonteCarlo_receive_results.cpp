@@ -1,14 +1,64 @@
+#include <math.h>
+#include <poll.h>
+#include <sys/time.h>
+
 #include "trick/MonteCarlo.hh"
 #include "trick/message_proto.h"
 #include "trick/message_type.h"
 #include "trick/tc_proto.h"
 
+/**
+ * Longest the master waits for slaves, in milliseconds, so that slaves started, stopped, or added through the
+ * variable server are noticed promptly.
+ */
+static const int max_poll_timeout = 100;
+
 /**
  * @par Detailed Design:
- * This function performs a non-blocking accept on the listening socket.
+ * This function polls the listening socket and every slave's connection, blocking until one of them is ready or the
+ * next dispatched run could time out.
  */
 void Trick::MonteCarlo::receive_results() {
 
+    /** <ul><li> Wait for a new connection, results from a slave, or the next timeout. */
+    std::vector<struct pollfd> fds;
+    std::vector<MonteSlave *> polled_slaves;
+    struct pollfd listen_fd = { listen_device.socket, POLLIN, 0 };
+    fds.push_back(listen_fd);
+    for (std::vector<MonteSlave *>::size_type i = 0; i < slaves.size(); ++i) {
+        if (slaves[i]->connection.socket != TRICKCOMM_INVALID_SOCKET) {
+            struct pollfd slave_fd = { slaves[i]->connection.socket, POLLIN, 0 };
+            fds.push_back(slave_fd);
+            polled_slaves.push_back(slaves[i]);
+        }
+    }
+    if (poll(&fds[0], fds.size(), get_poll_timeout()) <= 0) {
+        return;
+    }
+
+    /** <li> Receive results from every slave with data on its connection. */
+    for (std::vector<MonteSlave *>::size_type i = 0; i < polled_slaves.size(); ++i) {
+        if (fds[i + 1].revents != 0) {
+            MonteSlave* slave = polled_slaves[i];
+            int id;
+            if (read_from_slave(*slave, slave->connection, (char*)&id, (int)sizeof(id)) != (int)sizeof(id) ||
+              (unsigned int)ntohl(id) != slave->id) {
+                set_disconnected_state(*slave);
+                continue;
+            }
+            /* A local worker initializes over its pipe. */
+            if (slave->state == MonteSlave::MC_INITIALIZING) {
+                handle_initialization(*slave, slave->connection);
+            } else {
+                receive_run_data(*slave, slave->connection);
+            }
+        }
+    }
+
+    if (fds[0].revents == 0) {
+        return;
+    }
+
     /** <li> While there are pending connections: */
     while (tc_accept(&listen_device, &connection_device) == TC_SUCCESS) {
 
@@ -23,24 +73,53 @@ void Trick::MonteCarlo::receive_results() {
               "Monte [Master] Slave returned an invalid id (%d)\n",
               id) ;
             tc_disconnect(&connection_device);
-            return;
+            continue;
         }
 
         /**
          * <li> If the slave is in the MC_INITIALIZING state, it is sending us the
-         * machine name and port over which it is listening for new runs.
+         * machine name and port over which it is listening, and the connection
+         * becomes the slave's connection.
          */
         if (slave->state == MonteSlave::MC_INITIALIZING) {
-            handle_initialization(*slave);
+            handle_initialization(*slave, connection_device);
         }
-        /** <li> Otherwise, it's sending us run data. */
+        /** <li> Otherwise, it's sending us run data. </ul></ul> */
         else {
-            handle_run_data(*slave);
+            receive_run_data(*slave, connection_device);
+        }
+        if (connection_device.socket != TRICKCOMM_INVALID_SOCKET) {
+            tc_disconnect(&connection_device);
+        }
+    }
+}
+
+/**
+ * @par Detailed Design:
+ * The wait ends when the earliest running run reaches #timeout, scaled by its slave's MonteSlave::multiplier, and is
+ * at most max_poll_timeout.
+ */
+int Trick::MonteCarlo::get_poll_timeout() {
+    struct timeval time_val;
+    gettimeofday(&time_val, NULL);
+    double now = time_val.tv_sec + (double)time_val.tv_usec / 1000000;
+    double wait = max_poll_timeout / 1000.0;
+    for (std::vector<Trick::MonteSlave *>::size_type i = 0; i < slaves.size(); ++i) {
+        if ((slaves[i]->state == MonteSlave::MC_RUNNING || slaves[i]->state == MonteSlave::MC_STOPPING) &&
+          slaves[i]->current_run) {
+            double remaining = slaves[i]->current_run->start_time + timeout / slaves[i]->multiplier - now;
+            if (remaining < wait) {
+                wait = remaining;
+            }
         }
     }
+    if (wait <= 0.0) {
+        return 0;
+    }
+    return (int)ceil(wait * 1000);
 }
 
-void Trick::MonteCarlo::handle_initialization(Trick::MonteSlave& slave) {
+void Trick::MonteCarlo::handle_initialization(Trick::MonteSlave& slave, TCDevice& device) {
         if (verbosity >= MC_ALL) {
             message_publish(
               MSG_INFO,
@@ -49,7 +128,7 @@ void Trick::MonteCarlo::handle_initialization(Trick::MonteSlave& slave) {
         }
 
         int size;
-        if (tc_read(&connection_device, (char*)&size, (int)sizeof(size)) != (int)sizeof(size)) {
+        if (read_from_slave(slave, device, (char*)&size, (int)sizeof(size)) != (int)sizeof(size)) {
             set_disconnected_state(slave);
             return;
         }
@@ -57,31 +136,69 @@ void Trick::MonteCarlo::handle_initialization(Trick::MonteSlave& slave) {
 
         char name[size + 1];
         name[size] = '\0';
-        if (tc_read(&connection_device, name, size) != size) {
+        if (read_from_slave(slave, device, name, size) != size) {
             set_disconnected_state(slave);
             return;
         }
         slave.machine_name = std::string(name);
 
         size = (int)sizeof(slave.port);
-        if (tc_read(&connection_device, (char*)&slave.port, size) != size) {
+        if (read_from_slave(slave, device, (char*)&slave.port, size) != size) {
             set_disconnected_state(slave) ;
             return;
         }
         slave.port = ntohl(slave.port);
 
+        /* Keep the connection. Runs are dispatched and results returned over it from now on. */
+        if (&device != &slave.connection) {
+            slave.connection = device;
+            device.socket = TRICKCOMM_INVALID_SOCKET;
+        }
         slave.state = MonteSlave::MC_READY;
-        tc_disconnect(&connection_device);
 }
 
-void Trick::MonteCarlo::handle_run_data(Trick::MonteSlave& slave) {
+/**
+ * @par Detailed Design:
+ * Results are the run id, the exit status, and the length and contents of the data written by the slave's post run
+ * jobs.
+ */
+void Trick::MonteCarlo::receive_run_data(Trick::MonteSlave& slave, TCDevice& device) {
+    int header[3];
+    if (read_from_slave(slave, device, (char*)header, (int)sizeof(header)) != (int)sizeof(header)) {
+        set_disconnected_state(slave);
+        return;
+    }
+    int size = ntohl(header[2]);
+    run_data.resize(size < 0 ? 0 : size);
+    run_data_offset = 0;
+    if (size > 0 && read_from_slave(slave, device, &run_data[0], size) != size) {
+        set_disconnected_state(slave);
+        return;
+    }
+    handle_run_data(slave, ntohl(header[0]), ntohl(header[1]));
+}
+
+void Trick::MonteCarlo::handle_run_data(Trick::MonteSlave& slave, unsigned int run_id, int exit_status) {
+    /**
+     * <ul><li> Discard results for a run that is no longer this slave's. This covers the case in which the slave
+     * timed out, the run that was dispatched ahead to it was requeued, and the slave ran it anyway, and the case in
+     * which a run's slave post jobs fail after it returned results.
+     */
+    if (slave.current_run == NULL || slave.current_run->id != run_id) {
+        if (verbosity >= MC_ALL) {
+            message_publish(MSG_INFO, "Monte [Master] Run %d is no longer dispatched to %s:%d. Discarding results.\n",
+                 run_id, slave.machine_name.c_str(), slave.id) ;
+        }
+        return;
+    }
+
     if (verbosity >= MC_INFORMATIONAL) {
         message_publish(MSG_INFO, "Monte [Master] Receiving results for run %d from %s:%d.\n",
              slave.current_run->id, slave.machine_name.c_str(), slave.id) ;
     }
 
     /**
-     * <ul><li> Try to remove this run from the queue in case it was requeued by #check_timeouts.
+     * <li> Try to remove this run from the queue in case it was requeued by #check_timeouts.
      * This covers the case in which the master determines that a slave has timed out, requeues
      * the run, and then the slave reports results.
      */
@@ -93,10 +210,6 @@ void Trick::MonteCarlo::handle_run_data(Trick::MonteSlave& slave) {
      * discard these results.
      */
     if (slave.current_run->exit_status != MonteRun::MC_RUN_INCOMPLETE) {
-        // TODO: If a slave times out or core dumps in it's monte_slave_post
-        // jobs, the master will receive a MC_RUN_COMPLETE status from the slave's
-        // child process and then an error status from the parent, rendering
-        // this message incorrect.
         if (verbosity >= MC_ALL) {
             message_publish(
               MSG_INFO,
@@ -105,14 +218,6 @@ void Trick::MonteCarlo::handle_run_data(Trick::MonteSlave& slave) {
         }
     } else {
         /** <li> Otherwise, check the exit status: */
-        int exit_status;
-        int size = sizeof(exit_status);
-        if (tc_read(&connection_device, (char*)&exit_status, size) != size) {
-            set_disconnected_state(slave) ;
-            return;
-        }
-        exit_status = ntohl(exit_status);
-
         switch (exit_status) {
 
             case MonteRun::MC_RUN_COMPLETE:
@@ -172,22 +277,30 @@ void Trick::MonteCarlo::handle_run_data(Trick::MonteSlave& slave) {
                 break;
         }
     }
-    
-    tc_disconnect(&connection_device);
 
-    /** <li> Update the slave's state. */
+    /** <li> Update the slave's state and start the run dispatched ahead to it, if any. </ul> */
     if (slave.state == MonteSlave::MC_RUNNING || slave.state == MonteSlave::MC_UNRESPONSIVE_RUNNING) {
         slave.state = MonteSlave::MC_READY;
     } else if (slave.state == MonteSlave::MC_STOPPING || slave.state == MonteSlave::MC_UNRESPONSIVE_STOPPING) {
         slave.state = MonteSlave::MC_STOPPED;
     }
+    start_next_run(slave);
 }
 
+/**
+ * @par Detailed Design:
+ * A run the slave was processing is retried, and a run dispatched ahead to it is requeued.
+ */
 void Trick::MonteCarlo::set_disconnected_state(Trick::MonteSlave& slave) {
+    if ((slave.state == MonteSlave::MC_RUNNING || slave.state == MonteSlave::MC_STOPPING) &&
+      slave.current_run->exit_status == MonteRun::MC_RUN_INCOMPLETE) {
+        handle_retry(slave, MonteRun::MC_RUN_TIMED_OUT);
+    }
+    start_next_run(slave, true);
     slave.state = Trick::MonteSlave::MC_DISCONNECTED;
     if (verbosity >= MC_ERROR) {
         message_publish(MSG_ERROR, "Monte [Master] Lost connection to %s:%d.\n",
                         slave.machine_name.c_str(), slave.id) ;
     }
-    tc_disconnect(&connection_device);
+    disconnect_slave(slave);
 }
@@ -13,16 +13,13 @@ int Trick::MonteCarlo::execute_as_slave() {
             message_publish(MSG_INFO, "Monte [%s:%d] Waiting for new run.\n",
                             machine_name.c_str(), slave_id) ;
         }
-        /** <ul><li> On a blocking read, wait for a MonteSlave::Command from the master. */
-        if (tc_accept(&listen_device, &connection_device) != TC_SUCCESS) {
-            if (verbosity >= MC_ERROR) {
-                message_publish(MSG_ERROR, "Monte [%s:%d] Lost connection to Master. Shutting down.\n",
-                                machine_name.c_str(), slave_id) ;
-            }
-            slave_shutdown();
-        }
-        int command;
-        if (tc_read(&connection_device, (char *)&command, (int)sizeof(command)) != (int)sizeof(command)) {
+        /**
+         * <ul><li> On a blocking read, wait for a MonteSlave::Command from the master, unless #slave_run_cancelled
+         * already read it. Commands dispatched while a run was executing are already waiting on the connection.
+         */
+        int command = pending_command;
+        pending_command = -1;
+        if (command == -1 && read_from_master((char *)&command, (int)sizeof(command)) != (int)sizeof(command)) {
             if (verbosity >= MC_ERROR) {
                 message_publish(MSG_ERROR, "Monte [%s:%d] Lost connection to Master while receiving instructions. Shutting down.\n",
                                 machine_name.c_str(), slave_id) ;
@@ -31,6 +28,7 @@ int Trick::MonteCarlo::execute_as_slave() {
         }
         switch (command = ntohl(command)) {
             int return_value;
+            int cancelled_run;
             case MonteSlave::MC_PROCESS_RUN:
                 /**
                  * <ul><li> MonteSlave::MC_PROCESS_RUN: Call #slave_process_run. This will return a non-zero value when run in a
@@ -41,6 +39,15 @@ int Trick::MonteCarlo::execute_as_slave() {
                     return return_value;
                 }
                 break;
+            case MonteSlave::MC_CANCEL_RUN:
+                /**
+                 * <li> MonteSlave::MC_CANCEL_RUN: The cancelled run was already started, the master discards its
+                 * results. Read the run id and ignore it.
+                 */
+                if (read_from_master((char *)&cancelled_run, (int)sizeof(cancelled_run)) != (int)sizeof(cancelled_run)) {
+                    slave_shutdown();
+                }
+                break;
             case MonteSlave::MC_SHUTDOWN:
                 /** <li> MonteSlave::MC_SHUTDOWN: Call #slave_shutdown. */
                 if (verbosity >= MC_INFORMATIONAL) {
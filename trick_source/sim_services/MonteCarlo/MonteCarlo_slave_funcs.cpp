@@ -1,6 +1,16 @@
 
+#include <string.h>
+#include <stdlib.h>
+
 #include "trick/MonteCarlo.hh"
 #include "trick/SysThread.hh"
+#include "trick/MemoryManager.hh"
+#include "trick/memorymanager_c_intf.h"
+#include "trick/CommandLineArguments.hh"
+#include "trick/message_proto.h"
+#include "trick/message_type.h"
+
+extern Trick::CommandLineArguments * the_cmd_args;
 
 
 /** @par Detailed Design: */
@@ -42,3 +52,70 @@ void Trick::MonteCarlo::slave_kill_run() {
 void Trick::MonteSlave::set_S_main_name(std::string name) {
     S_main_name = name;
 }
+
+/** @par Detailed Design: */
+void Trick::MonteCarlo::copy_initialized_state(std::map<void *, std::string>& copy) {
+    copy.clear();
+    /** <ul><li> Copy the bytes of each memory managed allocation. </ul> */
+    for (Trick::AllocInfoMap::const_iterator it = trick_MM->alloc_info_map_begin();
+         it != trick_MM->alloc_info_map_end(); ++it) {
+        ALLOC_INFO *alloc_info = it->second;
+        if (alloc_info != NULL && alloc_info->start != NULL) {
+            copy[alloc_info->start].assign((char *)alloc_info->start, (char *)alloc_info->end + 1);
+        }
+    }
+}
+
+/** @par Detailed Design: */
+int Trick::MonteCarlo::check_initialized_state(const std::map<void *, std::string>& copy) {
+    /** <ul><li> The run may change the Monte Carlo variables. */
+    std::vector<std::pair<char *, char *> > allowed;
+    for (std::vector<MonteVar *>::size_type i = 0; i < variables.size(); ++i) {
+        REF2 *ref = ref_attributes(variables[i]->name.c_str());
+        if (ref != NULL) {
+            allowed.push_back(std::make_pair((char *)ref->address, (char *)ref->address + ref->attr->size));
+            ref_free(ref);
+            free(ref);
+        }
+    }
+    /** <li> This object and the command line arguments hold the run number and output directory. */
+    allowed.push_back(std::make_pair((char *)this, (char *)(this + 1)));
+    if (the_cmd_args != NULL) {
+        allowed.push_back(std::make_pair((char *)the_cmd_args, (char *)(the_cmd_args + 1)));
+    }
+
+    /** <li> Warn of the first other difference in each allocation. </ul> */
+    int num_changed = 0;
+    for (std::map<void *, std::string>::const_iterator it = copy.begin(); it != copy.end(); ++it) {
+        const std::string& before = it->second;
+        char *now = (char *)it->first;
+        ALLOC_INFO *alloc_info = trick_MM->get_alloc_info_at(it->first);
+        if (alloc_info == NULL || (char *)alloc_info->end + 1 - now != (long)before.size() ||
+          memcmp(now, before.data(), before.size()) == 0) {
+            continue;
+        }
+        std::string::size_type j = 0;
+        while (j < before.size()) {
+            if (now[j] == before[j]) {
+                ++j;
+                continue;
+            }
+            std::vector<std::pair<char *, char *> >::size_type k = 0;
+            while (k < allowed.size() && (now + j < allowed[k].first || now + j >= allowed[k].second)) {
+                ++k;
+            }
+            if (k < allowed.size()) {
+                j = allowed[k].second - now;
+                continue;
+            }
+            if (verbosity >= MC_ERROR) {
+                message_publish(MSG_WARNING, "Monte [%s:%d] %s changed in run %d but is not a Monte Carlo variable.\n",
+                                machine_name.c_str(), slave_id, trick_MM->ref_name_from_address(now + j).c_str(),
+                                current_run) ;
+            }
+            ++num_changed;
+            break;
+        }
+    }
+    return num_changed;
+}
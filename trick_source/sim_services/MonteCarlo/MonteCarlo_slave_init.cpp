@@ -26,15 +26,20 @@ int Trick::MonteCarlo::slave_init() {
     /** <li> Run the slave initialization jobs. */
     run_queue(&slave_init_queue, "in slave_init queue") ;
 
-    /** <li> Initialize the sockets. */
-    tc_error(&listen_device, 0);
-    tc_error(&connection_device, 0);
-    tc_init(&listen_device);
-    listen_device.disable_handshaking = TC_COMM_TRUE;
+    /** <li> A local worker already has its pipes to the master. Otherwise initialize the sockets. */
+    if (pipe_fd == -1) {
+        tc_error(&listen_device, 0);
+        tc_error(&connection_device, 0);
+        tc_init(&listen_device);
+        listen_device.disable_handshaking = TC_COMM_TRUE;
+    }
 
-    /** <li> Connect to the master and write the port over which we are listening for new runs. */
+    /**
+     * <li> Connect to the master and write the port over which we are listening for new runs. The connection stays
+     * open. Runs are received and results returned over it.
+     */
     connection_device.port = master_port;
-    if (tc_connect(&connection_device) != TC_SUCCESS) {
+    if (pipe_fd == -1 && tc_connect(&connection_device) != TC_SUCCESS) {
         if (verbosity >= MC_ERROR) {
             message_publish(MSG_ERROR, "Monte [%s:%d] Failed to initialize communication sockets.\nTerminating.\n",
                             machine_name.c_str(), slave_id) ;
@@ -48,17 +53,16 @@ int Trick::MonteCarlo::slave_init() {
     }
 
     int id = htonl(slave_id);
-    tc_write(&connection_device, (char *)&id, (int)sizeof(id));
+    write_to_master((char *)&id, (int)sizeof(id));
 
     char hostname[_POSIX_HOST_NAME_MAX] = {};
     gethostname(hostname, sizeof(hostname)-1);
 
     int num_bytes = htonl(strlen(hostname));
-    tc_write(&connection_device, (char *)&num_bytes, (int)sizeof(num_bytes));
-    tc_write(&connection_device, hostname, strlen(hostname));
+    write_to_master((char *)&num_bytes, (int)sizeof(num_bytes));
+    write_to_master(hostname, strlen(hostname));
     int listen_port = htonl(listen_device.port);
-    tc_write(&connection_device, (char *)&listen_port, (int)sizeof(listen_port));
-    tc_disconnect(&connection_device);
+    write_to_master((char *)&listen_port, (int)sizeof(listen_port));
 
     return 0;
 }
@@ -1,4 +1,5 @@
 
+#include <poll.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
 #include <stdio.h>
@@ -11,11 +12,16 @@
 #include "trick/message_type.h"
 #include "trick/tc_proto.h"
 
+/* The number of runs this slave has forked. */
+static int num_runs_forked = 0;
+
 /** @par Detailed Design: */
 int Trick::MonteCarlo::slave_process_run() {
+    int run_id;
     int size;
-    /** <ul><li> Read the length of the incoming message. */
-    if (tc_read(&connection_device, (char *)&size, (int)sizeof(size)) != (int)sizeof(size) || (size = ntohl(size)) < 0) {
+    /** <ul><li> Read the run id and the length of the incoming message. */
+    if (read_from_master((char *)&run_id, (int)sizeof(run_id)) != (int)sizeof(run_id) ||
+      read_from_master((char *)&size, (int)sizeof(size)) != (int)sizeof(size) || (size = ntohl(size)) < 0) {
         if (verbosity >= MC_ERROR) {
             message_publish(MSG_ERROR, "Monte [%s:%d] Lost connection to Master while receiving new run.\nShutting down.\n",
                             machine_name.c_str(), slave_id) ;
@@ -24,14 +30,24 @@ int Trick::MonteCarlo::slave_process_run() {
     }
     char *input = new char[size + 1];
     /** <li> Read the incoming message. */
-    if (tc_read(&connection_device, input, size) != size) {
+    if (read_from_master(input, size) != size) {
         if (verbosity >= MC_ERROR) {
             message_publish(MSG_ERROR, "Monte [%s:%d] Lost connection to Master while receiving new run.\nShutting down.\n",
                             machine_name.c_str(), slave_id) ;
         }
         slave_shutdown();
     }
-    tc_disconnect(&connection_device);
+    current_run = ntohl(run_id);
+
+    /** <li> Skip the run if the master cancelled it after dispatching it ahead. */
+    if (slave_run_cancelled(current_run)) {
+        if (verbosity >= MC_INFORMATIONAL) {
+            message_publish(MSG_INFO, "Monte [%s:%d] Run %d was cancelled by Master.\n",
+                            machine_name.c_str(), slave_id, current_run) ;
+        }
+        delete [] input;
+        return 0;
+    }
 
     /**
      * <li> fork() a child process to execute the simulation.
@@ -47,6 +63,7 @@ int Trick::MonteCarlo::slave_process_run() {
         slave_shutdown();
     /** <li>Parent process: */
     } else if (pid != 0) {
+        ++num_runs_forked;
         int return_value = 0 ;
         /** <li> Wait for the child to finish. */
         if (waitpid(pid, &return_value, 0) == -1) {
@@ -75,34 +92,45 @@ int Trick::MonteCarlo::slave_process_run() {
             message_publish(MSG_ERROR, "Monte [%s:%d] Run killed by signal %d: %s\n",
                             machine_name.c_str(), slave_id, signal, strsignal(signal)) ;
         }
-        connection_device.port = master_port;
-        if (tc_connect(&connection_device) != TC_SUCCESS) {
+        if (verbosity >= MC_ALL) {
+            message_publish(MSG_INFO, "Monte [%s:%d] Sending run exit status to master %d.\n",
+                            machine_name.c_str(), slave_id, exit_status) ;
+        }
+        /** <li> Write the slave's id, the run id, and the child's exit status to the master, with no data. </ul> */
+        int header[4];
+        header[0] = htonl(slave_id);
+        header[1] = htonl(current_run);
+        header[2] = htonl(exit_status);
+        header[3] = 0;
+        if (write_to_master((char *)header, (int)sizeof(header)) != (int)sizeof(header)) {
             if (verbosity >= MC_ERROR) {
                 message_publish(MSG_ERROR, "Monte [%s:%d] Lost connection to Master before results could be returned.\nShutting down.\n",
                                 machine_name.c_str(), slave_id) ;
             }
             slave_shutdown();
         }
-        if (verbosity >= MC_ALL) {
-            message_publish(MSG_INFO, "Monte [%s:%d] Sending run exit status to master %d.\n",
-                            machine_name.c_str(), slave_id, exit_status) ;
-        }
-        /** <li> Write the slaves id to the master. </ul> */
-        int id = htonl(slave_id);
-        tc_write(&connection_device, (char *)&id, (int)sizeof(id));
-        /** <li> Write the child's exit status to the master. </ul> */
-        return_value = htonl(exit_status);
-        tc_write(&connection_device, (char *)&return_value, (int)sizeof(return_value));
-        tc_disconnect(&connection_device);
         return 0;
     /** <li> Child process: */
     } else {
         input[size] = '\0';
+        /**
+         * <ul><li> When the slave initialized once, the first run it forks checks that the run's input changes
+         * nothing in the initialized state but the Monte Carlo variables.
+         */
+        std::map<void *, std::string> initialized_state;
+        bool check_state = slave_init_once && num_runs_forked == 0;
+        if (check_state) {
+            copy_initialized_state(initialized_state);
+        }
         if ( ip_parse(input) != 0 ) {
             exit(MonteRun::MC_PROBLEM_PARSING_INPUT);
         }
+        if (check_state) {
+            check_initialized_state(initialized_state);
+            initialized_state.clear();
+        }
 
-        /** <ul><li> Create the run directory. */
+        /** <li> Create the run directory. */
         std::string output_dir = command_line_args_get_output_dir();
         if (access(output_dir.c_str(), F_OK) != 0) {
             if (mkdir(output_dir.c_str(), 0775) == -1) {
@@ -151,3 +179,33 @@ int Trick::MonteCarlo::slave_process_run() {
     }
     return 0;
 }
+
+/**
+ * @par Detailed Design:
+ * A cancel is written after the run it cancels, so it is already waiting if the master cancelled the run while this
+ * slave was busy with the one before it.
+ */
+bool Trick::MonteCarlo::slave_run_cancelled(int run_id) {
+    struct pollfd fd = { connection_device.socket, POLLIN, 0 };
+    /** <ul><li> While a command is waiting on the connection: */
+    while (pending_command == -1 && poll(&fd, 1, 0) > 0 && (fd.revents & POLLIN)) {
+        /** <ul><li> Read it. Keep any command but a cancel for #execute_as_slave. */
+        int command;
+        if (read_from_master((char *)&command, (int)sizeof(command)) != (int)sizeof(command)) {
+            return false;
+        }
+        if ((int)ntohl(command) != MonteSlave::MC_CANCEL_RUN) {
+            pending_command = command;
+            return false;
+        }
+        /** <li> A cancel for another run is for a run that was already started, ignore it. </ul></ul> */
+        int cancelled_id;
+        if (read_from_master((char *)&cancelled_id, (int)sizeof(cancelled_id)) != (int)sizeof(cancelled_id)) {
+            return false;
+        }
+        if ((int)ntohl(cancelled_id) == run_id) {
+            return true;
+        }
+    }
+    return false;
+}
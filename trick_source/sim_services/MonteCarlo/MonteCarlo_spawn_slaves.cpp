@@ -17,10 +17,14 @@ void Trick::MonteCarlo::spawn_slaves() {
     /** <ul><li> For all slaves: */
     for (std::vector<MonteSlave *>::size_type i = 0; i < slaves.size(); ++i) {
         /** <ul><li> If the slave is in the UNINITIALZED state, then
-          * set up the command string for starting the slave.
+          * fork a local worker or set up the command string for starting the slave.
           */
         if (slaves[i]->state == MonteSlave::MC_UNINITIALIZED) {
-            initialize_slave(slaves[i]) ;
+            if (slaves[i]->local_worker) {
+                spawn_local_worker(slaves[i]) ;
+            } else {
+                initialize_slave(slaves[i]) ;
+            }
         }
     }
 }
@@ -0,0 +1,151 @@
+#define protected public
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+#include "trick/ExecutiveException.hh"
+#include "trick/CommandLineArguments.hh"
+#include "trick/mc_master.hh"
+#include "trick/mc_variable_fixed.hh"
+#include "trick/mc_variable_random_normal.hh"
+#include "trick/mc_variable_random_uniform.hh"
+
+class MonteCarloGenerationTest : public ::testing::Test {
+
+    protected:
+        Trick::CommandLineArguments cmd_args ;
+        MonteCarloMaster master ;
+        MonteCarloVariableRandomNormal normal ;
+        MonteCarloVariableRandomUniform uniform ;
+        MonteCarloVariableFixed fixed ;
+        std::string top_dir ;
+
+        MonteCarloGenerationTest() :
+         master("monte_carlo.mc_master") ,
+         normal("test.x", 5, 10.0, 2.0) ,
+         uniform("test.y", 7, -1.0, 1.0) ,
+         fixed("test.z", 3) {}
+        ~MonteCarloGenerationTest() {}
+
+        virtual void SetUp() {
+            char dir_template[] = "/tmp/mc_generation_XXXXXX" ;
+            top_dir = mkdtemp(dir_template) ;
+            master.activate("RUN_test") ;
+            master.monte_dir = top_dir + "/MONTE_RUN_test" ;
+            master.use_run_table = true ;
+            master.generate_meta_data = false ;
+            master.set_num_runs(12) ;
+            master.add_variable(normal) ;
+            master.add_variable(uniform) ;
+            master.add_variable(fixed) ;
+        }
+        virtual void TearDown() {
+            std::string command = "rm -rf " + top_dir ;
+            system(command.c_str()) ;
+        }
+
+        bool exists( std::string path ) {
+            struct stat st ;
+            return stat(path.c_str(), &st) == 0 ;
+        }
+
+        // The assignments every variable makes for a run, in table order.
+        std::string generate_run( size_t run_num ) {
+            std::string commands ;
+            for ( auto var : master.variables ) {
+                var->reseed_for_run(run_num) ;
+                var->generate_assignment() ;
+                commands += var->get_command() ;
+            }
+            return commands ;
+        }
+} ;
+
+TEST_F(MonteCarloGenerationTest , PrepareRunTable) {
+    EXPECT_TRUE(master.prepare_input_files()) ;
+
+    // One line and one index entry per run, each line naming its run.
+    std::ifstream index(master.monte_dir + "/monte_run_table_index", std::ios::binary) ;
+    std::ifstream table(master.monte_dir + "/monte_run_table", std::ios::binary) ;
+    ASSERT_TRUE(index.is_open()) ;
+    ASSERT_TRUE(table.is_open()) ;
+    std::vector<uint64_t> offsets(12) ;
+    index.read(reinterpret_cast<char *>(offsets.data()), offsets.size() * sizeof(uint64_t)) ;
+    EXPECT_TRUE(index.good()) ;
+    EXPECT_EQ(index.peek(), EOF) ;
+
+    char expected[8] ;
+    for ( int ii = 0 ; ii < 12 ; ii++ ) {
+        std::string line ;
+        EXPECT_EQ((uint64_t)table.tellg(), offsets[ii]) ;
+        std::getline(table, line) ;
+        snprintf(expected, sizeof(expected), "RUN_%02d ", ii) ;
+        EXPECT_EQ(line.compare(0, 7, expected), 0) << line ;
+        EXPECT_EQ(line.find('\n'), std::string::npos) ;
+    }
+    std::string line ;
+    EXPECT_FALSE(std::getline(table, line)) ;
+
+    // The runs share one input file and no run directory exists yet.
+    EXPECT_TRUE(exists(master.monte_dir + "/monte_input.py")) ;
+    EXPECT_TRUE(exists(master.monte_dir + "/monte_values_all_runs")) ;
+    EXPECT_FALSE(exists(master.monte_dir + "/RUN_00")) ;
+    EXPECT_FALSE(exists(master.monte_dir + "/RUN_11")) ;
+}
+
+TEST_F(MonteCarloGenerationTest , LoadRun) {
+    master.prepare_input_files() ;
+
+    EXPECT_TRUE(master.load_run(7)) ;
+    EXPECT_EQ(master.monte_run_number, 7u) ;
+    EXPECT_EQ(master.loaded_run_dir, master.monte_dir + "/RUN_07") ;
+    EXPECT_EQ(master.get_run_commands(), generate_run(7)) ;
+    EXPECT_NE(master.get_run_commands().find("test.z = 3"), std::string::npos) ;
+    // Loading a run does not create its directory, starting it does.
+    EXPECT_FALSE(exists(master.monte_dir + "/RUN_07")) ;
+    master.start_run() ;
+    EXPECT_TRUE(exists(master.monte_dir + "/RUN_07")) ;
+    EXPECT_EQ(cmd_args.get_output_dir(), master.monte_dir + "/RUN_07") ;
+
+    EXPECT_TRUE(master.load_run(0)) ;
+    EXPECT_EQ(master.get_run_commands(), generate_run(0)) ;
+    EXPECT_FALSE(exists(master.monte_dir + "/RUN_00")) ;
+
+    EXPECT_THROW(master.load_run(12), Trick::ExecutiveException) ;
+}
+
+TEST_F(MonteCarloGenerationTest , StartRunWithoutLoad) {
+    std::string output_dir = cmd_args.get_output_dir() ;
+    master.start_run() ;
+    EXPECT_EQ(cmd_args.get_output_dir(), output_dir) ;
+}
+
+TEST_F(MonteCarloGenerationTest , ReseedForRun) {
+    // A run's values depend only on the seed and the run number, not on the
+    // runs generated before it.
+    std::string run_5 = generate_run(5) ;
+    std::string run_6 = generate_run(6) ;
+    EXPECT_NE(run_5, run_6) ;
+    generate_run(9) ;
+    EXPECT_EQ(generate_run(5), run_5) ;
+    EXPECT_EQ(generate_run(6), run_6) ;
+
+    // Generating another value in between does not change the next run.
+    normal.generate_assignment() ;
+    uniform.generate_assignment() ;
+    EXPECT_EQ(generate_run(5), run_5) ;
+
+    // Another seed gives other values.
+    MonteCarloVariableRandomNormal other("test.x", 6, 10.0, 2.0) ;
+    other.reseed_for_run(5) ;
+    other.generate_assignment() ;
+    normal.reseed_for_run(5) ;
+    normal.generate_assignment() ;
+    EXPECT_NE(other.get_command(), normal.get_command()) ;
+}
@@ -3,7 +3,11 @@
 
 #include <iostream>
 #include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
 #include <signal.h>
+#include <unistd.h>
 #include <string>
 #include <sstream>
 #include <cmath>
@@ -245,6 +249,9 @@ TEST_F(MonteCarloTest , TestDefaultValues) {
     EXPECT_EQ(exec.get_custom_slave_dispatch(), false) ;
     EXPECT_EQ(exec.get_timeout(), 120) ;
     EXPECT_EQ(exec.get_max_tries(), 2) ;
+    EXPECT_EQ(exec.get_dispatch_ahead(), true) ;
+    EXPECT_EQ(exec.get_slave_init_once(), false) ;
+    EXPECT_EQ(exec.get_local_workers(), 0) ;
     EXPECT_EQ(exec.get_verbosity(), exec.MC_INFORMATIONAL) ;
     EXPECT_EQ(exec.get_num_runs(), 0) ;
     EXPECT_EQ(exec.get_slave_id(), 0) ;
@@ -268,6 +275,12 @@ TEST_F(MonteCarloTest, TestSettingValues) {
     EXPECT_EQ(exec.get_timeout(), 60) ;
     exec.set_max_tries(4) ;
     EXPECT_EQ(exec.get_max_tries(), 4) ;
+    exec.set_dispatch_ahead(false) ;
+    EXPECT_EQ(exec.get_dispatch_ahead(), false) ;
+    exec.set_slave_init_once(true) ;
+    EXPECT_EQ(exec.get_slave_init_once(), true) ;
+    exec.set_local_workers(4) ;
+    EXPECT_EQ(exec.get_local_workers(), 4) ;
     exec.set_verbosity(exec.MC_NONE) ;
     EXPECT_EQ(exec.get_verbosity(), exec.MC_NONE) ;
     exec.set_verbosity(exec.MC_ERROR) ;
@@ -318,6 +331,278 @@ TEST_F(MonteCarloTest, TestSlaves) {
     EXPECT_EQ(slave1.machine_name, "WonderWoman") ;
 }
 
+TEST_F(MonteCarloTest, TestDispatchAhead) {
+    // A loopback TCP connection stands in for the slave's connection.
+    int fds[2] ;
+    int header[3] ;
+    struct sockaddr_in addr = {} ;
+    socklen_t addr_len = sizeof(addr) ;
+    int listen_socket = socket(AF_INET, SOCK_STREAM, 0) ;
+    addr.sin_family = AF_INET ;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK) ;
+    ASSERT_EQ(bind(listen_socket, (struct sockaddr *)&addr, sizeof(addr)), 0) ;
+    ASSERT_EQ(listen(listen_socket, 1), 0) ;
+    getsockname(listen_socket, (struct sockaddr *)&addr, &addr_len) ;
+    fds[1] = socket(AF_INET, SOCK_STREAM, 0) ;
+    ASSERT_EQ(connect(fds[1], (struct sockaddr *)&addr, sizeof(addr)), 0) ;
+    fds[0] = accept(listen_socket, NULL, NULL) ;
+    close(listen_socket) ;
+
+    Trick::MonteSlave slave0("localhost") ;
+    exec.add_slave(&slave0) ;
+    slave0.connection.socket = fds[0] ;
+    slave0.state = Trick::MonteSlave::MC_READY ;
+    exec.run_data_file = tmpfile() ;
+    exec.set_verbosity(exec.MC_NONE) ;
+    exec.set_num_runs(3) ;
+
+    // The first run starts on the ready slave, the second waits behind it.
+    exec.dispatch_run_to_slave(exec.get_next_dispatch(), exec.get_ready_slave()) ;
+    EXPECT_EQ(slave0.state, Trick::MonteSlave::MC_RUNNING) ;
+    EXPECT_EQ(slave0.current_run->id, 0) ;
+    EXPECT_TRUE(exec.get_ready_slave() == NULL) ;
+    EXPECT_EQ(exec.get_dispatch_ahead_slave(), &slave0) ;
+    exec.dispatch_run_to_slave(exec.get_next_dispatch(), exec.get_dispatch_ahead_slave()) ;
+    EXPECT_EQ(slave0.next_run->id, 1) ;
+    EXPECT_TRUE(exec.get_dispatch_ahead_slave() == NULL) ;
+    exec.update_actual_num_runs() ;
+    EXPECT_EQ(exec.actual_num_runs, 3) ;
+
+    // Both runs were written to the slave's connection.
+    ASSERT_EQ(read(fds[1], header, sizeof(header)), (ssize_t)sizeof(header)) ;
+    EXPECT_EQ((int)ntohl(header[0]), Trick::MonteSlave::MC_PROCESS_RUN) ;
+    EXPECT_EQ((int)ntohl(header[1]), 0) ;
+
+    // Results for the first run start the second.
+    exec.handle_run_data(slave0, 0, Trick::MonteRun::MC_RUN_COMPLETE) ;
+    EXPECT_EQ(exec.num_results, 1) ;
+    EXPECT_EQ(slave0.state, Trick::MonteSlave::MC_RUNNING) ;
+    EXPECT_EQ(slave0.current_run->id, 1) ;
+    EXPECT_TRUE(slave0.next_run == NULL) ;
+
+    // A timeout retries the current run and requeues the one dispatched ahead.
+    exec.dispatch_run_to_slave(exec.get_next_dispatch(), exec.get_dispatch_ahead_slave()) ;
+    slave0.current_run->start_time = 0 ;
+    exec.check_timeouts() ;
+    EXPECT_EQ(slave0.state, Trick::MonteSlave::MC_UNRESPONSIVE_RUNNING) ;
+    EXPECT_TRUE(slave0.next_run == NULL) ;
+    ASSERT_EQ(exec.runs.size(), 2) ;
+    EXPECT_EQ(exec.runs.front()->id, 2) ;
+    EXPECT_EQ(exec.runs.back()->id, 1) ;
+
+    // Results for the requeued run are discarded.
+    exec.handle_run_data(slave0, 2, Trick::MonteRun::MC_RUN_COMPLETE) ;
+    EXPECT_EQ(exec.num_results, 1) ;
+
+    // Data returned with a run is read by the master post jobs.
+    char data[8] = {} ;
+    exec.run_data = "results" ;
+    exec.run_data_offset = 0 ;
+    EXPECT_EQ(exec.read(data, 4), 4) ;
+    EXPECT_EQ(exec.read(data + 4, 8), 3) ;
+    EXPECT_STREQ(data, "results") ;
+
+    fclose(exec.run_data_file) ;
+    close(fds[0]) ;
+    close(fds[1]) ;
+}
+
+TEST_F(MonteCarloTest, TestTimeoutCancelsDispatchedAhead) {
+    // A socket pair stands in for the connection between the master and a local worker.
+    int to_worker[2] ;
+    int header[3] ;
+    int cancel[2] ;
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, to_worker), 0) ;
+
+    Trick::MonteSlave slave0("localhost") ;
+    exec.add_slave(&slave0) ;
+    slave0.local_worker = true ;
+    slave0.pipe_fd = to_worker[1] ;
+    slave0.state = Trick::MonteSlave::MC_READY ;
+    exec.run_data_file = tmpfile() ;
+    exec.set_verbosity(exec.MC_NONE) ;
+    exec.set_num_runs(2) ;
+
+    exec.dispatch_run_to_slave(exec.get_next_dispatch(), exec.get_ready_slave()) ;
+    exec.dispatch_run_to_slave(exec.get_next_dispatch(), exec.get_dispatch_ahead_slave()) ;
+    ASSERT_EQ(slave0.next_run->id, 1) ;
+
+    // The timeout requeues the run dispatched ahead and cancels it on the slave.
+    slave0.current_run->start_time = 0 ;
+    exec.check_timeouts() ;
+    EXPECT_TRUE(slave0.next_run == NULL) ;
+    ASSERT_EQ(exec.runs.size(), 2) ;
+    EXPECT_EQ(exec.runs.front()->id, 1) ;
+
+    for (int run = 0 ; run < 2 ; run++) {
+        ASSERT_EQ(read(to_worker[0], header, sizeof(header)), (ssize_t)sizeof(header)) ;
+        EXPECT_EQ((int)ntohl(header[0]), Trick::MonteSlave::MC_PROCESS_RUN) ;
+        EXPECT_EQ((int)ntohl(header[1]), run) ;
+        std::vector<char> input(ntohl(header[2])) ;
+        ASSERT_EQ(read(to_worker[0], &input[0], input.size()), (ssize_t)input.size()) ;
+    }
+
+    // The slave reads the cancel after the run, so it skips the run if it has not started it.
+    exec.connection_device.socket = to_worker[0] ;
+    exec.pipe_fd = to_worker[1] ;
+    EXPECT_TRUE(exec.slave_run_cancelled(1)) ;
+    EXPECT_EQ(exec.pending_command, -1) ;
+
+    // Nothing waiting, or another command waiting, is not a cancel. The command is kept for the slave.
+    EXPECT_FALSE(exec.slave_run_cancelled(1)) ;
+    cancel[0] = htonl(Trick::MonteSlave::MC_SHUTDOWN) ;
+    ASSERT_EQ(write(to_worker[1], cancel, sizeof(int)), (ssize_t)sizeof(int)) ;
+    EXPECT_FALSE(exec.slave_run_cancelled(1)) ;
+    EXPECT_EQ((int)ntohl(exec.pending_command), Trick::MonteSlave::MC_SHUTDOWN) ;
+
+    // A cancel for a run the slave already started is ignored.
+    exec.pending_command = -1 ;
+    cancel[0] = htonl(Trick::MonteSlave::MC_CANCEL_RUN) ;
+    cancel[1] = htonl(0) ;
+    ASSERT_EQ(write(to_worker[1], cancel, sizeof(cancel)), (ssize_t)sizeof(cancel)) ;
+    EXPECT_FALSE(exec.slave_run_cancelled(1)) ;
+    EXPECT_EQ(exec.pending_command, -1) ;
+
+    // Results for the cancelled run, had the slave started it anyway, are discarded.
+    exec.handle_run_data(slave0, 1, Trick::MonteRun::MC_RUN_COMPLETE) ;
+    EXPECT_EQ(exec.num_results, 0) ;
+
+    exec.connection_device.socket = TRICKCOMM_INVALID_SOCKET ;
+    exec.pipe_fd = -1 ;
+    fclose(exec.run_data_file) ;
+    close(to_worker[0]) ;
+    close(to_worker[1]) ;
+}
+
+TEST_F(MonteCarloTest, TestLocalWorkers) {
+    // A negative number of local workers adds one per online processor.
+    exec.set_local_workers(-1) ;
+    exec.add_local_workers() ;
+    ASSERT_EQ(exec.slaves.size(), (size_t)sysconf(_SC_NPROCESSORS_ONLN)) ;
+    EXPECT_TRUE(exec.slaves.back()->local_worker) ;
+
+    // Socket pairs stand in for the pipes of a spawned worker.
+    int to_worker[2] ;
+    int from_worker[2] ;
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, to_worker), 0) ;
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, from_worker), 0) ;
+    Trick::MonteSlave * slave0 = exec.slaves[0] ;
+    slave0->connection.socket = from_worker[0] ;
+    slave0->pipe_fd = to_worker[1] ;
+    slave0->state = Trick::MonteSlave::MC_INITIALIZING ;
+    exec.listen_device.socket = TRICKCOMM_INVALID_SOCKET ;
+    exec.run_data_file = tmpfile() ;
+    exec.set_verbosity(exec.MC_NONE) ;
+    exec.set_num_runs(1) ;
+
+    // The worker initializes over its pipe.
+    int init[2] = { (int)htonl(slave0->id), (int)htonl(6) } ;
+    int port = 0 ;
+    ASSERT_EQ(write(from_worker[1], init, sizeof(init)), (ssize_t)sizeof(init)) ;
+    ASSERT_EQ(write(from_worker[1], "worker", 6), 6) ;
+    ASSERT_EQ(write(from_worker[1], &port, sizeof(port)), (ssize_t)sizeof(port)) ;
+    exec.receive_results() ;
+    EXPECT_EQ(slave0->state, Trick::MonteSlave::MC_READY) ;
+    EXPECT_EQ(slave0->machine_name, "worker") ;
+
+    // Runs are dispatched over the pipe to it.
+    int header[3] ;
+    exec.dispatch_run_to_slave(exec.get_next_dispatch(), exec.get_ready_slave()) ;
+    EXPECT_EQ(slave0->state, Trick::MonteSlave::MC_RUNNING) ;
+    ASSERT_EQ(read(to_worker[0], header, sizeof(header)), (ssize_t)sizeof(header)) ;
+    EXPECT_EQ((int)ntohl(header[0]), Trick::MonteSlave::MC_PROCESS_RUN) ;
+    EXPECT_EQ((int)ntohl(header[1]), 0) ;
+
+    // Its results resolve the run.
+    int results[4] = { (int)htonl(slave0->id), (int)htonl(0), (int)htonl(Trick::MonteRun::MC_RUN_COMPLETE), 0 } ;
+    ASSERT_EQ(write(from_worker[1], results, sizeof(results)), (ssize_t)sizeof(results)) ;
+    exec.receive_results() ;
+    EXPECT_EQ(exec.num_results, 1) ;
+    EXPECT_EQ(slave0->state, Trick::MonteSlave::MC_READY) ;
+
+    // A worker that exits closes its pipe, disconnecting it.
+    close(from_worker[1]) ;
+    exec.receive_results() ;
+    EXPECT_EQ(slave0->state, Trick::MonteSlave::MC_DISCONNECTED) ;
+    EXPECT_EQ(slave0->connection.socket, TRICKCOMM_INVALID_SOCKET) ;
+    EXPECT_EQ(slave0->pipe_fd, -1) ;
+
+    close(to_worker[0]) ;
+    fclose(exec.run_data_file) ;
+    for (size_t ii = 0 ; ii < exec.slaves.size() ; ii++) {
+        delete exec.slaves[ii] ;
+    }
+    exec.slaves.clear() ;
+}
+
+TEST_F(MonteCarloTest, TestDisconnectLocalWorker) {
+    // A worker shut down by the master exits when its pipe closes, and is reaped.
+    int to_worker[2] ;
+    Trick::MonteSlave slave0("localhost") ;
+    slave0.local_worker = true ;
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, to_worker), 0) ;
+    pid_t pid = fork() ;
+    if (pid == 0) {
+        char command ;
+        close(to_worker[1]) ;
+        while (read(to_worker[0], &command, 1) > 0) {
+        }
+        _exit(0) ;
+    }
+    close(to_worker[0]) ;
+    slave0.pid = pid ;
+    slave0.pipe_fd = to_worker[1] ;
+    slave0.state = Trick::MonteSlave::MC_FINISHED ;
+    exec.disconnect_slave(slave0) ;
+    EXPECT_EQ(slave0.pid, 0) ;
+    EXPECT_EQ(slave0.pipe_fd, -1) ;
+    EXPECT_EQ(waitpid(pid, NULL, WNOHANG), -1) ;
+
+    // A worker the master lost is killed, since it may never read its pipe.
+    pid = fork() ;
+    if (pid == 0) {
+        pause() ;
+        _exit(0) ;
+    }
+    slave0.pid = pid ;
+    slave0.state = Trick::MonteSlave::MC_DISCONNECTED ;
+    exec.disconnect_slave(slave0) ;
+    EXPECT_EQ(slave0.pid, 0) ;
+    EXPECT_EQ(waitpid(pid, NULL, WNOHANG), -1) ;
+
+    // Writing to a worker that has gone away fails rather than raising SIGPIPE.
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, to_worker), 0) ;
+    close(to_worker[0]) ;
+    slave0.pipe_fd = to_worker[1] ;
+    int command = htonl(Trick::MonteSlave::MC_SHUTDOWN) ;
+    EXPECT_LT(exec.write_to_slave(slave0, (char *)&command, sizeof(command)), (int)sizeof(command)) ;
+    close(to_worker[1]) ;
+}
+
+TEST_F(MonteCarloTest, TestCheckInitializedState) {
+    double * swept = (double *)TMM_declare_var_s("double mc_swept") ;
+    double * derived = (double *)TMM_declare_var_s("double mc_derived[2]") ;
+    Trick::MonteVarFixed var0("mc_swept", 1.0) ;
+    std::map<void *, std::string> copy ;
+
+    exec.add_variable(&var0) ;
+    exec.set_verbosity(exec.MC_NONE) ;
+
+    // Only the Monte Carlo variable changes.
+    exec.copy_initialized_state(copy) ;
+    *swept = 2.0 ;
+    EXPECT_EQ(exec.check_initialized_state(copy), 0) ;
+
+    // Anything else is reported.
+    exec.copy_initialized_state(copy) ;
+    *swept = 3.0 ;
+    derived[1] = 6.0 ;
+    EXPECT_EQ(exec.check_initialized_state(copy), 1) ;
+
+    TMM_delete_var_a(derived) ;
+    TMM_delete_var_a(swept) ;
+}
+
 TEST_F(MonteCarloTest, MonteVarFile) {
     //req.add_requirement("3932595803");
 
@@ -10,9 +10,46 @@ PROGRAMMERS:
 #include <iterator> // std::prev
 #include <fstream>  // std::ofstream
 #include <cstdlib>  // system
+#include <cstdint>  // uint64_t
+#include <unistd.h> // access
 #include "trick/message_type.h"
 #include "trick/message_proto.h"
 #include "trick/exec_proto.h"
+#include "trick/command_line_protos.h"
+
+// A run-table record is a single line, so the newlines in the commands are
+// escaped.
+static std::string escape_record( const std::string & text)
+{
+  std::string escaped;
+  for (char c : text) {
+    if (c == '\\') {
+      escaped += "\\\\";
+    }
+    else if (c == '\n') {
+      escaped += "\\n";
+    }
+    else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+static std::string unescape_record( const std::string & text)
+{
+  std::string unescaped;
+  for (size_t ii = 0; ii < text.size(); ++ii) {
+    if (text[ii] == '\\' && ii + 1 < text.size()) {
+      ++ii;
+      unescaped += (text[ii] == 'n') ? '\n' : text[ii];
+    }
+    else {
+      unescaped += text[ii];
+    }
+  }
+  return unescaped;
+}
 
 
 /*****************************************************************************
@@ -30,10 +67,13 @@ MonteCarloMaster::MonteCarloMaster(
   generate_summary(true),
   minimum_padding(0),
   monte_run_number(0),
+  use_run_table(false),
   input_files_prepared(false),
   location(location_),
   variables(),
-  num_runs(0)
+  num_runs(0),
+  run_commands(),
+  loaded_run_dir()
 {}
 
 /*****************************************************************************
@@ -122,6 +162,12 @@ MonteCarloMaster::prepare_input_files()
     }
   }
 
+  if (use_run_table) {
+    prepare_run_table( max_length);
+    input_files_prepared = true;
+    return true;
+  }
+
   // Process each input file one at a time, and write all variables into each
   // file before moving on to the next file. This is better than trying to
   // keep a large number of files open so each variable can be written into
@@ -231,6 +277,180 @@ MonteCarloMaster::prepare_input_files()
   return true;
 }
 
+/*****************************************************************************
+prepare_run_table
+Purpose:(Writes the assignments of every run as one line of the run table
+           MONTE_<run_name>/monte_run_table, with the byte offset of each line
+           in monte_run_table_index, so a run can be found without reading
+           the runs before it.
+         Writes the summary of every run directly to monte_values_all_runs.
+         Writes the single monte_<input.py> that launches any run from the
+           table.)
+Assumptions:(Random variables are re-seeded for each run from their seed and
+           the run number.  File and semi-fixed variables are still read in
+           run order.)
+*****************************************************************************/
+void
+MonteCarloMaster::prepare_run_table( int max_length)
+{
+  std::string table_name = monte_dir + "/monte_run_table";
+  std::string index_name = table_name + "_index";
+  std::ofstream table(table_name, std::ios::binary);
+  std::ofstream index(index_name, std::ios::binary);
+  if (table.fail() || index.fail()) {
+    std::string message =
+      std::string("File: ") + __FILE__ + ", Line: " +
+      std::to_string(__LINE__) + ", I/O error\nUnable to open file " +
+      table_name.c_str() + " or its index for writing.";
+    message_publish(MSG_ERROR, message.c_str());
+    exec_terminate_with_return(1, __FILE__, __LINE__, message.c_str());
+  }
+
+  std::ofstream values;
+  if (generate_summary) {
+    values.open(monte_dir + "/monte_values_all_runs");
+    if (!values.is_open()) {
+      std::string message =
+        std::string("File: ") + __FILE__ + ", Line: " +
+        std::to_string(__LINE__) + ", Output failure\nFailed to open the " +
+        "summary data file.\nDispersion summary will not be generated.\n";
+      message_publish(MSG_ERROR, message.c_str());
+      generate_summary = false;
+    }
+  }
+
+  // One run at a time; nothing about a run is kept once its line is written.
+  for (unsigned int run_num = 0; run_num < num_runs; ++run_num) {
+    std::string run_num_str = std::to_string(run_num);
+    if ((int)run_num_str.size() < max_length) {
+      run_num_str.insert(0, max_length - run_num_str.size(), '0');
+    }
+
+    uint64_t offset = table.tellp();
+    index.write( reinterpret_cast<const char *>(&offset), sizeof(offset));
+
+    table << "RUN_" << run_num_str << " ";
+    for (auto var_it : variables) {
+      var_it->reseed_for_run( run_num);
+      var_it->generate_assignment();
+      table << escape_record( var_it->get_command());
+    }
+    table << "\n";
+
+    if (generate_summary) {
+      values << run_num_str;
+      for (auto var_it : variables) {
+        if (var_it->include_in_summary) {
+          values << ", " << var_it->get_assignment();
+        }
+      }
+      values << "\n";
+    }
+  }
+  table.close();
+  index.close();
+  values.close();
+  if (table.fail() || index.fail()) {
+    std::string message =
+      std::string("File: ") + __FILE__ + ", Line: " +
+      std::to_string(__LINE__) + ", I/O error\nFailed writing the run " +
+      "table " + table_name.c_str() + ".";
+    message_publish(MSG_ERROR, message.c_str());
+    exec_terminate_with_return(1, __FILE__, __LINE__, message.c_str());
+  }
+
+  // The generic input file; the run number comes from the environment so
+  // that, for example, a SLURM array job can pass $SLURM_ARRAY_TASK_ID.
+  std::string filename = monte_dir + "/monte_" + input_file_name;
+  std::ofstream input_file(filename);
+  if (input_file.fail()) {
+    std::string message =
+      std::string("File: ") + __FILE__ + ", Line: " +
+      std::to_string(__LINE__) + ", I/O error\nUnable to open file " +
+      filename.c_str() + " for writing.";
+    message_publish(MSG_ERROR, message.c_str());
+    exec_terminate_with_return(1, __FILE__, __LINE__, message.c_str());
+  }
+  input_file <<
+  "import os\n" <<
+  location << ".active = True"
+  "\n" << location << ".generate_dispersions = False"
+  "\n" << location << ".monte_dir = '" << monte_dir << "'\n"
+  "\nexec(open('"<<run_name<<"/"<<input_file_name<<"').read())"
+  "\n" << location << ".load_run(int(os.environ['MONTE_RUN_NUMBER']))"
+  "\nexec(" << location << ".get_run_commands())\n";
+  input_file.close();
+}
+
+/*****************************************************************************
+load_run
+Purpose:(Loads the assignments of one run from the run table written by
+           prepare_run_table.
+         The assignments are then available from get_run_commands.  The run's
+           RUN_<run_num> directory is not created until the run starts, see
+           start_run.)
+*****************************************************************************/
+bool
+MonteCarloMaster::load_run( size_t run_num)
+{
+  std::string table_name = monte_dir + "/monte_run_table";
+  std::ifstream index(table_name + "_index", std::ios::binary);
+  std::ifstream table(table_name, std::ios::binary);
+  uint64_t offset = 0;
+  std::string record;
+  index.seekg( run_num * sizeof(offset));
+  index.read( reinterpret_cast<char *>(&offset), sizeof(offset));
+  if (index) {
+    table.seekg( offset);
+    std::getline( table, record);
+  }
+
+  // The record must name this run, e.g. "RUN_00042 <commands>".
+  size_t space = record.find(' ');
+  if (!index || !table || record.compare(0, 4, "RUN_") != 0 ||
+      space == std::string::npos ||
+      std::strtoul(record.c_str() + 4, NULL, 10) != run_num) {
+    std::string message =
+      std::string("File: ") + __FILE__ + ", Line: " +
+      std::to_string(__LINE__) + ", Invalid run\nRun " +
+      std::to_string(run_num) + " was not found in the run table " +
+      table_name.c_str() + ".\n";
+    message_publish(MSG_ERROR, message.c_str());
+    exec_terminate_with_return(1, __FILE__, __LINE__, message.c_str());
+    return false;
+  }
+
+  loaded_run_dir = monte_dir + "/" + record.substr(0, space);
+  run_commands = unescape_record( record.substr(space + 1));
+  monte_run_number = run_num;
+  return true;
+}
+
+/*****************************************************************************
+start_run
+Purpose:(Creates the RUN_<run_num> directory of the run loaded by load_run
+           and directs the output of the sim there.  This is run as an
+           initialization job, before anything is written to the output
+           directory.  It does nothing if no run was loaded.)
+*****************************************************************************/
+void
+MonteCarloMaster::start_run()
+{
+  if (loaded_run_dir.empty()) {
+    return;
+  }
+  create_path( loaded_run_dir.c_str());
+  if (access( loaded_run_dir.c_str(), W_OK) != 0) {
+    std::string message =
+      std::string("File: ") + __FILE__ + ", Line: " +
+      std::to_string(__LINE__) + ", I/O error\nUnable to create the run " +
+      "directory " + loaded_run_dir.c_str() + ".\n";
+    message_publish(MSG_ERROR, message.c_str());
+    exec_terminate_with_return(1, __FILE__, __LINE__, message.c_str());
+  }
+  set_output_dir( loaded_run_dir.c_str());
+}
+
 /*****************************************************************************
 add_variable
 Purpose:(Adds a pointer to an instantiated MonteCarloVariable to the
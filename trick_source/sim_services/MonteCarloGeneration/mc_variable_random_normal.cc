@@ -36,6 +36,18 @@ MonteCarloVariableRandomNormal::MonteCarloVariableRandomNormal(
   truncated_high(false)
 {}
 
+/*****************************************************************************
+reseed_for_run
+Purpose:(re-seeds the generator for a run, discarding the second value of
+         the last pair the distribution generated)
+*****************************************************************************/
+void
+MonteCarloVariableRandomNormal::reseed_for_run( size_t run_num)
+{
+  MonteCarloVariableRandom::reseed_for_run( run_num);
+  distribution.reset();
+}
+
 /*****************************************************************************
 generate_assignment
 Purpose:(generates the normally-distributed random number)
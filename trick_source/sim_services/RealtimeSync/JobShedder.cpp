@@ -0,0 +1,211 @@
+/*
+PURPOSE:
+    ( Sheds low priority jobs on sustained real-time overruns )
+*/
+
+#include <stdio.h>
+
+#include "trick/JobShedder.hh"
+#include "trick/JobData.hh"
+#include "trick/exec_proto.h"
+#include "trick/exec_proto.hh"
+#include "trick/message_proto.h"
+#include "trick/message_type.h"
+
+namespace Trick {
+
+    /** A group of jobs shed together, and the state of its jobs before and after it was shed. */
+    struct JobShedGroup {
+        std::string name ;
+        double cycle_factor ;
+        std::vector< Trick::JobData * > jobs ;
+        std::vector< double > cycles ;
+        std::vector< bool > disabled ;
+        std::vector< double > shed_cycles ;
+        std::vector< bool > shed_disabled ;
+    } ;
+
+}
+
+Trick::JobShedder::JobShedder() :
+ enabled(true) ,
+ shed_overrun_cnt(3) ,
+ restore_usage(0.75) ,
+ restore_frames(100) ,
+ shed_level(0) ,
+ total_shed(0) ,
+ overrun_frames(0) ,
+ headroom_frames(0) {}
+
+Trick::JobShedder::~JobShedder() {
+    unsigned int ii ;
+    for ( ii = 0 ; ii < groups.size() ; ii++ ) {
+        delete groups[ii] ;
+    }
+}
+
+int Trick::JobShedder::add_group(std::string job_name, double cycle_factor) {
+
+    Trick::JobShedGroup * group ;
+
+    if ( cycle_factor != 0.0 and cycle_factor <= 1.0 ) {
+        message_publish(MSG_WARNING, "Warning: Invalid cycle factor %g specified in JobShedder::add_group for %s\n" ,
+         cycle_factor, job_name.c_str()) ;
+        return -1 ;
+    }
+    group = new Trick::JobShedGroup() ;
+    group->name = job_name ;
+    group->cycle_factor = cycle_factor ;
+    groups.push_back(group) ;
+    return 0 ;
+}
+
+/**
+@details
+-# If the frame overran, count it.  When shed_overrun_cnt consecutive frames have overrun since the last group was
+   shed, and shedding is enabled, shed the next group.
+-# Else count the frame if it used less than restore_usage of the software frame.  When restore_frames consecutive
+   frames have, restore the last group shed.
+*/
+int Trick::JobShedder::frame(bool overrun, double usage) {
+
+    if ( overrun ) {
+        headroom_frames = 0 ;
+        overrun_frames++ ;
+        if ( enabled and overrun_frames >= shed_overrun_cnt and shed_level < groups.size() ) {
+            shed(*groups[shed_level], usage) ;
+            shed_level++ ;
+            total_shed++ ;
+            overrun_frames = 0 ;
+        }
+    } else {
+        overrun_frames = 0 ;
+        if ( usage < restore_usage ) {
+            headroom_frames++ ;
+        } else {
+            headroom_frames = 0 ;
+        }
+        if ( shed_level > 0 and headroom_frames >= restore_frames ) {
+            char reason[128] ;
+            snprintf(reason, sizeof(reason), "after %d frames under %.0f%% frame usage" ,
+             headroom_frames, restore_usage * 100.0) ;
+            shed_level-- ;
+            restore(*groups[shed_level], reason) ;
+            headroom_frames = 0 ;
+        }
+    }
+    return 0 ;
+}
+
+/**
+@details
+-# Find the jobs with the group name as their name or as one of their tags.  Jobs are looked up each time the group
+   is shed, so jobs added after the group are included.
+-# Save the cycle and on/off state of each job.
+-# If the group turns jobs off, disable them, as Executive::set_job_onoff() does.  Else multiply the cycle of each
+   cyclic job by the cycle factor and reschedule it, as Executive::set_job_cycle() does.
+-# Save the shed cycle and on/off state of each job, to tell at restore whether they were changed meanwhile.
+-# Publish the decision.
+*/
+void Trick::JobShedder::shed(Trick::JobShedGroup & group, double usage) {
+
+    std::vector< Trick::JobData * > all_jobs ;
+    unsigned int ii ;
+    long long time_tics = exec_get_time_tics() ;
+
+    group.jobs.clear() ;
+    group.cycles.clear() ;
+    group.disabled.clear() ;
+    group.shed_cycles.clear() ;
+    group.shed_disabled.clear() ;
+    exec_get_all_jobs_vector(all_jobs) ;
+    for ( ii = 0 ; ii < all_jobs.size() ; ii++ ) {
+        Trick::JobData * job = all_jobs[ii] ;
+        if ( job->name == group.name or job->tags.count(group.name) ) {
+            group.jobs.push_back(job) ;
+            group.cycles.push_back(job->cycle) ;
+            group.disabled.push_back(job->disabled) ;
+        }
+    }
+
+    for ( ii = 0 ; ii < group.jobs.size() ; ii++ ) {
+        Trick::JobData * job = group.jobs[ii] ;
+        if ( group.cycle_factor == 0.0 ) {
+            job->disabled = true ;
+        } else if ( job->cycle > 0.0 ) {
+            job->set_cycle(job->cycle * group.cycle_factor) ;
+            job->set_next_call_time(time_tics) ;
+        }
+        group.shed_cycles.push_back(job->cycle) ;
+        group.shed_disabled.push_back(job->disabled) ;
+    }
+
+    if ( group.jobs.empty() ) {
+        message_publish(MSG_WARNING, "Job shedder: no jobs named or tagged %s to shed at %f\n" ,
+         group.name.c_str(), exec_get_sim_time()) ;
+    } else if ( group.cycle_factor == 0.0 ) {
+        message_publish(MSG_WARNING, "Job shedder: turned off %d %s jobs at %f after %d consecutive overruns, "
+         "frame usage %.2f\n" , (int)group.jobs.size(), group.name.c_str(), exec_get_sim_time(), overrun_frames,
+         usage) ;
+    } else {
+        message_publish(MSG_WARNING, "Job shedder: slowed %d %s jobs by %g at %f after %d consecutive overruns, "
+         "frame usage %.2f\n" , (int)group.jobs.size(), group.name.c_str(), group.cycle_factor, exec_get_sim_time(),
+         overrun_frames, usage) ;
+    }
+}
+
+/**
+@details
+-# Give each job of the group back the cycle and on/off state saved when the group was shed, rescheduling jobs
+   whose cycle changed.  A cycle or on/off state that is no longer the one the shedder set was changed while the
+   group was shed, by the user or another job, and is kept.
+-# Publish the decision, with the number of jobs whose changes were kept.
+*/
+void Trick::JobShedder::restore(Trick::JobShedGroup & group, const char * reason) {
+
+    unsigned int ii ;
+    int changed = 0 ;
+    long long time_tics = exec_get_time_tics() ;
+
+    for ( ii = 0 ; ii < group.jobs.size() ; ii++ ) {
+        Trick::JobData * job = group.jobs[ii] ;
+        bool job_changed = false ;
+        if ( job->disabled == group.shed_disabled[ii] ) {
+            job->disabled = group.disabled[ii] ;
+        } else {
+            job_changed = true ;
+        }
+        if ( job->cycle != group.shed_cycles[ii] ) {
+            job_changed = true ;
+        } else if ( job->cycle != group.cycles[ii] ) {
+            job->set_cycle(group.cycles[ii]) ;
+            job->set_next_call_time(time_tics) ;
+        }
+        if ( job_changed ) {
+            changed++ ;
+        }
+    }
+
+    if ( changed > 0 ) {
+        message_publish(MSG_INFO, "Job shedder: restored %d %s jobs at %f, %s, keeping the changes made to %d of "
+         "them while shed\n" , (int)group.jobs.size(), group.name.c_str(), exec_get_sim_time(), reason, changed) ;
+    } else if ( ! group.jobs.empty() ) {
+        message_publish(MSG_INFO, "Job shedder: restored %d %s jobs at %f, %s\n" ,
+         (int)group.jobs.size(), group.name.c_str(), exec_get_sim_time(), reason) ;
+    }
+    group.jobs.clear() ;
+    group.cycles.clear() ;
+    group.disabled.clear() ;
+    group.shed_cycles.clear() ;
+    group.shed_disabled.clear() ;
+}
+
+int Trick::JobShedder::restore_all() {
+    while ( shed_level > 0 ) {
+        shed_level-- ;
+        restore(*groups[shed_level], "restore requested") ;
+    }
+    overrun_frames = 0 ;
+    headroom_frames = 0 ;
+    return 0 ;
+}
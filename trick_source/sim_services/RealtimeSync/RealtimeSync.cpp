@@ -51,6 +51,8 @@ Trick::RealtimeSync::RealtimeSync( Trick::Clock * in_clock , Trick::Timer * in_t
 
     actual_run_ratio = 0.0;
 
+    reset_wake_stats() ;
+
     the_rts = this ;
 
 }
@@ -97,9 +99,22 @@ const char * Trick::RealtimeSync::clock_get_name() {
 /**
 @details
 -# Sets the sleep timer to the incoming class [@ref disable]
+-# Clears the wake up statistics of the previous timer
 */
 int Trick::RealtimeSync::change_timer(Trick::Timer * in_sleep_timer) {
     sleep_timer = in_sleep_timer ;
+    reset_wake_stats() ;
+    return 0 ;
+}
+
+int Trick::RealtimeSync::reset_wake_stats() {
+    timer_wake_lead = 0.0 ;
+    timer_wake_lead_min = 0.0 ;
+    timer_wake_lead_mean = 0.0 ;
+    wake_jitter = 0.0 ;
+    wake_jitter_max = 0.0 ;
+    wake_jitter_mean = 0.0 ;
+    wake_samples = 0 ;
     return 0 ;
 }
 
@@ -294,6 +309,7 @@ class Run_Ratio {
 -# Calculate the real-time taken for the last frame of execution.
 -# if the frame has overrun
    -# Increment the number of consecutive overruns
+   -# Pass the overrun to the job shedder, which sheds low priority jobs if overruns persist
    -# If the maximum number of consecutive overrun frames has
       been reached or the maximum single overrun time has been exceeded
       -# If the freeze/terminate action was set
@@ -303,14 +319,17 @@ class Run_Ratio {
    -# Stop the sleep timer.
 -# Else the frame has underrun
    -# Reset the number of consecutive overruns to 0.
+   -# Pass the fraction of the frame used to the job shedder, which restores shed jobs once frames have headroom
    -# Pause for the sleep timer to expire
    -# Spin for the real-time clock to match the simulation time
+   -# If the sleep timer slept, add how early it woke and how late the spin ended to the wake up statistics
    -# Reset the sleep timer for the next frame
 -# Save the current real-time as the start of the frame reference
 */
 int Trick::RealtimeSync::rt_monitor(long long sim_time_tics) {
 
     long long curr_clock_time ;
+    long long software_frame_tics ;
     char buf[512];
     static Run_Ratio<100> run_ratio ;
 
@@ -345,6 +364,7 @@ int Trick::RealtimeSync::rt_monitor(long long sim_time_tics) {
     }
 
     frame_overrun_time = curr_clock_time - sim_time_tics ;
+    software_frame_tics = exec_get_software_frame_tics() ;
 
     frame_overrun = frame_overrun_time * (1.0/tics_per_sec);
 
@@ -355,6 +375,9 @@ int Trick::RealtimeSync::rt_monitor(long long sim_time_tics) {
         frame_overrun_cnt++;
         total_overrun++;
 
+        /* Shed low priority jobs if the overruns persist */
+        job_shedder.frame(true, (double)(curr_clock_time - sim_time_tics) / software_frame_tics + 1.0) ;
+
         /* If the number overruns surpass the maximum allowed freeze or shutdown. */
         if (frame_overrun_cnt >= rt_max_overrun_cnt || frame_overrun_time >= rt_max_overrun_time_tics) {
 
@@ -391,14 +414,35 @@ int Trick::RealtimeSync::rt_monitor(long long sim_time_tics) {
         /* Reset consecutive overrun counter frame_overrun_cnt */
         frame_overrun_cnt = 0;
 
+        /* Restore shed jobs once the frames have headroom again */
+        job_shedder.frame(false, 1.0 - (double)(sim_time_tics - curr_clock_time) / software_frame_tics) ;
+
         /* pause for the timer to signal the end of frame */
+        bool timer_slept = sleep_timer->get_enabled() and sleep_timer->get_active() ;
         sleep_timer->pause() ;
+        long long wake_clock_time = timer_slept ? rt_clock->clock_time() : 0 ;
 
         /* Spin to make sure that we are at the top of the frame */
         curr_clock_time = rt_clock->clock_spin(sim_time_tics) ;
 
-        /* If the timer requires to be reset at the end of each frame, reset it here. */
-        sleep_timer->reset(exec_get_software_frame() / rt_clock->get_rt_clock_ratio()) ;
+        if ( timer_slept ) {
+            timer_wake_lead = (sim_time_tics - wake_clock_time) * (1.0/tics_per_sec) ;
+            wake_jitter = (curr_clock_time - sim_time_tics) * (1.0/tics_per_sec) ;
+            wake_samples++ ;
+            if ( wake_samples == 1 or timer_wake_lead < timer_wake_lead_min ) {
+                timer_wake_lead_min = timer_wake_lead ;
+            }
+            if ( wake_jitter > wake_jitter_max ) {
+                wake_jitter_max = wake_jitter ;
+            }
+            timer_wake_lead_mean += (timer_wake_lead - timer_wake_lead_mean) / wake_samples ;
+            wake_jitter_mean += (wake_jitter - wake_jitter_mean) / wake_samples ;
+        }
+
+        /* If the timer requires to be reset at the end of each frame, reset it here.  The next frame is timed
+           from the frame boundary, not from now. */
+        sleep_timer->reset_late(exec_get_software_frame() / rt_clock->get_rt_clock_ratio() ,
+         (rt_clock->clock_time() - sim_time_tics) * (1.0/tics_per_sec) / rt_clock->get_rt_clock_ratio()) ;
 
         /* Calculate the run ratio after sleeping */
         actual_run_ratio = run_ratio(curr_clock_time, rt_clock->get_rt_clock_ratio());
@@ -466,8 +510,10 @@ int Trick::RealtimeSync::freeze_pause(double freeze_frame_sec) {
     /* Spin to make sure that we are at the top of the frame */
     rt_clock->clock_spin(freeze_time_tics + freeze_frame) ;
 
-    /* If the timer requires to be reset at the end of each frame, reset it here. */
-    sleep_timer->reset(freeze_frame_sec / rt_clock->get_rt_clock_ratio()) ;
+    /* If the timer requires to be reset at the end of each frame, reset it here, timed from the frame boundary. */
+    sleep_timer->reset_late(freeze_frame_sec / rt_clock->get_rt_clock_ratio() ,
+     (rt_clock->clock_time() - (freeze_time_tics + freeze_frame)) * (1.0/tics_per_sec) /
+     rt_clock->get_rt_clock_ratio()) ;
 
     freeze_time_tics += freeze_frame ;
 
@@ -89,6 +89,42 @@ extern "C" int real_time_set_rt_clock_ratio(double in_clock_ratio) {
     return the_rts->set_rt_clock_ratio(in_clock_ratio) ;
 }
 
+/**
+ * @relates Trick::RealtimeSync
+ * @copydoc Trick::RealtimeSync::reset_wake_stats
+ * C wrapper for Trick::RealtimeSync::reset_wake_stats
+ */
+extern "C" int real_time_reset_wake_stats() {
+    if ( the_rts != NULL ) {
+        return the_rts->reset_wake_stats() ;
+    }
+    return(0) ;
+}
+
+/**
+ * @relates Trick::JobShedder
+ * @copydoc Trick::JobShedder::add_group
+ * C wrapper for Trick::JobShedder::add_group
+ */
+extern "C" int real_time_add_shed_group(const char * job_name , double cycle_factor) {
+    if ( the_rts != NULL ) {
+        return the_rts->job_shedder.add_group(job_name, cycle_factor) ;
+    }
+    return(0) ;
+}
+
+/**
+ * @relates Trick::JobShedder
+ * @copydoc Trick::JobShedder::restore_all
+ * C wrapper for Trick::JobShedder::restore_all
+ */
+extern "C" int real_time_restore_shed_groups() {
+    if ( the_rts != NULL ) {
+        return the_rts->job_shedder.restore_all() ;
+    }
+    return(0) ;
+}
+
 // The lock memory functions are most closely related to real-time but are
 // not required for syncing.  Therefore keep the routines as stand
 // alone C functions.
@@ -0,0 +1,135 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#define protected public
+#include "trick/JobShedder.hh"
+#include "trick/JobData.hh"
+#include "trick/Executive.hh"
+
+namespace Trick {
+
+class JobShedderTest : public ::testing::Test {
+
+    protected:
+        Trick::Executive exec ;
+        Trick::JobShedder shedder ;
+        Trick::JobData display_1 ;
+        Trick::JobData display_2 ;
+        Trick::JobData logging ;
+        Trick::JobData model ;
+
+        JobShedderTest() :
+         display_1(0, 1, "scheduled", NULL, 0.1, "disp.update_1", "display") ,
+         display_2(0, 2, "scheduled", NULL, 0.5, "disp.update_2", "display") ,
+         logging(0, 3, "scheduled", NULL, 1.0, "log.write", "logging") ,
+         model(0, 4, "scheduled", NULL, 0.01, "dyn.deriv") {}
+        ~JobShedderTest() {}
+
+        virtual void SetUp() {
+            Trick::JobData * jobs[] = { &display_1 , &display_2 , &logging , &model } ;
+            for ( int ii = 0 ; ii < 4 ; ii++ ) {
+                jobs[ii]->time_tic_value = 1000000 ;
+                jobs[ii]->calc_cycle_tics() ;
+                exec.all_jobs_vector.push_back(jobs[ii]) ;
+            }
+            shedder.restore_frames = 10 ;
+            shedder.add_group("logging", 4.0) ;
+            shedder.add_group("display", 0.0) ;
+        }
+
+        void run_frames( int num , bool overrun , double usage ) {
+            for ( int ii = 0 ; ii < num ; ii++ ) {
+                shedder.frame(overrun, usage) ;
+            }
+        }
+} ;
+
+TEST_F(JobShedderTest , RejectsCycleFactor) {
+    EXPECT_EQ(shedder.add_group("model", 0.5), -1) ;
+    EXPECT_EQ(shedder.add_group("model", 1.0), -1) ;
+    EXPECT_EQ(shedder.groups.size(), 2u) ;
+}
+
+TEST_F(JobShedderTest , ShedsInOrder) {
+    // One group each shed_overrun_cnt consecutive overruns.
+    run_frames(2, true, 1.2) ;
+    EXPECT_EQ(shedder.shed_level, 0u) ;
+    shedder.frame(false, 0.9) ;
+    run_frames(2, true, 1.2) ;
+    EXPECT_EQ(shedder.shed_level, 0u) ;
+    shedder.frame(true, 1.2) ;
+    EXPECT_EQ(shedder.shed_level, 1u) ;
+    EXPECT_DOUBLE_EQ(logging.cycle, 4.0) ;
+    EXPECT_EQ(logging.cycle_tics, 4000000) ;
+    EXPECT_FALSE(display_1.disabled) ;
+
+    run_frames(3, true, 1.2) ;
+    EXPECT_EQ(shedder.shed_level, 2u) ;
+    EXPECT_TRUE(display_1.disabled) ;
+    EXPECT_TRUE(display_2.disabled) ;
+    EXPECT_DOUBLE_EQ(display_1.cycle, 0.1) ;
+    EXPECT_DOUBLE_EQ(model.cycle, 0.01) ;
+    EXPECT_FALSE(model.disabled) ;
+
+    // No more groups to shed.
+    run_frames(6, true, 1.2) ;
+    EXPECT_EQ(shedder.shed_level, 2u) ;
+    EXPECT_EQ(shedder.total_shed, 2u) ;
+}
+
+TEST_F(JobShedderTest , RestoresLastFirst) {
+    display_2.disabled = true ;
+    run_frames(6, true, 1.2) ;
+    ASSERT_EQ(shedder.shed_level, 2u) ;
+
+    // A frame over restore_usage starts the count over.
+    run_frames(9, false, 0.5) ;
+    shedder.frame(false, 0.8) ;
+    run_frames(9, false, 0.5) ;
+    EXPECT_EQ(shedder.shed_level, 2u) ;
+    shedder.frame(false, 0.5) ;
+    EXPECT_EQ(shedder.shed_level, 1u) ;
+    EXPECT_FALSE(display_1.disabled) ;
+    // display_2 was off before it was shed.
+    EXPECT_TRUE(display_2.disabled) ;
+    EXPECT_DOUBLE_EQ(logging.cycle, 4.0) ;
+
+    run_frames(10, false, 0.5) ;
+    EXPECT_EQ(shedder.shed_level, 0u) ;
+    EXPECT_DOUBLE_EQ(logging.cycle, 1.0) ;
+    EXPECT_EQ(logging.cycle_tics, 1000000) ;
+}
+
+TEST_F(JobShedderTest , KeepsChangesMadeWhileShed) {
+    display_2.disabled = true ;
+    run_frames(6, true, 1.2) ;
+    ASSERT_EQ(shedder.shed_level, 2u) ;
+
+    // While shed, a display job that was off is turned on, the logging cycle is changed, and so is the cycle of
+    // a display job that stays off.
+    display_2.disabled = false ;
+    logging.set_cycle(2.0) ;
+    display_1.set_cycle(0.2) ;
+
+    shedder.restore_all() ;
+    EXPECT_EQ(shedder.shed_level, 0u) ;
+    EXPECT_FALSE(display_2.disabled) ;
+    EXPECT_DOUBLE_EQ(logging.cycle, 2.0) ;
+    // The on/off state the shedder set is restored, the changed cycle is kept.
+    EXPECT_FALSE(display_1.disabled) ;
+    EXPECT_DOUBLE_EQ(display_1.cycle, 0.2) ;
+}
+
+TEST_F(JobShedderTest , DisabledStillRestores) {
+    run_frames(3, true, 1.2) ;
+    ASSERT_EQ(shedder.shed_level, 1u) ;
+    shedder.enabled = false ;
+    run_frames(6, true, 1.2) ;
+    EXPECT_EQ(shedder.shed_level, 1u) ;
+    run_frames(10, false, 0.5) ;
+    EXPECT_EQ(shedder.shed_level, 0u) ;
+    EXPECT_DOUBLE_EQ(logging.cycle, 1.0) ;
+}
+
+}
@@ -2,7 +2,9 @@
 #include <math.h>
 
 #include "trick/JobData.hh"
+#include "trick/JobProfile.hh"
 #include "trick/SimObject.hh"
+#include "trick/TraceWriter.hh"
 
 long long Trick::JobData::time_tic_value = 0 ;
 
@@ -33,6 +35,8 @@ Trick::JobData::JobData() {
 
     frame_time = 0 ;
     frame_time_seconds = 0.0;
+    profile = NULL ;
+    trace_name = NULL ;
 }
 
 Trick::JobData::JobData(int in_thread, int in_id, std::string in_job_class_name , void* in_sup_class_data,
@@ -67,6 +71,8 @@ Trick::JobData::JobData(int in_thread, int in_id, std::string in_job_class_name
 
     frame_time = 0 ;
     frame_time_seconds = 0.0 ;
+    profile = NULL ;
+    trace_name = NULL ;
 }
 
 void Trick::JobData::enable() {
@@ -170,48 +176,55 @@ int Trick::JobData::remove_inst( std::string job_name ) {
     return 0 ;
 }
 
-int Trick::JobData::call() {
-    int ret ;
+/*
+ * Calls the instrumentation jobs and the job itself through function, call_function or call_function_double.
+ * If the job has a profile the time of the job itself is recorded in it, and if a trace is on the call is traced.
+ */
+template < class RET >
+static inline RET call_job( Trick::JobData * job , RET (Trick::SimObject::*function)(Trick::JobData *) ) {
+    RET ret ;
     unsigned int ii , size ;
-    InstrumentBase * curr_job ;
+    Trick::JobProfile * curr_profile ;
+    long long start_ns , stop_ns ;
 
-    size = inst_before.size() ;
+    size = job->inst_before.size() ;
     for ( ii = 0 ; ii < size ; ii++ ) {
-        curr_job = inst_before[ii] ;
-        curr_job->call() ;
+        job->inst_before[ii]->call() ;
     }
 
-    ret = parent_object->call_function(this) ;
+    curr_profile = job->profile ;
+    if ( curr_profile != NULL or Trick::TraceWriter::active ) {
+        start_ns = Trick::JobProfile::now() ;
+        ret = (job->parent_object->*function)(job) ;
+        stop_ns = Trick::JobProfile::now() ;
+        if ( curr_profile != NULL ) {
+            curr_profile->record(stop_ns - start_ns) ;
+        }
+        if ( Trick::TraceWriter::active ) {
+            // the trace keeps the name after the call, so it gets its own copy
+            if ( job->trace_name == NULL ) {
+                job->trace_name = Trick::TraceWriter::intern(job->name) ;
+            }
+            Trick::TraceWriter::complete(job->trace_name, "job", start_ns, stop_ns) ;
+        }
+    } else {
+        ret = (job->parent_object->*function)(job) ;
+    }
 
-    size = inst_after.size() ;
+    size = job->inst_after.size() ;
     for ( ii = 0 ; ii < size ; ii++ ) {
-        curr_job = inst_after[ii] ;
-        curr_job->call() ;
+        job->inst_after[ii]->call() ;
     }
 
     return ret ;
 }
 
-double Trick::JobData::call_double() {
-    double ret ;
-    unsigned int ii , size ;
-    InstrumentBase * curr_job ;
-
-    size = inst_before.size() ;
-    for ( ii = 0 ; ii < size ; ii++ ) {
-        curr_job = inst_before[ii] ;
-        curr_job->call() ;
-    }
-
-    ret = parent_object->call_function_double(this) ;
-
-    size = inst_after.size() ;
-    for ( ii = 0 ; ii < size ; ii++ ) {
-        curr_job = inst_after[ii] ;
-        curr_job->call() ;
-    }
+int Trick::JobData::call() {
+    return call_job(this, &Trick::SimObject::call_function) ;
+}
 
-    return ret ;
+double Trick::JobData::call_double() {
+    return call_job(this, &Trick::SimObject::call_function_double) ;
 }
 
 int Trick::JobData::copy_from_checkpoint( JobData * in_job ) {
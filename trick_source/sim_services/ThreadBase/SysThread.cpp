@@ -72,6 +72,13 @@ int Trick::SysThread::ensureAllShutdown() {
     return 0;
 }
 
+int Trick::SysThread::get_sys_threads(std::vector<SysThread *> & threads) {
+    pthread_mutex_lock(&(list_mutex()));
+    threads = all_sys_threads();
+    pthread_mutex_unlock(&(list_mutex()));
+    return 0;
+}
+
 // To be called from main thread
 void Trick::SysThread::force_thread_to_pause() {
     pthread_mutex_lock(&_restart_pause_mutex);
@@ -13,6 +13,8 @@
 #include "trick/message_proto.h"
 #include "trick/message_type.h"
 
+void (*Trick::ThreadBase::start_hook)( Trick::ThreadBase * ) = NULL ;
+
 Trick::ThreadBase::ThreadBase(std::string in_name) :
  name(in_name) ,
  pthread_id(0) ,
@@ -372,6 +374,10 @@ void * Trick::ThreadBase::thread_helper( void * context ) {
     tb->execute_priority() ;
     tb->execute_cpu_affinity() ;
 
+    if ( start_hook != NULL ) {
+        start_hook(tb) ;
+    }
+
     return tb->thread_body() ;
 }
 
@@ -0,0 +1,140 @@
+/*
+PURPOSE:
+    ( Sleep timer that sleeps until shortly before an absolute frame deadline )
+*/
+
+#include <errno.h>
+#include <stdio.h>
+#if __linux
+#include <sys/prctl.h>
+#endif
+
+#include "trick/HybridTimer.hh"
+#include "trick/exec_proto.h"
+
+Trick::HybridTimer::HybridTimer() : Timer() , guard_time(100.0e-6) {
+    wake_time.tv_sec = 0 ;
+    wake_time.tv_nsec = 0 ;
+}
+
+/**
+@details
+-# On Linux, set the timer slack of the calling thread, the thread that will pause, to 1 ns.  Threads outside of a
+   real-time scheduling policy otherwise have their sleeps extended by up to 50 us.
+*/
+int Trick::HybridTimer::init() {
+#if __linux
+    prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL) ;
+#endif
+    return (0) ;
+}
+
+/**
+@details
+-# If the timer is enabled
+   -# If the frame time is not longer than guard_time, there is nothing to sleep, the timer is inactive.
+   -# Else set the wake up time to the frame time less guard_time after the start of the frame, which was
+      late_time before the current time.
+   -# If the frame time is not valid, terminate the simulation.
+*/
+int Trick::HybridTimer::set_wake_time(double in_frame_time, double late_time) {
+
+    struct timespec now ;
+    long long sleep_nsec ;
+
+    if ( enabled ) {
+        if ( in_frame_time <= 0 ) {
+            char error_message[256];
+            snprintf(error_message, sizeof(error_message), "HybridTimer frame_time is not set\n" ) ;
+            exec_terminate_with_return(-1, __FILE__, __LINE__ , error_message);
+        }
+        if ( in_frame_time <= guard_time ) {
+            active = false ;
+            return(0) ;
+        }
+        sleep_nsec = (long long)((in_frame_time - guard_time - late_time) * 1000000000.0) ;
+        clock_gettime(CLOCK_MONOTONIC, &now) ;
+        sleep_nsec += now.tv_nsec ;
+        // a frame that started more than a second ago
+        while ( sleep_nsec < 0 ) {
+            sleep_nsec += 1000000000LL ;
+            now.tv_sec-- ;
+        }
+        wake_time.tv_sec = now.tv_sec + (time_t)(sleep_nsec / 1000000000LL) ;
+        wake_time.tv_nsec = (long)(sleep_nsec % 1000000000LL) ;
+        active = true ;
+    }
+    return (0) ;
+}
+
+/**
+@details
+-# Start a frame that starts now.
+*/
+int Trick::HybridTimer::start(double in_frame_time) {
+    return set_wake_time(in_frame_time, 0.0) ;
+}
+
+/**
+@details
+-# Start a frame that starts now.  Without the time since the frame boundary, the next wake up is measured from
+   the reset.
+*/
+int Trick::HybridTimer::reset(double in_frame_time) {
+    return set_wake_time(in_frame_time, 0.0) ;
+}
+
+/**
+@details
+-# Start a frame that started late_time ago, at the end of the previous frame.  Lateness of the wake up, the spin
+   or the call is not carried into the next wake up.
+*/
+int Trick::HybridTimer::reset_late(double in_frame_time, double late_time) {
+    return set_wake_time(in_frame_time, (late_time > 0.0) ? late_time : 0.0) ;
+}
+
+int Trick::HybridTimer::stop() {
+    active = false ;
+    return (0) ;
+}
+
+/**
+@details
+-# If the timer is enabled and active, sleep until the absolute wake up time.  A signal interrupting the sleep
+   restarts it with the same wake up time.  If the wake up time has already passed, this returns at once.
+*/
+int Trick::HybridTimer::pause() {
+
+    int ret ;
+
+    if ( enabled and active ) {
+#if __APPLE__
+        // no clock_nanosleep, sleep for the time remaining until the wake up time
+        struct timespec now , remaining ;
+        do {
+            clock_gettime(CLOCK_MONOTONIC, &now) ;
+            long long remaining_nsec = (wake_time.tv_sec - now.tv_sec) * 1000000000LL + (wake_time.tv_nsec - now.tv_nsec) ;
+            if ( remaining_nsec <= 0 ) {
+                ret = 0 ;
+                break ;
+            }
+            remaining.tv_sec = (time_t)(remaining_nsec / 1000000000LL) ;
+            remaining.tv_nsec = (long)(remaining_nsec % 1000000000LL) ;
+            ret = (nanosleep(&remaining, NULL) == 0) ? 0 : errno ;
+        } while ( ret == EINTR ) ;
+#else
+        while ( (ret = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake_time, NULL)) == EINTR ) ;
+#endif
+        if ( ret != 0 ) {
+            errno = ret ;
+            perror( "HybridTimer call to clock_nanosleep()" );
+        }
+    }
+
+    return (0) ;
+}
+
+int Trick::HybridTimer::shutdown() {
+    active = false ;
+    return(0) ;
+}
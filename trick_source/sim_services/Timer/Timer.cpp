@@ -26,3 +26,11 @@ bool Trick::Timer::get_enabled() {
 void Trick::Timer::set_active(bool in_active) {
     active = in_active ;
 }
+
+bool Trick::Timer::get_active() {
+    return(active) ;
+}
+
+int Trick::Timer::reset_late(double in_frame_time, double) {
+    return reset(in_frame_time) ;
+}
@@ -0,0 +1,187 @@
+#define protected public
+#define TOL 2e3
+
+#include <iostream>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+#include "trick/HybridTimer.hh"
+#include "trick/GetTimeOfDayClock.hh"
+
+namespace Trick {
+
+class HybridTimerTest : public testing::Test {
+
+	public:
+		Trick::GetTimeOfDayClock dClk;
+		double sec;
+		long long tim_st, tim_elap;
+
+		HybridTimerTest() {}
+		~HybridTimerTest() {}
+		virtual void SetUp() {}
+		virtual void TearDown() {}
+};
+
+TEST_F(HybridTimerTest, Initialize) {
+
+	Trick::HybridTimer *hTim;
+	hTim = new Trick::HybridTimer;
+
+	hTim->init();
+
+	EXPECT_FALSE(hTim->get_enabled());
+	EXPECT_FALSE(hTim->get_active());
+	EXPECT_DOUBLE_EQ(hTim->guard_time, 100.0e-6);
+
+	delete hTim;
+}
+
+/* The timer wakes guard_time before the end of the frame */
+TEST_F(HybridTimerTest, TimerStartSuccess) {
+
+	sec = 0.02;
+
+	Trick::HybridTimer *hTim;
+	hTim = new Trick::HybridTimer;
+
+	hTim->init();
+	hTim->enable();
+
+	tim_st = dClk.wall_clock_time();
+	hTim->start(sec);
+	ASSERT_TRUE(hTim->active);
+	hTim->pause();
+	tim_elap = dClk.wall_clock_time() - tim_st;
+
+	EXPECT_GE(tim_elap, (sec - hTim->guard_time)*1e6 - 1);
+	EXPECT_NEAR(tim_elap, (sec - hTim->guard_time)*1e6, TOL);
+
+	delete hTim;
+}
+
+/* Frames shorter than 10 ms, which the ITimer cannot sleep through, are slept */
+TEST_F(HybridTimerTest, ShortFrame) {
+
+	sec = 0.002;
+
+	Trick::HybridTimer *hTim;
+	hTim = new Trick::HybridTimer;
+
+	hTim->init();
+	hTim->enable();
+
+	tim_st = dClk.wall_clock_time();
+	hTim->start(sec);
+	EXPECT_TRUE(hTim->active);
+	hTim->pause();
+	tim_elap = dClk.wall_clock_time() - tim_st;
+
+	EXPECT_GE(tim_elap, (sec - hTim->guard_time)*1e6 - 1);
+
+	/* Nothing to sleep in a frame no longer than guard_time */
+	hTim->start(hTim->guard_time);
+	EXPECT_FALSE(hTim->active);
+
+	delete hTim;
+}
+
+/* A late pause returns immediately, the wake up time is absolute */
+TEST_F(HybridTimerTest, DeadlinePassed) {
+
+	sec = 0.01;
+
+	Trick::HybridTimer *hTim;
+	hTim = new Trick::HybridTimer;
+
+	hTim->init();
+	hTim->enable();
+
+	hTim->start(sec);
+	usleep(20000);
+
+	tim_st = dClk.wall_clock_time();
+	hTim->pause();
+	tim_elap = dClk.wall_clock_time() - tim_st;
+
+	EXPECT_NEAR(tim_elap, 0, TOL);
+
+	delete hTim;
+}
+
+/* A frame reset late is timed from the frame boundary, the lateness is not carried into the next wake up */
+TEST_F(HybridTimerTest, ResetLate) {
+
+	sec = 0.01;
+
+	Trick::HybridTimer *hTim;
+	hTim = new Trick::HybridTimer;
+
+	hTim->init();
+	hTim->enable();
+
+	tim_st = dClk.wall_clock_time();
+	hTim->start(sec);
+	hTim->pause();
+	/* the frame boundary is guard_time after the wake up, the reset comes 3 ms after it */
+	usleep(3000 + (useconds_t)(hTim->guard_time*1e6));
+	long long late = dClk.wall_clock_time() - tim_st - (long long)(sec*1e6);
+	hTim->reset_late(sec, late*1e-6);
+	EXPECT_TRUE(hTim->active);
+	hTim->pause();
+	tim_elap = dClk.wall_clock_time() - tim_st;
+
+	EXPECT_GE(tim_elap, (2*sec - hTim->guard_time)*1e6 - 1);
+	EXPECT_NEAR(tim_elap, (2*sec - hTim->guard_time)*1e6, TOL);
+
+	/* A reset later than the whole frame does not sleep */
+	hTim->reset_late(sec, 2*sec);
+	tim_st = dClk.wall_clock_time();
+	hTim->pause();
+	tim_elap = dClk.wall_clock_time() - tim_st;
+	EXPECT_NEAR(tim_elap, 0, TOL);
+
+	delete hTim;
+}
+
+TEST_F(HybridTimerTest, TimerStartStop) {
+
+	sec = 0.05;
+
+	Trick::HybridTimer *hTim;
+	hTim = new Trick::HybridTimer;
+
+	hTim->init();
+	hTim->enable();
+
+	hTim->start(sec);
+	hTim->stop();
+	EXPECT_FALSE(hTim->active);
+
+	tim_st = dClk.wall_clock_time();
+	hTim->pause();
+	tim_elap = dClk.wall_clock_time() - tim_st;
+
+	EXPECT_NEAR(tim_elap, 0, TOL);
+
+	delete hTim;
+}
+
+TEST_F(HybridTimerTest, TimerNotEnabled) {
+
+	Trick::HybridTimer *hTim;
+	hTim = new Trick::HybridTimer;
+
+	hTim->init();
+	hTim->start(0.05);
+	EXPECT_FALSE(hTim->active);
+
+	tim_st = dClk.wall_clock_time();
+	hTim->pause();
+	tim_elap = dClk.wall_clock_time() - tim_st;
+	EXPECT_NEAR(tim_elap, 0, TOL);
+
+	delete hTim;
+}
+
+}
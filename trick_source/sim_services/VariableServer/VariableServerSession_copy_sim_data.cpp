@@ -5,6 +5,7 @@
 #include "trick/VariableServerSession.hh"
 #include "trick/memorymanager_c_intf.h"
 #include "trick/exec_proto.h"
+#include "trick/TraceWriter.hh"
 
 
 // These actually do the copying
@@ -20,6 +21,7 @@ int Trick::VariableServerSession::copy_sim_data(std::vector<VariableReference *>
     }
 
     if ( pthread_mutex_trylock(&_copy_mutex) == 0 ) {
+        long long start_ns = Trick::TraceWriter::active ? Trick::TraceWriter::now() : 0 ;
         // Get the simulation time we start this copy
         _time = (double)exec_get_time_tics() / exec_get_time_tic_value() ;
         
@@ -29,6 +31,9 @@ int Trick::VariableServerSession::copy_sim_data(std::vector<VariableReference *>
         }
 
         pthread_mutex_unlock(&_copy_mutex) ;
+        if ( Trick::TraceWriter::active ) {
+            Trick::TraceWriter::complete("variable server copy", "variable_server", start_ns, Trick::TraceWriter::now()) ;
+        }
     }
 
     return 0;
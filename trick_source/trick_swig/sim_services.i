@@ -40,6 +40,7 @@
 #include "trick/units_conv.h"
 
 #include "trick/GetTimeOfDayClock.hh"
+#include "trick/TSCClock.hh"
 #include "trick/clock_proto.h"
 #include "trick/CommandLineArguments.hh"
 #include "trick/command_line_protos.h"
@@ -58,6 +59,7 @@
 #include "trick/env_proto.h"
 #include "trick/Executive.hh"
 #include "trick/ExecutiveException.hh"
+#include "trick/RealtimeProfile.hh"
 #include "trick/exec_proto.h"
 #include "trick/exec_proto.hh"
 #include "trick/MalfunctionsTrickView.hh"
@@ -70,6 +72,10 @@
 #include "trick/FrameDataRecordGroup.hh"
 #include "trick/FrameLog.hh"
 #include "trick/framelog_proto.h"
+#include "trick/JobProfiler.hh"
+#include "trick/jobprofiler_proto.h"
+#include "trick/TraceWriter.hh"
+#include "trick/tracewriter_proto.h"
 #include "trick/IPPython.hh"
 #include "trick/input_processor_proto.h"
 #include "trick/MTV.hh"
@@ -141,10 +147,12 @@
 #include "trick/MonteVarFixed.hh"
 #include "trick/MonteVarRandom.hh"
 #include "trick/RealtimeSync.hh"
+#include "trick/JobShedder.hh"
 #include "trick/realtimesync_proto.h"
 #include "trick/RtiExec.hh"
 #include "trick/RtiStager.hh"
 #include "trick/ITimer.hh"
+#include "trick/HybridTimer.hh"
 #include "trick/Unit.hh"
 #include "trick/UnitTest.hh"
 #include "trick/trick_tests.h"
@@ -0,0 +1,191 @@
+/*
+    PURPOSE: ( Reader and writer of the columnar sidecar file of a Trick binary log.)
+*/
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "trick/trk_columns.h"
+#include "trick/parameter_types.h"
+
+int64_t trk_columns_mtime( const struct stat * st ) {
+#ifdef __APPLE__
+    return (int64_t)st->st_mtimespec.tv_sec * 1000000000 + st->st_mtimespec.tv_nsec ;
+#else
+    return (int64_t)st->st_mtim.tv_sec * 1000000000 + st->st_mtim.tv_nsec ;
+#endif
+}
+
+const char * trk_columns_magic( void ) {
+    union {
+        long l ;
+        char c[sizeof(long)] ;
+    } un ;
+    un.l = 1 ;
+    return ( un.c[sizeof(long) - 1] == 1 ) ? "TrkCol-B" : "TrkCol-L" ;
+}
+
+double trk_columns_value( const char * address , int type , int size , int swap ) {
+
+    unsigned char bytes[8] ;
+    int ii ;
+
+    if ( size <= 0 || size > 8 ) {
+        return 0.0 ;
+    }
+    for ( ii = 0 ; ii < size ; ii++ ) {
+        bytes[ii] = address[ swap ? size - 1 - ii : ii ] ;
+    }
+
+    switch ( type ) {
+        case TRICK_FLOAT:
+            if ( size == sizeof(float) ) {
+                float f ;
+                memcpy(&f , bytes , sizeof(f)) ;
+                return (double)f ;
+            }
+            break ;
+        case TRICK_DOUBLE:
+            if ( size == sizeof(double) ) {
+                double d ;
+                memcpy(&d , bytes , sizeof(d)) ;
+                return d ;
+            }
+            break ;
+        case TRICK_CHARACTER:
+        case TRICK_SHORT:
+        case TRICK_INTEGER:
+        case TRICK_ENUMERATED:
+        case TRICK_LONG:
+        case TRICK_LONG_LONG:
+        case TRICK_BITFIELD:
+            switch ( size ) {
+                case 1: { char v ; memcpy(&v , bytes , 1) ; return (double)v ; }
+                case 2: { int16_t v ; memcpy(&v , bytes , 2) ; return (double)v ; }
+                case 4: { int32_t v ; memcpy(&v , bytes , 4) ; return (double)v ; }
+                case 8: { int64_t v ; memcpy(&v , bytes , 8) ; return (double)v ; }
+            }
+            break ;
+        case TRICK_UNSIGNED_CHARACTER:
+        case TRICK_UNSIGNED_SHORT:
+        case TRICK_UNSIGNED_INTEGER:
+        case TRICK_UNSIGNED_LONG:
+        case TRICK_UNSIGNED_LONG_LONG:
+        case TRICK_UNSIGNED_BITFIELD:
+        case TRICK_BOOLEAN:
+            switch ( size ) {
+                case 1: { uint8_t v ; memcpy(&v , bytes , 1) ; return (double)v ; }
+                case 2: { uint16_t v ; memcpy(&v , bytes , 2) ; return (double)v ; }
+                case 4: { uint32_t v ; memcpy(&v , bytes , 4) ; return (double)v ; }
+                case 8: { uint64_t v ; memcpy(&v , bytes , 8) ; return (double)v ; }
+            }
+            break ;
+        default:
+            break ;
+    }
+    return 0.0 ;
+}
+
+int trk_columns_write( const char * col_name , const char * records , int64_t num_records ,
+ int64_t record_bytes , int num_params , const int * types , const int * sizes , const int64_t * offsets ,
+ int swap , int64_t trk_size , int64_t trk_mtime ) {
+
+    TRK_COLUMNS_HEADER header ;
+    const int64_t block_records = TRK_COLUMNS_INDEX_STRIDE ;
+    char * tmp_name ;
+    double * block ;
+    double * index ;
+    double prev_time = 0.0 ;
+    int64_t first , num , jj ;
+    off_t index_offset , columns_offset ;
+    int ii ;
+    int ok = 1 ;
+    int saved_errno ;
+    int fd ;
+
+    memset(&header , 0 , sizeof(header)) ;
+    memcpy(header.magic , trk_columns_magic() , sizeof(header.magic)) ;
+    header.trk_size = trk_size ;
+    header.trk_mtime = trk_mtime ;
+    header.num_records = num_records ;
+    header.num_params = num_params ;
+    header.index_stride = TRK_COLUMNS_INDEX_STRIDE ;
+    header.num_index = (num_records + TRK_COLUMNS_INDEX_STRIDE - 1) / TRK_COLUMNS_INDEX_STRIDE ;
+    header.time_sorted = 1 ;
+    index_offset = sizeof(header) ;
+    columns_offset = index_offset + header.num_index * sizeof(double) ;
+
+    tmp_name = (char *)malloc(strlen(col_name) + 5) ;
+    block = (double *)malloc((num_params > 0 ? num_params : 1) * block_records * sizeof(double)) ;
+    index = (double *)malloc((header.num_index > 0 ? header.num_index : 1) * sizeof(double)) ;
+    if ( tmp_name == NULL || block == NULL || index == NULL ) {
+        free(tmp_name) ;
+        free(block) ;
+        free(index) ;
+        return -1 ;
+    }
+    sprintf(tmp_name , "%s.tmp" , col_name) ;
+
+    if ((fd = open(tmp_name , O_WRONLY | O_CREAT | O_TRUNC , 0666)) < 0 ) {
+        saved_errno = errno ;
+        free(tmp_name) ;
+        free(block) ;
+        free(index) ;
+        errno = saved_errno ;
+        return -1 ;
+    }
+
+    /* Convert a block of records at a time, reading the log once. */
+    for ( first = 0 ; ok && first < num_records ; first += block_records ) {
+        const char * record = records + first * record_bytes ;
+        num = num_records - first ;
+        if ( num > block_records ) {
+            num = block_records ;
+        }
+        for ( jj = 0 ; jj < num ; jj++ , record += record_bytes ) {
+            for ( ii = 0 ; ii < num_params ; ii++ ) {
+                block[ii * block_records + jj] = trk_columns_value(record + offsets[ii] , types[ii] , sizes[ii] , swap) ;
+            }
+            if ( first + jj > 0 && block[jj] < prev_time ) {
+                header.time_sorted = 0 ;
+            }
+            prev_time = block[jj] ;
+        }
+        index[first / TRK_COLUMNS_INDEX_STRIDE] = block[0] ;
+        for ( ii = 0 ; ok && ii < num_params ; ii++ ) {
+            size_t bytes = num * sizeof(double) ;
+            off_t offset = columns_offset + ((off_t)ii * num_records + first) * sizeof(double) ;
+            ok = ( pwrite(fd , &block[ii * block_records] , bytes , offset) == (ssize_t)bytes ) ;
+        }
+    }
+
+    if ( ok && header.num_index > 0 ) {
+        size_t bytes = header.num_index * sizeof(double) ;
+        ok = ( pwrite(fd , index , bytes , index_offset) == (ssize_t)bytes ) ;
+    }
+    if ( ok ) {
+        ok = ( pwrite(fd , &header , sizeof(header) , 0) == (ssize_t)sizeof(header) ) ;
+    }
+    if ( close(fd) != 0 ) {
+        ok = 0 ;
+    }
+    if ( ok ) {
+        ok = ( rename(tmp_name , col_name) == 0 ) ;
+    }
+
+    saved_errno = errno ;
+    if ( ! ok ) {
+        unlink(tmp_name) ;
+    }
+    free(tmp_name) ;
+    free(block) ;
+    free(index) ;
+    errno = saved_errno ;
+    return ok ? 0 : -1 ;
+}